@@ -5,7 +5,9 @@
 // @see https://www.codeproject.com/Articles/1160934/Asynchronous-Multicast-Delegates-in-Cplusplus
 // David Lafreniere, Dec 2016.
 
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR_CACHE
+	#include "xallocatorcache.h"
+#elif USE_XALLOCATOR
 	#include "xallocator.h"
 #endif
 
@@ -13,7 +15,9 @@ namespace DelegateLib {
 
 /// @brief Non-template common base class for all delegates.
 class DelegateBase {
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR_CACHE
+	XALLOCATOR_CACHE
+#elif USE_XALLOCATOR
 	XALLOCATOR
 #endif
 public:
@@ -10,12 +10,33 @@
 #include "DelegateInvoker.h"
 #include <string.h>
 #include <type_traits>
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
 	#include <new>
 #endif
 
 namespace DelegateLib {
 
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
+/// Fixed block allocation of the copied parameters, from the allocator selected in DelegateOpt.h
+inline void* DelegateParamAlloc(size_t size)
+{
+#if USE_XALLOCATOR_CACHE
+	return xcmalloc(size);
+#else
+	return xmalloc(size);
+#endif
+}
+
+inline void DelegateParamFree(void* ptr)
+{
+#if USE_XALLOCATOR_CACHE
+	xcfree(ptr);
+#else
+	xfree(ptr);
+#endif
+}
+#endif
+
 /// @brief Implements a new/delete for pass by value parameter values. Doesn't 
 /// actually create memory as pass by value already has a full copy.
 template <typename Param>
@@ -33,8 +54,8 @@ class DelegateParam<Param *>
 {
 public:
 	static Param* New(Param* param, void *_pUserContext=nullptr)	{
-#if USE_XALLOCATOR
-		void* mem = xmalloc(sizeof(*param));
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
+		void* mem = DelegateParamAlloc(sizeof(*param));
 		Param* newParam = new (mem) Param(*param);
 #else
 		Param* newParam = new Param(*param);
@@ -49,9 +70,9 @@ public:
 	}
 
 	static void Delete(Param* param) {
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
 		param->~Param();
-		xfree((void*)param);
+		DelegateParamFree((void*)param);
 #else
 		delete param;
 #endif
@@ -64,11 +85,11 @@ class DelegateParam<Param **>
 {
 public:
 	static Param** New(Param** param) {
-#if USE_XALLOCATOR
-		void* mem = xmalloc(sizeof(*param));
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
+		void* mem = DelegateParamAlloc(sizeof(*param));
 		Param** newParam = new (mem) Param*();
 
-		void* mem2 = xmalloc(sizeof(**param));
+		void* mem2 = DelegateParamAlloc(sizeof(**param));
 		*newParam = new (mem2) Param(**param);
 #else
 		Param** newParam = new Param*();
@@ -79,11 +100,11 @@ public:
 	}
 
 	static void Delete(Param** param) {
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
 		(*param)->~Param();
-		xfree((void*)(*param));
+		DelegateParamFree((void*)(*param));
 
-		xfree((void*)(param));
+		DelegateParamFree((void*)(param));
 #else
 		delete *param;
 		delete param;
@@ -97,8 +118,8 @@ class DelegateParam<Param &>
 {
 public:
 	static Param& New(Param& param, void *_pUserContext=nullptr)	{
-#if USE_XALLOCATOR
-		void* mem = xmalloc(sizeof(param));
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
+		void* mem = DelegateParamAlloc(sizeof(param));
 		Param* newParam = new (mem) Param(param);
 #else
 		Param* newParam = new Param(param);
@@ -111,9 +132,9 @@ public:
 	}
 
 	static void Delete(Param& param) {
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR || USE_XALLOCATOR_CACHE
 		(&param)->~Param();
-		xfree((void*)(&param));
+		DelegateParamFree((void*)(&param));
 #else
 		delete &param;
 #endif
@@ -0,0 +1,288 @@
+#ifndef _DELEGATE_FAST_H
+#define _DELEGATE_FAST_H
+
+// DelegateFast.h
+// Allocation free variant of the asynchronous multicast delegates:
+// - DelegateFast1 stores the bound function inline (small buffer) and is trivially
+//   copyable, so registering or dispatching it never calls a virtual Clone().
+// - DelegateFastMsg1 carries the copied argument by value and is obtained from
+//   DelegateMsgPool (XallocCache), a per-thread fixed block cache, instead of the global heap.
+// - MulticastDelegateFast1 keeps its invocation list in a BofCowList: an immutable snapshot
+//   replaced (copy-on-write) on +=/-=, so operator() never takes a lock nor waits for a registration.
+
+#include "DelegateOpt.h"
+#include "DelegateThread.h"
+#include "DelegateInvoker.h"
+#include "xallocatorcache.h"
+#include <bofstd/bofcowlist.h>
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string.h>
+#include <type_traits>
+
+namespace DelegateLib {
+
+/// @brief Fixed block allocator used for the asynchronous delegate messages.
+/// @details The thread cached xallocator: a message allocated by the caller thread and released
+/// by the DelegateThread is exchanged between the thread caches by batches, without a lock per message.
+typedef XallocCache DelegateMsgPool;
+
+/// @brief Copies a delegate argument inside the message storage instead of on the heap.
+/// @details Same semantic as DelegateParam: pass by value parameters are copied, pointer and
+/// reference parameters have their target copied and, if a user context is bound to the delegate,
+/// this one is injected in the first pointer sized field of the copy.
+template <typename Param>
+class DelegateFastParam
+{
+public:
+	typedef Param Storage;
+	static void New(void* where, Param param, void* userContext) { ::new (where) Storage(param); }
+	static Param Get(void* where) { return *static_cast<Storage*>(where); }
+	static void Delete(void* where) { static_cast<Storage*>(where)->~Storage(); }
+};
+
+template <typename Param>
+class DelegateFastParam<Param*>
+{
+public:
+	typedef typename std::remove_cv<Param>::type Storage;
+	static void New(void* where, Param* param, void* userContext) {
+		Storage* newParam = ::new (where) Storage(*param);
+		if (userContext)
+		{
+			memcpy((void *)newParam, &userContext, sizeof(void *));
+		}
+	}
+	static Param* Get(void* where) { return static_cast<Storage*>(where); }
+	static void Delete(void* where) { static_cast<Storage*>(where)->~Storage(); }
+};
+
+template <typename Param>
+class DelegateFastParam<Param&>
+{
+public:
+	typedef typename std::remove_cv<Param>::type Storage;
+	static void New(void* where, Param& param, void* userContext) {
+		Storage* newParam = ::new (where) Storage(param);
+		if (userContext)
+		{
+			memcpy((void *)newParam, &userContext, sizeof(void *));
+		}
+	}
+	static Param& Get(void* where) { return *static_cast<Storage*>(where); }
+	static void Delete(void* where) { static_cast<Storage*>(where)->~Storage(); }
+};
+
+template <class Param1>
+class DelegateFastMsg1;
+
+/// @brief Small buffer delegate bound to a free or member function, invoked synchronously
+/// if no DelegateThread is given or asynchronously on that thread otherwise.
+/// @details The target is kept in an inline buffer together with a non virtual trampoline,
+/// so the object is trivially copyable and never touches the heap.
+template <class Param1>
+class DelegateFast1
+{
+public:
+	typedef void (*FreeFunc)(Param1);
+
+	DelegateFast1() : m_stub(0), m_thread(0), m_userContext(0) { memset(m_storage, 0, sizeof(m_storage)); }
+	DelegateFast1(FreeFunc func, DelegateThread* thread = 0) { Bind(func, thread); }
+	template <class TClass>
+	DelegateFast1(TClass* object, void (TClass::*func)(Param1), DelegateThread* thread = 0) { Bind(object, func, thread); }
+	template <class TClass>
+	DelegateFast1(TClass* object, void (TClass::*func)(Param1) const, DelegateThread* thread = 0) { Bind(object, func, thread); }
+
+	/// Bind a free function to the delegate.
+	void Bind(FreeFunc func, DelegateThread* thread) {
+		Reset(thread);
+		memcpy(m_storage, &func, sizeof(func));
+		m_stub = &FreeStub;
+	}
+
+	/// Bind a (const) member function to the delegate.
+	template <class TClass, class MemberFunc>
+	void Bind(TClass* object, MemberFunc func, DelegateThread* thread) {
+		typedef MemberTarget<TClass, MemberFunc> Target;
+		static_assert(sizeof(Target) <= sizeof(m_storage), "DelegateFast1: member target does not fit in the small buffer");
+		Reset(thread);
+		Target target = { object, func };
+		memcpy(m_storage, &target, sizeof(target));
+		m_stub = &MemberStub<TClass, MemberFunc>;
+	}
+
+	void UserContext(void* userContext) { m_userContext = userContext; }
+	void* UserContext() const { return m_userContext; }
+	DelegateThread* Thread() const { return m_thread; }
+	bool Empty() const { return m_stub == 0; }
+
+	/// Two delegates are equal if they target the same function (and object) on the same thread.
+	bool operator==(const DelegateFast1& rhs) const {
+		return (m_stub == rhs.m_stub) && (m_thread == rhs.m_thread) && (memcmp(m_storage, rhs.m_storage, sizeof(m_storage)) == 0);
+	}
+	bool operator!=(const DelegateFast1& rhs) const { return !operator==(rhs); }
+
+	/// Invoke the delegate, asynchronously if a DelegateThread is bound.
+	void operator()(Param1 p1) const;
+
+	/// Call the target on the calling thread.
+	void Invoke(Param1 p1) const { m_stub(m_storage, p1); }
+
+private:
+	template <class TClass, class MemberFunc>
+	struct MemberTarget
+	{
+		TClass* Object;
+		MemberFunc Func;
+	};
+
+	static void FreeStub(const void* storage, Param1 p1) {
+		FreeFunc func;
+		memcpy(&func, storage, sizeof(func));
+		(*func)(p1);
+	}
+
+	template <class TClass, class MemberFunc>
+	static void MemberStub(const void* storage, Param1 p1) {
+		const MemberTarget<TClass, MemberFunc>* target = static_cast<const MemberTarget<TClass, MemberFunc>*>(storage);
+		(target->Object->*target->Func)(p1);
+	}
+
+	void Reset(DelegateThread* thread) {
+		memset(m_storage, 0, sizeof(m_storage));
+		m_thread = thread;
+		m_userContext = 0;
+	}
+
+	/// Large enough for an object pointer plus a member function pointer.
+	alignas(void*) unsigned char m_storage[3 * sizeof(void*)];
+	void (*m_stub)(const void*, Param1);
+	DelegateThread* m_thread;
+	void* m_userContext;
+};
+
+/// @brief Message dispatched by DelegateFast1. It is its own IDelegateInvoker, so no delegate
+/// clone is needed, and it is released to DelegateMsgPool once the target has been called.
+template <class Param1>
+class DelegateFastMsg1 : public IDelegateInvoker, public DelegateMsgBase
+{
+public:
+	typedef typename DelegateFastParam<Param1>::Storage Storage;
+
+	/// Build a message in a pooled block.
+	/// @return The message or 0 if out of memory.
+	static DelegateFastMsg1* Create(const DelegateFast1<Param1>& delegate, Param1 p1) {
+		void* mem = DelegateMsgPool::Allocate(sizeof(DelegateFastMsg1<Param1>));
+		return mem ? ::new (mem) DelegateFastMsg1<Param1>(delegate, p1) : 0;
+	}
+
+	/// Called by the target thread to invoke the delegate function
+	virtual void DelegateInvoke(DelegateMsgBase** msg) {
+		m_delegate.Invoke(DelegateFastParam<Param1>::Get(&m_param));
+		*msg = 0;
+
+		// Do this last before returning!
+		this->~DelegateFastMsg1();
+		DelegateMsgPool::Deallocate(this);
+	}
+
+private:
+	DelegateFastMsg1(const DelegateFast1<Param1>& delegate, Param1 p1) :
+		IDelegateInvoker(),
+		DelegateMsgBase(this),
+		m_delegate(delegate)
+	{
+		DelegateFastParam<Param1>::New(&m_param, p1, delegate.UserContext());
+	}
+	~DelegateFastMsg1() { DelegateFastParam<Param1>::Delete(&m_param); }
+
+	DelegateFast1<Param1> m_delegate;
+	typename std::aligned_storage<sizeof(Storage), alignof(Storage)>::type m_param;
+};
+
+template <class Param1>
+void DelegateFast1<Param1>::operator()(Param1 p1) const
+{
+	if (m_stub)
+	{
+		if (m_thread == 0)
+		{
+			Invoke(p1);
+		}
+		else
+		{
+			DelegateFastMsg1<Param1>* msg = DelegateFastMsg1<Param1>::Create(*this, p1);
+			if (msg)
+			{
+				// DelegateInvoke() will be called by the target thread.
+				m_thread->DispatchDelegate(msg);
+			}
+		}
+	}
+}
+
+/// @brief Thread-safe multicast container of DelegateFast1 with a lock-free invocation path.
+/// @details The invocation list is a BofCowList: invocation enters the current snapshot with one
+/// compare and swap on its reader count (no shared_ptr atomic_load, no lock), walks it and leaves
+/// it; registration publishes a new one under a mutex. Each replaced snapshot is freed when its
+/// last invocation returns.
+template <class Param1>
+class MulticastDelegateFast1
+{
+public:
+	MulticastDelegateFast1() { }
+	~MulticastDelegateFast1() { }
+
+	void operator+=(const DelegateFast1<Param1>& delegate) {
+		uint32_t id;
+		m_list.Insert(delegate, id);
+	}
+
+	/// Remove the first delegate equal to the given one.
+	void operator-=(const DelegateFast1<Param1>& delegate) {
+		m_list.RemoveIf([&delegate](uint32_t, const DelegateFast1<Param1>& item) { return item == delegate; }, 1);
+	}
+
+	/// Invoke all registered delegates. Lock-free: never blocks on a registration in progress.
+	void operator()(Param1 p1) {
+		onbings::bof::BofCowListReader<DelegateFast1<Param1> > reader(m_list);
+		for (const onbings::bof::BOF_COW_LIST_ITEM<DelegateFast1<Param1> >* it = reader.begin(); it != reader.end(); ++it)
+		{
+			it->Value(p1);
+		}
+	}
+
+	bool Empty() const { return m_list.IsEmpty(); }
+
+	void Clear() { m_list.Clear(); }
+
+	explicit operator bool() const { return !Empty(); }
+
+private:
+	// Prevent copying objects
+	MulticastDelegateFast1(const MulticastDelegateFast1&);
+	MulticastDelegateFast1& operator=(const MulticastDelegateFast1&);
+
+	onbings::bof::BofCowList<DelegateFast1<Param1> > m_list;
+};
+
+template <class Param1>
+DelegateFast1<Param1> MakeDelegateFast(void (*func)(Param1), DelegateThread* thread = 0) {
+	return DelegateFast1<Param1>(func, thread);
+}
+
+template <class TClass, class Param1>
+DelegateFast1<Param1> MakeDelegateFast(TClass* object, void (TClass::*func)(Param1), DelegateThread* thread = 0) {
+	return DelegateFast1<Param1>(object, func, thread);
+}
+
+template <class TClass, class Param1>
+DelegateFast1<Param1> MakeDelegateFast(TClass* object, void (TClass::*func)(Param1) const, DelegateThread* thread = 0) {
+	return DelegateFast1<Param1>(object, func, thread);
+}
+
+}
+
+#endif
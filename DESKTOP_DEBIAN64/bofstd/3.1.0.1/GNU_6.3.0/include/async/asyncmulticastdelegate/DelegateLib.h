@@ -12,6 +12,7 @@
 #include "DelegateRemoteRecv.h"
 
 #include "DelegateSpAsync.h"
+#include "DelegateFast.h"
 
 #include <asyncmulticastdelegate/bofmsgthread.h>
 
@@ -2,7 +2,9 @@
 #define _DELEGATE_MSG_H
 #include <cassert>
 #include "DelegateInvoker.h"
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR_CACHE
+	#include "xallocatorcache.h"
+#elif USE_XALLOCATOR
 	#include "xallocator.h"
 #endif
 
@@ -12,7 +14,9 @@ class DelegateBase;
 
 class DelegateMsgBase
 {
-#if USE_XALLOCATOR
+#if USE_XALLOCATOR_CACHE
+	XALLOCATOR_CACHE
+#elif USE_XALLOCATOR
 	XALLOCATOR
 #endif
 public:
@@ -7,4 +7,9 @@
 // @see https://www.codeproject.com/Articles/1084801/Replace-malloc-free-with-a-Fast-Fixed-Block-Memory
 //#define USE_XALLOCATOR 1
 
+// Uncomment the line below to use the header only, thread cached fixed block allocator
+// (xallocatorcache.h) instead: no global lock on each message and programmatic statistics
+// with xcalloc_get_stats(). It takes precedence over USE_XALLOCATOR.
+//#define USE_XALLOCATOR_CACHE 1
+
 #endif
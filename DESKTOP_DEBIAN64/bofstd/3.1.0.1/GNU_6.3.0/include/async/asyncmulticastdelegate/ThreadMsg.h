@@ -1,17 +1,22 @@
 #ifndef _THREAD_MSG_H
 #define _THREAD_MSG_H
 
-//#if USE_XALLOCATOR
+#include "DelegateOpt.h"
+#if USE_XALLOCATOR_CACHE
+	#include "xallocatorcache.h"
+#else
 	#include "xallocator.h"
-///#endif
+#endif
 
 /// @brief A class to hold a platform-specific thread messsage that will be passed 
 /// through the OS message queue. 
 class ThreadMsg
 {
-//#if USE_XALLOCATOR
+#if USE_XALLOCATOR_CACHE
+	XALLOCATOR_CACHE
+#else
 	XALLOCATOR
-//#endif
+#endif
 public:
 	/// Constructor
 	/// @param[in] id - a unique identifier for the thread messsage
@@ -0,0 +1,408 @@
+#ifndef _XALLOCATOR_CACHE_H
+#define _XALLOCATOR_CACHE_H
+
+// xallocatorcache.h
+// Header only, thread cached variant of the xallocator fixed block allocator:
+// - each thread keeps a private free list per size class, so xcmalloc()/xcfree()
+//   do not take any lock in the steady state;
+// - blocks are exchanged with the global lists (one lock per size class) by batches;
+// - xcalloc_get_stats() returns per size class counters instead of printing them.
+// Select it for the delegate library with USE_XALLOCATOR_CACHE (see DelegateOpt.h),
+// class by class with the XALLOCATOR_CACHE macro, or for std::allocate_shared with
+// XallocCacheStlAllocator (socket IO/session objects for example).
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/// Number of size classes: 16, 32, 64, ... 4096 bytes. Bigger requests go to the global heap.
+#define XALLOC_CACHE_NB_CLASS		9
+#define XALLOC_CACHE_MIN_SHIFT		4
+/// A thread cache holding more than this number of free blocks of a class gives a batch back.
+#define XALLOC_CACHE_MAX_CACHED		256
+/// Number of blocks moved at once between a thread cache and the global lists.
+#define XALLOC_CACHE_BATCH			64
+
+/// @brief Counters of one size class, all threads merged.
+struct XallocCacheClassStats
+{
+	size_t BlockSize;
+	uint64_t Allocs;
+	uint64_t Frees;
+	int64_t InUse;				///< Allocs - Frees. A thread may free the blocks of another one, only the sum is meaningful.
+	uint64_t Outstanding;		///< Blocks out of the global list (in use or kept by a thread cache)
+	uint64_t PeakOutstanding;	///< High water mark of Outstanding: upper bound of the in use peak
+	uint64_t BlocksCreated;		///< Blocks taken from the global heap
+	uint64_t Refills;			///< Batches taken from the global list (or created)
+	uint64_t Spills;			///< Batches given back to the global list
+	uint64_t LockContentions;	///< Refills/spills which found the class lock taken
+};
+
+struct XallocCacheStats
+{
+	XallocCacheClassStats Class[XALLOC_CACHE_NB_CLASS];
+	uint64_t HeapAllocs;		///< Requests bigger than the biggest class
+	uint64_t HeapFrees;
+	uint32_t NbThreadCache;		///< Threads which currently own a cache
+};
+
+/// @brief Thread cached fixed block allocator.
+/// @details A block is preceded by a 16 bytes header giving its size class, so xcfree()
+/// does not need the size and a block may be freed by any thread. As a message is typically
+/// allocated by one thread and freed by another one, blocks migrate: the freeing thread
+/// caches them and spills batches to the global list, where the allocating thread refills.
+/// The counters are written by their owning thread only (relaxed atomics) and summed by
+/// GetStats(). The global lists are never destroyed: thread caches may be spilled during
+/// static destruction.
+class XallocCache
+{
+public:
+	/// Get a block of at least size bytes.
+	/// @param[in] size - requested size in bytes.
+	/// @return The block or 0 if out of memory.
+	static void* Allocate(size_t size)
+	{
+		void* pRts = 0;
+		uint32_t sizeClass = SizeToClass(size);
+
+		if (sizeClass == HEAP_CLASS)
+		{
+			BlockHeader* header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + size, std::nothrow));
+			if (header)
+			{
+				header->SizeClass = HEAP_CLASS;
+				pRts = header + 1;
+				GetGlobal().HeapAllocs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		else
+		{
+			ThreadCache& cache = GetThreadCache();
+			BlockHeader* header = cache.FreeList[sizeClass];
+			if (header == 0)
+			{
+				header = Refill(cache, sizeClass);
+			}
+			if (header)
+			{
+				cache.FreeList[sizeClass] = header->Next;
+				cache.NbFree[sizeClass]--;
+				header->SizeClass = sizeClass;
+				pRts = header + 1;
+				Inc(cache.Allocs[sizeClass]);
+			}
+		}
+		return pRts;
+	}
+
+	/// Give back a block obtained with Allocate(). May be called from any thread.
+	/// @param[in] ptr - the block to release.
+	static void Deallocate(void* ptr)
+	{
+		if (ptr)
+		{
+			BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+			uint32_t sizeClass = header->SizeClass;
+
+			if (sizeClass == HEAP_CLASS)
+			{
+				::operator delete(header);
+				GetGlobal().HeapFrees.fetch_add(1, std::memory_order_relaxed);
+			}
+			else
+			{
+				ThreadCache& cache = GetThreadCache();
+				header->Next = cache.FreeList[sizeClass];
+				cache.FreeList[sizeClass] = header;
+				Inc(cache.Frees[sizeClass]);
+				if (++cache.NbFree[sizeClass] > XALLOC_CACHE_MAX_CACHED)
+				{
+					Spill(cache, sizeClass, XALLOC_CACHE_BATCH);
+				}
+			}
+		}
+	}
+
+	/// Get the counters of all the size classes, all threads merged.
+	/// @param[out] stats - the counters.
+	static void GetStats(XallocCacheStats& stats)
+	{
+		Global& global = GetGlobal();
+		uint32_t i;
+
+		for (i = 0; i < XALLOC_CACHE_NB_CLASS; i++)
+		{
+			ClassList& list = global.Class[i];
+			std::lock_guard<std::mutex> lock(list.Lock);
+			stats.Class[i].BlockSize = ClassToSize(i);
+			stats.Class[i].Outstanding = list.Outstanding;
+			stats.Class[i].PeakOutstanding = list.PeakOutstanding;
+			stats.Class[i].BlocksCreated = list.BlocksCreated;
+			stats.Class[i].Refills = list.Refills;
+			stats.Class[i].Spills = list.Spills;
+			stats.Class[i].LockContentions = list.LockContentions;
+		}
+		std::lock_guard<std::mutex> lock(global.RegistryLock);
+		for (i = 0; i < XALLOC_CACHE_NB_CLASS; i++)
+		{
+			stats.Class[i].Allocs = global.ExitedAllocs[i];
+			stats.Class[i].Frees = global.ExitedFrees[i];
+			for (const ThreadCache* cache : global.ThreadCacheCollection)
+			{
+				stats.Class[i].Allocs += cache->Allocs[i].load(std::memory_order_relaxed);
+				stats.Class[i].Frees += cache->Frees[i].load(std::memory_order_relaxed);
+			}
+			stats.Class[i].InUse = static_cast<int64_t>(stats.Class[i].Allocs - stats.Class[i].Frees);
+		}
+		stats.HeapAllocs = global.HeapAllocs.load(std::memory_order_relaxed);
+		stats.HeapFrees = global.HeapFrees.load(std::memory_order_relaxed);
+		stats.NbThreadCache = static_cast<uint32_t>(global.ThreadCacheCollection.size());
+	}
+
+	/// Gets the block size of a size class.
+	static size_t ClassToSize(uint32_t sizeClass) { return static_cast<size_t>(1) << (sizeClass + XALLOC_CACHE_MIN_SHIFT); }
+
+private:
+	static const uint32_t HEAP_CLASS = 0xFF;
+
+	/// Prepended to each block. Aligned on 16 bytes to keep the payload suitably aligned.
+	struct alignas(16) BlockHeader
+	{
+		union
+		{
+			BlockHeader* Next;
+			uint32_t SizeClass;
+		};
+	};
+
+	struct ThreadCache
+	{
+		BlockHeader* FreeList[XALLOC_CACHE_NB_CLASS];
+		uint32_t NbFree[XALLOC_CACHE_NB_CLASS];
+		std::atomic<uint64_t> Allocs[XALLOC_CACHE_NB_CLASS];
+		std::atomic<uint64_t> Frees[XALLOC_CACHE_NB_CLASS];
+
+		ThreadCache()
+		{
+			for (uint32_t i = 0; i < XALLOC_CACHE_NB_CLASS; i++)
+			{
+				FreeList[i] = 0;
+				NbFree[i] = 0;
+				Allocs[i].store(0, std::memory_order_relaxed);
+				Frees[i].store(0, std::memory_order_relaxed);
+			}
+			Global& global = GetGlobal();
+			std::lock_guard<std::mutex> lock(global.RegistryLock);
+			global.ThreadCacheCollection.push_back(this);
+		}
+		/// A dying thread hands all its cached blocks to the global lists and folds its counters.
+		~ThreadCache()
+		{
+			Global& global = GetGlobal();
+			uint32_t i;
+
+			for (i = 0; i < XALLOC_CACHE_NB_CLASS; i++)
+			{
+				Spill(*this, i, NbFree[i]);
+			}
+			std::lock_guard<std::mutex> lock(global.RegistryLock);
+			for (i = 0; i < XALLOC_CACHE_NB_CLASS; i++)
+			{
+				global.ExitedAllocs[i] += Allocs[i].load(std::memory_order_relaxed);
+				global.ExitedFrees[i] += Frees[i].load(std::memory_order_relaxed);
+			}
+			global.ThreadCacheCollection.erase(std::remove(global.ThreadCacheCollection.begin(), global.ThreadCacheCollection.end(), this), global.ThreadCacheCollection.end());
+		}
+	};
+
+	/// One lock per size class: threads working on different classes never contend.
+	struct ClassList
+	{
+		std::mutex Lock;
+		BlockHeader* FreeList = 0;
+		uint64_t Outstanding = 0;
+		uint64_t PeakOutstanding = 0;
+		uint64_t BlocksCreated = 0;
+		uint64_t Refills = 0;
+		uint64_t Spills = 0;
+		uint64_t LockContentions = 0;
+	};
+
+	struct Global
+	{
+		ClassList Class[XALLOC_CACHE_NB_CLASS];
+		std::mutex RegistryLock;
+		std::vector<ThreadCache*> ThreadCacheCollection;
+		uint64_t ExitedAllocs[XALLOC_CACHE_NB_CLASS] = {};
+		uint64_t ExitedFrees[XALLOC_CACHE_NB_CLASS] = {};
+		std::atomic<uint64_t> HeapAllocs{0};
+		std::atomic<uint64_t> HeapFrees{0};
+	};
+
+	static void Inc(std::atomic<uint64_t>& counter)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	static uint32_t SizeToClass(size_t size)
+	{
+		uint32_t sizeClass;
+
+		for (sizeClass = 0; sizeClass < XALLOC_CACHE_NB_CLASS; sizeClass++)
+		{
+			if (size <= ClassToSize(sizeClass))
+			{
+				return sizeClass;
+			}
+		}
+		return HEAP_CLASS;
+	}
+
+	static ThreadCache& GetThreadCache()
+	{
+		static thread_local ThreadCache S_threadCache;
+		return S_threadCache;
+	}
+
+	static Global& GetGlobal()
+	{
+		static Global* S_pGlobal = new Global();
+		return *S_pGlobal;
+	}
+
+	/// Lock a class list, counting the cases where another thread holds it.
+	static std::unique_lock<std::mutex> LockClass(ClassList& list)
+	{
+		std::unique_lock<std::mutex> lock(list.Lock, std::try_to_lock);
+
+		if (!lock.owns_lock())
+		{
+			lock.lock();
+			list.LockContentions++;
+		}
+		return lock;
+	}
+
+	/// Take a batch from the global list or, if it is empty, carve a new one from the heap.
+	static BlockHeader* Refill(ThreadCache& cache, uint32_t sizeClass)
+	{
+		ClassList& list = GetGlobal().Class[sizeClass];
+		BlockHeader* header;
+		uint32_t i, nb = 0;
+
+		std::unique_lock<std::mutex> lock = LockClass(list);
+		while ((nb < XALLOC_CACHE_BATCH) && (list.FreeList))
+		{
+			header = list.FreeList;
+			list.FreeList = header->Next;
+			header->Next = cache.FreeList[sizeClass];
+			cache.FreeList[sizeClass] = header;
+			nb++;
+		}
+		if (nb == 0)
+		{
+			lock.unlock();
+			for (i = 0; i < XALLOC_CACHE_BATCH; i++)
+			{
+				header = static_cast<BlockHeader*>(::operator new(sizeof(BlockHeader) + ClassToSize(sizeClass), std::nothrow));
+				if (header == 0)
+				{
+					break;
+				}
+				header->Next = cache.FreeList[sizeClass];
+				cache.FreeList[sizeClass] = header;
+				nb++;
+			}
+			lock.lock();
+			list.BlocksCreated += nb;
+		}
+		list.Refills++;
+		list.Outstanding += nb;
+		list.PeakOutstanding = std::max(list.PeakOutstanding, list.Outstanding);
+		cache.NbFree[sizeClass] += nb;
+		return cache.FreeList[sizeClass];
+	}
+
+	static void Spill(ThreadCache& cache, uint32_t sizeClass, uint32_t nb)
+	{
+		ClassList& list = GetGlobal().Class[sizeClass];
+		BlockHeader* header;
+
+		if ((nb) && (cache.FreeList[sizeClass]))
+		{
+			std::unique_lock<std::mutex> lock = LockClass(list);
+			list.Spills++;
+			while ((nb--) && (cache.FreeList[sizeClass]))
+			{
+				header = cache.FreeList[sizeClass];
+				cache.FreeList[sizeClass] = header->Next;
+				header->Next = list.FreeList;
+				list.FreeList = header;
+				cache.NbFree[sizeClass]--;
+				list.Outstanding--;
+			}
+		}
+	}
+};
+
+/// Allocate a block of memory from the thread cached allocator
+/// @param[in] size - the size of the block to allocate.
+inline void* xcmalloc(size_t size) { return XallocCache::Allocate(size); }
+
+/// Frees a block allocated with xcmalloc, from any thread
+/// @param[in] ptr - a pointer to a previously allocated memory using xcmalloc.
+inline void xcfree(void* ptr) { XallocCache::Deallocate(ptr); }
+
+/// Get the allocator statistics
+/// @param[out] stats - the per size class counters, all threads merged.
+inline void xcalloc_get_stats(XallocCacheStats* stats)
+{
+	if (stats)
+	{
+		XallocCache::GetStats(*stats);
+	}
+}
+
+/// Macro to overload new/delete with xcmalloc/xcfree
+#define XALLOCATOR_CACHE \
+    public: \
+        void* operator new(size_t size) { \
+            void* p = xcmalloc(size); \
+            if (p == 0) throw std::bad_alloc(); \
+            return p; \
+        } \
+        void operator delete(void* pObject) { \
+            xcfree(pObject); \
+        }
+
+/// @brief Standard allocator adaptor, e.g. std::allocate_shared<MySocketSession>(XallocCacheStlAllocator<MySocketSession>(), ...)
+/// puts the object and its control block in a single thread cached block.
+template <class T>
+class XallocCacheStlAllocator
+{
+public:
+	typedef T value_type;
+
+	XallocCacheStlAllocator() {}
+	template <class U> XallocCacheStlAllocator(const XallocCacheStlAllocator<U>&) {}
+
+	T* allocate(size_t n)
+	{
+		void* p = xcmalloc(n * sizeof(T));
+		if (p == 0)
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(p);
+	}
+	void deallocate(T* p, size_t) { xcfree(p); }
+
+	template <class U> bool operator==(const XallocCacheStlAllocator<U>&) const { return true; }
+	template <class U> bool operator!=(const XallocCacheStlAllocator<U>&) const { return false; }
+};
+
+#endif
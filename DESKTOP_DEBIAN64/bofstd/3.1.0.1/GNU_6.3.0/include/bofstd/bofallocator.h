@@ -0,0 +1,805 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the size class slab allocator (with per thread caches)
+ * and the arena allocator used for transient and request scoped buffers.
+ *
+ * Name:        bofallocator.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/ibofallocator.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofstatistics.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+constexpr uint32_t BOF_SLAB_MAX_SIZE_CLASS = 24;
+
+/*** Structure **************************************************************/
+
+struct BOF_SLAB_ALLOCATOR_PARAM
+{
+  std::string Name_S;
+  uint32_t    MinBlockSizeInByte_U32;       /*! Smallest size class, rounded up to a power of two (>= 16) */
+  uint32_t    MaxBlockSizeInByte_U32;       /*! Largest size class. Bigger requests go to the system heap (NbFallback_U64) */
+  uint32_t    SlabSizeInByte_U32;           /*! Memory taken from the system at once to carve blocks of one class */
+  uint32_t    ThreadCacheSize_U32;          /*! Max number of blocks per class kept by each thread. 0 disables the thread caches */
+  uint64_t    MaxMemoryInByte_U64;          /*! Limit of ReservedInByte_U64. 0 means unlimited */
+  bool        LockSlab_B;                   /*! Lock the slabs in RAM (see Bof_LockMem) */
+
+  BOF_SLAB_ALLOCATOR_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S                 = "";
+    MinBlockSizeInByte_U32 = 64;
+    MaxBlockSizeInByte_U32 = 64 * 1024;
+    SlabSizeInByte_U32     = 256 * 1024;
+    ThreadCacheSize_U32    = 32;
+    MaxMemoryInByte_U64    = 0;
+    LockSlab_B             = false;
+  }
+};
+
+struct BOF_ARENA_ALLOCATOR_PARAM
+{
+  std::string   Name_S;
+  uint32_t      ChunkSizeInByte_U32;        /*! Size of the chunks in which the allocations are bumped */
+  uint32_t      AlignmentInByte_U32;        /*! Alignment of each allocation (power of two) */
+  bool          MultiThreadAware_B;
+  uint64_t      MaxMemoryInByte_U64;        /*! 0 means unlimited */
+  IBofAllocator *pChunkAllocator;           /*! Chunks come from this allocator (a BofSlabAllocator for example) or from the heap if nullptr */
+
+  BOF_ARENA_ALLOCATOR_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S              = "";
+    ChunkSizeInByte_U32 = 64 * 1024;
+    AlignmentInByte_U32 = 16;
+    MultiThreadAware_B  = false;
+    MaxMemoryInByte_U64 = 0;
+    pChunkAllocator     = nullptr;
+  }
+};
+
+/*** Class **************************************************************/
+
+class BofSlabAllocator;
+
+//Owned by the allocator, used lock free by a single thread. The counters are only written by this thread (relaxed load/store)
+//and summed by BofSlabAllocator::V_Statistic.
+struct BOF_SLAB_THREAD_CACHE
+{
+  uint32_t                           InstanceId_U32;
+  std::vector<void *>                BlockCollection[BOF_SLAB_MAX_SIZE_CLASS];
+  std::atomic<uint64_t>              NbAlloc_U64;
+  std::atomic<uint64_t>              NbFree_U64;
+  std::atomic<uint64_t>              NbCacheHit_U64;
+  std::atomic<int64_t>               AllocInByte_S64;     /*! A thread can free blocks allocated by another one: can be negative */
+
+  BOF_SLAB_THREAD_CACHE(uint32_t _InstanceId_U32) : InstanceId_U32(_InstanceId_U32), NbAlloc_U64(0), NbFree_U64(0), NbCacheHit_U64(0), AllocInByte_S64(0) {}
+
+  static void S_Inc(std::atomic<uint64_t> &_rCounter, uint64_t _Val_U64)
+  {
+    _rCounter.store(_rCounter.load(std::memory_order_relaxed) + _Val_U64, std::memory_order_relaxed);
+  }
+};
+
+//Registry of the live slab allocators. A thread cache is flushed at thread exit only if its allocator is still alive.
+//Never destroyed so that it is usable from thread_local destructors running late.
+struct BOF_SLAB_REGISTRY
+{
+  std::mutex                                Mtx;
+  std::set<uint32_t>                        LiveCollection;
+  std::atomic<uint32_t>                     NextInstanceId_U32;
+
+  BOF_SLAB_REGISTRY() : NextInstanceId_U32(1) {}
+
+  static BOF_SLAB_REGISTRY &S_Instance()
+  {
+    static BOF_SLAB_REGISTRY *spRegistry_X = new BOF_SLAB_REGISTRY();
+    return *spRegistry_X;
+  }
+};
+
+//The cache pointer is only dereferenced when its allocator instance is known to be alive
+struct BOF_SLAB_THREAD_CACHE_ENTRY
+{
+  uint32_t              InstanceId_U32;
+  BofSlabAllocator      *pAllocator;
+  BOF_SLAB_THREAD_CACHE *pCache_X;
+};
+
+struct BOF_SLAB_THREAD_CACHE_SET
+{
+  uint32_t                                 LastInstanceId_U32 = 0;
+  BOF_SLAB_THREAD_CACHE                    *pLastCache_X = nullptr;
+  std::vector<BOF_SLAB_THREAD_CACHE_ENTRY> CacheCollection;
+
+  ~BOF_SLAB_THREAD_CACHE_SET();
+};
+
+/*!
+ * Summary
+ * Size class slab allocator
+ *
+ * Description
+ * Requests are rounded up to a power of two size class between MinBlockSizeInByte_U32 and MaxBlockSizeInByte_U32. Each
+ * class has a free list refilled by carving slabs of SlabSizeInByte_U32. Each thread keeps up to ThreadCacheSize_U32
+ * blocks per class: most allocations and frees are a vector push/pop without any lock or atomic read-modify-write. When a
+ * thread cache is empty (or full) half of it is refilled from (or given back to) the class free list under the class lock.
+ * Memory is returned to the system only when the allocator is destroyed: all the blocks must have been freed by then.
+ *
+ * See Also
+ * BofArenaAllocator, Bof_AllocatorBufferAlloc
+ */
+class BofSlabAllocator : public IBofAllocator
+{
+  friend struct BOF_SLAB_THREAD_CACHE_SET;
+
+private:
+  struct BOF_SLAB_FREE_BLOCK
+  {
+    BOF_SLAB_FREE_BLOCK *pNext_X;
+  };
+  struct BOF_SLAB_SIZE_CLASS
+  {
+    std::mutex          Mtx;
+    uint32_t            BlockSizeInByte_U32 = 0;
+    BOF_SLAB_FREE_BLOCK *pFreeList_X = nullptr;
+  };
+
+  BOF_SLAB_ALLOCATOR_PARAM                           mSlabAllocatorParam_X;
+  uint32_t                                           mInstanceId_U32;
+  uint32_t                                           mMinShift_U32;
+  uint32_t                                           mNbClass_U32;
+  BOF_SLAB_SIZE_CLASS                                mpSizeClass_X[BOF_SLAB_MAX_SIZE_CLASS];
+  std::mutex                                         mSlabMtx;                    /*! Protects mSlabCollection and mCacheCollection */
+  std::vector<BOF_BUFFER>                            mSlabCollection;
+  std::vector<std::unique_ptr<BOF_SLAB_THREAD_CACHE>> mCacheCollection;
+  std::atomic<uint64_t>                              mReservedInByte_U64;
+  std::atomic<uint64_t>                              mMaxAllocInByte_U64;
+  //Counters of the released thread caches and of the uncached path
+  std::atomic<uint64_t>                              mNbAlloc_U64;
+  std::atomic<uint64_t>                              mNbFree_U64;
+  std::atomic<uint64_t>                              mNbCacheHit_U64;
+  std::atomic<uint64_t>                              mNbAllocFail_U64;
+  std::atomic<uint64_t>                              mNbFallback_U64;
+  std::atomic<int64_t>                               mAllocInByte_S64;
+  BOFERR                                             mErrorCode_E;
+
+public:
+  BofSlabAllocator(const BOF_SLAB_ALLOCATOR_PARAM &_rSlabAllocatorParam_X)
+    : mSlabAllocatorParam_X(_rSlabAllocatorParam_X), mReservedInByte_U64(0), mMaxAllocInByte_U64(0), mNbAlloc_U64(0), mNbFree_U64(0), mNbCacheHit_U64(0), mNbAllocFail_U64(0),
+      mNbFallback_U64(0), mAllocInByte_S64(0)
+  {
+    uint32_t i_U32, MaxShift_U32;
+
+    mErrorCode_E = BOF_ERR_EINVAL;
+    mNbClass_U32 = 0;
+    mMinShift_U32 = S_Log2Ceil(std::max<uint32_t>(mSlabAllocatorParam_X.MinBlockSizeInByte_U32, sizeof(BOF_SLAB_FREE_BLOCK) * 2));
+    MaxShift_U32  = S_Log2Ceil(mSlabAllocatorParam_X.MaxBlockSizeInByte_U32);
+    if ((MaxShift_U32 >= mMinShift_U32) && ((MaxShift_U32 - mMinShift_U32) < BOF_SLAB_MAX_SIZE_CLASS) && (MaxShift_U32 < 31))
+    {
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      mNbClass_U32 = MaxShift_U32 - mMinShift_U32 + 1;
+      for (i_U32 = 0; i_U32 < mNbClass_U32; i_U32++)
+      {
+        mpSizeClass_X[i_U32].BlockSizeInByte_U32 = 1 << (mMinShift_U32 + i_U32);
+      }
+      if (mSlabAllocatorParam_X.SlabSizeInByte_U32 < (1U << MaxShift_U32))
+      {
+        mSlabAllocatorParam_X.SlabSizeInByte_U32 = 1 << MaxShift_U32;
+      }
+    }
+    BOF_SLAB_REGISTRY &rRegistry_X = BOF_SLAB_REGISTRY::S_Instance();
+    std::lock_guard<std::mutex> Lock(rRegistry_X.Mtx);
+    mInstanceId_U32 = rRegistry_X.NextInstanceId_U32++;
+    rRegistry_X.LiveCollection.insert(mInstanceId_U32);
+  }
+
+  virtual ~BofSlabAllocator()
+  {
+    {
+      BOF_SLAB_REGISTRY &rRegistry_X = BOF_SLAB_REGISTRY::S_Instance();
+      std::lock_guard<std::mutex> Lock(rRegistry_X.Mtx);
+      rRegistry_X.LiveCollection.erase(mInstanceId_U32);
+    }
+    std::lock_guard<std::mutex> Lock(mSlabMtx);
+    for (auto &rSlab_X : mSlabCollection)
+    {
+      Bof_AlignedMemFree(rSlab_X);
+    }
+    mSlabCollection.clear();
+    //The threads still referencing their cache will not find this instance in the registry anymore
+    mCacheCollection.clear();
+  }
+  BofSlabAllocator &operator=(const BofSlabAllocator &) = delete; // Disallow copying
+  BofSlabAllocator(const BofSlabAllocator &) = delete;
+
+  BOFERR LastErrorCode() const { return mErrorCode_E; }
+
+  //Size of the block really used for a request of _SizeInByte_U64 bytes (0 if it is served by the heap)
+  uint32_t BlockSize(uint64_t _SizeInByte_U64) const
+  {
+    uint32_t Class_U32 = SizeClass(_SizeInByte_U64);
+    return (Class_U32 < mNbClass_U32) ? mpSizeClass_X[Class_U32].BlockSizeInByte_U32 : 0;
+  }
+
+  void *V_Allocate(uint64_t _SizeInByte_U64) override
+  {
+    void                  *pRts = nullptr;
+    uint32_t              Class_U32;
+    BOF_SLAB_THREAD_CACHE *pCache_X;
+
+    Class_U32 = SizeClass(_SizeInByte_U64);
+    if (Class_U32 < mNbClass_U32)
+    {
+      pCache_X = (mSlabAllocatorParam_X.ThreadCacheSize_U32) ? ThreadCache() : nullptr;
+      if (pCache_X)
+      {
+        std::vector<void *> &rBlockCollection = pCache_X->BlockCollection[Class_U32];
+        if (rBlockCollection.empty())
+        {
+          Refill(Class_U32, rBlockCollection, std::max<uint32_t>(mSlabAllocatorParam_X.ThreadCacheSize_U32 / 2, 1));
+        }
+        else
+        {
+          BOF_SLAB_THREAD_CACHE::S_Inc(pCache_X->NbCacheHit_U64, 1);
+        }
+        if (!rBlockCollection.empty())
+        {
+          pRts = rBlockCollection.back();
+          rBlockCollection.pop_back();
+          BOF_SLAB_THREAD_CACHE::S_Inc(pCache_X->NbAlloc_U64, 1);
+          pCache_X->AllocInByte_S64.store(pCache_X->AllocInByte_S64.load(std::memory_order_relaxed) + mpSizeClass_X[Class_U32].BlockSizeInByte_U32, std::memory_order_relaxed);
+        }
+      }
+      else
+      {
+        pRts = PopBlock(Class_U32);
+        if (pRts)
+        {
+          mNbAlloc_U64++;
+          mAllocInByte_S64 += mpSizeClass_X[Class_U32].BlockSizeInByte_U32;
+        }
+      }
+    }
+    else if (_SizeInByte_U64)
+    {
+      pRts = new (std::nothrow) uint8_t[static_cast<size_t>(_SizeInByte_U64)];
+      if (pRts)
+      {
+        mNbFallback_U64++;
+        mNbAlloc_U64++;
+        mAllocInByte_S64 += static_cast<int64_t>(_SizeInByte_U64);
+      }
+    }
+    if (!pRts)
+    {
+      mNbAllocFail_U64++;
+    }
+    return pRts;
+  }
+
+  void V_Free(void *_pData, uint64_t _SizeInByte_U64) override
+  {
+    uint32_t              Class_U32, NbToFlush_U32;
+    BOF_SLAB_THREAD_CACHE *pCache_X;
+
+    if (_pData)
+    {
+      Class_U32 = SizeClass(_SizeInByte_U64);
+      if (Class_U32 < mNbClass_U32)
+      {
+        pCache_X = (mSlabAllocatorParam_X.ThreadCacheSize_U32) ? ThreadCache() : nullptr;
+        if (pCache_X)
+        {
+          std::vector<void *> &rBlockCollection = pCache_X->BlockCollection[Class_U32];
+          rBlockCollection.push_back(_pData);
+          if (rBlockCollection.size() > mSlabAllocatorParam_X.ThreadCacheSize_U32)
+          {
+            NbToFlush_U32 = std::max<uint32_t>(mSlabAllocatorParam_X.ThreadCacheSize_U32 / 2, 1);
+            Flush(Class_U32, rBlockCollection, NbToFlush_U32);
+          }
+          BOF_SLAB_THREAD_CACHE::S_Inc(pCache_X->NbFree_U64, 1);
+          pCache_X->AllocInByte_S64.store(pCache_X->AllocInByte_S64.load(std::memory_order_relaxed) - mpSizeClass_X[Class_U32].BlockSizeInByte_U32, std::memory_order_relaxed);
+        }
+        else
+        {
+          PushBlock(Class_U32, _pData);
+          mNbFree_U64++;
+          mAllocInByte_S64 -= mpSizeClass_X[Class_U32].BlockSizeInByte_U32;
+        }
+      }
+      else
+      {
+        delete[] static_cast<uint8_t *>(_pData);
+        mNbFree_U64++;
+        mAllocInByte_S64 -= static_cast<int64_t>(_SizeInByte_U64);
+      }
+    }
+  }
+
+  BOFERR V_Statistic(BOF_ALLOCATOR_STATISTIC &_rStatistic_X) override
+  {
+    int64_t AllocInByte_S64;
+    uint64_t Max_U64;
+
+    _rStatistic_X.Reset();
+    std::lock_guard<std::mutex> Lock(mSlabMtx);
+    _rStatistic_X.NbAlloc_U64     = mNbAlloc_U64;
+    _rStatistic_X.NbFree_U64      = mNbFree_U64;
+    _rStatistic_X.NbCacheHit_U64  = mNbCacheHit_U64;
+    _rStatistic_X.NbAllocFail_U64 = mNbAllocFail_U64;
+    _rStatistic_X.NbFallback_U64  = mNbFallback_U64;
+    AllocInByte_S64               = mAllocInByte_S64;
+    for (auto &rpuCache_X : mCacheCollection)
+    {
+      _rStatistic_X.NbAlloc_U64    += rpuCache_X->NbAlloc_U64.load(std::memory_order_relaxed);
+      _rStatistic_X.NbFree_U64     += rpuCache_X->NbFree_U64.load(std::memory_order_relaxed);
+      _rStatistic_X.NbCacheHit_U64 += rpuCache_X->NbCacheHit_U64.load(std::memory_order_relaxed);
+      AllocInByte_S64              += rpuCache_X->AllocInByte_S64.load(std::memory_order_relaxed);
+    }
+    _rStatistic_X.CurrentAllocInByte_U64 = (AllocInByte_S64 > 0) ? static_cast<uint64_t>(AllocInByte_S64) : 0;
+    //The high water mark is sampled here: keeping it exact would need a shared atomic on each allocation
+    Max_U64 = mMaxAllocInByte_U64;
+    BOF_SET_NEW_STAT_MAX(_rStatistic_X.CurrentAllocInByte_U64, Max_U64);
+    mMaxAllocInByte_U64               = Max_U64;
+    _rStatistic_X.MaxAllocInByte_U64 = Max_U64;
+    _rStatistic_X.ReservedInByte_U64 = mReservedInByte_U64;
+    return BOF_ERR_NO_ERROR;
+  }
+
+  const char *V_Name() const override
+  {
+    return mSlabAllocatorParam_X.Name_S.c_str();
+  }
+
+  std::string SlabAllocatorDebugInfo()
+  {
+    BOF_ALLOCATOR_STATISTIC Statistic_X;
+    size_t                  NbCache;
+
+    V_Statistic(Statistic_X);
+    {
+      std::lock_guard<std::mutex> Lock(mSlabMtx);
+      NbCache = mCacheCollection.size();
+    }
+    return Bof_Sprintf("Slab '%s' %d class %d..%d B Cache %d Alloc %lld Free %lld Hit %lld Fail %lld Fallback %lld Used %lld/%lld Max %lld\n", mSlabAllocatorParam_X.Name_S.c_str(),
+                       mNbClass_U32, 1 << mMinShift_U32, mNbClass_U32 ? mpSizeClass_X[mNbClass_U32 - 1].BlockSizeInByte_U32 : 0, static_cast<uint32_t>(NbCache),
+                       Statistic_X.NbAlloc_U64, Statistic_X.NbFree_U64, Statistic_X.NbCacheHit_U64, Statistic_X.NbAllocFail_U64, Statistic_X.NbFallback_U64,
+                       Statistic_X.CurrentAllocInByte_U64, Statistic_X.ReservedInByte_U64, Statistic_X.MaxAllocInByte_U64);
+  }
+
+private:
+  static uint32_t S_Log2Ceil(uint64_t _Val_U64)
+  {
+    uint32_t Rts_U32 = 0;
+
+    while ((1ULL << Rts_U32) < _Val_U64)
+    {
+      Rts_U32++;
+    }
+    return Rts_U32;
+  }
+
+  uint32_t SizeClass(uint64_t _SizeInByte_U64) const
+  {
+    uint32_t Rts_U32 = mNbClass_U32, Shift_U32;
+
+    if ((_SizeInByte_U64) && (mNbClass_U32) && (_SizeInByte_U64 <= mpSizeClass_X[mNbClass_U32 - 1].BlockSizeInByte_U32))
+    {
+      Shift_U32 = S_Log2Ceil(_SizeInByte_U64);
+      Rts_U32   = (Shift_U32 > mMinShift_U32) ? Shift_U32 - mMinShift_U32 : 0;
+    }
+    return Rts_U32;
+  }
+
+  BOF_SLAB_THREAD_CACHE *ThreadCache()
+  {
+    static thread_local BOF_SLAB_THREAD_CACHE_SET S_CacheSet_X;
+    BOF_SLAB_THREAD_CACHE                         *pRts_X = nullptr;
+
+    if (S_CacheSet_X.LastInstanceId_U32 == mInstanceId_U32)
+    {
+      pRts_X = S_CacheSet_X.pLastCache_X;
+    }
+    else
+    {
+      for (auto &rEntry : S_CacheSet_X.CacheCollection)
+      {
+        if (rEntry.InstanceId_U32 == mInstanceId_U32)
+        {
+          pRts_X = rEntry.pCache_X;
+          break;
+        }
+      }
+      if (!pRts_X)
+      {
+        pRts_X = CreateThreadCache(S_CacheSet_X);
+      }
+      S_CacheSet_X.LastInstanceId_U32 = mInstanceId_U32;
+      S_CacheSet_X.pLastCache_X       = pRts_X;
+    }
+    return pRts_X;
+  }
+
+  BOF_SLAB_THREAD_CACHE *CreateThreadCache(BOF_SLAB_THREAD_CACHE_SET &_rCacheSet_X)
+  {
+    BOF_SLAB_THREAD_CACHE *pRts_X = new BOF_SLAB_THREAD_CACHE(mInstanceId_U32);
+    uint32_t              i_U32;
+
+    for (i_U32 = 0; i_U32 < mNbClass_U32; i_U32++)
+    {
+      pRts_X->BlockCollection[i_U32].reserve(mSlabAllocatorParam_X.ThreadCacheSize_U32 + 1);
+    }
+    {
+      std::lock_guard<std::mutex> Lock(mSlabMtx);
+      mCacheCollection.emplace_back(pRts_X);
+    }
+    //Forget the caches of the allocators which have been destroyed
+    {
+      BOF_SLAB_REGISTRY &rRegistry_X = BOF_SLAB_REGISTRY::S_Instance();
+      std::lock_guard<std::mutex> Lock(rRegistry_X.Mtx);
+      _rCacheSet_X.CacheCollection.erase(std::remove_if(_rCacheSet_X.CacheCollection.begin(), _rCacheSet_X.CacheCollection.end(),
+                                                        [&](const BOF_SLAB_THREAD_CACHE_ENTRY &_rEntry_X)
+                                                        { return rRegistry_X.LiveCollection.find(_rEntry_X.InstanceId_U32) == rRegistry_X.LiveCollection.end(); }),
+                                         _rCacheSet_X.CacheCollection.end());
+    }
+    _rCacheSet_X.CacheCollection.push_back(BOF_SLAB_THREAD_CACHE_ENTRY{mInstanceId_U32, this, pRts_X});
+    return pRts_X;
+  }
+
+  //Called at thread exit with the registry locked, so the allocator cannot be destroyed meanwhile
+  void ReleaseThreadCache(BOF_SLAB_THREAD_CACHE *_pCache_X)
+  {
+    uint32_t i_U32;
+
+    for (i_U32 = 0; i_U32 < mNbClass_U32; i_U32++)
+    {
+      Flush(i_U32, _pCache_X->BlockCollection[i_U32], static_cast<uint32_t>(_pCache_X->BlockCollection[i_U32].size()));
+    }
+    std::lock_guard<std::mutex> Lock(mSlabMtx);
+    mNbAlloc_U64     += _pCache_X->NbAlloc_U64.load(std::memory_order_relaxed);
+    mNbFree_U64      += _pCache_X->NbFree_U64.load(std::memory_order_relaxed);
+    mNbCacheHit_U64  += _pCache_X->NbCacheHit_U64.load(std::memory_order_relaxed);
+    mAllocInByte_S64 += _pCache_X->AllocInByte_S64.load(std::memory_order_relaxed);
+    mCacheCollection.erase(std::remove_if(mCacheCollection.begin(), mCacheCollection.end(),
+                                          [&](const std::unique_ptr<BOF_SLAB_THREAD_CACHE> &_rpuCache_X) { return _rpuCache_X.get() == _pCache_X; }),
+                           mCacheCollection.end());
+  }
+
+  //Must be called with the class lock held
+  bool CarveSlab(uint32_t _Class_U32)
+  {
+    bool                Rts_B = false;
+    BOF_BUFFER          Slab_X;
+    uint32_t            BlockSize_U32, i_U32, NbBlock_U32;
+    BOF_SLAB_FREE_BLOCK *pBlock_X;
+
+    if ((mSlabAllocatorParam_X.MaxMemoryInByte_U64 == 0) || ((mReservedInByte_U64 + mSlabAllocatorParam_X.SlabSizeInByte_U32) <= mSlabAllocatorParam_X.MaxMemoryInByte_U64))
+    {
+      if (Bof_AlignedMemAlloc(BOF_BUFFER_ALLOCATE_ZONE::BOF_BUFFER_ALLOCATE_ZONE_RAM, 64, mSlabAllocatorParam_X.SlabSizeInByte_U32, mSlabAllocatorParam_X.LockSlab_B, false, Slab_X) == BOF_ERR_NO_ERROR)
+      {
+        Rts_B         = true;
+        BlockSize_U32 = mpSizeClass_X[_Class_U32].BlockSizeInByte_U32;
+        NbBlock_U32   = mSlabAllocatorParam_X.SlabSizeInByte_U32 / BlockSize_U32;
+        for (i_U32 = NbBlock_U32; i_U32 > 0; i_U32--)
+        {
+          pBlock_X          = reinterpret_cast<BOF_SLAB_FREE_BLOCK *>(Slab_X.pData_U8 + (static_cast<size_t>(i_U32 - 1) * BlockSize_U32));
+          pBlock_X->pNext_X = mpSizeClass_X[_Class_U32].pFreeList_X;
+          mpSizeClass_X[_Class_U32].pFreeList_X = pBlock_X;
+        }
+        mReservedInByte_U64 += mSlabAllocatorParam_X.SlabSizeInByte_U32;
+        std::lock_guard<std::mutex> Lock(mSlabMtx);
+        mSlabCollection.push_back(Slab_X);
+      }
+    }
+    return Rts_B;
+  }
+
+  void Refill(uint32_t _Class_U32, std::vector<void *> &_rBlockCollection, uint32_t _Nb_U32)
+  {
+    BOF_SLAB_SIZE_CLASS &rClass_X = mpSizeClass_X[_Class_U32];
+    std::lock_guard<std::mutex> Lock(rClass_X.Mtx);
+
+    while ((_Nb_U32) && ((rClass_X.pFreeList_X) || (CarveSlab(_Class_U32))))
+    {
+      _rBlockCollection.push_back(rClass_X.pFreeList_X);
+      rClass_X.pFreeList_X = rClass_X.pFreeList_X->pNext_X;
+      _Nb_U32--;
+    }
+  }
+
+  void Flush(uint32_t _Class_U32, std::vector<void *> &_rBlockCollection, uint32_t _Nb_U32)
+  {
+    BOF_SLAB_SIZE_CLASS &rClass_X = mpSizeClass_X[_Class_U32];
+    BOF_SLAB_FREE_BLOCK *pBlock_X;
+    std::lock_guard<std::mutex> Lock(rClass_X.Mtx);
+
+    while ((_Nb_U32) && (!_rBlockCollection.empty()))
+    {
+      pBlock_X             = static_cast<BOF_SLAB_FREE_BLOCK *>(_rBlockCollection.back());
+      pBlock_X->pNext_X    = rClass_X.pFreeList_X;
+      rClass_X.pFreeList_X = pBlock_X;
+      _rBlockCollection.pop_back();
+      _Nb_U32--;
+    }
+  }
+
+  void *PopBlock(uint32_t _Class_U32)
+  {
+    void                *pRts = nullptr;
+    BOF_SLAB_SIZE_CLASS &rClass_X = mpSizeClass_X[_Class_U32];
+    std::lock_guard<std::mutex> Lock(rClass_X.Mtx);
+
+    if ((rClass_X.pFreeList_X) || (CarveSlab(_Class_U32)))
+    {
+      pRts                 = rClass_X.pFreeList_X;
+      rClass_X.pFreeList_X = rClass_X.pFreeList_X->pNext_X;
+    }
+    return pRts;
+  }
+
+  void PushBlock(uint32_t _Class_U32, void *_pData)
+  {
+    BOF_SLAB_SIZE_CLASS &rClass_X = mpSizeClass_X[_Class_U32];
+    BOF_SLAB_FREE_BLOCK *pBlock_X = static_cast<BOF_SLAB_FREE_BLOCK *>(_pData);
+    std::lock_guard<std::mutex> Lock(rClass_X.Mtx);
+
+    pBlock_X->pNext_X    = rClass_X.pFreeList_X;
+    rClass_X.pFreeList_X = pBlock_X;
+  }
+};
+
+inline BOF_SLAB_THREAD_CACHE_SET::~BOF_SLAB_THREAD_CACHE_SET()
+{
+  BOF_SLAB_REGISTRY &rRegistry_X = BOF_SLAB_REGISTRY::S_Instance();
+  std::lock_guard<std::mutex> Lock(rRegistry_X.Mtx);
+
+  for (auto &rEntry : CacheCollection)
+  {
+    if (rRegistry_X.LiveCollection.find(rEntry.InstanceId_U32) != rRegistry_X.LiveCollection.end())
+    {
+      rEntry.pAllocator->ReleaseThreadCache(rEntry.pCache_X);
+    }
+  }
+}
+
+/*!
+ * Summary
+ * Arena (region) allocator
+ *
+ * Description
+ * Allocations are bumped in chunks of ChunkSizeInByte_U32 and are never freed individually: V_Free only updates the
+ * statistics and the whole arena is released at once with Reset, at the end of a request for example. The first chunk is
+ * kept by Reset so that a steady state arena does not touch the system allocator. Requests larger than a chunk get a
+ * dedicated chunk.
+ *
+ * See Also
+ * BofSlabAllocator, Bof_AllocatorBufferAlloc
+ */
+class BofArenaAllocator : public IBofAllocator
+{
+private:
+  struct BOF_ARENA_CHUNK
+  {
+    uint8_t  *pData_U8;
+    uint64_t SizeInByte_U64;
+  };
+
+  BOF_ARENA_ALLOCATOR_PARAM    mArenaAllocatorParam_X;
+  BOF_MUTEX                    mMtx_X;
+  std::vector<BOF_ARENA_CHUNK> mChunkCollection;
+  uint64_t                     mOffset_U64 = 0;     /*! In the last chunk */
+  BOF_ALLOCATOR_STATISTIC      mStatistic_X;
+  uint64_t                     mNbReset_U64 = 0;
+  BOFERR                       mErrorCode_E;
+
+public:
+  BofArenaAllocator(const BOF_ARENA_ALLOCATOR_PARAM &_rArenaAllocatorParam_X) : mArenaAllocatorParam_X(_rArenaAllocatorParam_X)
+  {
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mArenaAllocatorParam_X.ChunkSizeInByte_U32) && (mArenaAllocatorParam_X.AlignmentInByte_U32) &&
+        ((mArenaAllocatorParam_X.AlignmentInByte_U32 & (mArenaAllocatorParam_X.AlignmentInByte_U32 - 1)) == 0))
+    {
+      mErrorCode_E = mArenaAllocatorParam_X.MultiThreadAware_B ? Bof_CreateMutex(mArenaAllocatorParam_X.Name_S + "_mtx", false, false, mMtx_X) : BOF_ERR_NO_ERROR;
+    }
+  }
+  virtual ~BofArenaAllocator()
+  {
+    ReleaseChunk(0);
+    if (mArenaAllocatorParam_X.MultiThreadAware_B)
+    {
+      Bof_DestroyMutex(mMtx_X);
+    }
+  }
+  BofArenaAllocator &operator=(const BofArenaAllocator &) = delete; // Disallow copying
+  BofArenaAllocator(const BofArenaAllocator &) = delete;
+
+  BOFERR LastErrorCode() const { return mErrorCode_E; }
+
+  void *V_Allocate(uint64_t _SizeInByte_U64) override
+  {
+    void     *pRts = nullptr;
+    uint64_t Offset_U64, ChunkSize_U64;
+
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_SizeInByte_U64) && (Lock() == BOF_ERR_NO_ERROR))
+    {
+      Offset_U64 = (mOffset_U64 + mArenaAllocatorParam_X.AlignmentInByte_U32 - 1) & ~static_cast<uint64_t>(mArenaAllocatorParam_X.AlignmentInByte_U32 - 1);
+      if ((mChunkCollection.empty()) || ((Offset_U64 + _SizeInByte_U64) > mChunkCollection.back().SizeInByte_U64))
+      {
+        ChunkSize_U64 = std::max<uint64_t>(mArenaAllocatorParam_X.ChunkSizeInByte_U32, _SizeInByte_U64);
+        Offset_U64    = 0;
+        if (!AddChunk(ChunkSize_U64))
+        {
+          ChunkSize_U64 = 0;
+        }
+      }
+      else
+      {
+        ChunkSize_U64 = mChunkCollection.back().SizeInByte_U64;
+      }
+      if (ChunkSize_U64)
+      {
+        pRts        = mChunkCollection.back().pData_U8 + Offset_U64;
+        mOffset_U64 = Offset_U64 + _SizeInByte_U64;
+        mStatistic_X.NbAlloc_U64++;
+        mStatistic_X.CurrentAllocInByte_U64 += _SizeInByte_U64;
+        BOF_SET_NEW_STAT_MAX(mStatistic_X.CurrentAllocInByte_U64, mStatistic_X.MaxAllocInByte_U64);
+      }
+      else
+      {
+        mStatistic_X.NbAllocFail_U64++;
+      }
+      Unlock();
+    }
+    return pRts;
+  }
+
+  //Nothing is given back before Reset
+  void V_Free(void *_pData, uint64_t /*_SizeInByte_U64*/) override
+  {
+    if ((_pData) && (Lock() == BOF_ERR_NO_ERROR))
+    {
+      mStatistic_X.NbFree_U64++;
+      Unlock();
+    }
+  }
+
+  BOFERR V_Statistic(BOF_ALLOCATOR_STATISTIC &_rStatistic_X) override
+  {
+    BOFERR Rts_E = Lock();
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      _rStatistic_X = mStatistic_X;
+      Unlock();
+    }
+    return Rts_E;
+  }
+
+  const char *V_Name() const override
+  {
+    return mArenaAllocatorParam_X.Name_S.c_str();
+  }
+
+  //Releases all the allocations at once. The first chunk is kept for the next request.
+  BOFERR Reset()
+  {
+    BOFERR Rts_E = Lock();
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      ReleaseChunk(1);
+      mOffset_U64                         = 0;
+      mStatistic_X.CurrentAllocInByte_U64 = 0;
+      mNbReset_U64++;
+      Unlock();
+    }
+    return Rts_E;
+  }
+
+  std::string ArenaAllocatorDebugInfo()
+  {
+    BOF_ALLOCATOR_STATISTIC Statistic_X;
+    uint32_t                NbChunk_U32 = 0;
+
+    if (Lock() == BOF_ERR_NO_ERROR)
+    {
+      Statistic_X = mStatistic_X;
+      NbChunk_U32 = static_cast<uint32_t>(mChunkCollection.size());
+      Unlock();
+    }
+    return Bof_Sprintf("Arena '%s' Chunk %d Alloc %lld Free %lld Fail %lld Reset %lld Used %lld/%lld Max %lld\n", mArenaAllocatorParam_X.Name_S.c_str(), NbChunk_U32,
+                       Statistic_X.NbAlloc_U64, Statistic_X.NbFree_U64, Statistic_X.NbAllocFail_U64, mNbReset_U64, Statistic_X.CurrentAllocInByte_U64,
+                       Statistic_X.ReservedInByte_U64, Statistic_X.MaxAllocInByte_U64);
+  }
+
+private:
+  BOFERR Lock()
+  {
+    return mArenaAllocatorParam_X.MultiThreadAware_B ? Bof_LockMutex(mMtx_X) : BOF_ERR_NO_ERROR;
+  }
+
+  void Unlock()
+  {
+    if (mArenaAllocatorParam_X.MultiThreadAware_B)
+    {
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+
+  bool AddChunk(uint64_t _SizeInByte_U64)
+  {
+    bool            Rts_B = false;
+    BOF_ARENA_CHUNK Chunk_X;
+
+    if ((mArenaAllocatorParam_X.MaxMemoryInByte_U64 == 0) || ((mStatistic_X.ReservedInByte_U64 + _SizeInByte_U64) <= mArenaAllocatorParam_X.MaxMemoryInByte_U64))
+    {
+      Chunk_X.SizeInByte_U64 = _SizeInByte_U64;
+      Chunk_X.pData_U8       = mArenaAllocatorParam_X.pChunkAllocator ? static_cast<uint8_t *>(mArenaAllocatorParam_X.pChunkAllocator->V_Allocate(_SizeInByte_U64))
+                                                                      : new (std::nothrow) uint8_t[static_cast<size_t>(_SizeInByte_U64)];
+      if (Chunk_X.pData_U8)
+      {
+        Rts_B = true;
+        mChunkCollection.push_back(Chunk_X);
+        mStatistic_X.ReservedInByte_U64 += _SizeInByte_U64;
+      }
+    }
+    return Rts_B;
+  }
+
+  void ReleaseChunk(uint32_t _NbToKeep_U32)
+  {
+    while (mChunkCollection.size() > _NbToKeep_U32)
+    {
+      BOF_ARENA_CHUNK &rChunk_X = mChunkCollection.back();
+      if (mArenaAllocatorParam_X.pChunkAllocator)
+      {
+        mArenaAllocatorParam_X.pChunkAllocator->V_Free(rChunk_X.pData_U8, rChunk_X.SizeInByte_U64);
+      }
+      else
+      {
+        delete[] rChunk_X.pData_U8;
+      }
+      mStatistic_X.ReservedInByte_U64 -= rChunk_X.SizeInByte_U64;
+      mChunkCollection.pop_back();
+    }
+  }
+};
+
+END_BOF_NAMESPACE()
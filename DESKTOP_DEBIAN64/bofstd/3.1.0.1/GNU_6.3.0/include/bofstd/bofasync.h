@@ -126,7 +126,7 @@ public:
 
 private:
   BofMsgThread                                                                               mMsgThread;
-  DelegateLib::MulticastDelegateSafe1<const T *> mMulticastDelegate;
+  DelegateLib::MulticastDelegateFast1<const T *> mMulticastDelegate;      /*! Copy-on-write list: Notify does not lock nor allocate from the heap */
 };
 
 template<class T>
@@ -156,7 +156,7 @@ BOFERR BofMulticastAsyncNotifier<T>::Register(BOF_MULTICAST_ASYNC_NOTIFY_FCT<T>
   if (_pNotifyFct)
   {
     Rts_E = BOF_ERR_NO_ERROR;
-    auto Delegate=MakeDelegate(_pNotifyFct, &mMsgThread);;
+    auto Delegate=DelegateLib::MakeDelegateFast(_pNotifyFct, &mMsgThread);
     Delegate.UserContext(_pUserContext);
     mMulticastDelegate += Delegate;
   }
@@ -171,7 +171,7 @@ BOFERR BofMulticastAsyncNotifier<T>::Unregister(BOF_MULTICAST_ASYNC_NOTIFY_FCT<T
   if (_pNotifyFct)
   {
     Rts_E = BOF_ERR_NO_ERROR;
-    mMulticastDelegate -= MakeDelegate(_pNotifyFct, &mMsgThread);
+    mMulticastDelegate -= DelegateLib::MakeDelegateFast(_pNotifyFct, &mMsgThread);
   }
   return Rts_E;
 }
@@ -248,7 +248,7 @@ public:
   BOFERR Notify(const T *_pNotifyArg_X);
 
 private:
-  DelegateLib::MulticastDelegateSafe1<const T *> mMulticastDelegate;
+  DelegateLib::MulticastDelegateFast1<const T *> mMulticastDelegate;
 };
 
 template<class T>
@@ -269,7 +269,7 @@ BOFERR BofMulticastSyncNotifier<T>::Register(BOF_MULTICAST_SYNC_NOTIFY_FCT<T> _p
   if (_pNotifyFct)
   {
     Rts_E = BOF_ERR_NO_ERROR;
-    auto Delegate=DelegateLib::MakeDelegate(_pNotifyFct);;
+    auto Delegate=DelegateLib::MakeDelegateFast(_pNotifyFct);
     Delegate.UserContext(_pUserContext);
     mMulticastDelegate += Delegate;
   }
@@ -284,7 +284,7 @@ BOFERR BofMulticastSyncNotifier<T>::Unregister(BOF_MULTICAST_SYNC_NOTIFY_FCT<T>
   if (_pNotifyFct)
   {
     Rts_E = BOF_ERR_NO_ERROR;
-    mMulticastDelegate -= DelegateLib::MakeDelegate(_pNotifyFct);
+    mMulticastDelegate -= DelegateLib::MakeDelegateFast(_pNotifyFct);
   }
   return Rts_E;
 }
@@ -24,10 +24,11 @@
 
 /*** Include files ***********************************************************/
 
-#include <bofstd/bofsystem.h>
+#include <bofstd/bofcowlist.h>
+#include <algorithm>
 #include <atomic>
 #include <functional>
-#include <map>
+#include <vector>
 
 /*** Global variables ********************************************************/
 
@@ -45,40 +46,19 @@ class BofCallbackCollection
 {
 
 private:
-		struct CB_ITEM
-		{
-//				bool EraseIt_B;
-				T Callback;
-
-				CB_ITEM()
-				{
-					Reset();
-				}
-
-				void Reset()
-				{
-//					EraseIt_B=false;
-					Callback = nullptr;
-				}
-		};
-
-		std::atomic<uint32_t> mCallbackId;
-		std::map<uint32_t, CB_ITEM> mCallbackCollection;
-		BOF_MUTEX mMtxCallbackCollection_X;
-		bool mUnregisterIfFail_B = false;
+		//Dispatch walks a lock free snapshot of the callbacks (see BofCowList). Register/Unregister copy the list and
+		//publish a new snapshot: a callback can (un)register from inside a Call without deadlock.
+		BofCowList<T> mCallbackCollection;
+		std::atomic<bool> mUnregisterIfFail_B;
 
 		BofCallbackCollection()
 		{
-			BOFERR Sts_E = Bof_CreateMutex("BofCallbackCollection", true, true, mMtxCallbackCollection_X);
-			BOF_ASSERT(Sts_E == BOF_ERR_NO_ERROR);
-
-			mCallbackId.store(0);
+			mUnregisterIfFail_B.store(false);
 		}
 
 public:
 		virtual ~BofCallbackCollection()
 		{
-			Bof_DestroyMutex(mMtxCallbackCollection_X);
 		}
 
 		static BofCallbackCollection<T> &S_Instance()
@@ -97,70 +77,41 @@ public:
 		BofCallbackCollection &operator=(BofCallbackCollection &&) = delete; // Move assign
 		BOFERR Register(const T &_rCallback, uint32_t &_rId_U32)
 		{
-			BOFERR Rts_E = Bof_LockMutex(mMtxCallbackCollection_X);
-			CB_ITEM Cb_X;
-
-			if (Rts_E == BOF_ERR_NO_ERROR)
-			{
-				_rId_U32 = ++mCallbackId;
-				//			Cb_X.EraseIt_B=false;
-				Cb_X.Callback = _rCallback;
-				mCallbackCollection[_rId_U32] = Cb_X;
-				Bof_UnlockMutex(mMtxCallbackCollection_X);
-			}
-			return Rts_E;
+			return mCallbackCollection.Insert(_rCallback, _rId_U32);
 		}
 
 		BOFERR Unregister(uint32_t _Id_U32)
 		{
-			BOFERR Rts_E = Bof_LockMutex(mMtxCallbackCollection_X);
+			return mCallbackCollection.Remove(_Id_U32);
+		}
 
-			if (Rts_E == BOF_ERR_NO_ERROR)
-			{
-				Rts_E = BOF_ERR_NOT_FOUND;
-				auto It = mCallbackCollection.find(_Id_U32);
-				if (It != mCallbackCollection.end())
-				{
-					mCallbackCollection.erase(It);
-					Rts_E = BOF_ERR_NO_ERROR;
-//					It->second.EraseIt_B=true;
-				}
-				Bof_UnlockMutex(mMtxCallbackCollection_X);
-			}
-			return Rts_E;
+		//Generation of the callback list, incremented by each Register/Unregister
+		uint64_t Generation()
+		{
+			return mCallbackCollection.Generation();
 		}
 
 		template<typename ... Args>
 		BOFERR Call(uint32_t _Id_U32, const Args &... _Args)
 		{
-			bool HasFailed_B;
+			BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+			bool HasFailed_B = false;
 
-			BOFERR Rts_E = Bof_LockMutex(mMtxCallbackCollection_X);
-			if (Rts_E == BOF_ERR_NO_ERROR)
 			{
-				Rts_E = BOF_ERR_NOT_FOUND;
-				auto It = mCallbackCollection.find(_Id_U32);
-				if (It != mCallbackCollection.end())
+				BofCowListReader<T> Reader(mCallbackCollection);
+				const BOF_COW_LIST_ITEM<T> *pItem_X = Reader.Find(_Id_U32);
+
+				if (pItem_X)
 				{
-/*
-					if (It->second.EraseIt_B)
-					{
-						mCallbackCollection.erase(It);
-					}
-					else
-*/
-					{
 //				static_assert(std::is_same<typename T::result_type, void>::value, "Oops");
-						Rts_E = BOF_ERR_NO_ERROR;
-						CallIt(It->second.Callback, HasFailed_B, _Args ...);
-						if ((mUnregisterIfFail_B) && (HasFailed_B))
-						{
-							mCallbackCollection.erase(It);
-							Rts_E = BOF_ERR_CANCEL;
-						}
-					}
+					Rts_E = BOF_ERR_NO_ERROR;
+					CallIt(pItem_X->Value, HasFailed_B, _Args ...);
 				}
-				Bof_UnlockMutex(mMtxCallbackCollection_X);
+			}
+			if ((mUnregisterIfFail_B) && (HasFailed_B))
+			{
+				mCallbackCollection.Remove(_Id_U32);
+				Rts_E = BOF_ERR_CANCEL;
 			}
 			return Rts_E;
 		}
@@ -168,36 +119,27 @@ public:
 		template<typename ... Args>
 		BOFERR Call(const Args &... _Args)
 		{
-			BOFERR Rts_E = Bof_LockMutex(mMtxCallbackCollection_X);
+			BOFERR Rts_E;
 			bool HasFailed_B;
+			std::vector<uint32_t> FailedCollection;
 
-			if (Rts_E == BOF_ERR_NO_ERROR)
 			{
-				auto It = mCallbackCollection.begin();
-				Rts_E = (It != mCallbackCollection.end()) ? BOF_ERR_NO_ERROR : BOF_ERR_EMPTY;
+				BofCowListReader<T> Reader(mCallbackCollection);
 
-				while (It != mCallbackCollection.end())
+				Rts_E = Reader.Size() ? BOF_ERR_NO_ERROR : BOF_ERR_EMPTY;
+				for (const auto &rItem_X : Reader)
 				{
-/*
-					if (It->second.EraseIt_B)
+					CallIt(rItem_X.Value, HasFailed_B, _Args ...);
+					if ((mUnregisterIfFail_B) && (HasFailed_B))
 					{
-						It=mCallbackCollection.erase(It);
-					}
-					else
-*/
-					{
-						CallIt(It->second.Callback, HasFailed_B, _Args ...);
-						if ((mUnregisterIfFail_B) && (HasFailed_B))
-						{
-							It = mCallbackCollection.erase(It);
-						}
-						else
-						{
-							++It;
-						}
+						FailedCollection.push_back(rItem_X.Id_U32);
 					}
 				}
-				Bof_UnlockMutex(mMtxCallbackCollection_X);
+			}
+			//Failed callbacks are removed once the walk is over, in a single publication
+			if (FailedCollection.size())
+			{
+				mCallbackCollection.RemoveIf([&](uint32_t _Id_U32, const T &) { return std::find(FailedCollection.begin(), FailedCollection.end(), _Id_U32) != FailedCollection.end(); });
 			}
 			return Rts_E;
 		}
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the BofCowList class: a copy on write list whose
+ * readers walk an immutable snapshot without taking any lock.
+ *
+ * Name:        bofcowlist.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsystem.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Structure **************************************************************/
+
+template<typename T>
+struct BOF_COW_LIST_ITEM
+{
+  uint32_t Id_U32;
+  T        Value;
+};
+
+//Immutable once published
+template<typename T>
+struct BOF_COW_LIST_SNAPSHOT
+{
+  uint64_t                            Generation_U64;
+  std::vector<BOF_COW_LIST_ITEM<T>>   ItemCollection;     /*! Sorted by increasing Id_U32 */
+
+  BOF_COW_LIST_SNAPSHOT() : Generation_U64(0) {}
+};
+
+/*** Class **************************************************************/
+
+template<typename T>
+class BofCowList;
+
+//Holds a reference on the current snapshot for the duration of a walk: the snapshot is freed when its last reader is destroyed.
+template<typename T>
+class BofCowListReader
+{
+private:
+  const BofCowList<T>            &mrCowList;
+  const BOF_COW_LIST_SNAPSHOT<T> *mpSnapshot_X;
+  uint32_t                       mSlot_U32;
+
+public:
+  BofCowListReader(const BofCowList<T> &_rCowList) : mrCowList(_rCowList)
+  {
+    mpSnapshot_X = mrCowList.Acquire(mSlot_U32);
+  }
+  ~BofCowListReader()
+  {
+    mrCowList.Release(mSlot_U32);
+  }
+  BofCowListReader &operator=(const BofCowListReader &) = delete; // Disallow copying
+  BofCowListReader(const BofCowListReader &) = delete;
+
+  uint64_t Generation() const { return mpSnapshot_X ? mpSnapshot_X->Generation_U64 : 0; }
+  uint32_t Size() const { return mpSnapshot_X ? static_cast<uint32_t>(mpSnapshot_X->ItemCollection.size()) : 0; }
+  const BOF_COW_LIST_ITEM<T> *begin() const { return mpSnapshot_X ? mpSnapshot_X->ItemCollection.data() : nullptr; }
+  const BOF_COW_LIST_ITEM<T> *end() const { return mpSnapshot_X ? mpSnapshot_X->ItemCollection.data() + mpSnapshot_X->ItemCollection.size() : nullptr; }
+
+  const BOF_COW_LIST_ITEM<T> *Find(uint32_t _Id_U32) const
+  {
+    const BOF_COW_LIST_ITEM<T> *pRts_X = nullptr, *pIt_X;
+
+    if (mpSnapshot_X)
+    {
+      pIt_X = std::lower_bound(begin(), end(), _Id_U32, [](const BOF_COW_LIST_ITEM<T> &_rItem_X, uint32_t _Id_U32) { return _rItem_X.Id_U32 < _Id_U32; });
+      if ((pIt_X != end()) && (pIt_X->Id_U32 == _Id_U32))
+      {
+        pRts_X = pIt_X;
+      }
+    }
+    return pRts_X;
+  }
+};
+
+/*!
+ * Summary
+ * Copy on write list
+ *
+ * Description
+ * Designed for frequent traversal and rare modification (callback or observer lists on an event path). Each Insert/Remove
+ * copies the current array, applies the change and publishes the new snapshot; the generation counter is incremented on
+ * each publication. Readers never take a lock: the current snapshot is published as a slot index in one atomic word and
+ * each of the BOF_COW_LIST_NB_SLOT slots holds a snapshot with its own reader count. A reader enters with a single
+ * compare and swap on the slot word, which only succeeds while the slot still holds the generation it read and is not
+ * retired, then walks a plain array.
+ * A replaced snapshot is retired: it is freed by the writer if it has no reader, otherwise by its last reader, whatever the
+ * other readers are doing, so overlapping readers never make snapshots pile up. The slot then becomes free for a later
+ * publication; a writer which finds every slot busy (readers still walking old snapshots) yields until one is reclaimed.
+ * Writers are serialized by a mutex. A reader may call Insert/Remove (e.g. a callback unregistering itself): the
+ * snapshot it walks stays valid until it leaves.
+ *
+ * See Also
+ * BofCallbackCollection, BofCowObservable, MulticastDelegateFast1
+ */
+template<typename T>
+class BofCowList
+{
+  friend class BofCowListReader<T>;
+
+private:
+  static constexpr uint32_t BOF_COW_LIST_NB_SLOT = 32;
+  static constexpr uint32_t NO_SLOT = 0xFFFFFFFF;
+  static constexpr uint64_t SLOT_RETIRED = 0x01;      //Slot word: generation (32 bits) | reader count (31 bits) | retired (1 bit)
+  static constexpr uint64_t SLOT_READER = 0x02;
+
+  struct SLOT
+  {
+    std::atomic<uint64_t>                         Word_U64;
+    std::atomic<const BOF_COW_LIST_SNAPSHOT<T> *> pSnapshot_X;    /*! nullptr: the slot is free */
+  };
+
+  std::atomic<uint64_t>                           mCurrent_U64;       /*! Generation (32 bits) | slot index of the current snapshot (NO_SLOT: empty list) */
+  SLOT                                            mpSlot_X[BOF_COW_LIST_NB_SLOT];
+  uint64_t                                        mGeneration_U64 = 0;
+  uint32_t                                        mLastId_U32 = 0;
+  std::mutex                                      mWriterMtx;
+
+public:
+  BofCowList()
+  {
+    uint32_t i_U32;
+
+    mCurrent_U64.store(NO_SLOT);
+    for (i_U32 = 0; i_U32 < BOF_COW_LIST_NB_SLOT; i_U32++)
+    {
+      mpSlot_X[i_U32].Word_U64.store(SLOT_RETIRED);
+      mpSlot_X[i_U32].pSnapshot_X.store(nullptr);
+    }
+  }
+  //No reader may be left
+  virtual ~BofCowList()
+  {
+    uint32_t i_U32;
+
+    for (i_U32 = 0; i_U32 < BOF_COW_LIST_NB_SLOT; i_U32++)
+    {
+      delete mpSlot_X[i_U32].pSnapshot_X.load();
+    }
+  }
+  BofCowList &operator=(const BofCowList &) = delete; // Disallow copying
+  BofCowList(const BofCowList &) = delete;
+
+  BOFERR Insert(const T &_rValue, uint32_t &_rId_U32)
+  {
+    std::lock_guard<std::mutex>    Lock(mWriterMtx);
+    const BOF_COW_LIST_SNAPSHOT<T> *pOld_X = CurrentSnapshot();
+    BOF_COW_LIST_SNAPSHOT<T>       *pNew_X = new BOF_COW_LIST_SNAPSHOT<T>();
+
+    if (pOld_X)
+    {
+      pNew_X->ItemCollection = pOld_X->ItemCollection;
+    }
+    _rId_U32 = ++mLastId_U32;
+    pNew_X->ItemCollection.push_back(BOF_COW_LIST_ITEM<T>{_rId_U32, _rValue});
+    Publish(pNew_X);
+    return BOF_ERR_NO_ERROR;
+  }
+
+  BOFERR Remove(uint32_t _Id_U32)
+  {
+    return RemoveIf([_Id_U32](uint32_t _ItemId_U32, const T & /*_rValue*/) { return _ItemId_U32 == _Id_U32; }, 1) ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_FOUND;
+  }
+
+  //Removes, in a single publication, the first _MaxRemove_U32 values (in insertion order) for which _Predicate(Id, Value) returns true
+  template<typename Predicate>
+  uint32_t RemoveIf(Predicate _Predicate, uint32_t _MaxRemove_U32 = 0xFFFFFFFF)
+  {
+    uint32_t                       Rts_U32 = 0;
+    std::lock_guard<std::mutex>    Lock(mWriterMtx);
+    const BOF_COW_LIST_SNAPSHOT<T> *pOld_X = CurrentSnapshot();
+    BOF_COW_LIST_SNAPSHOT<T>       *pNew_X;
+
+    if (pOld_X)
+    {
+      pNew_X = new BOF_COW_LIST_SNAPSHOT<T>();
+      pNew_X->ItemCollection.reserve(pOld_X->ItemCollection.size());
+      for (const auto &rItem_X : pOld_X->ItemCollection)
+      {
+        if ((Rts_U32 < _MaxRemove_U32) && (_Predicate(rItem_X.Id_U32, rItem_X.Value)))
+        {
+          Rts_U32++;
+        }
+        else
+        {
+          pNew_X->ItemCollection.push_back(rItem_X);
+        }
+      }
+      if ((Rts_U32 == 0) || (pNew_X->ItemCollection.empty()))
+      {
+        delete pNew_X;
+        pNew_X = nullptr;
+      }
+      if (Rts_U32)
+      {
+        Publish(pNew_X);
+      }
+    }
+    return Rts_U32;
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> Lock(mWriterMtx);
+    if (CurrentSnapshot())
+    {
+      Publish(nullptr);
+    }
+  }
+
+  bool IsEmpty() const
+  {
+    return static_cast<uint32_t>(mCurrent_U64.load(std::memory_order_acquire)) == NO_SLOT;
+  }
+
+  //Incremented on each modification
+  uint64_t Generation()
+  {
+    std::lock_guard<std::mutex> Lock(mWriterMtx);
+    return mGeneration_U64;
+  }
+
+  //Calls _Fct(Id, Value) for each value of the current snapshot, without lock
+  template<typename Fct>
+  void ForEach(Fct _Fct) const
+  {
+    BofCowListReader<T> Reader(*this);
+
+    for (const auto &rItem_X : Reader)
+    {
+      _Fct(rItem_X.Id_U32, rItem_X.Value);
+    }
+  }
+
+private:
+  //Enters the current snapshot: one compare and swap, retried only if a writer or another reader changed the slot word meanwhile
+  const BOF_COW_LIST_SNAPSHOT<T> *Acquire(uint32_t &_rSlot_U32) const
+  {
+    const BOF_COW_LIST_SNAPSHOT<T> *pRts_X = nullptr;
+    uint64_t                       Current_U64 = mCurrent_U64.load(std::memory_order_acquire), Word_U64;
+    bool                           Done_B = false;
+
+    _rSlot_U32 = NO_SLOT;
+    while (!Done_B)
+    {
+      if (static_cast<uint32_t>(Current_U64) == NO_SLOT)
+      {
+        Done_B = true;
+      }
+      else
+      {
+        SLOT &rSlot_X = const_cast<SLOT &>(mpSlot_X[static_cast<uint32_t>(Current_U64)]);
+
+        Word_U64 = rSlot_X.Word_U64.load(std::memory_order_acquire);
+        if (((Word_U64 >> 32) == (Current_U64 >> 32)) && ((Word_U64 & SLOT_RETIRED) == 0))
+        {
+          if (rSlot_X.Word_U64.compare_exchange_weak(Word_U64, Word_U64 + SLOT_READER, std::memory_order_acq_rel, std::memory_order_acquire))
+          {
+            _rSlot_U32 = static_cast<uint32_t>(Current_U64);
+            pRts_X = rSlot_X.pSnapshot_X.load(std::memory_order_acquire);
+            Done_B = true;
+          }
+        }
+        else
+        {
+          //Replaced since Current_U64 was read
+          Current_U64 = mCurrent_U64.load(std::memory_order_acquire);
+        }
+      }
+    }
+    return pRts_X;
+  }
+
+  //Leaves a snapshot: the last reader of a retired snapshot frees it
+  void Release(uint32_t _Slot_U32) const
+  {
+    uint64_t Word_U64;
+
+    if (_Slot_U32 != NO_SLOT)
+    {
+      SLOT &rSlot_X = const_cast<SLOT &>(mpSlot_X[_Slot_U32]);
+
+      Word_U64 = rSlot_X.Word_U64.fetch_sub(SLOT_READER, std::memory_order_acq_rel);
+      if ((Word_U64 & 0xFFFFFFFF) == (SLOT_READER | SLOT_RETIRED))
+      {
+        Reclaim(rSlot_X);
+      }
+    }
+  }
+
+  static void Reclaim(SLOT &_rSlot_X)
+  {
+    delete _rSlot_X.pSnapshot_X.load(std::memory_order_relaxed);
+    _rSlot_X.pSnapshot_X.store(nullptr, std::memory_order_release);
+  }
+
+  //Called with mWriterMtx held: only the writer retires the current snapshot, so it cannot be freed under it
+  const BOF_COW_LIST_SNAPSHOT<T> *CurrentSnapshot() const
+  {
+    uint32_t Slot_U32 = static_cast<uint32_t>(mCurrent_U64.load(std::memory_order_relaxed));
+
+    return (Slot_U32 == NO_SLOT) ? nullptr : mpSlot_X[Slot_U32].pSnapshot_X.load(std::memory_order_relaxed);
+  }
+
+  //Called with mWriterMtx held. The replaced snapshot is freed here if it has no reader, otherwise by its last reader.
+  void Publish(BOF_COW_LIST_SNAPSHOT<T> *_pSnapshot_X)
+  {
+    uint64_t Current_U64, Old_U64, Word_U64;
+    uint32_t Slot_U32 = NO_SLOT, i_U32;
+
+    mGeneration_U64++;
+    if (_pSnapshot_X)
+    {
+      _pSnapshot_X->Generation_U64 = mGeneration_U64;
+      while (Slot_U32 == NO_SLOT)
+      {
+        for (i_U32 = 0; (i_U32 < BOF_COW_LIST_NB_SLOT) && (Slot_U32 == NO_SLOT); i_U32++)
+        {
+          if (mpSlot_X[i_U32].pSnapshot_X.load(std::memory_order_acquire) == nullptr)
+          {
+            Slot_U32 = i_U32;
+          }
+        }
+        if (Slot_U32 == NO_SLOT)
+        {
+          std::this_thread::yield();
+        }
+      }
+      mpSlot_X[Slot_U32].pSnapshot_X.store(_pSnapshot_X, std::memory_order_relaxed);
+      mpSlot_X[Slot_U32].Word_U64.store((mGeneration_U64 & 0xFFFFFFFF) << 32, std::memory_order_release);
+    }
+    Current_U64 = ((mGeneration_U64 & 0xFFFFFFFF) << 32) | Slot_U32;
+    Old_U64 = mCurrent_U64.exchange(Current_U64, std::memory_order_acq_rel);
+    if (static_cast<uint32_t>(Old_U64) != NO_SLOT)
+    {
+      Word_U64 = mpSlot_X[static_cast<uint32_t>(Old_U64)].Word_U64.fetch_or(SLOT_RETIRED, std::memory_order_acq_rel);
+      if ((Word_U64 & 0xFFFFFFFF) == 0)
+      {
+        Reclaim(mpSlot_X[static_cast<uint32_t>(Old_U64)]);
+      }
+    }
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the vectorized (sse2/avx2) single and multi byte
+ * delimiter search used to split a received byte stream into frames.
+ *
+ * Name:        bofdelimiterscanner.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         The avx2 path is selected at run time, the sse2 one is the
+ *              x86_64 baseline. Other architectures use memchr (vectorized
+ *              by the c library) and a scalar compare.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofstd.h>
+#include <string.h>
+#include <string>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define BOF_DELIMITER_SCANNER_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define BOF_DELIMITER_SCANNER_SSE2 0
+#endif
+#if BOF_DELIMITER_SCANNER_SSE2 && (defined(__GNUC__) || defined(__clang__))
+#define BOF_DELIMITER_SCANNER_AVX2 1
+#include <immintrin.h>
+#else
+#define BOF_DELIMITER_SCANNER_AVX2 0
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+constexpr uint32_t BOF_DELIMITER_SCANNER_MAX_DELIMITER = 16;  /*! Longest supported delimiter */
+constexpr uint32_t BOF_DELIMITER_NOT_FOUND = 0xFFFFFFFF;
+
+/*** Function ***************************************************************/
+
+inline uint32_t Bof_DelimiterScannerCtz(uint32_t _Mask_U32)
+{
+#if defined(_MSC_VER)
+  unsigned long Rts;
+
+  _BitScanForward(&Rts, _Mask_U32);
+  return static_cast<uint32_t>(Rts);
+#else
+  return static_cast<uint32_t>(__builtin_ctz(_Mask_U32));
+#endif
+}
+
+//Scalar search of _pDelimiter_U8 in [_Start_U32, _Size_U32[. Used for the tails and when no simd is available
+inline uint32_t Bof_ScanDelimiterScalar(const uint8_t *_pBuffer_U8, uint32_t _Start_U32, uint32_t _Size_U32, const uint8_t *_pDelimiter_U8, uint32_t _DelimiterSize_U32)
+{
+  uint32_t Rts_U32 = BOF_DELIMITER_NOT_FOUND;
+  const uint8_t *pFound_U8;
+
+  while ((Rts_U32 == BOF_DELIMITER_NOT_FOUND) && (_Start_U32 + _DelimiterSize_U32 <= _Size_U32))
+  {
+    pFound_U8 = static_cast<const uint8_t *>(memchr(_pBuffer_U8 + _Start_U32, _pDelimiter_U8[0], _Size_U32 - _DelimiterSize_U32 + 1 - _Start_U32));
+    if (pFound_U8 == nullptr)
+    {
+      _Start_U32 = _Size_U32;
+    }
+    else
+    {
+      _Start_U32 = static_cast<uint32_t>(pFound_U8 - _pBuffer_U8);
+      if (memcmp(pFound_U8 + 1, _pDelimiter_U8 + 1, _DelimiterSize_U32 - 1) == 0)
+      {
+        Rts_U32 = _Start_U32;
+      }
+      _Start_U32++;
+    }
+  }
+  return Rts_U32;
+}
+
+#if BOF_DELIMITER_SCANNER_SSE2
+// Candidates are the positions where both the first and the last delimiter byte match; the bytes in between are
+// then checked with memcmp. For a 1 byte delimiter the two compares are the same and no memcmp is needed.
+inline uint32_t Bof_ScanDelimiterSse2(const uint8_t *_pBuffer_U8, uint32_t _Start_U32, uint32_t _Size_U32, const uint8_t *_pDelimiter_U8, uint32_t _DelimiterSize_U32)
+{
+  uint32_t Rts_U32 = BOF_DELIMITER_NOT_FOUND, Mask_U32, Bit_U32;
+  const __m128i First = _mm_set1_epi8(static_cast<char>(_pDelimiter_U8[0]));
+  const __m128i Last = _mm_set1_epi8(static_cast<char>(_pDelimiter_U8[_DelimiterSize_U32 - 1]));
+  __m128i BlockFirst, BlockLast;
+
+  while ((Rts_U32 == BOF_DELIMITER_NOT_FOUND) && (_Start_U32 + _DelimiterSize_U32 - 1 + 16 <= _Size_U32))
+  {
+    BlockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pBuffer_U8 + _Start_U32));
+    BlockLast = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pBuffer_U8 + _Start_U32 + _DelimiterSize_U32 - 1));
+    Mask_U32 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(BlockFirst, First), _mm_cmpeq_epi8(BlockLast, Last))));
+    while ((Mask_U32) && (Rts_U32 == BOF_DELIMITER_NOT_FOUND))
+    {
+      Bit_U32 = Bof_DelimiterScannerCtz(Mask_U32);
+      if ((_DelimiterSize_U32 <= 2) || (memcmp(_pBuffer_U8 + _Start_U32 + Bit_U32 + 1, _pDelimiter_U8 + 1, _DelimiterSize_U32 - 2) == 0))
+      {
+        Rts_U32 = _Start_U32 + Bit_U32;
+      }
+      Mask_U32 &= Mask_U32 - 1;
+    }
+    _Start_U32 += 16;
+  }
+  if (Rts_U32 == BOF_DELIMITER_NOT_FOUND)
+  {
+    Rts_U32 = Bof_ScanDelimiterScalar(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+  }
+  return Rts_U32;
+}
+#endif
+
+#if BOF_DELIMITER_SCANNER_AVX2
+__attribute__((target("avx2"))) inline uint32_t Bof_ScanDelimiterAvx2(const uint8_t *_pBuffer_U8, uint32_t _Start_U32, uint32_t _Size_U32, const uint8_t *_pDelimiter_U8, uint32_t _DelimiterSize_U32)
+{
+  uint32_t Rts_U32 = BOF_DELIMITER_NOT_FOUND, Mask_U32, Bit_U32;
+  const __m256i First = _mm256_set1_epi8(static_cast<char>(_pDelimiter_U8[0]));
+  const __m256i Last = _mm256_set1_epi8(static_cast<char>(_pDelimiter_U8[_DelimiterSize_U32 - 1]));
+  __m256i BlockFirst, BlockLast;
+
+  while ((Rts_U32 == BOF_DELIMITER_NOT_FOUND) && (_Start_U32 + _DelimiterSize_U32 - 1 + 32 <= _Size_U32))
+  {
+    BlockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pBuffer_U8 + _Start_U32));
+    BlockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pBuffer_U8 + _Start_U32 + _DelimiterSize_U32 - 1));
+    Mask_U32 = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(BlockFirst, First), _mm256_cmpeq_epi8(BlockLast, Last))));
+    while ((Mask_U32) && (Rts_U32 == BOF_DELIMITER_NOT_FOUND))
+    {
+      Bit_U32 = Bof_DelimiterScannerCtz(Mask_U32);
+      if ((_DelimiterSize_U32 <= 2) || (memcmp(_pBuffer_U8 + _Start_U32 + Bit_U32 + 1, _pDelimiter_U8 + 1, _DelimiterSize_U32 - 2) == 0))
+      {
+        Rts_U32 = _Start_U32 + Bit_U32;
+      }
+      Mask_U32 &= Mask_U32 - 1;
+    }
+    _Start_U32 += 32;
+  }
+  if (Rts_U32 == BOF_DELIMITER_NOT_FOUND)
+  {
+    Rts_U32 = Bof_ScanDelimiterSse2(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+  }
+  return Rts_U32;
+}
+
+inline bool Bof_IsAvx2Supported()
+{
+  static const bool S_Avx2_B = __builtin_cpu_supports("avx2");
+
+  return S_Avx2_B;
+}
+#endif
+
+/*!
+ * Description
+ * Finds the first occurrence of a delimiter in a buffer using the widest simd path available.
+ *
+ * Parameters
+ * _pBuffer_U8: Specifies the buffer
+ * _Start_U32: Specifies the offset where the search starts
+ * _Size_U32: Specifies the buffer size
+ * _pDelimiter_U8: Specifies the delimiter
+ * _DelimiterSize_U32: Specifies the delimiter size (1 to BOF_DELIMITER_SCANNER_MAX_DELIMITER)
+ *
+ * Returns
+ * uint32_t: Offset of the first delimiter byte or BOF_DELIMITER_NOT_FOUND
+ */
+inline uint32_t Bof_ScanDelimiter(const uint8_t *_pBuffer_U8, uint32_t _Start_U32, uint32_t _Size_U32, const uint8_t *_pDelimiter_U8, uint32_t _DelimiterSize_U32)
+{
+  uint32_t Rts_U32 = BOF_DELIMITER_NOT_FOUND;
+
+  if ((_pBuffer_U8) && (_pDelimiter_U8) && (_DelimiterSize_U32) && (_DelimiterSize_U32 <= BOF_DELIMITER_SCANNER_MAX_DELIMITER) && (_Start_U32 < _Size_U32))
+  {
+#if BOF_DELIMITER_SCANNER_AVX2
+    if (Bof_IsAvx2Supported())
+    {
+      Rts_U32 = Bof_ScanDelimiterAvx2(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+    }
+    else
+    {
+      Rts_U32 = Bof_ScanDelimiterSse2(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+    }
+#elif BOF_DELIMITER_SCANNER_SSE2
+    Rts_U32 = Bof_ScanDelimiterSse2(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+#else
+    Rts_U32 = Bof_ScanDelimiterScalar(_pBuffer_U8, _Start_U32, _Size_U32, _pDelimiter_U8, _DelimiterSize_U32);
+#endif
+  }
+  return Rts_U32;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Incremental delimiter scanner
+ *
+ * Description
+ * Keeps track of the part of a growing buffer which has already been scanned so that each new chunk of received
+ * data is examined once: the next Scan restarts DelimiterSize - 1 bytes before the previous end to catch a
+ * delimiter split between two receptions (the CR of a CRLF at the end of one recv and the LF in the next one).
+ *
+ * See Also
+ * Bof_ScanDelimiter, BofSocketFramer
+ */
+class BofDelimiterScanner
+{
+private:
+  uint8_t  mpDelimiter_U8[BOF_DELIMITER_SCANNER_MAX_DELIMITER];
+  uint32_t mDelimiterSize_U32 = 0;
+  uint32_t mScanFrom_U32 = 0;
+
+public:
+  BofDelimiterScanner()
+  {
+  }
+  BofDelimiterScanner(const std::string &_rDelimiter_S)
+  {
+    Delimiter(_rDelimiter_S);
+  }
+
+  BOFERR Delimiter(const std::string &_rDelimiter_S)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((!_rDelimiter_S.empty()) && (_rDelimiter_S.size() <= BOF_DELIMITER_SCANNER_MAX_DELIMITER))
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      mDelimiterSize_U32 = static_cast<uint32_t>(_rDelimiter_S.size());
+      memcpy(mpDelimiter_U8, _rDelimiter_S.data(), mDelimiterSize_U32);
+      mScanFrom_U32 = 0;
+    }
+    return Rts_E;
+  }
+  uint32_t DelimiterSize() const
+  {
+    return mDelimiterSize_U32;
+  }
+
+  /*!
+   * Description
+   * Looks for the delimiter in the bytes of _pBuffer_U8 not examined by the previous calls.
+   *
+   * Parameters
+   * _pBuffer_U8: Specifies the buffer. Its first _Size_U32 bytes must be the same as in the previous call, plus the new data
+   * _Size_U32: Specifies the number of valid bytes
+   *
+   * Returns
+   * uint32_t: Offset of the delimiter or BOF_DELIMITER_NOT_FOUND
+   */
+  uint32_t Scan(const uint8_t *_pBuffer_U8, uint32_t _Size_U32)
+  {
+    uint32_t Rts_U32 = BOF_DELIMITER_NOT_FOUND;
+
+    if (mDelimiterSize_U32)
+    {
+      Rts_U32 = Bof_ScanDelimiter(_pBuffer_U8, mScanFrom_U32, _Size_U32, mpDelimiter_U8, mDelimiterSize_U32);
+      if (Rts_U32 == BOF_DELIMITER_NOT_FOUND)
+      {
+        mScanFrom_U32 = (_Size_U32 >= mDelimiterSize_U32) ? _Size_U32 - mDelimiterSize_U32 + 1 : 0;
+      }
+    }
+    return Rts_U32;
+  }
+
+  //To call when the first _Nb_U32 bytes of the buffer have been consumed (frame handed off)
+  void Consume(uint32_t _Nb_U32)
+  {
+    mScanFrom_U32 = (mScanFrom_U32 > _Nb_U32) ? mScanFrom_U32 - _Nb_U32 : 0;
+  }
+  void Reset()
+  {
+    mScanFrom_U32 = 0;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,562 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the BofHugePagePool class: a memory pool reserved
+ * once in huge pages and sub allocated with a buddy allocator.
+ *
+ * Name:        bofhugepagepool.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only (hugetlb and transparent huge pages)
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/ibofallocator.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofstatistics.h>
+#include <mutex>
+#include <vector>
+#if !defined (_WIN32)
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+constexpr uint8_t BOF_HUGE_PAGE_POOL_FREE = 0x80;     /*! Flag of the buddy block state: block is free. Low bits are the order */
+constexpr uint8_t BOF_HUGE_PAGE_POOL_NONE = 0xFF;     /*! Buddy block state: not the start of a block */
+
+#if !defined (_WIN32)
+#if !defined(MAP_HUGETLB)
+#define MAP_HUGETLB 0x40000
+#endif
+#if !defined(MAP_HUGE_SHIFT)
+#define MAP_HUGE_SHIFT 26
+#endif
+#if !defined(MADV_HUGEPAGE)
+#define MADV_HUGEPAGE 14
+#endif
+#endif
+
+/*** Enum *****************************************************************/
+
+enum class BOF_HUGE_PAGE_BACKING : uint32_t
+{
+  AUTO = 0,                   //Try HUGETLB, then THP, then REGULAR
+  HUGETLB,                    //Reserved huge pages (vm.nr_hugepages), MAP_HUGETLB
+  THP,                        //Transparent huge pages, madvise(MADV_HUGEPAGE) on a huge page aligned mapping
+  REGULAR,                    //Regular pages
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_HUGE_PAGE_POOL_PARAM
+{
+  std::string           Name_S;
+  uint64_t              PoolSizeInByte_U64;       /*! Rounded up to the huge page size */
+  uint32_t              MinBlockSizeInByte_U32;   /*! Smallest block (power of two, >= 64). Blocks are aligned on their size */
+  uint32_t              HugePageSizeInByte_U32;   /*! 0 uses the default huge page size of the system (Hugepagesize in /proc/meminfo) */
+  BOF_HUGE_PAGE_BACKING Backing_E;
+  bool                  MultiThreadAware_B;
+  bool                  LockIt_B;                 /*! mlock the pool */
+  bool                  Prefault_B;               /*! Touch the pool at creation: no page fault (and no THP collapse delay) later */
+
+  BOF_HUGE_PAGE_POOL_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S                 = "";
+    PoolSizeInByte_U64     = 256 * 1024 * 1024;
+    MinBlockSizeInByte_U32 = 4096;
+    HugePageSizeInByte_U32 = 0;
+    Backing_E              = BOF_HUGE_PAGE_BACKING::AUTO;
+    MultiThreadAware_B     = true;
+    LockIt_B               = false;
+    Prefault_B             = true;
+  }
+};
+
+struct BOF_HUGE_PAGE_POOL_STATISTIC
+{
+  BOF_ALLOCATOR_STATISTIC Allocator_X;
+  BOF_HUGE_PAGE_BACKING   Backing_E;                      /*! Backing really obtained */
+  uint32_t                HugePageSizeInByte_U32;
+  uint64_t                PoolSizeInByte_U64;
+  uint64_t                FreeInByte_U64;
+  uint64_t                LargestFreeBlockInByte_U64;     /*! Fragmentation indicator */
+  uint64_t                HugePageMappedInByte_U64;       /*! Part of the pool really backed by huge pages (AnonHugePages or hugetlb mapping) */
+  uint64_t                NbTlbEntry_U64;                 /*! Number of pages (thus of TLB entries) needed to cover the pool */
+  uint64_t                NbTlbEntryRegular_U64;          /*! Same with regular pages, for comparison */
+
+  BOF_HUGE_PAGE_POOL_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Allocator_X.Reset();
+    Backing_E                  = BOF_HUGE_PAGE_BACKING::REGULAR;
+    HugePageSizeInByte_U32     = 0;
+    PoolSizeInByte_U64         = 0;
+    FreeInByte_U64             = 0;
+    LargestFreeBlockInByte_U64 = 0;
+    HugePageMappedInByte_U64   = 0;
+    NbTlbEntry_U64             = 0;
+    NbTlbEntryRegular_U64      = 0;
+  }
+};
+
+/*** Function **************************************************************/
+
+//Reads a "Key: value kB" entry of a /proc file (0 if not found)
+inline uint64_t Bof_ReadProcKbEntry(const char *_pFile_c, const char *_pKey_c)
+{
+  uint64_t Rts_U64 = 0;
+#if !defined (_WIN32)
+  FILE               *pIo_X;
+  char               pLine_c[256];
+  unsigned long long Val_ULL;
+  size_t             Len = strlen(_pKey_c);
+
+  pIo_X = fopen(_pFile_c, "r");
+  if (pIo_X)
+  {
+    while (fgets(pLine_c, sizeof(pLine_c), pIo_X))
+    {
+      if ((strncmp(pLine_c, _pKey_c, Len) == 0) && (pLine_c[Len] == ':') && (sscanf(pLine_c + Len + 1, "%llu", &Val_ULL) == 1))
+      {
+        Rts_U64 = static_cast<uint64_t>(Val_ULL) * 1024;
+        break;
+      }
+    }
+    fclose(pIo_X);
+  }
+#endif
+  return Rts_U64;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Huge page buffer pool
+ *
+ * Description
+ * The pool is mapped once at creation. With MAP_HUGETLB it uses the huge pages reserved by the administrator
+ * (vm.nr_hugepages); when none is available it maps a huge page aligned area and asks for transparent huge pages with
+ * madvise(MADV_HUGEPAGE). Blocks are sub allocated with a buddy allocator: power of two sizes from MinBlockSizeInByte_U32
+ * to the pool size, aligned on their size, split and coalesced in O(log n). Large frames thus span a few huge pages
+ * instead of hundreds of regular pages, which removes most of the dTLB misses.
+ * The allocator does not touch the blocks it hands out: its bookkeeping lives outside of the pool.
+ *
+ * See Also
+ * Bof_AlignedMemAlloc, BofSlabAllocator
+ */
+class BofHugePagePool : public IBofAllocator
+{
+private:
+  BOF_HUGE_PAGE_POOL_PARAM                  mHugePagePoolParam_X;
+  BOF_HUGE_PAGE_BACKING                     mBacking_E = BOF_HUGE_PAGE_BACKING::REGULAR;
+  uint8_t                                   *mpMapping_U8 = nullptr;   /*! Mapping as returned by mmap */
+  uint64_t                                  mMappingSize_U64 = 0;
+  uint8_t                                   *mpPool_U8 = nullptr;     /*! Huge page aligned start of the pool */
+  uint64_t                                  mPoolSize_U64 = 0;
+  uint32_t                                  mHugePageSize_U32 = 0;
+  uint32_t                                  mMinShift_U32 = 0;
+  uint32_t                                  mNbOrder_U32 = 0;
+  std::vector<uint8_t>                      mBlockState_U8;           /*! One entry per min block */
+  std::vector<std::vector<uint32_t>>        mFreeCollection;          /*! Per order, min block index of the free blocks */
+  std::vector<uint32_t>                     mFreePos_U32;             /*! Position of a free block in its mFreeCollection entry */
+  std::mutex                                mMtx;
+  BOF_ALLOCATOR_STATISTIC                   mStatistic_X;
+  uint64_t                                  mFreeInByte_U64 = 0;
+  BOFERR                                    mErrorCode_E = BOF_ERR_INIT;
+
+public:
+  BofHugePagePool(const BOF_HUGE_PAGE_POOL_PARAM &_rHugePagePoolParam_X) : mHugePagePoolParam_X(_rHugePagePoolParam_X)
+  {
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mHugePagePoolParam_X.PoolSizeInByte_U64) && (mHugePagePoolParam_X.MinBlockSizeInByte_U32 >= 64) &&
+        ((mHugePagePoolParam_X.MinBlockSizeInByte_U32 & (mHugePagePoolParam_X.MinBlockSizeInByte_U32 - 1)) == 0))
+    {
+      mErrorCode_E = Map();
+      if (mErrorCode_E == BOF_ERR_NO_ERROR)
+      {
+        InitBuddy();
+      }
+    }
+  }
+  virtual ~BofHugePagePool()
+  {
+#if !defined (_WIN32)
+    if (mpMapping_U8)
+    {
+      munmap(mpMapping_U8, mMappingSize_U64);
+    }
+#endif
+  }
+  BofHugePagePool &operator=(const BofHugePagePool &) = delete; // Disallow copying
+  BofHugePagePool(const BofHugePagePool &) = delete;
+
+  BOFERR LastErrorCode() const { return mErrorCode_E; }
+  BOF_HUGE_PAGE_BACKING Backing() const { return mBacking_E; }
+
+  void *V_Allocate(uint64_t _SizeInByte_U64) override
+  {
+    void     *pRts = nullptr;
+    uint32_t Order_U32, Avail_U32, Index_U32;
+
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_SizeInByte_U64) && (_SizeInByte_U64 <= mPoolSize_U64))
+    {
+      Order_U32 = OrderOf(_SizeInByte_U64);
+      Lock();
+      for (Avail_U32 = Order_U32; Avail_U32 < mNbOrder_U32; Avail_U32++)
+      {
+        if (!mFreeCollection[Avail_U32].empty())
+        {
+          break;
+        }
+      }
+      if (Avail_U32 < mNbOrder_U32)
+      {
+        Index_U32 = mFreeCollection[Avail_U32].back();
+        RemoveFree(Index_U32, Avail_U32);
+        //Split down to the requested order, the upper halves become free
+        while (Avail_U32 > Order_U32)
+        {
+          Avail_U32--;
+          AddFree(Index_U32 + (1U << Avail_U32), Avail_U32);
+        }
+        mBlockState_U8[Index_U32] = static_cast<uint8_t>(Order_U32);
+        pRts                      = mpPool_U8 + (static_cast<uint64_t>(Index_U32) << mMinShift_U32);
+        mFreeInByte_U64          -= BlockSize(Order_U32);
+        mStatistic_X.NbAlloc_U64++;
+        mStatistic_X.CurrentAllocInByte_U64 += BlockSize(Order_U32);
+        BOF_SET_NEW_STAT_MAX(mStatistic_X.CurrentAllocInByte_U64, mStatistic_X.MaxAllocInByte_U64);
+      }
+      else
+      {
+        mStatistic_X.NbAllocFail_U64++;
+      }
+      Unlock();
+    }
+    return pRts;
+  }
+
+  //The block order is kept in the pool bookkeeping: _SizeInByte_U64 is only checked
+  void V_Free(void *_pData, uint64_t _SizeInByte_U64) override
+  {
+    uint8_t  *pData_U8 = static_cast<uint8_t *>(_pData);
+    uint32_t Index_U32, Order_U32, Buddy_U32;
+
+    if ((pData_U8 >= mpPool_U8) && (pData_U8 < (mpPool_U8 + mPoolSize_U64)))
+    {
+      Index_U32 = static_cast<uint32_t>((pData_U8 - mpPool_U8) >> mMinShift_U32);
+      Lock();
+      Order_U32 = mBlockState_U8[Index_U32];
+      if ((Order_U32 < mNbOrder_U32) && ((_SizeInByte_U64 == 0) || (_SizeInByte_U64 <= BlockSize(Order_U32))))
+      {
+        mFreeInByte_U64 += BlockSize(Order_U32);
+        mStatistic_X.NbFree_U64++;
+        mStatistic_X.CurrentAllocInByte_U64 -= BlockSize(Order_U32);
+        //Coalesce with the buddy as long as it is free and of the same order
+        while ((Order_U32 + 1) < mNbOrder_U32)
+        {
+          Buddy_U32 = Index_U32 ^ (1U << Order_U32);
+          if ((Buddy_U32 >= mBlockState_U8.size()) || (mBlockState_U8[Buddy_U32] != (BOF_HUGE_PAGE_POOL_FREE | Order_U32)))
+          {
+            break;
+          }
+          RemoveFree(Buddy_U32, Order_U32);
+          mBlockState_U8[std::max(Index_U32, Buddy_U32)] = BOF_HUGE_PAGE_POOL_NONE;
+          Index_U32 = std::min(Index_U32, Buddy_U32);
+          Order_U32++;
+        }
+        AddFree(Index_U32, Order_U32);
+      }
+      Unlock();
+    }
+  }
+
+  BOFERR V_Statistic(BOF_ALLOCATOR_STATISTIC &_rStatistic_X) override
+  {
+    Lock();
+    _rStatistic_X = mStatistic_X;
+    Unlock();
+    return BOF_ERR_NO_ERROR;
+  }
+
+  const char *V_Name() const override
+  {
+    return mHugePagePoolParam_X.Name_S.c_str();
+  }
+
+  BOFERR HugePagePoolStatistic(BOF_HUGE_PAGE_POOL_STATISTIC &_rStatistic_X)
+  {
+    BOFERR   Rts_E = mErrorCode_E;
+    int32_t  Order_S32;
+
+    _rStatistic_X.Reset();
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Lock();
+      _rStatistic_X.Allocator_X = mStatistic_X;
+      _rStatistic_X.FreeInByte_U64 = mFreeInByte_U64;
+      for (Order_S32 = static_cast<int32_t>(mNbOrder_U32) - 1; Order_S32 >= 0; Order_S32--)
+      {
+        if (!mFreeCollection[Order_S32].empty())
+        {
+          _rStatistic_X.LargestFreeBlockInByte_U64 = BlockSize(Order_S32);
+          break;
+        }
+      }
+      Unlock();
+      _rStatistic_X.Allocator_X.ReservedInByte_U64 = mPoolSize_U64;
+      _rStatistic_X.Backing_E                      = mBacking_E;
+      _rStatistic_X.HugePageSizeInByte_U32         = mHugePageSize_U32;
+      _rStatistic_X.PoolSizeInByte_U64             = mPoolSize_U64;
+      _rStatistic_X.HugePageMappedInByte_U64       = HugePageMappedInByte();
+      _rStatistic_X.NbTlbEntryRegular_U64          = mPoolSize_U64 / RegularPageSize();
+      //Pages not backed by a huge page need one TLB entry per regular page
+      _rStatistic_X.NbTlbEntry_U64 = (_rStatistic_X.HugePageMappedInByte_U64 / mHugePageSize_U32) +
+                                     ((mPoolSize_U64 - std::min(mPoolSize_U64, _rStatistic_X.HugePageMappedInByte_U64)) / RegularPageSize());
+    }
+    return Rts_E;
+  }
+
+  std::string HugePagePoolDebugInfo()
+  {
+    BOF_HUGE_PAGE_POOL_STATISTIC Statistic_X;
+    static const char            *S_pBacking_c[] = { "Auto", "HugeTlb", "Thp", "Regular" };
+
+    HugePagePoolStatistic(Statistic_X);
+    return Bof_Sprintf("HugePagePool '%s' %s page %d KB Pool %lld MB HugeMapped %lld MB Free %lld Largest %lld Alloc %lld Free %lld Fail %lld Used %lld Max %lld Tlb %lld (regular %lld)\n",
+                       mHugePagePoolParam_X.Name_S.c_str(), S_pBacking_c[static_cast<uint32_t>(Statistic_X.Backing_E) & 3], Statistic_X.HugePageSizeInByte_U32 / 1024,
+                       Statistic_X.PoolSizeInByte_U64 >> 20, Statistic_X.HugePageMappedInByte_U64 >> 20, Statistic_X.FreeInByte_U64, Statistic_X.LargestFreeBlockInByte_U64,
+                       Statistic_X.Allocator_X.NbAlloc_U64, Statistic_X.Allocator_X.NbFree_U64, Statistic_X.Allocator_X.NbAllocFail_U64,
+                       Statistic_X.Allocator_X.CurrentAllocInByte_U64, Statistic_X.Allocator_X.MaxAllocInByte_U64, Statistic_X.NbTlbEntry_U64, Statistic_X.NbTlbEntryRegular_U64);
+  }
+
+private:
+  void Lock()
+  {
+    if (mHugePagePoolParam_X.MultiThreadAware_B)
+    {
+      mMtx.lock();
+    }
+  }
+
+  void Unlock()
+  {
+    if (mHugePagePoolParam_X.MultiThreadAware_B)
+    {
+      mMtx.unlock();
+    }
+  }
+
+  static uint32_t RegularPageSize()
+  {
+#if defined (_WIN32)
+    return 4096;
+#else
+    return static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+#endif
+  }
+
+  uint64_t BlockSize(uint32_t _Order_U32) const
+  {
+    return 1ULL << (mMinShift_U32 + _Order_U32);
+  }
+
+  uint32_t OrderOf(uint64_t _SizeInByte_U64) const
+  {
+    uint32_t Rts_U32 = 0;
+
+    while (BlockSize(Rts_U32) < _SizeInByte_U64)
+    {
+      Rts_U32++;
+    }
+    return Rts_U32;
+  }
+
+  void AddFree(uint32_t _Index_U32, uint32_t _Order_U32)
+  {
+    mBlockState_U8[_Index_U32] = static_cast<uint8_t>(BOF_HUGE_PAGE_POOL_FREE | _Order_U32);
+    mFreePos_U32[_Index_U32]   = static_cast<uint32_t>(mFreeCollection[_Order_U32].size());
+    mFreeCollection[_Order_U32].push_back(_Index_U32);
+  }
+
+  void RemoveFree(uint32_t _Index_U32, uint32_t _Order_U32)
+  {
+    std::vector<uint32_t> &rFree = mFreeCollection[_Order_U32];
+    uint32_t              Pos_U32 = mFreePos_U32[_Index_U32];
+
+    rFree[Pos_U32]              = rFree.back();
+    mFreePos_U32[rFree[Pos_U32]] = Pos_U32;
+    rFree.pop_back();
+    mBlockState_U8[_Index_U32] = static_cast<uint8_t>(_Order_U32);
+  }
+
+  BOFERR Map()
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if !defined (_WIN32)
+    void     *pMap;
+    uint64_t Size_U64, i_U64;
+    int      Flag_i;
+
+    mHugePageSize_U32 = mHugePagePoolParam_X.HugePageSizeInByte_U32 ? mHugePagePoolParam_X.HugePageSizeInByte_U32
+                                                                   : static_cast<uint32_t>(Bof_ReadProcKbEntry("/proc/meminfo", "Hugepagesize"));
+    if (mHugePageSize_U32 == 0)
+    {
+      mHugePageSize_U32 = 2 * 1024 * 1024;
+    }
+    mPoolSize_U64 = (mHugePagePoolParam_X.PoolSizeInByte_U64 + mHugePageSize_U32 - 1) & ~static_cast<uint64_t>(mHugePageSize_U32 - 1);
+
+    if ((mHugePagePoolParam_X.Backing_E == BOF_HUGE_PAGE_BACKING::AUTO) || (mHugePagePoolParam_X.Backing_E == BOF_HUGE_PAGE_BACKING::HUGETLB))
+    {
+      Flag_i = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+      if (mHugePagePoolParam_X.HugePageSizeInByte_U32)
+      {
+        Flag_i |= (__builtin_ctz(mHugePageSize_U32) << MAP_HUGE_SHIFT);
+      }
+      pMap = mmap(nullptr, mPoolSize_U64, PROT_READ | PROT_WRITE, Flag_i, -1, 0);
+      if (pMap != MAP_FAILED)
+      {
+        Rts_E            = BOF_ERR_NO_ERROR;
+        mBacking_E       = BOF_HUGE_PAGE_BACKING::HUGETLB;
+        mpMapping_U8      = static_cast<uint8_t *>(pMap);
+        mMappingSize_U64 = mPoolSize_U64;
+        mpPool_U8        = mpMapping_U8;
+      }
+    }
+    if ((Rts_E != BOF_ERR_NO_ERROR) && (mHugePagePoolParam_X.Backing_E != BOF_HUGE_PAGE_BACKING::HUGETLB))
+    {
+      //Over allocate by one huge page to align the pool: THP can only back huge page aligned ranges
+      Size_U64 = mPoolSize_U64 + mHugePageSize_U32;
+      pMap     = mmap(nullptr, Size_U64, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (pMap != MAP_FAILED)
+      {
+        Rts_E            = BOF_ERR_NO_ERROR;
+        mpMapping_U8      = static_cast<uint8_t *>(pMap);
+        mMappingSize_U64 = Size_U64;
+        mpPool_U8        = reinterpret_cast<uint8_t *>((reinterpret_cast<uintptr_t>(mpMapping_U8) + mHugePageSize_U32 - 1) & ~static_cast<uintptr_t>(mHugePageSize_U32 - 1));
+        mBacking_E       = BOF_HUGE_PAGE_BACKING::REGULAR;
+        if ((mHugePagePoolParam_X.Backing_E != BOF_HUGE_PAGE_BACKING::REGULAR) && (madvise(mpPool_U8, mPoolSize_U64, MADV_HUGEPAGE) == 0))
+        {
+          mBacking_E = BOF_HUGE_PAGE_BACKING::THP;
+        }
+      }
+      else
+      {
+        Rts_E = BOF_ERR_ENOMEM;
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mHugePagePoolParam_X.Prefault_B)
+      {
+        for (i_U64 = 0; i_U64 < mPoolSize_U64; i_U64 += RegularPageSize())
+        {
+          mpPool_U8[i_U64] = 0;
+        }
+      }
+      if ((mHugePagePoolParam_X.LockIt_B) && (mlock(mpPool_U8, mPoolSize_U64) != 0))
+      {
+        Rts_E = BOF_ERR_LOCK;
+      }
+    }
+#endif
+    return Rts_E;
+  }
+
+  void InitBuddy()
+  {
+    uint64_t NbMinBlock_U64, Index_U64;
+    uint32_t Order_U32;
+
+    mMinShift_U32 = 0;
+    while ((1U << mMinShift_U32) < mHugePagePoolParam_X.MinBlockSizeInByte_U32)
+    {
+      mMinShift_U32++;
+    }
+    NbMinBlock_U64 = mPoolSize_U64 >> mMinShift_U32;
+    mNbOrder_U32   = 1;
+    while ((mNbOrder_U32 < 32) && ((1ULL << mNbOrder_U32) <= NbMinBlock_U64))
+    {
+      mNbOrder_U32++;
+    }
+    mBlockState_U8.assign(static_cast<size_t>(NbMinBlock_U64), BOF_HUGE_PAGE_POOL_NONE);
+    mFreePos_U32.assign(static_cast<size_t>(NbMinBlock_U64), 0);
+    mFreeCollection.resize(mNbOrder_U32);
+    //The pool is not a power of two in general: cover it with the largest aligned blocks possible
+    Index_U64 = 0;
+    while (Index_U64 < NbMinBlock_U64)
+    {
+      Order_U32 = mNbOrder_U32 - 1;
+      while ((((Index_U64 & ((1ULL << Order_U32) - 1)) != 0) || ((Index_U64 + (1ULL << Order_U32)) > NbMinBlock_U64)) && (Order_U32))
+      {
+        Order_U32--;
+      }
+      AddFree(static_cast<uint32_t>(Index_U64), Order_U32);
+      Index_U64 += 1ULL << Order_U32;
+    }
+    mFreeInByte_U64 = mPoolSize_U64;
+  }
+
+  uint64_t HugePageMappedInByte() const
+  {
+    uint64_t Rts_U64 = 0;
+#if !defined (_WIN32)
+    FILE               *pIo_X;
+    char               pLine_c[256];
+    unsigned long long Start_ULL, End_ULL, Val_ULL;
+    bool               InPool_B = false;
+
+    if (mBacking_E == BOF_HUGE_PAGE_BACKING::HUGETLB)
+    {
+      Rts_U64 = mPoolSize_U64;
+    }
+    else if ((mBacking_E == BOF_HUGE_PAGE_BACKING::THP) && ((pIo_X = fopen("/proc/self/smaps", "r")) != nullptr))
+    {
+      //The pool can be split in several vmas by the kernel (mlock, madvise...): sum all the ones inside the mapping
+      while (fgets(pLine_c, sizeof(pLine_c), pIo_X))
+      {
+        if (sscanf(pLine_c, "%llx-%llx ", &Start_ULL, &End_ULL) == 2)
+        {
+          InPool_B = (Start_ULL >= reinterpret_cast<uintptr_t>(mpMapping_U8)) && (End_ULL <= reinterpret_cast<uintptr_t>(mpMapping_U8) + mMappingSize_U64);
+        }
+        else if ((InPool_B) && (sscanf(pLine_c, "AnonHugePages: %llu kB", &Val_ULL) == 1))
+        {
+          Rts_U64 += static_cast<uint64_t>(Val_ULL) * 1024;
+        }
+      }
+      fclose(pIo_X);
+    }
+#endif
+    return Rts_U64;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines a minimal io_uring ring and provided buffer ring built
+ * on the raw system calls (no liburing dependency).
+ *
+ * Name:        bofiouring.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only. The kernel uapi header must be recent enough to
+ *              define the multishot accept/recv flags (6.0), otherwise
+ *              BOF_IO_URING_AVAILABLE is 0, the classes are not defined and
+ *              the io_uring users fall back to epoll.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofstd.h>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(IORING_RECV_MULTISHOT) && defined(IORING_ACCEPT_MULTISHOT) && defined(IORING_FEAT_EXT_ARG)
+#define BOF_IO_URING_AVAILABLE 1
+#endif
+#endif
+#endif
+#if !defined(BOF_IO_URING_AVAILABLE)
+#define BOF_IO_URING_AVAILABLE 0
+#endif
+
+#if BOF_IO_URING_AVAILABLE
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#define BOF_IO_URING_INFINITE_TIMEOUT 0xFFFFFFFF
+
+#if BOF_IO_URING_AVAILABLE
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * io_uring submission/completion ring
+ *
+ * Description
+ * Thin wrapper over io_uring_setup/io_uring_enter/io_uring_register. The submission side (GetSqe/Submit) must be
+ * serialized by the caller. The completion side (ForEachCqe) must be used by a single thread. Wait can be called
+ * concurrently with the submission side.
+ *
+ * See Also
+ * BofIoUringBufferRing
+ */
+class BofIoUring
+{
+private:
+  int                  mRingFd_i = -1;
+  uint32_t             mFeature_U32 = 0;
+  void                 *mpSqRing = MAP_FAILED;
+  size_t               mSqRingSize = 0;
+  void                 *mpCqRing = MAP_FAILED;
+  size_t               mCqRingSize = 0;
+  struct io_uring_sqe  *mpSqe_X = nullptr;
+  size_t               mSqeSize = 0;
+  uint32_t             *mpSqHead_U32 = nullptr;
+  uint32_t             *mpSqTail_U32 = nullptr;
+  uint32_t             mSqMask_U32 = 0;
+  uint32_t             mSqEntry_U32 = 0;
+  uint32_t             mSqeTail_U32 = 0;         //Local tail: published to the kernel by Submit
+  uint32_t             *mpCqHead_U32 = nullptr;
+  uint32_t             *mpCqTail_U32 = nullptr;
+  uint32_t             mCqMask_U32 = 0;
+  struct io_uring_cqe  *mpCqe_X = nullptr;
+  std::vector<uint8_t> mOpcodeSupportedCollection;
+
+public:
+  BofIoUring()
+  {
+  }
+  virtual ~BofIoUring()
+  {
+    Close();
+  }
+  BofIoUring &operator=(const BofIoUring &) = delete; // Disallow copying
+  BofIoUring(const BofIoUring &) = delete;
+
+  static int S_Setup(uint32_t _NbEntry_U32, struct io_uring_params *_pParam_X)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_setup, _NbEntry_U32, _pParam_X));
+  }
+  static int S_Enter(int _Fd_i, uint32_t _NbSubmit_U32, uint32_t _MinComplete_U32, uint32_t _Flag_U32, void *_pArg, size_t _ArgSize)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_enter, _Fd_i, _NbSubmit_U32, _MinComplete_U32, _Flag_U32, _pArg, _ArgSize));
+  }
+  static int S_Register(int _Fd_i, uint32_t _Opcode_U32, const void *_pArg, uint32_t _NbArg_U32)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_register, _Fd_i, _Opcode_U32, _pArg, _NbArg_U32));
+  }
+
+  /*!
+   * Description
+   * Open the ring.
+   *
+   * Parameters
+   * _NbEntry_U32: Specifies the number of submission entries (rounded up to a power of 2 by the kernel)
+   * _Flag_U32:    Specifies the IORING_SETUP_xxx flags
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_NOT_SUPPORTED if the kernel lacks io_uring or
+   * the single mmap and extended wait argument features
+   */
+  BOFERR Open(uint32_t _NbEntry_U32, uint32_t _Flag_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_EEXIST;
+    struct io_uring_params Param_X;
+    uint8_t *pSqRing_U8, *pCqRing_U8;
+    uint32_t i_U32, *pSqArray_U32;
+
+    if (mRingFd_i < 0)
+    {
+      memset(&Param_X, 0, sizeof(Param_X));
+      Param_X.flags = _Flag_U32;
+      mRingFd_i = S_Setup(_NbEntry_U32, &Param_X);
+      Rts_E = (mRingFd_i >= 0) ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_SUPPORTED;
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mFeature_U32 = Param_X.features;
+        Rts_E = ((mFeature_U32 & IORING_FEAT_SINGLE_MMAP) && (mFeature_U32 & IORING_FEAT_EXT_ARG)) ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_SUPPORTED;
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        //With IORING_FEAT_SINGLE_MMAP the sq and cq rings share the same mapping
+        mSqRingSize = Param_X.sq_off.array + (Param_X.sq_entries * sizeof(uint32_t));
+        mCqRingSize = Param_X.cq_off.cqes + (Param_X.cq_entries * sizeof(struct io_uring_cqe));
+        if (mCqRingSize > mSqRingSize)
+        {
+          mSqRingSize = mCqRingSize;
+        }
+        mpSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd_i, IORING_OFF_SQ_RING);
+        mSqeSize = Param_X.sq_entries * sizeof(struct io_uring_sqe);
+        mpSqe_X = static_cast<struct io_uring_sqe *>(mmap(nullptr, mSqeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd_i, IORING_OFF_SQES));
+        Rts_E = ((mpSqRing != MAP_FAILED) && (mpSqe_X != MAP_FAILED)) ? BOF_ERR_NO_ERROR : BOF_ERR_ENOMEM;
+        if (mpSqe_X == MAP_FAILED)
+        {
+          mpSqe_X = nullptr;
+        }
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mpCqRing = mpSqRing;
+        pSqRing_U8 = static_cast<uint8_t *>(mpSqRing);
+        pCqRing_U8 = static_cast<uint8_t *>(mpCqRing);
+        mpSqHead_U32 = reinterpret_cast<uint32_t *>(pSqRing_U8 + Param_X.sq_off.head);
+        mpSqTail_U32 = reinterpret_cast<uint32_t *>(pSqRing_U8 + Param_X.sq_off.tail);
+        mSqMask_U32 = *reinterpret_cast<uint32_t *>(pSqRing_U8 + Param_X.sq_off.ring_mask);
+        mSqEntry_U32 = Param_X.sq_entries;
+        mSqeTail_U32 = *mpSqTail_U32;
+        pSqArray_U32 = reinterpret_cast<uint32_t *>(pSqRing_U8 + Param_X.sq_off.array);
+        for (i_U32 = 0; i_U32 < mSqEntry_U32; i_U32++)
+        {
+          pSqArray_U32[i_U32] = i_U32;   //Identity mapping: sqe i is always in slot i
+        }
+        mpCqHead_U32 = reinterpret_cast<uint32_t *>(pCqRing_U8 + Param_X.cq_off.head);
+        mpCqTail_U32 = reinterpret_cast<uint32_t *>(pCqRing_U8 + Param_X.cq_off.tail);
+        mCqMask_U32 = *reinterpret_cast<uint32_t *>(pCqRing_U8 + Param_X.cq_off.ring_mask);
+        mpCqe_X = reinterpret_cast<struct io_uring_cqe *>(pCqRing_U8 + Param_X.cq_off.cqes);
+        Rts_E = Probe();
+      }
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        Close();
+      }
+    }
+    return Rts_E;
+  }
+
+  void Close()
+  {
+    if (mpSqe_X)
+    {
+      munmap(mpSqe_X, mSqeSize);
+      mpSqe_X = nullptr;
+    }
+    if (mpSqRing != MAP_FAILED)
+    {
+      munmap(mpSqRing, mSqRingSize);
+      mpSqRing = MAP_FAILED;
+      mpCqRing = MAP_FAILED;
+    }
+    if (mRingFd_i >= 0)
+    {
+      close(mRingFd_i);
+      mRingFd_i = -1;
+    }
+    mOpcodeSupportedCollection.clear();
+  }
+
+  bool IsOpen() const
+  {
+    return (mRingFd_i >= 0);
+  }
+
+  int RingFd() const
+  {
+    return mRingFd_i;
+  }
+
+  uint32_t Feature() const
+  {
+    return mFeature_U32;
+  }
+
+  bool IsOpcodeSupported(uint8_t _Opcode_U8) const
+  {
+    return (_Opcode_U8 < mOpcodeSupportedCollection.size()) && (mOpcodeSupportedCollection[_Opcode_U8]);
+  }
+
+  /*!
+   * Description
+   * Reserve the next submission entry. The entry is zeroed and becomes visible to the kernel on the next Submit.
+   *
+   * Returns
+   * struct io_uring_sqe *: The entry or nullptr if the submission ring is full (call Submit and retry)
+   */
+  struct io_uring_sqe *GetSqe()
+  {
+    struct io_uring_sqe *pRts_X = nullptr;
+
+    if ((mpSqe_X) && ((mSqeTail_U32 - __atomic_load_n(mpSqHead_U32, __ATOMIC_ACQUIRE)) < mSqEntry_U32))
+    {
+      pRts_X = &mpSqe_X[mSqeTail_U32 & mSqMask_U32];
+      memset(pRts_X, 0, sizeof(*pRts_X));
+      mSqeTail_U32++;
+    }
+    return pRts_X;
+  }
+
+  uint32_t NbPendingSqe() const
+  {
+    return mpSqHead_U32 ? (mSqeTail_U32 - __atomic_load_n(mpSqHead_U32, __ATOMIC_ACQUIRE)) : 0;
+  }
+
+  /*!
+   * Description
+   * Publish the reserved submission entries and optionally wait for completions in the same system call.
+   *
+   * Parameters
+   * _MinComplete_U32: Specifies the number of completions to wait for (0: submit only)
+   * _TimeoutInMs_U32: Specifies the maximum wait time if _MinComplete_U32 is not 0 (BOF_IO_URING_INFINITE_TIMEOUT)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful (a timeout or a signal is not an error)
+   */
+  BOFERR Submit(uint32_t _MinComplete_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_OPENED;
+    uint32_t NbSubmit_U32;
+
+    if (IsOpen())
+    {
+      __atomic_store_n(mpSqTail_U32, mSqeTail_U32, __ATOMIC_RELEASE);
+      NbSubmit_U32 = mSqeTail_U32 - __atomic_load_n(mpSqHead_U32, __ATOMIC_ACQUIRE);
+      Rts_E = BOF_ERR_NO_ERROR;
+      if ((NbSubmit_U32) || (_MinComplete_U32))
+      {
+        Rts_E = Enter(NbSubmit_U32, _MinComplete_U32, _TimeoutInMs_U32);
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Wait for completions without touching the submission ring (can run concurrently with GetSqe/Submit).
+   */
+  BOFERR Wait(uint32_t _MinComplete_U32, uint32_t _TimeoutInMs_U32)
+  {
+    return IsOpen() ? Enter(0, _MinComplete_U32, _TimeoutInMs_U32) : BOF_ERR_NOT_OPENED;
+  }
+
+  /*!
+   * Description
+   * Consume the available completions.
+   *
+   * Parameters
+   * _rCqeHandler: Specifies the handler called as void(const struct io_uring_cqe &) for each completion
+   *
+   * Returns
+   * uint32_t: The number of completions consumed
+   */
+  template <typename CqeHandler>
+  uint32_t ForEachCqe(CqeHandler &&_rCqeHandler)
+  {
+    uint32_t Rts_U32 = 0, Head_U32, Tail_U32;
+
+    if (IsOpen())
+    {
+      Head_U32 = *mpCqHead_U32;
+      Tail_U32 = __atomic_load_n(mpCqTail_U32, __ATOMIC_ACQUIRE);
+      while (Head_U32 != Tail_U32)
+      {
+        _rCqeHandler(mpCqe_X[Head_U32 & mCqMask_U32]);
+        Head_U32++;
+        Rts_U32++;
+      }
+      __atomic_store_n(mpCqHead_U32, Head_U32, __ATOMIC_RELEASE);
+    }
+    return Rts_U32;
+  }
+
+  BOFERR RegisterBuffer(const struct iovec *_pIoVec_X, uint32_t _NbIoVec_U32)
+  {
+    return Register(IORING_REGISTER_BUFFERS, _pIoVec_X, _NbIoVec_U32);
+  }
+
+  /*!
+   * Description
+   * Register a fixed file table with every slot empty. Slots are then set with UpdateFile.
+   */
+  BOFERR RegisterSparseFile(uint32_t _NbFile_U32)
+  {
+    std::vector<int> FdCollection(_NbFile_U32, -1);
+
+    return Register(IORING_REGISTER_FILES, FdCollection.data(), _NbFile_U32);
+  }
+
+  BOFERR UpdateFile(uint32_t _Index_U32, int _Fd_i)
+  {
+    struct io_uring_files_update FileUpdate_X;
+
+    memset(&FileUpdate_X, 0, sizeof(FileUpdate_X));
+    FileUpdate_X.offset = _Index_U32;
+    FileUpdate_X.fds = reinterpret_cast<uint64_t>(&_Fd_i);
+    return Register(IORING_REGISTER_FILES_UPDATE, &FileUpdate_X, 1);
+  }
+
+  BOFERR Register(uint32_t _Opcode_U32, const void *_pArg, uint32_t _NbArg_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_OPENED;
+
+    if (IsOpen())
+    {
+      Rts_E = (S_Register(mRingFd_i, _Opcode_U32, _pArg, _NbArg_U32) >= 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Check that the running kernel provides io_uring with the features and opcodes used by the socket backends.
+   */
+  static bool S_IsSupported()
+  {
+    BofIoUring IoUring;
+
+    return (IoUring.Open(4, 0) == BOF_ERR_NO_ERROR) && (IoUring.IsOpcodeSupported(IORING_OP_POLL_ADD)) && (IoUring.IsOpcodeSupported(IORING_OP_POLL_REMOVE)) &&
+           (IoUring.IsOpcodeSupported(IORING_OP_ACCEPT)) && (IoUring.IsOpcodeSupported(IORING_OP_RECV)) && (IoUring.IsOpcodeSupported(IORING_OP_SEND)) &&
+           (IoUring.IsOpcodeSupported(IORING_OP_WRITE_FIXED)) && (IoUring.IsOpcodeSupported(IORING_OP_NOP));
+  }
+
+private:
+  BOFERR Enter(uint32_t _NbSubmit_U32, uint32_t _MinComplete_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+    struct io_uring_getevents_arg Arg_X;
+    struct __kernel_timespec Ts_X;
+    uint32_t Flag_U32 = 0;
+    int Sts_i;
+
+    memset(&Arg_X, 0, sizeof(Arg_X));
+    if (_MinComplete_U32)
+    {
+      Flag_U32 = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+      Arg_X.sigmask_sz = _NSIG / 8;
+      if (_TimeoutInMs_U32 != BOF_IO_URING_INFINITE_TIMEOUT)
+      {
+        Ts_X.tv_sec = _TimeoutInMs_U32 / 1000;
+        Ts_X.tv_nsec = static_cast<long long>(_TimeoutInMs_U32 % 1000) * 1000000;
+        Arg_X.ts = reinterpret_cast<uint64_t>(&Ts_X);
+      }
+    }
+    Sts_i = S_Enter(mRingFd_i, _NbSubmit_U32, _MinComplete_U32, Flag_U32, _MinComplete_U32 ? &Arg_X : nullptr, _MinComplete_U32 ? sizeof(Arg_X) : 0);
+    if ((Sts_i < 0) && (errno != ETIME) && (errno != EINTR))
+    {
+      Rts_E = static_cast<BOFERR>(errno);
+    }
+    return Rts_E;
+  }
+
+  BOFERR Probe()
+  {
+    BOFERR Rts_E;
+    std::vector<uint8_t> ProbeBuffer(sizeof(struct io_uring_probe) + (256 * sizeof(struct io_uring_probe_op)), 0);
+    struct io_uring_probe *pProbe_X = reinterpret_cast<struct io_uring_probe *>(ProbeBuffer.data());
+    uint32_t i_U32;
+
+    Rts_E = Register(IORING_REGISTER_PROBE, pProbe_X, 256);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mOpcodeSupportedCollection.assign(256, 0);
+      for (i_U32 = 0; i_U32 < pProbe_X->ops_len; i_U32++)
+      {
+        if (pProbe_X->ops[i_U32].flags & IO_URING_OP_SUPPORTED)
+        {
+          mOpcodeSupportedCollection[pProbe_X->ops[i_U32].op] = 1;
+        }
+      }
+    }
+    else
+    {
+      Rts_E = BOF_ERR_NOT_SUPPORTED;
+    }
+    return Rts_E;
+  }
+};
+
+/*!
+ * Summary
+ * io_uring provided buffer ring
+ *
+ * Description
+ * Pool of equally sized receive buffers handed to the kernel (IORING_REGISTER_PBUF_RING) for the multishot recv
+ * requests of a buffer group. The kernel picks a buffer per completion and reports its id in the cqe flags; the
+ * buffer is given back with Recycle once consumed. Single threaded: use it from the completion thread only.
+ */
+class BofIoUringBufferRing
+{
+private:
+  BofIoUring            *mpIoUring = nullptr;
+  struct io_uring_buf_ring *mpBufRing_X = nullptr;
+  size_t                mBufRingSize = 0;
+  uint8_t               *mpBuffer_U8 = nullptr;
+  size_t                mBufferSize = 0;
+  uint32_t              mNbBuffer_U32 = 0;
+  uint32_t              mBufferSizeInByte_U32 = 0;
+  uint16_t              mGroupId_U16 = 0;
+  uint16_t              mTail_U16 = 0;
+  bool                  mRegistered_B = false;
+
+public:
+  BofIoUringBufferRing()
+  {
+  }
+  virtual ~BofIoUringBufferRing()
+  {
+    Close();
+  }
+  BofIoUringBufferRing &operator=(const BofIoUringBufferRing &) = delete; // Disallow copying
+  BofIoUringBufferRing(const BofIoUringBufferRing &) = delete;
+
+  /*!
+   * Description
+   * Allocate the buffers, register the ring in buffer group _GroupId_U16 and hand every buffer to the kernel.
+   *
+   * Parameters
+   * _pIoUring:             Specifies the ring
+   * _GroupId_U16:          Specifies the buffer group id used in the sqe buf_group field
+   * _NbBuffer_U32:         Specifies the number of buffers (power of 2, max 32768)
+   * _BufferSizeInByte_U32: Specifies the size of each buffer
+   */
+  BOFERR Open(BofIoUring *_pIoUring, uint16_t _GroupId_U16, uint32_t _NbBuffer_U32, uint32_t _BufferSizeInByte_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    struct io_uring_buf_reg BufReg_X;
+    uint32_t i_U32;
+
+    if ((_pIoUring) && (_pIoUring->IsOpen()) && (_NbBuffer_U32) && (_NbBuffer_U32 <= 32768) && ((_NbBuffer_U32 & (_NbBuffer_U32 - 1)) == 0) && (_BufferSizeInByte_U32) && (!mpBufRing_X))
+    {
+      mpIoUring = _pIoUring;
+      mGroupId_U16 = _GroupId_U16;
+      mNbBuffer_U32 = _NbBuffer_U32;
+      mBufferSizeInByte_U32 = _BufferSizeInByte_U32;
+      mBufRingSize = _NbBuffer_U32 * sizeof(struct io_uring_buf);
+      mBufferSize = static_cast<size_t>(_NbBuffer_U32) * _BufferSizeInByte_U32;
+      //The ring must be page aligned
+      mpBufRing_X = static_cast<struct io_uring_buf_ring *>(mmap(nullptr, mBufRingSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
+      mpBuffer_U8 = static_cast<uint8_t *>(mmap(nullptr, mBufferSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0));
+      Rts_E = ((mpBufRing_X != MAP_FAILED) && (mpBuffer_U8 != MAP_FAILED)) ? BOF_ERR_NO_ERROR : BOF_ERR_ENOMEM;
+      if (mpBufRing_X == MAP_FAILED)
+      {
+        mpBufRing_X = nullptr;
+      }
+      if (mpBuffer_U8 == MAP_FAILED)
+      {
+        mpBuffer_U8 = nullptr;
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        memset(&BufReg_X, 0, sizeof(BufReg_X));
+        BufReg_X.ring_addr = reinterpret_cast<uint64_t>(mpBufRing_X);
+        BufReg_X.ring_entries = _NbBuffer_U32;
+        BufReg_X.bgid = _GroupId_U16;
+        Rts_E = mpIoUring->Register(IORING_REGISTER_PBUF_RING, &BufReg_X, 1);
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mRegistered_B = true;
+        mTail_U16 = 0;
+        for (i_U32 = 0; i_U32 < _NbBuffer_U32; i_U32++)
+        {
+          Add(static_cast<uint16_t>(i_U32));
+        }
+        Publish();
+      }
+      else
+      {
+        Close();
+      }
+    }
+    return Rts_E;
+  }
+
+  void Close()
+  {
+    struct io_uring_buf_reg BufReg_X;
+
+    if ((mRegistered_B) && (mpIoUring))
+    {
+      memset(&BufReg_X, 0, sizeof(BufReg_X));
+      BufReg_X.bgid = mGroupId_U16;
+      mpIoUring->Register(IORING_UNREGISTER_PBUF_RING, &BufReg_X, 1);
+      mRegistered_B = false;
+    }
+    if (mpBufRing_X)
+    {
+      munmap(mpBufRing_X, mBufRingSize);
+      mpBufRing_X = nullptr;
+    }
+    if (mpBuffer_U8)
+    {
+      munmap(mpBuffer_U8, mBufferSize);
+      mpBuffer_U8 = nullptr;
+    }
+  }
+
+  uint16_t GroupId() const
+  {
+    return mGroupId_U16;
+  }
+
+  uint32_t BufferSizeInByte() const
+  {
+    return mBufferSizeInByte_U32;
+  }
+
+  uint8_t *Buffer(uint16_t _BufferId_U16) const
+  {
+    return (_BufferId_U16 < mNbBuffer_U32) ? mpBuffer_U8 + (static_cast<size_t>(_BufferId_U16) * mBufferSizeInByte_U32) : nullptr;
+  }
+
+  /*!
+   * Description
+   * Give a buffer reported by a completion (cqe flags >> IORING_CQE_BUFFER_SHIFT) back to the kernel.
+   */
+  void Recycle(uint16_t _BufferId_U16)
+  {
+    if ((mRegistered_B) && (_BufferId_U16 < mNbBuffer_U32))
+    {
+      Add(_BufferId_U16);
+      Publish();
+    }
+  }
+
+private:
+  void Add(uint16_t _BufferId_U16)
+  {
+    struct io_uring_buf *pBuf_X = &mpBufRing_X->bufs[mTail_U16 & (mNbBuffer_U32 - 1)];
+
+    pBuf_X->addr = reinterpret_cast<uint64_t>(Buffer(_BufferId_U16));
+    pBuf_X->len = mBufferSizeInByte_U32;
+    pBuf_X->bid = _BufferId_U16;
+    mTail_U16++;
+  }
+
+  void Publish()
+  {
+    __atomic_store_n(&mpBufRing_X->tail, mTail_U16, __ATOMIC_RELEASE);
+  }
+};
+#endif
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,598 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the tagged memory accounting layer: current and
+ * peak bytes per subsystem, per thread counters merged on read, dump and
+ * periodic reporter.
+ *
+ * Name:        bofmemoryaccounting.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/ibofallocator.h>
+#include <bofstd/bofcowlist.h>
+#include <bofstd/bofthread.h>
+#include <bofstd/bofstringformatter.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+const uint32_t BOF_MEMORY_ACCOUNTING_MAX_TAG          = 64;
+const int64_t  BOF_MEMORY_ACCOUNTING_FLUSH_THRESHOLD  = 256 * 1024;   /*! A thread publishes its pending delta to the tag total when it exceeds this (in absolute value) */
+
+/*** Enum *****************************************************************/
+
+//Predefined tags. Other ones are created by BofMemoryAccounting::RegisterTag
+enum BOF_MEMORY_TAG : uint32_t
+{
+  BOF_MEMORY_TAG_OTHER = 0,
+  BOF_MEMORY_TAG_CONTAINER,     /*! Pots, circular buffers, RAM DB, queues */
+  BOF_MEMORY_TAG_SOCKET,        /*! Socket and session buffers */
+  BOF_MEMORY_TAG_LOGGER,        /*! Logger queues */
+  BOF_MEMORY_TAG_ALIGNED,       /*! Bof_AlignedMemAlloc */
+  BOF_MEMORY_TAG_ALLOCATOR,     /*! Slab, arena and huge page pools */
+  BOF_MEMORY_TAG_USER           /*! First tag id given by RegisterTag */
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_MEMORY_ACCOUNTING_ENTRY
+{
+  uint32_t    Tag_U32;
+  std::string Name_S;
+  int64_t     CurrentInByte_S64;    /*! Accounted bytes (all threads merged) plus the sampled ones */
+  int64_t     PeakInByte_S64;
+  int64_t     SampledInByte_S64;    /*! Part of CurrentInByte_S64 given by the samplers */
+  uint64_t    NbAlloc_U64;
+  uint64_t    NbFree_U64;
+
+  BOF_MEMORY_ACCOUNTING_ENTRY()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Tag_U32           = 0;
+    Name_S            = "";
+    CurrentInByte_S64 = 0;
+    PeakInByte_S64    = 0;
+    SampledInByte_S64 = 0;
+    NbAlloc_U64       = 0;
+    NbFree_U64        = 0;
+  }
+};
+
+//Totals published by the threads. Memory can be freed by another thread than the one which allocated it: values are signed.
+struct BOF_MEMORY_ACCOUNTING_TAG
+{
+  char                 pName_c[32];
+  std::atomic<int64_t> CurrentInByte_S64;
+  std::atomic<int64_t> PeakInByte_S64;
+
+  BOF_MEMORY_ACCOUNTING_TAG() : CurrentInByte_S64(0), PeakInByte_S64(0)
+  {
+    pName_c[0] = 0;
+  }
+};
+
+//Owned by one thread which is the only writer (relaxed load/store), read by the snapshot under the registry lock
+struct BOF_MEMORY_ACCOUNTING_THREAD_COUNTER
+{
+  std::atomic<int64_t>  DeltaInByte_S64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+  std::atomic<uint64_t> NbAlloc_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+  std::atomic<uint64_t> NbFree_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+
+  BOF_MEMORY_ACCOUNTING_THREAD_COUNTER()
+  {
+    uint32_t i_U32;
+
+    for (i_U32 = 0; i_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG; i_U32++)
+    {
+      DeltaInByte_S64[i_U32].store(0, std::memory_order_relaxed);
+      NbAlloc_U64[i_U32].store(0, std::memory_order_relaxed);
+      NbFree_U64[i_U32].store(0, std::memory_order_relaxed);
+    }
+  }
+};
+
+//Gives the memory held by an object which cannot report its allocations itself (compiled containers for example)
+struct BOF_MEMORY_ACCOUNTING_SAMPLER
+{
+  uint32_t                  Tag_U32;
+  std::function<uint64_t()> Sampler;
+};
+
+struct BOF_MEMORY_ACCOUNTING_THREAD_HOLDER
+{
+  BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *pCounter_X = nullptr;
+
+  ~BOF_MEMORY_ACCOUNTING_THREAD_HOLDER();
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Tagged memory accounting
+ *
+ * Description
+ * Each subsystem reports its allocations under a tag (BOF_MEMORY_TAG or a tag created by RegisterTag). The hot path
+ * (Account/Unaccount) only updates counters owned by the calling thread; the pending delta of a tag is added to the tag
+ * total once it exceeds BOF_MEMORY_ACCOUNTING_FLUSH_THRESHOLD, which is also where the peak is tracked. A snapshot
+ * merges the tag totals, the pending deltas of all the live threads and the samplers, so the current values are exact
+ * (minus the updates racing with the read) and the peak is exact within NbThread*BOF_MEMORY_ACCOUNTING_FLUSH_THRESHOLD.
+ *
+ * Objects which are compiled in the library (BofPot, BofCircularBuffer, BofRamDb, logger queues...) cannot call
+ * Account themselves: register a sampler which returns their footprint (e.g. capacity * element size). IBofAllocator
+ * based storage (slab, arena, huge page pool, shared buffers) is covered by wrapping the allocator in a
+ * BofAccountingAllocator, aligned allocations by Bof_AccountedAlignedMemAlloc.
+ *
+ * The instance is never destroyed so that thread exit and static destructors can still report.
+ *
+ * See Also
+ * BofAccountingAllocator, BofMemoryAccountingReporter
+ */
+class BofMemoryAccounting
+{
+  friend struct BOF_MEMORY_ACCOUNTING_THREAD_HOLDER;
+
+private:
+  BOF_MEMORY_ACCOUNTING_TAG                           mpTag_X[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+  std::atomic<uint32_t>                               mNbTag_U32;
+  std::atomic<bool>                                   mEnable_B;
+  std::mutex                                          mMtx;
+  std::vector<BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *> mThreadCounterCollection;
+  uint64_t                                            mpExitedNbAlloc_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG];   /*! Counters of the threads which have exited */
+  uint64_t                                            mpExitedNbFree_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+  BofCowList<BOF_MEMORY_ACCOUNTING_SAMPLER>           mSamplerCollection;
+
+  BofMemoryAccounting() : mNbTag_U32(BOF_MEMORY_TAG_USER), mEnable_B(true)
+  {
+    static const char *S_ppTagName_c[BOF_MEMORY_TAG_USER] = {"Other", "Container", "Socket", "Logger", "Aligned", "Allocator"};
+    uint32_t          i_U32;
+
+    for (i_U32 = 0; i_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG; i_U32++)
+    {
+      if (i_U32 < BOF_MEMORY_TAG_USER)
+      {
+        BOF_STRNCPY_NULL_CLIPPED(mpTag_X[i_U32].pName_c, S_ppTagName_c[i_U32], sizeof(mpTag_X[i_U32].pName_c));
+      }
+      mpExitedNbAlloc_U64[i_U32] = 0;
+      mpExitedNbFree_U64[i_U32]  = 0;
+    }
+  }
+
+public:
+  BofMemoryAccounting &operator=(const BofMemoryAccounting &) = delete; // Disallow copying
+  BofMemoryAccounting(const BofMemoryAccounting &) = delete;
+
+  static BofMemoryAccounting &S_Instance()
+  {
+    static BofMemoryAccounting *spInstance = new BofMemoryAccounting();
+    return *spInstance;
+  }
+
+  //When disabled Account/Unaccount return at once. Disabling while memory is accounted makes the totals drift.
+  void Enable(bool _Enable_B) { mEnable_B.store(_Enable_B, std::memory_order_relaxed); }
+  bool IsEnabled() const { return mEnable_B.load(std::memory_order_relaxed); }
+  uint32_t NbTag() const { return mNbTag_U32.load(std::memory_order_acquire); }
+
+  //Returns the tag named _rName_S, creating it if needed
+  BOFERR RegisterTag(const std::string &_rName_S, uint32_t &_rTag_U32)
+  {
+    BOFERR                      Rts_E = BOF_ERR_EINVAL;
+    std::lock_guard<std::mutex> Lock(mMtx);
+    uint32_t                    i_U32, NbTag_U32 = mNbTag_U32.load(std::memory_order_relaxed);
+
+    if (!_rName_S.empty())
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      for (i_U32 = 0; i_U32 < NbTag_U32; i_U32++)
+      {
+        if (_rName_S == mpTag_X[i_U32].pName_c)
+        {
+          _rTag_U32 = i_U32;
+          break;
+        }
+      }
+      if (i_U32 == NbTag_U32)
+      {
+        Rts_E = BOF_ERR_FULL;
+        if (NbTag_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG)
+        {
+          Rts_E = BOF_ERR_NO_ERROR;
+          BOF_STRNCPY_NULL_CLIPPED(mpTag_X[NbTag_U32].pName_c, _rName_S.c_str(), sizeof(mpTag_X[NbTag_U32].pName_c));
+          _rTag_U32 = NbTag_U32;
+          mNbTag_U32.store(NbTag_U32 + 1, std::memory_order_release);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  void Account(uint32_t _Tag_U32, uint64_t _SizeInByte_U64)
+  {
+    BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *pCounter_X;
+
+    if ((IsEnabled()) && (_Tag_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG))
+    {
+      pCounter_X = ThreadCounter();
+      pCounter_X->NbAlloc_U64[_Tag_U32].store(pCounter_X->NbAlloc_U64[_Tag_U32].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      AddDelta(pCounter_X, _Tag_U32, static_cast<int64_t>(_SizeInByte_U64));
+    }
+  }
+
+  void Unaccount(uint32_t _Tag_U32, uint64_t _SizeInByte_U64)
+  {
+    BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *pCounter_X;
+
+    if ((IsEnabled()) && (_Tag_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG))
+    {
+      pCounter_X = ThreadCounter();
+      pCounter_X->NbFree_U64[_Tag_U32].store(pCounter_X->NbFree_U64[_Tag_U32].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      AddDelta(pCounter_X, _Tag_U32, -static_cast<int64_t>(_SizeInByte_U64));
+    }
+  }
+
+  BOFERR RegisterSampler(uint32_t _Tag_U32, const std::function<uint64_t()> &_rSampler, uint32_t &_rSamplerId_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((_Tag_U32 < NbTag()) && (_rSampler))
+    {
+      Rts_E = mSamplerCollection.Insert(BOF_MEMORY_ACCOUNTING_SAMPLER{_Tag_U32, _rSampler}, _rSamplerId_U32);
+    }
+    return Rts_E;
+  }
+
+  BOFERR UnregisterSampler(uint32_t _SamplerId_U32)
+  {
+    return mSamplerCollection.Remove(_SamplerId_U32);
+  }
+
+  /*!
+   * Description
+   * Merges the tag totals, the pending deltas of the live threads and the samplers. The peak of each tag is raised to the
+   * merged current value.
+   *
+   * Parameters
+   * _rEntryCollection: Returns one entry per tag which has been used (or all of them if _All_B is true)
+   * _All_B: Specifies if the tags without any activity must be returned
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Snapshot(std::vector<BOF_MEMORY_ACCOUNTING_ENTRY> &_rEntryCollection, bool _All_B)
+  {
+    uint32_t                    i_U32, NbTag_U32 = NbTag();
+    int64_t                     pCurrent_S64[BOF_MEMORY_ACCOUNTING_MAX_TAG], pSampled_S64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+    uint64_t                    pNbAlloc_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG], pNbFree_U64[BOF_MEMORY_ACCOUNTING_MAX_TAG];
+    BOF_MEMORY_ACCOUNTING_ENTRY Entry_X;
+
+    _rEntryCollection.clear();
+    for (i_U32 = 0; i_U32 < NbTag_U32; i_U32++)
+    {
+      pSampled_S64[i_U32] = 0;
+    }
+    mSamplerCollection.ForEach([&](uint32_t /*_Id_U32*/, const BOF_MEMORY_ACCOUNTING_SAMPLER &_rSampler_X)
+                               { pSampled_S64[_rSampler_X.Tag_U32] += static_cast<int64_t>(_rSampler_X.Sampler()); });
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+
+      for (i_U32 = 0; i_U32 < NbTag_U32; i_U32++)
+      {
+        pCurrent_S64[i_U32] = mpTag_X[i_U32].CurrentInByte_S64.load(std::memory_order_relaxed);
+        pNbAlloc_U64[i_U32] = mpExitedNbAlloc_U64[i_U32];
+        pNbFree_U64[i_U32]  = mpExitedNbFree_U64[i_U32];
+      }
+      for (auto pCounter_X : mThreadCounterCollection)
+      {
+        for (i_U32 = 0; i_U32 < NbTag_U32; i_U32++)
+        {
+          pCurrent_S64[i_U32] += pCounter_X->DeltaInByte_S64[i_U32].load(std::memory_order_relaxed);
+          pNbAlloc_U64[i_U32] += pCounter_X->NbAlloc_U64[i_U32].load(std::memory_order_relaxed);
+          pNbFree_U64[i_U32]  += pCounter_X->NbFree_U64[i_U32].load(std::memory_order_relaxed);
+        }
+      }
+    }
+    for (i_U32 = 0; i_U32 < NbTag_U32; i_U32++)
+    {
+      Entry_X.Tag_U32           = i_U32;
+      Entry_X.Name_S            = mpTag_X[i_U32].pName_c;
+      Entry_X.SampledInByte_S64 = pSampled_S64[i_U32];
+      Entry_X.CurrentInByte_S64 = pCurrent_S64[i_U32] + pSampled_S64[i_U32];
+      Entry_X.NbAlloc_U64       = pNbAlloc_U64[i_U32];
+      Entry_X.NbFree_U64        = pNbFree_U64[i_U32];
+      Entry_X.PeakInByte_S64    = RaisePeak(i_U32, Entry_X.CurrentInByte_S64);
+      if ((_All_B) || (Entry_X.NbAlloc_U64) || (Entry_X.CurrentInByte_S64) || (Entry_X.PeakInByte_S64))
+      {
+        _rEntryCollection.push_back(Entry_X);
+      }
+    }
+    return BOF_ERR_NO_ERROR;
+  }
+
+  BOFERR Entry(uint32_t _Tag_U32, BOF_MEMORY_ACCOUNTING_ENTRY &_rEntry_X)
+  {
+    BOFERR                                   Rts_E = BOF_ERR_EINVAL;
+    std::vector<BOF_MEMORY_ACCOUNTING_ENTRY> EntryCollection;
+
+    if (_Tag_U32 < NbTag())
+    {
+      Rts_E = Snapshot(EntryCollection, true);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        _rEntry_X = EntryCollection[_Tag_U32];
+      }
+    }
+    return Rts_E;
+  }
+
+  //The peaks restart from the current values
+  void ResetPeak()
+  {
+    std::vector<BOF_MEMORY_ACCOUNTING_ENTRY> EntryCollection;
+
+    Snapshot(EntryCollection, true);
+    for (const auto &rEntry_X : EntryCollection)
+    {
+      mpTag_X[rEntry_X.Tag_U32].PeakInByte_S64.store(rEntry_X.CurrentInByte_S64, std::memory_order_relaxed);
+    }
+  }
+
+  std::string MemoryAccountingDump(bool _All_B)
+  {
+    std::string                              Rts_S;
+    std::vector<BOF_MEMORY_ACCOUNTING_ENTRY> EntryCollection;
+    int64_t                                  Current_S64 = 0;
+
+    Snapshot(EntryCollection, _All_B);
+    Rts_S = Bof_Sprintf("%-3s %-31s %16s %16s %16s %12s %12s\n", "Tag", "Name", "Current", "Peak", "Sampled", "NbAlloc", "NbFree");
+    for (const auto &rEntry_X : EntryCollection)
+    {
+      Rts_S += Bof_Sprintf("%-3d %-31s %16lld %16lld %16lld %12lld %12lld\n", rEntry_X.Tag_U32, rEntry_X.Name_S.c_str(), rEntry_X.CurrentInByte_S64, rEntry_X.PeakInByte_S64,
+                           rEntry_X.SampledInByte_S64, rEntry_X.NbAlloc_U64, rEntry_X.NbFree_U64);
+      Current_S64 += rEntry_X.CurrentInByte_S64;
+    }
+    Rts_S += Bof_Sprintf("%-35s %16lld\n", "Total", Current_S64);
+    return Rts_S;
+  }
+
+private:
+  BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *ThreadCounter()
+  {
+    static thread_local BOF_MEMORY_ACCOUNTING_THREAD_HOLDER S_Holder_X;
+
+    if (!S_Holder_X.pCounter_X)
+    {
+      S_Holder_X.pCounter_X = new BOF_MEMORY_ACCOUNTING_THREAD_COUNTER();
+      std::lock_guard<std::mutex> Lock(mMtx);
+      mThreadCounterCollection.push_back(S_Holder_X.pCounter_X);
+    }
+    return S_Holder_X.pCounter_X;
+  }
+
+  void AddDelta(BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *_pCounter_X, uint32_t _Tag_U32, int64_t _Delta_S64)
+  {
+    int64_t Delta_S64 = _pCounter_X->DeltaInByte_S64[_Tag_U32].load(std::memory_order_relaxed) + _Delta_S64;
+
+    if ((Delta_S64 >= BOF_MEMORY_ACCOUNTING_FLUSH_THRESHOLD) || (Delta_S64 <= -BOF_MEMORY_ACCOUNTING_FLUSH_THRESHOLD))
+    {
+      _pCounter_X->DeltaInByte_S64[_Tag_U32].store(0, std::memory_order_relaxed);
+      RaisePeak(_Tag_U32, mpTag_X[_Tag_U32].CurrentInByte_S64.fetch_add(Delta_S64, std::memory_order_relaxed) + Delta_S64);
+    }
+    else
+    {
+      _pCounter_X->DeltaInByte_S64[_Tag_U32].store(Delta_S64, std::memory_order_relaxed);
+    }
+  }
+
+  int64_t RaisePeak(uint32_t _Tag_U32, int64_t _Value_S64)
+  {
+    int64_t Peak_S64 = mpTag_X[_Tag_U32].PeakInByte_S64.load(std::memory_order_relaxed);
+
+    while ((_Value_S64 > Peak_S64) && (!mpTag_X[_Tag_U32].PeakInByte_S64.compare_exchange_weak(Peak_S64, _Value_S64, std::memory_order_relaxed)))
+    {
+    }
+    return (_Value_S64 > Peak_S64) ? _Value_S64 : Peak_S64;
+  }
+
+  //Folds the counters of an exiting thread into the totals
+  void ReleaseThreadCounter(BOF_MEMORY_ACCOUNTING_THREAD_COUNTER *_pCounter_X)
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    uint32_t                    i_U32;
+
+    for (i_U32 = 0; i_U32 < BOF_MEMORY_ACCOUNTING_MAX_TAG; i_U32++)
+    {
+      mpTag_X[i_U32].CurrentInByte_S64.fetch_add(_pCounter_X->DeltaInByte_S64[i_U32].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      mpExitedNbAlloc_U64[i_U32] += _pCounter_X->NbAlloc_U64[i_U32].load(std::memory_order_relaxed);
+      mpExitedNbFree_U64[i_U32]  += _pCounter_X->NbFree_U64[i_U32].load(std::memory_order_relaxed);
+    }
+    mThreadCounterCollection.erase(std::remove(mThreadCounterCollection.begin(), mThreadCounterCollection.end(), _pCounter_X), mThreadCounterCollection.end());
+    delete _pCounter_X;
+  }
+};
+
+inline BOF_MEMORY_ACCOUNTING_THREAD_HOLDER::~BOF_MEMORY_ACCOUNTING_THREAD_HOLDER()
+{
+  if (pCounter_X)
+  {
+    BofMemoryAccounting::S_Instance().ReleaseThreadCounter(pCounter_X);
+    pCounter_X = nullptr;
+  }
+}
+
+/*** Function **************************************************************/
+
+inline void Bof_MemoryAccount(uint32_t _Tag_U32, uint64_t _SizeInByte_U64)
+{
+  BofMemoryAccounting::S_Instance().Account(_Tag_U32, _SizeInByte_U64);
+}
+
+inline void Bof_MemoryUnaccount(uint32_t _Tag_U32, uint64_t _SizeInByte_U64)
+{
+  BofMemoryAccounting::S_Instance().Unaccount(_Tag_U32, _SizeInByte_U64);
+}
+
+//Bof_AlignedMemAlloc accounted under _Tag_U32. The buffer must be released by Bof_AccountedAlignedMemFree with the same tag.
+inline BOFERR Bof_AccountedAlignedMemAlloc(uint32_t _Tag_U32, BOF_BUFFER_ALLOCATE_ZONE _AllocateZone_E, uint32_t _AligmentInByte_U32, uint32_t _SizeInByte_U32, bool _LockIt_B, bool _ClearIt_B,
+                                           BOF_BUFFER &_rAllocatedBuffer_X)
+{
+  BOFERR Rts_E = Bof_AlignedMemAlloc(_AllocateZone_E, _AligmentInByte_U32, _SizeInByte_U32, _LockIt_B, _ClearIt_B, _rAllocatedBuffer_X);
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Bof_MemoryAccount(_Tag_U32, _rAllocatedBuffer_X.Capacity_U64);
+  }
+  return Rts_E;
+}
+
+inline BOFERR Bof_AccountedAlignedMemFree(uint32_t _Tag_U32, BOF_BUFFER &_rBuffer_X)
+{
+  uint64_t Capacity_U64 = _rBuffer_X.Capacity_U64;
+  BOFERR   Rts_E        = Bof_AlignedMemFree(_rBuffer_X);
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Bof_MemoryUnaccount(_Tag_U32, Capacity_U64);
+  }
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Accounting allocator decorator
+ *
+ * Description
+ * Forwards to another IBofAllocator and accounts each successful allocation under a tag. Give it to
+ * Bof_AllocatorBufferAlloc, BofSharedBuffer::S_Create or as the chunk allocator of a BofArenaAllocator to see the
+ * memory of these objects in the BofMemoryAccounting dump.
+ *
+ * See Also
+ * BofMemoryAccounting
+ */
+class BofAccountingAllocator : public IBofAllocator
+{
+private:
+  IBofAllocator *mpAllocator;
+  uint32_t      mTag_U32;
+
+public:
+  BofAccountingAllocator(IBofAllocator *_pAllocator, uint32_t _Tag_U32) : mpAllocator(_pAllocator), mTag_U32(_Tag_U32) {}
+  virtual ~BofAccountingAllocator() {}
+  BofAccountingAllocator &operator=(const BofAccountingAllocator &) = delete; // Disallow copying
+  BofAccountingAllocator(const BofAccountingAllocator &) = delete;
+
+  uint32_t Tag() const { return mTag_U32; }
+
+  void *V_Allocate(uint64_t _SizeInByte_U64) override
+  {
+    void *pRts = mpAllocator ? mpAllocator->V_Allocate(_SizeInByte_U64) : nullptr;
+
+    if (pRts)
+    {
+      Bof_MemoryAccount(mTag_U32, _SizeInByte_U64);
+    }
+    return pRts;
+  }
+
+  void V_Free(void *_pData, uint64_t _SizeInByte_U64) override
+  {
+    if ((mpAllocator) && (_pData))
+    {
+      mpAllocator->V_Free(_pData, _SizeInByte_U64);
+      Bof_MemoryUnaccount(mTag_U32, _SizeInByte_U64);
+    }
+  }
+
+  BOFERR V_Statistic(BOF_ALLOCATOR_STATISTIC &_rStatistic_X) override
+  {
+    return mpAllocator ? mpAllocator->V_Statistic(_rStatistic_X) : BOF_ERR_INIT;
+  }
+
+  const char *V_Name() const override
+  {
+    return mpAllocator ? mpAllocator->V_Name() : "";
+  }
+};
+
+/*!
+ * Summary
+ * Periodic memory accounting reporter
+ *
+ * Description
+ * Calls the report callback with MemoryAccountingDump every _PeriodInMs_U32 ms, from its own low priority thread.
+ *
+ * See Also
+ * BofMemoryAccounting
+ */
+class BofMemoryAccountingReporter : public BofThread
+{
+private:
+  std::function<void(const std::string &)> mOnReport;
+  uint32_t                                 mPeriodInMs_U32 = 0;
+  bool                                     mAll_B = false;
+
+public:
+  BofMemoryAccountingReporter(const std::function<void(const std::string &)> &_rOnReport, uint32_t _PeriodInMs_U32, bool _All_B)
+    : mOnReport(_rOnReport), mPeriodInMs_U32(_PeriodInMs_U32), mAll_B(_All_B)
+  {
+  }
+  virtual ~BofMemoryAccountingReporter()
+  {
+    DestroyBofProcessingThread("~BofMemoryAccountingReporter");
+  }
+  BofMemoryAccountingReporter &operator=(const BofMemoryAccountingReporter &) = delete; // Disallow copying
+  BofMemoryAccountingReporter(const BofMemoryAccountingReporter &) = delete;
+
+  BOFERR Start(const std::string &_rName_S)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((mOnReport) && (mPeriodInMs_U32))
+    {
+      Rts_E = LaunchBofProcessingThread(_rName_S, false, 0, BOF_THREAD_SCHEDULER_POLICY_OTHER, BOF_THREAD_DEFAULT_PRIORITY, 0, 2000, 0);
+    }
+    return Rts_E;
+  }
+
+private:
+  BOFERR V_OnProcessing() override
+  {
+    WaitForThreadWakeUpEvent(mPeriodInMs_U32);
+    if (!IsThreadLoopMustExit())
+    {
+      mOnReport(BofMemoryAccounting::S_Instance().MemoryAccountingDump(mAll_B));
+    }
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <bofstd/bofcowlist.h>
 #include <list>
 #include <mutex>
 
@@ -78,6 +79,56 @@ public:
 
 };
 
+/*!
+ * Summary
+ * Observable with a lock free notification path
+ *
+ * Description
+ * Same contract as BofObservable but the observers are kept in a copy on write list: ObservableNotify walks an immutable
+ * snapshot without locking, RegisterCowObserver/UnregisterCowObserver publish a new one. Use it when notifications are
+ * frequent and registrations rare.
+ * The BofObservable methods are not virtual, so the copy on write list has its own method names instead of hiding them:
+ * RegisterObserver/UnregisterObserver/ObservableNotify keep working on the BofObservable list, which this class never
+ * reads. Use one family or the other for a given object. An observer must be removed with UnregisterCowObserver before it
+ * is destroyed.
+ */
+class BofCowObservable : public BofObservable
+{
+private:
+		onbings::bof::BofCowList<BofObserver *> mObserverCollection;
+
+public:
+		BofCowObservable() {}
+
+		virtual ~BofCowObservable() {}
+
+		void RegisterCowObserver(BofObserver *_pBofObserver_O)
+		{
+			uint32_t Id_U32;
+
+			if (_pBofObserver_O)
+			{
+				mObserverCollection.Insert(_pBofObserver_O, Id_U32);
+			}
+		}
+
+		void UnregisterCowObserver(BofObserver *_pBofObserver_O)
+		{
+			mObserverCollection.RemoveIf([&](uint32_t, BofObserver *_pObserver_O) { return _pObserver_O == _pBofObserver_O; });
+		}
+
+protected:
+		void CowObservableNotify(uint64_t _User_U64, void *_pUser)
+		{
+			onbings::bof::BofCowListReader<BofObserver *> Reader(mObserverCollection);
+
+			for (const auto &rItem_X : Reader)
+			{
+				V_ObserverNotifyAll(rItem_X.Value, _User_U64, _pUser);
+			}
+		}
+};
+
 #if 0
 // Example
 class Barometre:public   BofObservable
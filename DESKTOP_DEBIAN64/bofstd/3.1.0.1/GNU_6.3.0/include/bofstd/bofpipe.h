@@ -37,6 +37,7 @@ enum class BOF_PIPE_TYPE:uint32_t
 	BOF_PIPE_OVER_LOCAL_UDP,
 //	BOF_PIPE_OVER_LOCAL_TCP,
   BOF_PIPE_NATIVE,
+  BOF_PIPE_OVER_SHM,   //Shared memory rings: created by Bof_CreatePipe as a BofShmPipe (bofshmpipe.h), not handled by BofPipe
 };
 /*** structure **************************************************************/
 
@@ -0,0 +1,684 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines a dataflow pipeline made of BofThread stages
+ * connected by bounded BofCircularBuffer links.
+ *
+ * Name:        bofpipeline.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofthread.h>
+#include <bofstd/bofcircularbuffer.h>
+#include <bofstd/bofstatistics.h>
+#include <bofstd/bofstringformatter.h>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+constexpr uint32_t BOF_PIPELINE_ALL_OUTPUT = 0xFFFFFFFF;      /*! Output index meaning "send a copy to every output" */
+constexpr uint32_t BOF_PIPELINE_NO_OUTPUT = 0xFFFFFFFE;       /*! Output index meaning "drop the item" */
+
+/*** Enum *****************************************************************/
+
+enum class BOF_PIPELINE_DISPATCH : uint32_t
+{
+  BROADCAST = 0,              //Each output receives a copy of the item
+  ROUND_ROBIN,                //Items are spread over the outputs
+};
+
+/*** Structure **************************************************************/
+
+//Stage processing function. For a source stage (no input) it must fill _rItem. _rOutput_U32 is preset according to
+//BOF_PIPELINE_STAGE_PARAM::Dispatch_E and can be changed to select an output (index in Connect order), BOF_PIPELINE_ALL_OUTPUT
+//or BOF_PIPELINE_NO_OUTPUT. Return BOF_ERR_NO_ERROR to forward the item, BOF_ERR_EMPTY to drop it silently (filter or source
+//with nothing to produce), BOF_ERR_FINISHED for a source which will not produce anything anymore, any other value is counted as an error.
+template<typename ItemType>
+using BOF_PIPELINE_STAGE_FCT = std::function<BOFERR(uint32_t _Replica_U32, ItemType &_rItem, uint32_t &_rOutput_U32)>;
+
+struct BOF_PIPELINE_STAGE_PARAM
+{
+  std::string           Name_S;
+  BOF_THREAD_PARAM      ThreadParam_X;                /*! SchedulerPolicy_E, Priority_E and AffinityCpuSet_U64 are used for each replica thread */
+  uint32_t              NbReplica_U32;                /*! Number of threads sharing the stage input (parallel stage) */
+  bool                  Ordered_B;                    /*! If true and NbReplica_U32 > 1, items leave the stage in the order they entered it */
+  uint32_t              InputLinkCapacity_U32;        /*! Size of the bounded input link. 0 uses BOF_PIPELINE_PARAM::DefaultLinkCapacity_U32 */
+  BOF_PIPELINE_DISPATCH Dispatch_E;
+  uint32_t              StackSize_U32;
+
+  BOF_PIPELINE_STAGE_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S                = "";
+    ThreadParam_X.Reset();
+    NbReplica_U32         = 1;
+    Ordered_B             = false;
+    InputLinkCapacity_U32 = 0;
+    Dispatch_E            = BOF_PIPELINE_DISPATCH::BROADCAST;
+    StackSize_U32         = 0;
+  }
+};
+
+struct BOF_PIPELINE_PARAM
+{
+  std::string Name_S;
+  uint32_t    DefaultLinkCapacity_U32;                /*! Default number of items in a link */
+  uint32_t    PollTimeoutInMs_U32;                    /*! Wait granularity of the stage threads, bounds the stop latency */
+  uint32_t    StartStopTimeoutInMs_U32;
+
+  BOF_PIPELINE_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S                   = "";
+    DefaultLinkCapacity_U32  = 64;
+    PollTimeoutInMs_U32      = 20;
+    StartStopTimeoutInMs_U32 = 2000;
+  }
+};
+
+struct BOF_PIPELINE_STAGE_STATISTIC
+{
+  uint64_t                    NbItemIn_U64;           /*! Items popped from the input link (or produced by a source) */
+  uint64_t                    NbItemOut_U64;          /*! Items pushed to the output links (one per item, not per copy) */
+  uint64_t                    NbItemDropped_U64;      /*! BOF_ERR_EMPTY or BOF_PIPELINE_NO_OUTPUT */
+  uint64_t                    NbError_U64;
+  uint64_t                    NbBackpressure_U64;     /*! Push to a full downstream link which had to be retried */
+  uint32_t                    InputLevel_U32;         /*! Current input link occupancy */
+  uint32_t                    InputMaxLevel_U32;      /*! Input link high water mark (BofCircularBuffer::GetMaxLevel) */
+  uint32_t                    InputCapacity_U32;
+  uint32_t                    ThroughputPerSec_U32;   /*! NbItemOut_U64 per second since the last ResetStatistic */
+  BOF_STAT_VARIABLE<uint64_t> ProcessingTimeInUs_X;   /*! Time spent in the stage function */
+  BOF_STAT_VARIABLE<uint64_t> LatencyInUs_X;          /*! Time between the item creation by the source and its exit from this stage */
+
+  BOF_PIPELINE_STAGE_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbItemIn_U64         = 0;
+    NbItemOut_U64        = 0;
+    NbItemDropped_U64    = 0;
+    NbError_U64          = 0;
+    NbBackpressure_U64   = 0;
+    InputLevel_U32       = 0;
+    InputMaxLevel_U32    = 0;
+    InputCapacity_U32    = 0;
+    ThroughputPerSec_U32 = 0;
+    ProcessingTimeInUs_X.Reset();
+    LatencyInUs_X.Reset();
+  }
+};
+
+//Envelope travelling in the links
+template<typename ItemType>
+struct BOF_PIPELINE_ENVELOPE
+{
+  uint64_t CreationTimeInUs_U64;
+  uint64_t StageSeq_U64;                              /*! Order of entry in the current stage, used for the reassembly */
+  ItemType Item;
+
+  BOF_PIPELINE_ENVELOPE()
+  {
+    CreationTimeInUs_U64 = 0;
+    StageSeq_U64         = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+template<typename ItemType>
+class BofPipeline;
+
+template<typename ItemType>
+class BofPipelineStage;
+
+//One thread of a stage
+template<typename ItemType>
+class BofPipelineWorker : public BofThread
+{
+private:
+  BofPipelineStage<ItemType> *mpStage;
+  uint32_t                   mReplica_U32;
+
+public:
+  BofPipelineWorker(BofPipelineStage<ItemType> *_pStage, uint32_t _Replica_U32) : mpStage(_pStage), mReplica_U32(_Replica_U32) {}
+  virtual ~BofPipelineWorker()
+  {
+    DestroyBofProcessingThread("~BofPipelineWorker");
+  }
+
+private:
+  BOFERR V_OnProcessing() override
+  {
+    mpStage->ProcessOneItem(this, mReplica_U32);
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+/*!
+ * Summary
+ * Pipeline stage
+ *
+ * Description
+ * A stage owns its input link. Fan-in is obtained by connecting several stages to the same downstream stage: they all push
+ * into its input link. Replicas pop from this shared input; when Ordered_B is set, the items entering the stage are numbered
+ * and a reorder buffer releases them in that order. The number of items in flight is bounded by the reorder window so a slow
+ * replica stalls the others instead of growing the buffer.
+ */
+template<typename ItemType>
+class BofPipelineStage
+{
+  friend class BofPipeline<ItemType>;
+  friend class BofPipelineWorker<ItemType>;
+
+private:
+  BOF_PIPELINE_STAGE_PARAM                                              mStageParam_X;
+  const BOF_PIPELINE_PARAM                                              &mrPipelineParam_X;
+  BOF_PIPELINE_STAGE_FCT<ItemType>                                      mStageFct;
+  std::unique_ptr<BofCircularBuffer<BOF_PIPELINE_ENVELOPE<ItemType>>> mpuInputLink = nullptr;
+  std::vector<BofPipelineStage<ItemType> *>                             mOutputCollection;
+  std::vector<std::unique_ptr<BofPipelineWorker<ItemType>>>             mWorkerCollection;
+  std::atomic<uint32_t>                                                 mRoundRobin;
+  std::atomic<bool>                                                     mSourceFinished;
+  std::atomic<uint32_t>                                                 mNbInFlight;
+
+  std::mutex                                                            mInputMtx;        /*! Pop and StageSeq numbering are atomic */
+  std::atomic<uint64_t>                                                 mNextInSeq_U64;
+  std::mutex                                                            mReorderMtx;
+  std::condition_variable                                               mReorderCv;
+  uint64_t                                                              mNextOutSeq_U64 = 0;
+  std::map<uint64_t, std::pair<bool, BOF_PIPELINE_ENVELOPE<ItemType>>>  mReorderCollection;  /*! StageSeq -> (forward, envelope) */
+  std::map<uint64_t, uint32_t>                                          mReorderOutputCollection;
+
+  std::mutex                                                            mStatMtx;
+  BOF_PIPELINE_STAGE_STATISTIC                                          mStatistic_X;
+  uint32_t                                                              mStatStartInMs_U32;
+
+public:
+  BofPipelineStage(const BOF_PIPELINE_STAGE_PARAM &_rStageParam_X, const BOF_PIPELINE_PARAM &_rPipelineParam_X, BOF_PIPELINE_STAGE_FCT<ItemType> _StageFct)
+    : mStageParam_X(_rStageParam_X), mrPipelineParam_X(_rPipelineParam_X), mStageFct(_StageFct), mRoundRobin(0), mSourceFinished(false), mNbInFlight(0), mNextInSeq_U64(0)
+  {
+    if (mStageParam_X.NbReplica_U32 == 0)
+    {
+      mStageParam_X.NbReplica_U32 = 1;
+    }
+    mStatStartInMs_U32 = Bof_GetMsTickCount();
+  }
+  virtual ~BofPipelineStage()
+  {
+    mWorkerCollection.clear();
+  }
+  BofPipelineStage &operator=(const BofPipelineStage &) = delete; // Disallow copying
+  BofPipelineStage(const BofPipelineStage &) = delete;
+
+  bool IsSource() const { return mpuInputLink == nullptr; }
+  const std::string &Name() const { return mStageParam_X.Name_S; }
+
+private:
+  BOFERR CreateInputLink()
+  {
+    BOFERR                    Rts_E = BOF_ERR_NO_ERROR;
+    BOF_CIRCULAR_BUFFER_PARAM CircularBufferParam_X;
+
+    if (!mpuInputLink)
+    {
+      CircularBufferParam_X.MultiThreadAware_B = true;
+      CircularBufferParam_X.Blocking_B         = true;
+      CircularBufferParam_X.NbMaxElement_U32   = mStageParam_X.InputLinkCapacity_U32 ? mStageParam_X.InputLinkCapacity_U32 : mrPipelineParam_X.DefaultLinkCapacity_U32;
+      mpuInputLink.reset(new BofCircularBuffer<BOF_PIPELINE_ENVELOPE<ItemType>>(CircularBufferParam_X));
+      Rts_E = mpuInputLink->LastErrorCode();
+    }
+    return Rts_E;
+  }
+
+  //Blocking push with backpressure accounting: retried until it succeeds or the worker must exit
+  BOFERR PushToInput(BofThread *_pWorker, const BOF_PIPELINE_ENVELOPE<ItemType> &_rEnvelope_X, uint64_t &_rNbBackpressure_U64)
+  {
+    BOFERR Rts_E;
+
+    do
+    {
+      Rts_E = mpuInputLink->Push(&_rEnvelope_X, mrPipelineParam_X.PollTimeoutInMs_U32, nullptr);
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        _rNbBackpressure_U64++;
+      }
+    } while ((Rts_E != BOF_ERR_NO_ERROR) && (_pWorker) && (!_pWorker->IsThreadLoopMustExit()));
+    return Rts_E;
+  }
+
+  void Emit(BofThread *_pWorker, uint32_t _Output_U32, const BOF_PIPELINE_ENVELOPE<ItemType> &_rEnvelope_X, uint64_t &_rNbBackpressure_U64)
+  {
+    uint32_t i_U32;
+
+    if (_Output_U32 == BOF_PIPELINE_ALL_OUTPUT)
+    {
+      for (i_U32 = 0; i_U32 < mOutputCollection.size(); i_U32++)
+      {
+        mOutputCollection[i_U32]->PushToInput(_pWorker, _rEnvelope_X, _rNbBackpressure_U64);
+      }
+    }
+    else if (_Output_U32 < mOutputCollection.size())
+    {
+      mOutputCollection[_Output_U32]->PushToInput(_pWorker, _rEnvelope_X, _rNbBackpressure_U64);
+    }
+  }
+
+  uint32_t ReorderWindow() const
+  {
+    return mStageParam_X.NbReplica_U32 * 2;
+  }
+
+  void ProcessOneItem(BofThread *_pWorker, uint32_t _Replica_U32)
+  {
+    BOFERR   Sts_E;
+    bool     Forward_B, Reordered_B;
+    uint32_t Output_U32;
+    uint64_t StartInUs_U64, NowInUs_U64, NbBackpressure_U64 = 0;
+    BOF_PIPELINE_ENVELOPE<ItemType> Envelope_X;
+
+    Reordered_B = (mStageParam_X.Ordered_B) && (mStageParam_X.NbReplica_U32 > 1) && (!IsSource());
+    if (Reordered_B)
+    {
+      //Bound the reorder buffer: do not take a new item while too many are in flight
+      std::unique_lock<std::mutex> Lock(mReorderMtx);
+      if (!mReorderCv.wait_for(Lock, std::chrono::milliseconds(mrPipelineParam_X.PollTimeoutInMs_U32), [&] { return (mNextInSeq_U64 - mNextOutSeq_U64) < ReorderWindow(); }))
+      {
+        return;
+      }
+    }
+    if (IsSource())
+    {
+      if (mSourceFinished)
+      {
+        Bof_MsSleep(mrPipelineParam_X.PollTimeoutInMs_U32);
+        return;
+      }
+      Sts_E = BOF_ERR_NO_ERROR;
+      Envelope_X.CreationTimeInUs_U64 = Bof_GetUsTickCount();
+    }
+    else
+    {
+      std::lock_guard<std::mutex> Lock(mInputMtx);
+      Sts_E = mpuInputLink->Pop(&Envelope_X, mrPipelineParam_X.PollTimeoutInMs_U32, nullptr, nullptr);
+      if (Sts_E == BOF_ERR_NO_ERROR)
+      {
+        Envelope_X.StageSeq_U64 = mNextInSeq_U64++;
+      }
+    }
+    if (Sts_E == BOF_ERR_NO_ERROR)
+    {
+      mNbInFlight++;
+      Output_U32 = BOF_PIPELINE_ALL_OUTPUT;
+      if ((mStageParam_X.Dispatch_E == BOF_PIPELINE_DISPATCH::ROUND_ROBIN) && (mOutputCollection.size()))
+      {
+        Output_U32 = mRoundRobin++ % static_cast<uint32_t>(mOutputCollection.size());
+      }
+      StartInUs_U64 = Bof_GetUsTickCount();
+      Sts_E         = mStageFct(_Replica_U32, Envelope_X.Item, Output_U32);
+      NowInUs_U64   = Bof_GetUsTickCount();
+      Forward_B     = (Sts_E == BOF_ERR_NO_ERROR) && (Output_U32 != BOF_PIPELINE_NO_OUTPUT);
+
+      if ((IsSource()) && (Sts_E == BOF_ERR_FINISHED))
+      {
+        mSourceFinished = true;
+      }
+      if ((IsSource()) && (Sts_E != BOF_ERR_NO_ERROR))
+      {
+        //Nothing produced: not an item
+        mNbInFlight--;
+        return;
+      }
+
+      if (Reordered_B)
+      {
+        std::unique_lock<std::mutex> Lock(mReorderMtx);
+        mReorderCollection[Envelope_X.StageSeq_U64] = std::make_pair(Forward_B, Envelope_X);
+        mReorderOutputCollection[Envelope_X.StageSeq_U64] = Output_U32;
+        //Whoever completes the expected item releases all the consecutive ones. Pushing under the lock keeps the order.
+        while ((!mReorderCollection.empty()) && (mReorderCollection.begin()->first == mNextOutSeq_U64))
+        {
+          auto It = mReorderCollection.begin();
+          if (It->second.first)
+          {
+            Emit(_pWorker, mReorderOutputCollection[It->first], It->second.second, NbBackpressure_U64);
+          }
+          mReorderOutputCollection.erase(It->first);
+          mReorderCollection.erase(It);
+          mNextOutSeq_U64++;
+        }
+        Lock.unlock();
+        mReorderCv.notify_all();
+      }
+      else if (Forward_B)
+      {
+        Emit(_pWorker, Output_U32, Envelope_X, NbBackpressure_U64);
+      }
+      mNbInFlight--;
+
+      std::lock_guard<std::mutex> Lock(mStatMtx);
+      mStatistic_X.NbItemIn_U64++;
+      if (Forward_B)
+      {
+        mStatistic_X.NbItemOut_U64++;
+        Bof_UpdateStatVar(mStatistic_X.LatencyInUs_X, NowInUs_U64 - Envelope_X.CreationTimeInUs_U64);
+      }
+      else if ((Sts_E == BOF_ERR_NO_ERROR) || (Sts_E == BOF_ERR_EMPTY))
+      {
+        mStatistic_X.NbItemDropped_U64++;
+      }
+      else
+      {
+        mStatistic_X.NbError_U64++;
+      }
+      mStatistic_X.NbBackpressure_U64 += NbBackpressure_U64;
+      Bof_UpdateStatVar(mStatistic_X.ProcessingTimeInUs_X, NowInUs_U64 - StartInUs_U64);
+    }
+  }
+
+  BOFERR Start()
+  {
+    BOFERR                      Rts_E = BOF_ERR_NO_ERROR;
+    uint32_t                    i_U32;
+    BOF_THREAD_SCHEDULER_POLICY Policy_E;
+
+    Policy_E = (mStageParam_X.ThreadParam_X.SchedulerPolicy_E == BOF_THREAD_SCHEDULER_POLICY_MAX) ? BOF_THREAD_SCHEDULER_POLICY_OTHER : mStageParam_X.ThreadParam_X.SchedulerPolicy_E;
+    for (i_U32 = 0; (i_U32 < mStageParam_X.NbReplica_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+    {
+      mWorkerCollection.emplace_back(new BofPipelineWorker<ItemType>(this, i_U32));
+      Rts_E = mWorkerCollection.back()->LaunchBofProcessingThread(mStageParam_X.Name_S + "_" + std::to_string(i_U32), false, 0, Policy_E, mStageParam_X.ThreadParam_X.Priority_E,
+                                                                  mStageParam_X.ThreadParam_X.AffinityCpuSet_U64, mrPipelineParam_X.StartStopTimeoutInMs_U32, mStageParam_X.StackSize_U32);
+    }
+    return Rts_E;
+  }
+
+  void Stop()
+  {
+    mWorkerCollection.clear();
+  }
+
+  bool IsIdle()
+  {
+    return (mNbInFlight == 0) && ((!mpuInputLink) || (mpuInputLink->IsEmpty()));
+  }
+
+  BOF_PIPELINE_STAGE_STATISTIC Statistic()
+  {
+    BOF_PIPELINE_STAGE_STATISTIC Rts_X;
+    uint32_t                     ElapsedInMs_U32;
+
+    {
+      std::lock_guard<std::mutex> Lock(mStatMtx);
+      Rts_X           = mStatistic_X;
+      ElapsedInMs_U32 = Bof_ElapsedMsTime(mStatStartInMs_U32);
+    }
+    if (mpuInputLink)
+    {
+      Rts_X.InputLevel_U32    = mpuInputLink->GetNbElement();
+      Rts_X.InputMaxLevel_U32 = mpuInputLink->GetMaxLevel();
+      Rts_X.InputCapacity_U32 = mpuInputLink->GetCapacity();
+    }
+    Rts_X.ThroughputPerSec_U32 = ElapsedInMs_U32 ? static_cast<uint32_t>((Rts_X.NbItemOut_U64 * 1000) / ElapsedInMs_U32) : 0;
+    return Rts_X;
+  }
+
+  void ResetStatistic()
+  {
+    std::lock_guard<std::mutex> Lock(mStatMtx);
+    mStatistic_X.Reset();
+    mStatStartInMs_U32 = Bof_GetMsTickCount();
+  }
+};
+
+/*!
+ * Summary
+ * Dataflow pipeline
+ *
+ * Description
+ * Stages are declared with AddStage and connected with Connect. A stage without any incoming connection is a source, a stage
+ * without outgoing connection is a sink. Links are blocking BofCircularBuffer: a full link blocks the upstream stage, which
+ * stops consuming its own input, and so on up to the source (backpressure). ItemType must be default constructible and copyable,
+ * use a (smart) pointer for heavy items.
+ *
+ * Usage
+ * AddStage(capture), AddStage(convert, 4 replicas, Ordered_B), AddStage(encode), AddStage(write)
+ * Connect(capture, convert) Connect(convert, encode) Connect(encode, write) Start()
+ * PipelineDebugInfo() shows for each stage its throughput, latency and input occupancy: the bottleneck is the first stage
+ * whose input link is full while its output link is empty.
+ */
+template<typename ItemType>
+class BofPipeline
+{
+private:
+  BOF_PIPELINE_PARAM                                          mPipelineParam_X;
+  std::vector<std::unique_ptr<BofPipelineStage<ItemType>>>    mStageCollection;
+  bool                                                        mRunning_B = false;
+
+public:
+  BofPipeline(const BOF_PIPELINE_PARAM &_rPipelineParam_X) : mPipelineParam_X(_rPipelineParam_X) {}
+  virtual ~BofPipeline()
+  {
+    Stop();
+  }
+  BofPipeline &operator=(const BofPipeline &) = delete; // Disallow copying
+  BofPipeline(const BofPipeline &) = delete;
+
+  BOFERR AddStage(const BOF_PIPELINE_STAGE_PARAM &_rStageParam_X, BOF_PIPELINE_STAGE_FCT<ItemType> _StageFct, uint32_t &_rStageId_U32);
+  BOFERR Connect(uint32_t _FromStageId_U32, uint32_t _ToStageId_U32);
+  BOFERR Start();
+  BOFERR Stop();
+  BOFERR PushToStage(uint32_t _StageId_U32, const ItemType &_rItem, uint32_t _TimeoutInMs_U32);
+  BOFERR WaitForIdle(uint32_t _PollTimeInMs_U32, uint32_t _TimeoutInMs_U32);
+  BOFERR StageStatistic(uint32_t _StageId_U32, BOF_PIPELINE_STAGE_STATISTIC &_rStatistic_X);
+  BOFERR ResetStatistic();
+  uint32_t NbStage() const;
+  std::string PipelineDebugInfo();
+};
+
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::AddStage(const BOF_PIPELINE_STAGE_PARAM &_rStageParam_X, BOF_PIPELINE_STAGE_FCT<ItemType> _StageFct, uint32_t &_rStageId_U32)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+
+  if (_StageFct)
+  {
+    Rts_E = BOF_ERR_RUNNING;
+    if (!mRunning_B)
+    {
+      Rts_E         = BOF_ERR_NO_ERROR;
+      _rStageId_U32 = static_cast<uint32_t>(mStageCollection.size());
+      mStageCollection.emplace_back(new BofPipelineStage<ItemType>(_rStageParam_X, mPipelineParam_X, _StageFct));
+    }
+  }
+  return Rts_E;
+}
+
+//Several Connect from the same stage is a fan-out, several Connect to the same stage is a fan-in
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::Connect(uint32_t _FromStageId_U32, uint32_t _ToStageId_U32)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+
+  if ((_FromStageId_U32 < mStageCollection.size()) && (_ToStageId_U32 < mStageCollection.size()) && (_FromStageId_U32 != _ToStageId_U32))
+  {
+    Rts_E = BOF_ERR_RUNNING;
+    if (!mRunning_B)
+    {
+      Rts_E = mStageCollection[_ToStageId_U32]->CreateInputLink();
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mStageCollection[_FromStageId_U32]->mOutputCollection.push_back(mStageCollection[_ToStageId_U32].get());
+      }
+    }
+  }
+  return Rts_E;
+}
+
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::Start()
+{
+  BOFERR   Rts_E = BOF_ERR_RUNNING;
+  uint32_t i_U32;
+
+  if (!mRunning_B)
+  {
+    Rts_E      = BOF_ERR_NO_ERROR;
+    mRunning_B = true;
+    //Start from the sinks so that each stage has its consumers running
+    for (i_U32 = static_cast<uint32_t>(mStageCollection.size()); (i_U32 > 0) && (Rts_E == BOF_ERR_NO_ERROR); i_U32--)
+    {
+      Rts_E = mStageCollection[i_U32 - 1]->Start();
+    }
+    if (Rts_E != BOF_ERR_NO_ERROR)
+    {
+      Stop();
+    }
+  }
+  return Rts_E;
+}
+
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::Stop()
+{
+  BOFERR Rts_E = BOF_ERR_NO_ERROR;
+
+  for (auto &rpuStage : mStageCollection)
+  {
+    rpuStage->Stop();
+  }
+  mRunning_B = false;
+  return Rts_E;
+}
+
+//Feed a stage from outside of the pipeline (the stage must have an input link, i.e. be the target of a Connect or not a source)
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::PushToStage(uint32_t _StageId_U32, const ItemType &_rItem, uint32_t _TimeoutInMs_U32)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+  BOF_PIPELINE_ENVELOPE<ItemType> Envelope_X;
+
+  if (_StageId_U32 < mStageCollection.size())
+  {
+    Rts_E = mStageCollection[_StageId_U32]->CreateInputLink();
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Envelope_X.CreationTimeInUs_U64 = Bof_GetUsTickCount();
+      Envelope_X.Item                 = _rItem;
+      Rts_E = mStageCollection[_StageId_U32]->mpuInputLink->Push(&Envelope_X, _TimeoutInMs_U32, nullptr);
+    }
+  }
+  return Rts_E;
+}
+
+//Wait until every link is empty and no item is being processed. Sources are not stopped.
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::WaitForIdle(uint32_t _PollTimeInMs_U32, uint32_t _TimeoutInMs_U32)
+{
+  BOFERR   Rts_E = BOF_ERR_ETIMEDOUT;
+  uint32_t StartInMs_U32 = Bof_GetMsTickCount();
+  bool     Idle_B;
+
+  do
+  {
+    Idle_B = true;
+    for (auto &rpuStage : mStageCollection)
+    {
+      if ((!rpuStage->IsSource()) && (!rpuStage->IsIdle()))
+      {
+        Idle_B = false;
+        break;
+      }
+    }
+    if (Idle_B)
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      break;
+    }
+    Bof_MsSleep(_PollTimeInMs_U32);
+  } while (Bof_ElapsedMsTime(StartInMs_U32) < _TimeoutInMs_U32);
+  return Rts_E;
+}
+
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::StageStatistic(uint32_t _StageId_U32, BOF_PIPELINE_STAGE_STATISTIC &_rStatistic_X)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+
+  if (_StageId_U32 < mStageCollection.size())
+  {
+    Rts_E         = BOF_ERR_NO_ERROR;
+    _rStatistic_X = mStageCollection[_StageId_U32]->Statistic();
+  }
+  return Rts_E;
+}
+
+template<typename ItemType>
+BOFERR BofPipeline<ItemType>::ResetStatistic()
+{
+  for (auto &rpuStage : mStageCollection)
+  {
+    rpuStage->ResetStatistic();
+  }
+  return BOF_ERR_NO_ERROR;
+}
+
+template<typename ItemType>
+uint32_t BofPipeline<ItemType>::NbStage() const
+{
+  return static_cast<uint32_t>(mStageCollection.size());
+}
+
+template<typename ItemType>
+std::string BofPipeline<ItemType>::PipelineDebugInfo()
+{
+  std::string                  Rts_S;
+  uint32_t                     i_U32;
+  BOF_PIPELINE_STAGE_STATISTIC Statistic_X;
+
+  Rts_S = Bof_Sprintf("Pipeline '%s' %d stage(s)\n", mPipelineParam_X.Name_S.c_str(), static_cast<uint32_t>(mStageCollection.size()));
+  for (i_U32 = 0; i_U32 < mStageCollection.size(); i_U32++)
+  {
+    Statistic_X = mStageCollection[i_U32]->Statistic();
+    Rts_S += Bof_Sprintf("%02d %-16s x%d In %lld Out %lld Drop %lld Err %lld %d/s Link %d/%d Max %d BackPres %lld Proc %lld/%lld/%lld us Lat %lld/%lld/%lld us\n", i_U32,
+                         mStageCollection[i_U32]->Name().c_str(), mStageCollection[i_U32]->mStageParam_X.NbReplica_U32, Statistic_X.NbItemIn_U64, Statistic_X.NbItemOut_U64,
+                         Statistic_X.NbItemDropped_U64, Statistic_X.NbError_U64, Statistic_X.ThroughputPerSec_U32, Statistic_X.InputLevel_U32, Statistic_X.InputCapacity_U32,
+                         Statistic_X.InputMaxLevel_U32, Statistic_X.NbBackpressure_U64, Statistic_X.ProcessingTimeInUs_X.Min, Statistic_X.ProcessingTimeInUs_X.Mean,
+                         Statistic_X.ProcessingTimeInUs_X.Max, Statistic_X.LatencyInUs_X.Min, Statistic_X.LatencyInUs_X.Mean, Statistic_X.LatencyInUs_X.Max);
+  }
+  return Rts_S;
+}
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,531 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines real-time helpers: SCHED_DEADLINE scheduling with
+ * fallback, one-call process preparation (memory locking and prefaulting)
+ * and per thread page fault/context switch accounting.
+ *
+ * Name:        bofrealtime.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         SCHED_DEADLINE and getrusage(RUSAGE_THREAD) only exist on Linux,
+ *              the other platforms return BOF_ERR_NOT_SUPPORTED.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofthread.h>
+#include <bofstd/bofstringformatter.h>
+#include <mutex>
+#if !defined (_WIN32)
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <alloca.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if !defined (_WIN32)
+#if !defined(SCHED_DEADLINE)
+#define SCHED_DEADLINE 6
+#endif
+#if !defined(SCHED_FLAG_RESET_ON_FORK)
+#define SCHED_FLAG_RESET_ON_FORK 0x01
+#endif
+#endif
+
+/*** Enum *****************************************************************/
+
+enum class BOF_REALTIME_SCHEDULING : uint32_t
+{
+  NONE = 0,                   //Nothing could be applied, the thread keeps its previous policy
+  DEADLINE,                   //SCHED_DEADLINE is active
+  FALLBACK,                   //SCHED_DEADLINE has been refused, FallbackPolicy_E/FallbackPriority_E are active
+};
+
+/*** Structure **************************************************************/
+
+//Kernel ABI of sched_setattr (not exported by every glibc)
+struct BOF_SCHED_ATTR
+{
+  uint32_t Size_U32;
+  uint32_t Policy_U32;
+  uint64_t Flag_U64;
+  int32_t  Nice_S32;
+  uint32_t Priority_U32;
+  uint64_t RuntimeInNs_U64;
+  uint64_t DeadlineInNs_U64;
+  uint64_t PeriodInNs_U64;
+};
+
+//The kernel admits the thread only if RuntimeInNs_U64 <= DeadlineInNs_U64 <= PeriodInNs_U64 and the sum of the
+//Runtime/Period ratios stays below the rt bandwidth (/proc/sys/kernel/sched_rt_runtime_us). A deadline thread must
+//be allowed to run on all the cpus of its root domain: use cpusets instead of an affinity mask.
+struct BOF_THREAD_DEADLINE_PARAM
+{
+  uint64_t                    RuntimeInNs_U64;        /*! Cpu budget per period */
+  uint64_t                    DeadlineInNs_U64;       /*! Relative deadline, 0 means equal to the period */
+  uint64_t                    PeriodInNs_U64;
+  BOF_THREAD_SCHEDULER_POLICY FallbackPolicy_E;       /*! Used if SCHED_DEADLINE is refused (no CAP_SYS_NICE, bandwidth exceeded, old kernel) */
+  BOF_THREAD_PRIORITY         FallbackPriority_E;
+
+  BOF_THREAD_DEADLINE_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    RuntimeInNs_U64    = 0;
+    DeadlineInNs_U64   = 0;
+    PeriodInNs_U64     = 0;
+    FallbackPolicy_E   = BOF_THREAD_SCHEDULER_POLICY_FIFO;
+    FallbackPriority_E = BOF_THREAD_PRIORITY_050;
+  }
+};
+
+struct BOF_THREAD_RT_STAT
+{
+  uint64_t NbMinorFault_U64;
+  uint64_t NbMajorFault_U64;
+  uint64_t NbVoluntaryCtxSwitch_U64;
+  uint64_t NbInvoluntaryCtxSwitch_U64;
+
+  BOF_THREAD_RT_STAT()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbMinorFault_U64           = 0;
+    NbMajorFault_U64           = 0;
+    NbVoluntaryCtxSwitch_U64   = 0;
+    NbInvoluntaryCtxSwitch_U64 = 0;
+  }
+};
+
+struct BOF_REALTIME_PARAM
+{
+  uint32_t StackPrefaultInByte_U32;                   /*! Stack of the calling thread to prefault (see also Bof_PrefaultCurrentThreadStack) */
+  uint64_t HeapReserveInByte_U64;                     /*! Heap to prefault and keep in the malloc arena */
+
+  BOF_REALTIME_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    StackPrefaultInByte_U32 = 512 * 1024;
+    HeapReserveInByte_U64   = 64 * 1024 * 1024;
+  }
+};
+
+struct BOF_REALTIME_STATUS
+{
+  bool               RealTimeReady_B;                 /*! All the memory of the process is locked and prefaulted */
+  BOFERR             LockRamError_E;
+  uint64_t           LockedMemoryInByte_U64;          /*! VmLck of /proc/self/status */
+  BOF_THREAD_RT_STAT PrepareStat_X;                   /*! Faults and context switches of the process generated by the preparation */
+
+  BOF_REALTIME_STATUS()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    RealTimeReady_B        = false;
+    LockRamError_E         = BOF_ERR_NO_ERROR;
+    LockedMemoryInByte_U64 = 0;
+    PrepareStat_X.Reset();
+  }
+};
+
+/*** Function **************************************************************/
+
+#if !defined (_WIN32)
+inline BOFERR Bof_RusageToRtStat(bool _Thread_B, BOF_THREAD_RT_STAT &_rStat_X)
+{
+  BOFERR        Rts_E = BOF_ERR_EINVAL;
+  struct rusage Usage_X;
+
+  if (getrusage(_Thread_B ? RUSAGE_THREAD : RUSAGE_SELF, &Usage_X) == 0)
+  {
+    Rts_E                                = BOF_ERR_NO_ERROR;
+    _rStat_X.NbMinorFault_U64           = static_cast<uint64_t>(Usage_X.ru_minflt);
+    _rStat_X.NbMajorFault_U64           = static_cast<uint64_t>(Usage_X.ru_majflt);
+    _rStat_X.NbVoluntaryCtxSwitch_U64   = static_cast<uint64_t>(Usage_X.ru_nvcsw);
+    _rStat_X.NbInvoluntaryCtxSwitch_U64 = static_cast<uint64_t>(Usage_X.ru_nivcsw);
+  }
+  return Rts_E;
+}
+#endif
+
+/*!
+ * Description
+ * Returns the page fault and context switch counters of the calling thread (getrusage(RUSAGE_THREAD)).
+ *
+ * Parameters
+ * _rStat_X: Returns the counters since the thread creation
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+ */
+inline BOFERR Bof_GetCurrentThreadRtStat(BOF_THREAD_RT_STAT &_rStat_X)
+{
+#if defined (_WIN32)
+  _rStat_X.Reset();
+  return BOF_ERR_NOT_SUPPORTED;
+#else
+  return Bof_RusageToRtStat(true, _rStat_X);
+#endif
+}
+
+inline BOF_THREAD_RT_STAT Bof_RtStatDelta(const BOF_THREAD_RT_STAT &_rNew_X, const BOF_THREAD_RT_STAT &_rOld_X)
+{
+  BOF_THREAD_RT_STAT Rts_X;
+
+  Rts_X.NbMinorFault_U64           = _rNew_X.NbMinorFault_U64 - _rOld_X.NbMinorFault_U64;
+  Rts_X.NbMajorFault_U64           = _rNew_X.NbMajorFault_U64 - _rOld_X.NbMajorFault_U64;
+  Rts_X.NbVoluntaryCtxSwitch_U64   = _rNew_X.NbVoluntaryCtxSwitch_U64 - _rOld_X.NbVoluntaryCtxSwitch_U64;
+  Rts_X.NbInvoluntaryCtxSwitch_U64 = _rNew_X.NbInvoluntaryCtxSwitch_U64 - _rOld_X.NbInvoluntaryCtxSwitch_U64;
+  return Rts_X;
+}
+
+/*!
+ * Description
+ * Applies SCHED_DEADLINE to the calling thread. If the kernel refuses it (EPERM without CAP_SYS_NICE, EBUSY when the
+ * deadline bandwidth is exhausted, ENOSYS/EINVAL on old kernels), the fallback fixed priority policy is applied instead.
+ * sched_setattr only works on a tid, so this must be called from the thread itself: BofRtThread does it in V_OnCreate and
+ * a thread started with Bof_LaunchThread can call it first thing in its thread function.
+ *
+ * Parameters
+ * _rDeadlineParam_X: Specifies the deadline parameters and the fallback policy
+ * _rApplied_E: Returns the scheduling really in effect
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if either the deadline or the fallback policy has been applied, BOF_ERR_EINVAL if the
+ * fallback priority is out of the range of the fallback policy
+ */
+inline BOFERR Bof_SetCurrentThreadDeadline(const BOF_THREAD_DEADLINE_PARAM &_rDeadlineParam_X, BOF_REALTIME_SCHEDULING &_rApplied_E)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+
+  _rApplied_E = BOF_REALTIME_SCHEDULING::NONE;
+  if ((_rDeadlineParam_X.RuntimeInNs_U64) && (_rDeadlineParam_X.PeriodInNs_U64))
+  {
+#if !defined (_WIN32)
+    BOF_SCHED_ATTR     Attr_X;
+    struct sched_param SchedParam_X;
+    int                Policy_i;
+
+    memset(&Attr_X, 0, sizeof(Attr_X));
+    Attr_X.Size_U32         = sizeof(Attr_X);
+    Attr_X.Policy_U32       = SCHED_DEADLINE;
+    Attr_X.Flag_U64         = SCHED_FLAG_RESET_ON_FORK;     //A child of a deadline thread would otherwise inherit the reservation
+    Attr_X.RuntimeInNs_U64  = _rDeadlineParam_X.RuntimeInNs_U64;
+    Attr_X.DeadlineInNs_U64 = _rDeadlineParam_X.DeadlineInNs_U64 ? _rDeadlineParam_X.DeadlineInNs_U64 : _rDeadlineParam_X.PeriodInNs_U64;
+    Attr_X.PeriodInNs_U64   = _rDeadlineParam_X.PeriodInNs_U64;
+    if ((Attr_X.RuntimeInNs_U64 <= Attr_X.DeadlineInNs_U64) && (Attr_X.DeadlineInNs_U64 <= Attr_X.PeriodInNs_U64))
+    {
+#if defined(SYS_sched_setattr)
+      if (syscall(SYS_sched_setattr, 0, &Attr_X, 0) == 0)
+      {
+        Rts_E       = BOF_ERR_NO_ERROR;
+        _rApplied_E = BOF_REALTIME_SCHEDULING::DEADLINE;
+      }
+      else
+#endif
+      {
+        Policy_i = (_rDeadlineParam_X.FallbackPolicy_E == BOF_THREAD_SCHEDULER_POLICY_ROUND_ROBIN) ? SCHED_RR : (_rDeadlineParam_X.FallbackPolicy_E == BOF_THREAD_SCHEDULER_POLICY_FIFO) ? SCHED_FIFO : SCHED_OTHER;
+        //BOF_THREAD_DEFAULT_PRIORITY is not a valid sched_priority: it stands for the lowest one of the policy
+        SchedParam_X.sched_priority = (_rDeadlineParam_X.FallbackPriority_E == BOF_THREAD_DEFAULT_PRIORITY) ? sched_get_priority_min(Policy_i) : static_cast<int>(_rDeadlineParam_X.FallbackPriority_E);
+        if (Policy_i == SCHED_OTHER)
+        {
+          SchedParam_X.sched_priority = 0;
+        }
+        Rts_E = BOF_ERR_EINVAL;
+        if ((SchedParam_X.sched_priority >= sched_get_priority_min(Policy_i)) && (SchedParam_X.sched_priority <= sched_get_priority_max(Policy_i)))
+        {
+          Rts_E = BOF_ERR_EPERM;
+          if (pthread_setschedparam(pthread_self(), Policy_i, &SchedParam_X) == 0)
+          {
+            Rts_E       = BOF_ERR_NO_ERROR;
+            _rApplied_E = BOF_REALTIME_SCHEDULING::FALLBACK;
+          }
+        }
+      }
+    }
+#else
+    Rts_E = BOF_ERR_NOT_SUPPORTED;
+#endif
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Touches each page of a stack area of the calling thread so that, once the memory is locked, the thread never takes a
+ * page fault when its call depth grows. Must be called from the thread which will use the stack.
+ *
+ * Parameters
+ * _StackSizeInByte_U32: Specifies the number of bytes to prefault. Keep it below the thread stack size.
+ *
+ * Returns
+ * None
+ */
+inline void Bof_PrefaultCurrentThreadStack(uint32_t _StackSizeInByte_U32)
+{
+#if !defined (_WIN32)
+  volatile uint8_t *pStack_U8;
+  uint32_t         i_U32, PageSize_U32;
+
+  if (_StackSizeInByte_U32)
+  {
+    PageSize_U32 = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    pStack_U8    = static_cast<volatile uint8_t *>(alloca(_StackSizeInByte_U32));
+    for (i_U32 = 0; i_U32 < _StackSizeInByte_U32; i_U32 += PageSize_U32)
+    {
+      pStack_U8[i_U32] = 0;
+    }
+  }
+#endif
+}
+
+inline uint64_t Bof_LockedMemoryInByte()
+{
+  uint64_t Rts_U64 = 0;
+#if !defined (_WIN32)
+  FILE          *pIo_X;
+  char          pLine_c[128];
+  unsigned long long Val_ULL;
+
+  pIo_X = fopen("/proc/self/status", "r");
+  if (pIo_X)
+  {
+    while (fgets(pLine_c, sizeof(pLine_c), pIo_X))
+    {
+      if (sscanf(pLine_c, "VmLck: %llu kB", &Val_ULL) == 1)
+      {
+        Rts_U64 = static_cast<uint64_t>(Val_ULL) * 1024;
+        break;
+      }
+    }
+    fclose(pIo_X);
+  }
+#endif
+  return Rts_U64;
+}
+
+/*!
+ * Description
+ * Puts the process in a real-time ready state in one call. It relies on Bof_LockRam (mlockall(MCL_CURRENT|MCL_FUTURE),
+ * malloc trimming and mmap disabled, heap reserve prefaulted) and then prefaults the stack of the calling thread and
+ * measures the result. Other real-time threads should call Bof_PrefaultCurrentThreadStack at startup (BofRtThread does it).
+ *
+ * Parameters
+ * _rRealTimeParam_X: Specifies the amount of stack and heap to prefault
+ * _rStatus_X: Returns the real-time readiness and the cost of the preparation
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+ */
+inline BOFERR Bof_PrepareRealTime(const BOF_REALTIME_PARAM &_rRealTimeParam_X, BOF_REALTIME_STATUS &_rStatus_X)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+
+  _rStatus_X.Reset();
+#if !defined (_WIN32)
+  BOF_THREAD_RT_STAT Start_X, End_X;
+
+  Bof_RusageToRtStat(false, Start_X);
+  Rts_E = Bof_LockRam(_rRealTimeParam_X.StackPrefaultInByte_U32, _rRealTimeParam_X.HeapReserveInByte_U64);
+  _rStatus_X.LockRamError_E = Rts_E;
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    //Bof_LockRam prefaults the stack in its own frame, redo it from here so that the caller's frame is covered too
+    Bof_PrefaultCurrentThreadStack(_rRealTimeParam_X.StackPrefaultInByte_U32);
+    _rStatus_X.LockedMemoryInByte_U64 = Bof_LockedMemoryInByte();
+    _rStatus_X.RealTimeReady_B        = (_rStatus_X.LockedMemoryInByte_U64 != 0);
+    if (!_rStatus_X.RealTimeReady_B)
+    {
+      Rts_E = BOF_ERR_LOCK;
+    }
+  }
+  Bof_RusageToRtStat(false, End_X);
+  _rStatus_X.PrepareStat_X = Bof_RtStatDelta(End_X, Start_X);
+#endif
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Real-time BofThread
+ *
+ * Description
+ * BofThread whose processing loop runs under SCHED_DEADLINE (or the fallback policy) with a prefaulted stack. The page
+ * faults and involuntary context switches taken by each V_OnRtProcessing call are accumulated so that a thread which is
+ * not real-time clean is visible before frames are dropped.
+ *
+ * See Also
+ * Bof_PrepareRealTime
+ */
+class BofRtThread : public BofThread
+{
+private:
+  BOF_THREAD_DEADLINE_PARAM mDeadlineParam_X;
+  uint32_t                  mStackPrefaultInByte_U32 = 0;
+  BOF_REALTIME_SCHEDULING   mApplied_E = BOF_REALTIME_SCHEDULING::NONE;
+  BOFERR                    mSchedulingError_E = BOF_ERR_INIT;
+  std::mutex                mStatMtx;
+  BOF_THREAD_RT_STAT        mLast_X;
+  BOF_THREAD_RT_STAT        mTotal_X;                 /*! Since the end of V_OnCreate */
+  uint64_t                  mNbLoop_U64 = 0;
+  uint64_t                  mNbLoopWithFault_U64 = 0;       /*! Loops which took at least one page fault */
+  uint64_t                  mNbLoopWithPreemption_U64 = 0;  /*! Loops which have been involuntarily preempted */
+
+public:
+  BofRtThread() {}
+  virtual ~BofRtThread()
+  {
+    DestroyBofProcessingThread("~BofRtThread");
+  }
+
+  /*!
+   * Description
+   * Launches the thread. When _rDeadlineParam_X.RuntimeInNs_U64 is 0 the thread is launched with the fallback policy
+   * and priority, otherwise it switches itself to SCHED_DEADLINE in V_OnCreate.
+   *
+   * Parameters
+   * _rName_S: Specifies the thread name
+   * _rDeadlineParam_X: Specifies the deadline parameters
+   * _StackPrefaultInByte_U32: Specifies the part of the stack to prefault before the loop starts
+   * _ThreadCpuCoreAffinityMask_U64: Specifies the affinity, leave it to 0 for a deadline thread
+   * _StartStopTimeoutInMs_U32: Specifies the start and stop timeout
+   * _StackSize_U32: Specifies the thread stack size
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR LaunchBofRtThread(const std::string &_rName_S, const BOF_THREAD_DEADLINE_PARAM &_rDeadlineParam_X, uint32_t _StackPrefaultInByte_U32, uint64_t _ThreadCpuCoreAffinityMask_U64,
+                           uint32_t _StartStopTimeoutInMs_U32, uint32_t _StackSize_U32)
+  {
+    bool Deadline_B;
+
+    mDeadlineParam_X         = _rDeadlineParam_X;
+    mStackPrefaultInByte_U32 = _StackPrefaultInByte_U32;
+    Deadline_B               = (_rDeadlineParam_X.RuntimeInNs_U64 != 0);
+    return LaunchBofProcessingThread(_rName_S, false, 0, Deadline_B ? BOF_THREAD_SCHEDULER_POLICY_OTHER : _rDeadlineParam_X.FallbackPolicy_E,
+                                     Deadline_B ? BOF_THREAD_DEFAULT_PRIORITY : _rDeadlineParam_X.FallbackPriority_E, _ThreadCpuCoreAffinityMask_U64, _StartStopTimeoutInMs_U32, _StackSize_U32);
+  }
+
+  //Scheduling really obtained, valid once the thread is running
+  BOF_REALTIME_SCHEDULING AppliedScheduling(BOFERR &_rSchedulingError_E) const
+  {
+    _rSchedulingError_E = mSchedulingError_E;
+    return mApplied_E;
+  }
+
+  void RtStatistic(BOF_THREAD_RT_STAT &_rTotal_X, uint64_t &_rNbLoop_U64, uint64_t &_rNbLoopWithFault_U64, uint64_t &_rNbLoopWithPreemption_U64)
+  {
+    std::lock_guard<std::mutex> Lock(mStatMtx);
+    _rTotal_X                  = mTotal_X;
+    _rNbLoop_U64               = mNbLoop_U64;
+    _rNbLoopWithFault_U64      = mNbLoopWithFault_U64;
+    _rNbLoopWithPreemption_U64 = mNbLoopWithPreemption_U64;
+  }
+
+  std::string RtThreadDebugInfo()
+  {
+    BOF_THREAD_RT_STAT Total_X;
+    uint64_t           NbLoop_U64, NbFault_U64, NbPreempt_U64;
+
+    RtStatistic(Total_X, NbLoop_U64, NbFault_U64, NbPreempt_U64);
+    return Bof_Sprintf("Sched %s Loop %lld MinFlt %lld MajFlt %lld (%lld loop) NivCsw %lld (%lld loop) NvCsw %lld\n",
+                       (mApplied_E == BOF_REALTIME_SCHEDULING::DEADLINE) ? "Deadline" : (mApplied_E == BOF_REALTIME_SCHEDULING::FALLBACK) ? "Fallback" : "None",
+                       NbLoop_U64, Total_X.NbMinorFault_U64, Total_X.NbMajorFault_U64, NbFault_U64, Total_X.NbInvoluntaryCtxSwitch_U64, NbPreempt_U64, Total_X.NbVoluntaryCtxSwitch_U64);
+  }
+
+protected:
+  //One period of work. A deadline thread should end it with sched_yield() (S_RtYield) to give back its remaining budget.
+  virtual BOFERR V_OnRtProcessing() = 0;
+
+  static void S_RtYield()
+  {
+#if !defined (_WIN32)
+    sched_yield();
+#endif
+  }
+
+  BOFERR V_OnCreate() override
+  {
+    if (mDeadlineParam_X.RuntimeInNs_U64)
+    {
+      mSchedulingError_E = Bof_SetCurrentThreadDeadline(mDeadlineParam_X, mApplied_E);
+    }
+    else
+    {
+      mSchedulingError_E = BOF_ERR_NO_ERROR;
+      mApplied_E         = BOF_REALTIME_SCHEDULING::FALLBACK;
+    }
+    Bof_PrefaultCurrentThreadStack(mStackPrefaultInByte_U32);
+    Bof_GetCurrentThreadRtStat(mLast_X);
+    return BOF_ERR_NO_ERROR;
+  }
+
+private:
+  BOFERR V_OnProcessing() override
+  {
+    BOFERR             Rts_E;
+    BOF_THREAD_RT_STAT Now_X, Delta_X;
+
+    Rts_E = V_OnRtProcessing();
+    Bof_GetCurrentThreadRtStat(Now_X);
+    Delta_X = Bof_RtStatDelta(Now_X, mLast_X);
+    mLast_X = Now_X;
+
+    std::lock_guard<std::mutex> Lock(mStatMtx);
+    mNbLoop_U64++;
+    if (Delta_X.NbMinorFault_U64 || Delta_X.NbMajorFault_U64)
+    {
+      mNbLoopWithFault_U64++;
+    }
+    if (Delta_X.NbInvoluntaryCtxSwitch_U64)
+    {
+      mNbLoopWithPreemption_U64++;
+    }
+    mTotal_X.NbMinorFault_U64           += Delta_X.NbMinorFault_U64;
+    mTotal_X.NbMajorFault_U64           += Delta_X.NbMajorFault_U64;
+    mTotal_X.NbVoluntaryCtxSwitch_U64   += Delta_X.NbVoluntaryCtxSwitch_U64;
+    mTotal_X.NbInvoluntaryCtxSwitch_U64 += Delta_X.NbInvoluntaryCtxSwitch_U64;
+    return Rts_E;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines reference counted buffers which can be sliced and
+ * chained without copying the data.
+ *
+ * Name:        bofsharedbuffer.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/ibofallocator.h>
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <string.h>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+constexpr uint32_t BOF_SHARED_BUFFER_HEADER_SIZE = 64;        /*! Storage header size: keeps the data 64 bytes aligned when it follows the header */
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SHARED_BUFFER_STORAGE_TYPE : uint32_t
+{
+  INLINE_HEAP = 0,            //Header and data in one new uint8_t[]
+  INLINE_ALLOCATOR,           //Header and data in one IBofAllocator block
+  ADOPTED_ARRAY,              //Data adopted from a BOF_BUFFER with MustBeDeleted_B (delete[])
+  ADOPTED_ALLOCATOR,          //Data adopted from a BOF_BUFFER built by Bof_AllocatorBufferAlloc
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SHARED_BUFFER_STORAGE
+{
+  std::atomic<uint32_t>          NbRef_U32;
+  BOF_SHARED_BUFFER_STORAGE_TYPE Type_E;
+  IBofAllocator                  *pAllocator;
+  uint8_t                        *pData_U8;
+  uint64_t                       Capacity_U64;
+};
+static_assert(sizeof(BOF_SHARED_BUFFER_STORAGE) <= BOF_SHARED_BUFFER_HEADER_SIZE, "BOF_SHARED_BUFFER_HEADER_SIZE is too small");
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Reference counted buffer slice
+ *
+ * Description
+ * A BofSharedBuffer is a view (offset, size) on a reference counted storage with a 64 bit capacity. Copying or slicing it
+ * only increments the reference count; the storage is released when the last view goes away, and given back to the
+ * allocator it comes from (a BofSlabAllocator for example) so that a received packet can be parsed, logged and forwarded
+ * without any copy. The storage must be considered read only as soon as it is shared (see IsUnique).
+ * A view is not thread safe but different views on the same storage can be used and released by different threads.
+ *
+ * See Also
+ * BofSharedBufferChain
+ */
+class BofSharedBuffer
+{
+private:
+  BOF_SHARED_BUFFER_STORAGE *mpStorage_X = nullptr;
+  uint64_t                  mOffset_U64 = 0;
+  uint64_t                  mSize_U64 = 0;
+
+public:
+  BofSharedBuffer() {}
+  BofSharedBuffer(const BofSharedBuffer &_rOther) : mpStorage_X(_rOther.mpStorage_X), mOffset_U64(_rOther.mOffset_U64), mSize_U64(_rOther.mSize_U64)
+  {
+    AddRef();
+  }
+  BofSharedBuffer(BofSharedBuffer &&_rrOther) : mpStorage_X(_rrOther.mpStorage_X), mOffset_U64(_rrOther.mOffset_U64), mSize_U64(_rrOther.mSize_U64)
+  {
+    _rrOther.mpStorage_X = nullptr;
+    _rrOther.mOffset_U64 = 0;
+    _rrOther.mSize_U64   = 0;
+  }
+  BofSharedBuffer &operator=(const BofSharedBuffer &_rOther)
+  {
+    if (this != &_rOther)
+    {
+      BofSharedBuffer Copy(_rOther);
+      Swap(Copy);
+    }
+    return *this;
+  }
+  BofSharedBuffer &operator=(BofSharedBuffer &&_rrOther)
+  {
+    if (this != &_rrOther)
+    {
+      Release();
+      Swap(_rrOther);
+    }
+    return *this;
+  }
+  virtual ~BofSharedBuffer()
+  {
+    Release();
+  }
+
+  /*!
+   * Description
+   * Allocates a new storage. The header and the data are allocated in a single block, from _pAllocator if given.
+   *
+   * Parameters
+   * _Capacity_U64: Specifies the storage capacity
+   * _pAllocator: Specifies the allocator to use or nullptr for the heap
+   * _rBuffer: Returns a view on the whole storage with a size of 0
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  static BOFERR S_Create(uint64_t _Capacity_U64, IBofAllocator *_pAllocator, BofSharedBuffer &_rBuffer)
+  {
+    BOFERR                    Rts_E = BOF_ERR_EINVAL;
+    uint8_t                   *pBlock_U8;
+    BOF_SHARED_BUFFER_STORAGE *pStorage_X;
+
+    _rBuffer.Release();
+    if (_Capacity_U64)
+    {
+      Rts_E     = BOF_ERR_ENOMEM;
+      pBlock_U8 = _pAllocator ? static_cast<uint8_t *>(_pAllocator->V_Allocate(BOF_SHARED_BUFFER_HEADER_SIZE + _Capacity_U64))
+                              : new (std::nothrow) uint8_t[static_cast<size_t>(BOF_SHARED_BUFFER_HEADER_SIZE + _Capacity_U64)];
+      if (pBlock_U8)
+      {
+        Rts_E                    = BOF_ERR_NO_ERROR;
+        pStorage_X               = new (pBlock_U8) BOF_SHARED_BUFFER_STORAGE();
+        pStorage_X->NbRef_U32.store(1);
+        pStorage_X->Type_E       = _pAllocator ? BOF_SHARED_BUFFER_STORAGE_TYPE::INLINE_ALLOCATOR : BOF_SHARED_BUFFER_STORAGE_TYPE::INLINE_HEAP;
+        pStorage_X->pAllocator   = _pAllocator;
+        pStorage_X->pData_U8     = pBlock_U8 + BOF_SHARED_BUFFER_HEADER_SIZE;
+        pStorage_X->Capacity_U64 = _Capacity_U64;
+        _rBuffer.mpStorage_X     = pStorage_X;
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Takes the ownership of the storage of a BOF_BUFFER (from BofSocketIo::TransferDataBufferOwnershipTo for example).
+   * Supported are the buffers owning their storage (MustBeDeleted_B) and the ones built by Bof_AllocatorBufferAlloc
+   * (recognized by Bof_AllocatorOfBuffer). Any other buffer (Bof_AlignedMemAlloc, external storage) is refused with
+   * BOF_ERR_EINVAL. _rBofBuffer_X is reset on success.
+   *
+   * Parameters
+   * _rBofBuffer_X: Specifies the buffer to adopt
+   * _rBuffer: Returns a view on the adopted data (size is _rBofBuffer_X.Size_U64)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  static BOFERR S_Adopt(BOF_BUFFER &_rBofBuffer_X, BofSharedBuffer &_rBuffer)
+  {
+    BOFERR                    Rts_E = BOF_ERR_EINVAL;
+    BOF_SHARED_BUFFER_STORAGE *pStorage_X;
+    IBofAllocator             *pAllocator = Bof_AllocatorOfBuffer(_rBofBuffer_X);
+
+    _rBuffer.Release();
+    if ((_rBofBuffer_X.pData_U8) && ((_rBofBuffer_X.MustBeDeleted_B) || (pAllocator)))
+    {
+      Rts_E      = BOF_ERR_ENOMEM;
+      pStorage_X = new (std::nothrow) BOF_SHARED_BUFFER_STORAGE();
+      if (pStorage_X)
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        pStorage_X->NbRef_U32.store(1);
+        pStorage_X->Type_E       = _rBofBuffer_X.MustBeDeleted_B ? BOF_SHARED_BUFFER_STORAGE_TYPE::ADOPTED_ARRAY : BOF_SHARED_BUFFER_STORAGE_TYPE::ADOPTED_ALLOCATOR;
+        pStorage_X->pAllocator   = pAllocator;
+        pStorage_X->pData_U8     = _rBofBuffer_X.pData_U8;
+        pStorage_X->Capacity_U64 = _rBofBuffer_X.Capacity_U64;
+        _rBuffer.mpStorage_X     = pStorage_X;
+        _rBuffer.mSize_U64       = _rBofBuffer_X.Size_U64;
+        _rBofBuffer_X.Reset();
+      }
+    }
+    return Rts_E;
+  }
+
+  void Swap(BofSharedBuffer &_rOther)
+  {
+    std::swap(mpStorage_X, _rOther.mpStorage_X);
+    std::swap(mOffset_U64, _rOther.mOffset_U64);
+    std::swap(mSize_U64, _rOther.mSize_U64);
+  }
+
+  void Release()
+  {
+    if (mpStorage_X)
+    {
+      if (mpStorage_X->NbRef_U32.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        FreeStorage(mpStorage_X);
+      }
+      mpStorage_X = nullptr;
+    }
+    mOffset_U64 = 0;
+    mSize_U64   = 0;
+  }
+
+  bool IsNull() const { return mpStorage_X == nullptr; }
+  uint8_t *Data() const { return mpStorage_X ? mpStorage_X->pData_U8 + mOffset_U64 : nullptr; }
+  uint64_t Size() const { return mSize_U64; }
+  //Room available from the start of the view up to the end of the storage
+  uint64_t Capacity() const { return mpStorage_X ? mpStorage_X->Capacity_U64 - mOffset_U64 : 0; }
+  uint32_t UseCount() const { return mpStorage_X ? mpStorage_X->NbRef_U32.load(std::memory_order_acquire) : 0; }
+  //True if this view is the only owner of the storage: it is then safe to write into it
+  bool IsUnique() const { return UseCount() == 1; }
+
+  //Sets the size of the view, up to Capacity()
+  BOFERR Resize(uint64_t _Size_U64)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((mpStorage_X) && (_Size_U64 <= Capacity()))
+    {
+      Rts_E     = BOF_ERR_NO_ERROR;
+      mSize_U64 = _Size_U64;
+    }
+    return Rts_E;
+  }
+
+  //Copies data at the end of the view. Only allowed on a unique storage.
+  BOFERR Append(uint64_t _Size_U64, const void *_pData)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((_pData) && (IsUnique()))
+    {
+      Rts_E = BOF_ERR_FULL;
+      if ((mSize_U64 + _Size_U64) <= Capacity())
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        memcpy(Data() + mSize_U64, _pData, static_cast<size_t>(_Size_U64));
+        mSize_U64 += _Size_U64;
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Returns a new view on a part of this one. No data is copied.
+   *
+   * Parameters
+   * _Offset_U64: Specifies the offset of the slice in this view
+   * _Size_U64: Specifies the slice size
+   * _rSlice: Returns the slice
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Slice(uint64_t _Offset_U64, uint64_t _Size_U64, BofSharedBuffer &_rSlice) const
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if ((mpStorage_X) && (_Offset_U64 <= mSize_U64) && (_Size_U64 <= (mSize_U64 - _Offset_U64)))
+    {
+      Rts_E               = BOF_ERR_NO_ERROR;
+      _rSlice             = *this;
+      _rSlice.mOffset_U64 = mOffset_U64 + _Offset_U64;
+      _rSlice.mSize_U64   = _Size_U64;
+    }
+    return Rts_E;
+  }
+
+  //Drops _Size_U64 bytes at the start of the view (consumed data)
+  BOFERR Consume(uint64_t _Size_U64)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+
+    if (_Size_U64 <= mSize_U64)
+    {
+      Rts_E        = BOF_ERR_NO_ERROR;
+      mOffset_U64 += _Size_U64;
+      mSize_U64   -= _Size_U64;
+    }
+    return Rts_E;
+  }
+
+  //Non owning BOF_BUFFER describing the view, valid as long as this view (or another one on the storage) is alive
+  BOF_BUFFER BofBufferView() const
+  {
+    BOF_BUFFER Rts_X;
+
+    Rts_X.pData_U8     = Data();
+    Rts_X.Size_U64     = mSize_U64;
+    Rts_X.Capacity_U64 = Capacity();
+    return Rts_X;
+  }
+
+private:
+  void AddRef()
+  {
+    if (mpStorage_X)
+    {
+      mpStorage_X->NbRef_U32.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  static void FreeStorage(BOF_SHARED_BUFFER_STORAGE *_pStorage_X)
+  {
+    uint8_t *pBlock_U8 = reinterpret_cast<uint8_t *>(_pStorage_X);
+
+    switch (_pStorage_X->Type_E)
+    {
+      case BOF_SHARED_BUFFER_STORAGE_TYPE::INLINE_ALLOCATOR:
+        _pStorage_X->~BOF_SHARED_BUFFER_STORAGE();
+        _pStorage_X->pAllocator->V_Free(pBlock_U8, BOF_SHARED_BUFFER_HEADER_SIZE + _pStorage_X->Capacity_U64);
+        break;
+
+      case BOF_SHARED_BUFFER_STORAGE_TYPE::ADOPTED_ARRAY:
+        delete[] _pStorage_X->pData_U8;
+        delete _pStorage_X;
+        break;
+
+      case BOF_SHARED_BUFFER_STORAGE_TYPE::ADOPTED_ALLOCATOR:
+        _pStorage_X->pAllocator->V_Free(_pStorage_X->pData_U8, _pStorage_X->Capacity_U64);
+        delete _pStorage_X;
+        break;
+
+      case BOF_SHARED_BUFFER_STORAGE_TYPE::INLINE_HEAP:
+      default:
+        _pStorage_X->~BOF_SHARED_BUFFER_STORAGE();
+        delete[] pBlock_U8;
+        break;
+    }
+  }
+};
+
+/*!
+ * Summary
+ * Chain of buffer slices
+ *
+ * Description
+ * Ordered list of BofSharedBuffer slices describing a single logical message (header slice + payload slices for
+ * example). BofBufferCollection builds the std::vector<BOF_BUFFER> expected by BofSocket::WriteScatterGatherData and
+ * Consume drops what has been written after a partial write.
+ */
+class BofSharedBufferChain
+{
+private:
+  std::vector<BofSharedBuffer> mSliceCollection;
+  uint64_t                     mSize_U64 = 0;
+
+public:
+  BofSharedBufferChain() {}
+  virtual ~BofSharedBufferChain() {}
+
+  void Append(const BofSharedBuffer &_rSlice)
+  {
+    if (_rSlice.Size())
+    {
+      mSliceCollection.push_back(_rSlice);
+      mSize_U64 += _rSlice.Size();
+    }
+  }
+
+  void Append(const BofSharedBufferChain &_rChain)
+  {
+    for (const auto &rSlice : _rChain.mSliceCollection)
+    {
+      Append(rSlice);
+    }
+  }
+
+  void Clear()
+  {
+    mSliceCollection.clear();
+    mSize_U64 = 0;
+  }
+
+  uint64_t Size() const { return mSize_U64; }
+  uint32_t NbSlice() const { return static_cast<uint32_t>(mSliceCollection.size()); }
+  const BofSharedBuffer &SliceAt(uint32_t _Index_U32) const { return mSliceCollection[_Index_U32]; }
+
+  //Scatter gather list for WriteScatterGatherData. The BOF_BUFFER entries do not own anything.
+  void BofBufferCollection(std::vector<BOF_BUFFER> &_rBufferCollection) const
+  {
+    _rBufferCollection.clear();
+    _rBufferCollection.reserve(mSliceCollection.size());
+    for (const auto &rSlice : mSliceCollection)
+    {
+      _rBufferCollection.push_back(rSlice.BofBufferView());
+    }
+  }
+
+  //Drops _Size_U64 bytes at the start of the chain, releasing the slices which are fully consumed
+  BOFERR Consume(uint64_t _Size_U64)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    size_t NbDone = 0;
+
+    if (_Size_U64 <= mSize_U64)
+    {
+      Rts_E      = BOF_ERR_NO_ERROR;
+      mSize_U64 -= _Size_U64;
+      while ((_Size_U64) && (NbDone < mSliceCollection.size()))
+      {
+        if (_Size_U64 >= mSliceCollection[NbDone].Size())
+        {
+          _Size_U64 -= mSliceCollection[NbDone].Size();
+          NbDone++;
+        }
+        else
+        {
+          mSliceCollection[NbDone].Consume(_Size_U64);
+          _Size_U64 = 0;
+        }
+      }
+      mSliceCollection.erase(mSliceCollection.begin(), mSliceCollection.begin() + NbDone);
+    }
+    return Rts_E;
+  }
+
+  //Copies _Size_U64 bytes starting at _Offset_U64 in the chain
+  BOFERR CopyOut(uint64_t _Offset_U64, uint64_t _Size_U64, void *_pData) const
+  {
+    BOFERR   Rts_E = BOF_ERR_EINVAL;
+    uint8_t  *pData_U8 = static_cast<uint8_t *>(_pData);
+    uint64_t Nb_U64;
+
+    if ((_pData) && (_Offset_U64 <= mSize_U64) && (_Size_U64 <= (mSize_U64 - _Offset_U64)))
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      for (const auto &rSlice : mSliceCollection)
+      {
+        if (_Size_U64 == 0)
+        {
+          break;
+        }
+        if (_Offset_U64 >= rSlice.Size())
+        {
+          _Offset_U64 -= rSlice.Size();
+        }
+        else
+        {
+          Nb_U64 = std::min<uint64_t>(rSlice.Size() - _Offset_U64, _Size_U64);
+          memcpy(pData_U8, rSlice.Data() + _Offset_U64, static_cast<size_t>(Nb_U64));
+          pData_U8    += Nb_U64;
+          _Size_U64   -= Nb_U64;
+          _Offset_U64  = 0;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  //Gathers the whole chain in a single new buffer (for an api which needs contiguous data)
+  BOFERR Flatten(IBofAllocator *_pAllocator, BofSharedBuffer &_rBuffer) const
+  {
+    BOFERR Rts_E = BOF_ERR_EMPTY;
+
+    if (mSize_U64)
+    {
+      Rts_E = BofSharedBuffer::S_Create(mSize_U64, _pAllocator, _rBuffer);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = CopyOut(0, mSize_U64, _rBuffer.Data());
+        _rBuffer.Resize(mSize_U64);
+      }
+    }
+    return Rts_E;
+  }
+};
+
+END_BOF_NAMESPACE()
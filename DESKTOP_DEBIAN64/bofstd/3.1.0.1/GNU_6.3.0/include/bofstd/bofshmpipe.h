@@ -0,0 +1,455 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the BofShmPipe class: a pipe communication channel
+ * between two processes made of two BofShmRing, one per direction.
+ *
+ * Name:        bofshmpipe.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only, see bofshmring.h
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofcomchannel.h>
+#include <bofstd/bofpipe.h>
+#include <bofstd/bofshmring.h>
+#include <memory>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+const uint32_t BOF_SHM_PIPE_DEFAULT_RING_SIZE = 0x10000;
+
+/*** Structure **************************************************************/
+
+struct BOF_SHM_PIPE_PARAM
+{
+  BOF_COM_CHANNEL_PARAM BaseChannelParam_X;         /*! ChannelName_S names the two rings, ListenBackLog_U32 != 0 for the server end, 0 for the client end */
+  uint32_t              RingSizeInByte_U32;         /*! Size of each ring, both ends must use the same one */
+  uint32_t              SpinTimeInUs_U32;           /*! Maximum adaptive spin before sleeping on the futex, 0 to always sleep */
+  uint32_t              PeerCheckPeriodInMs_U32;
+  uint32_t              HeartbeatTimeoutInMs_U32;
+
+  BOF_SHM_PIPE_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    BaseChannelParam_X.Reset();
+    RingSizeInByte_U32       = BOF_SHM_PIPE_DEFAULT_RING_SIZE;
+    SpinTimeInUs_U32         = 50;
+    PeerCheckPeriodInMs_U32  = 100;
+    HeartbeatTimeoutInMs_U32 = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Shared memory pipe communication channel
+ *
+ * Description
+ * Same BofComChannel interface as BofPipe, but the data never goes through the kernel: the server end consumes the
+ * '<ChannelName_S>_c2s' ring and produces the '<ChannelName_S>_s2c' one, the client end does the opposite. A small
+ * message costs two copies and, when the reader is spinning, no system call at all; a reader which had to sleep is
+ * woken up by a process shared futex.
+ *
+ * Each V_WriteData call is split in records of at most MaxRecordSize() bytes. V_ReadData returns at most one record:
+ * with a buffer at least as large as the writes, message boundaries are kept; with a smaller one the record is
+ * returned in several pieces, as a byte stream.
+ *
+ * A pipe has a single peer and no accept: both ends call V_Connect to wait for the other one and V_Listen is not
+ * supported. One thread can read while another one writes, each direction having its own ring.
+ *
+ * See Also
+ * BofPipe, BofShmRing
+ */
+class BofShmPipe : public BofComChannel
+{
+private:
+  BOF_SHM_PIPE_PARAM          mShmPipeParam_X;
+  std::unique_ptr<BofShmRing> mpuRxRing;
+  std::unique_ptr<BofShmRing> mpuTxRing;
+  const uint8_t               *mpRxRecord_U8 = nullptr;   /*! Record held by Peek, partially read if mRxOffset_U32 != 0 */
+  uint32_t                    mRxRecordSize_U32 = 0;
+  uint32_t                    mRxOffset_U32 = 0;
+
+public:
+  BofShmPipe(const BOF_SHM_PIPE_PARAM &_rShmPipeParam_X)
+    : BofComChannel(BOF_COM_CHANNEL_TYPE::TPIPE, mShmPipeParam_X.BaseChannelParam_X)
+  {
+    BOF_SHM_RING_PARAM RingParam_X;
+    bool               Server_B;
+
+    mShmPipeParam_X = _rShmPipeParam_X;
+    mErrorCode_E    = BOF_ERR_EINVAL;
+    if ((!mShmPipeParam_X.BaseChannelParam_X.ChannelName_S.empty()) && (mShmPipeParam_X.RingSizeInByte_U32))
+    {
+      Server_B                             = (mShmPipeParam_X.BaseChannelParam_X.ListenBackLog_U32 != 0);
+      RingParam_X.Mode_E                   = BOF_SHM_RING_MODE_BYTE_RECORD;
+      RingParam_X.BufferSizeInByte_U32     = mShmPipeParam_X.RingSizeInByte_U32;
+      RingParam_X.PeerCheckPeriodInMs_U32  = mShmPipeParam_X.PeerCheckPeriodInMs_U32;
+      RingParam_X.HeartbeatTimeoutInMs_U32 = mShmPipeParam_X.HeartbeatTimeoutInMs_U32;
+      RingParam_X.SpinTimeInUs_U32         = mShmPipeParam_X.SpinTimeInUs_U32;
+
+      RingParam_X.Name_S = S_RingName(mShmPipeParam_X.BaseChannelParam_X.ChannelName_S, !Server_B);
+      RingParam_X.Role_E = BOF_SHM_RING_ROLE_CONSUMER;
+      mpuRxRing.reset(new BofShmRing(RingParam_X));
+      RingParam_X.Name_S = S_RingName(mShmPipeParam_X.BaseChannelParam_X.ChannelName_S, Server_B);
+      RingParam_X.Role_E = BOF_SHM_RING_ROLE_PRODUCER;
+      mpuTxRing.reset(new BofShmRing(RingParam_X));
+
+      mErrorCode_E = mpuRxRing->LastErrorCode();
+      if (mErrorCode_E == BOF_ERR_NO_ERROR)
+      {
+        mErrorCode_E = mpuTxRing->LastErrorCode();
+      }
+    }
+  }
+
+  virtual ~BofShmPipe()
+  {
+  }
+
+  BofShmPipe &operator=(const BofShmPipe &) = delete; // Disallow copying
+  BofShmPipe(const BofShmPipe &) = delete;
+
+  /*!
+   * Description
+   * Waits until the peer end has opened both rings.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies the maximum time to wait
+   * _rTarget_S: Not used, the peer is given by ChannelName_S
+   * _rOption_S: Not used
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the peer is there, BOF_ERR_ETIMEDOUT otherwise, BOF_ERR_EOWNERDEAD if it is gone
+   */
+  BOFERR V_Connect(uint32_t _TimeoutInMs_U32, const std::string & /*_rTarget_S*/, const std::string & /*_rOption_S*/) override
+  {
+    BOFERR   Rts_E = mErrorCode_E;
+    uint32_t Start_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Start_U32 = Bof_GetMsTickCount();
+      Rts_E     = PeerStatus();
+      while ((Rts_E == BOF_ERR_ENOTCONN) && (Bof_ElapsedMsTime(Start_U32) < _TimeoutInMs_U32))
+      {
+        Bof_MsSleep(1);
+        Rts_E = PeerStatus();
+      }
+      if (Rts_E == BOF_ERR_ENOTCONN)
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+      }
+    }
+    return Rts_E;
+  }
+
+  //A pipe has a single peer: use V_Connect on both ends
+  BofComChannel *V_Listen(uint32_t /*_TimeoutInMs_U32*/, const std::string & /*_rOption_S*/) override
+  {
+    return nullptr;
+  }
+
+  /*!
+   * Description
+   * Reads the next record, or the rest of a record partially read by a previous call.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies how long to wait for data (0: do not wait)
+   * _rNb_U32: Specifies the size of _pBuffer_U8 and returns the number of bytes read
+   * _pBuffer_U8: Returns the data
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_ETIMEDOUT if no data came in time,
+   * BOF_ERR_EOWNERDEAD if the writer is gone and everything it sent has been read
+   */
+  BOFERR V_ReadData(uint32_t _TimeoutInMs_U32, uint32_t &_rNb_U32, uint8_t *_pBuffer_U8) override
+  {
+    BOFERR   Rts_E = mErrorCode_E;
+    uint32_t Nb_U32 = 0;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_rNb_U32) && (_pBuffer_U8))
+      {
+        Rts_E = HoldRxRecord(_TimeoutInMs_U32);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Nb_U32 = mRxRecordSize_U32 - mRxOffset_U32;
+          if (Nb_U32 > _rNb_U32)
+          {
+            Nb_U32 = _rNb_U32;
+          }
+          memcpy(_pBuffer_U8, mpRxRecord_U8 + mRxOffset_U32, Nb_U32);
+          mRxOffset_U32 += Nb_U32;
+          if (mRxOffset_U32 == mRxRecordSize_U32)
+          {
+            Rts_E = ReleaseRxRecord();
+          }
+        }
+      }
+    }
+    _rNb_U32 = Nb_U32;
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Writes data to the peer, in records of at most MaxRecordSize() bytes.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies how long to wait for room in the ring (0: do not wait)
+   * _rNb_U32: Specifies the number of bytes to write and returns the number of bytes written
+   * _pBuffer_U8: Specifies the data
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_ETIMEDOUT if the reader did not make room in
+   * time, BOF_ERR_EOWNERDEAD if the reader is gone
+   */
+  BOFERR V_WriteData(uint32_t _TimeoutInMs_U32, uint32_t &_rNb_U32, const uint8_t *_pBuffer_U8) override
+  {
+    BOFERR   Rts_E = mErrorCode_E;
+    uint32_t Nb_U32 = 0, Chunk_U32, Start_U32, Elapsed_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_rNb_U32) && (_pBuffer_U8))
+      {
+        Rts_E     = BOF_ERR_NO_ERROR;
+        Start_U32 = Bof_GetMsTickCount();
+        while ((Rts_E == BOF_ERR_NO_ERROR) && (Nb_U32 < _rNb_U32))
+        {
+          Chunk_U32 = _rNb_U32 - Nb_U32;
+          if (Chunk_U32 > mpuTxRing->MaxRecordSize())
+          {
+            Chunk_U32 = mpuTxRing->MaxRecordSize();
+          }
+          Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+          Rts_E       = mpuTxRing->Push(_pBuffer_U8 + Nb_U32, Chunk_U32, (Elapsed_U32 < _TimeoutInMs_U32) ? _TimeoutInMs_U32 - Elapsed_U32 : 0);
+          if (Rts_E == BOF_ERR_NO_ERROR)
+          {
+            Nb_U32 += Chunk_U32;
+          }
+          else if (Rts_E == BOF_ERR_FULL)
+          {
+            Rts_E = BOF_ERR_ETIMEDOUT;
+          }
+        }
+      }
+    }
+    _rNb_U32 = Nb_U32;
+    return Rts_E;
+  }
+
+  BOFERR V_WriteData(uint32_t _TimeoutInMs_U32, const std::string &_rBuffer_S, uint32_t &_rNb_U32) override
+  {
+    _rNb_U32 = static_cast<uint32_t>(_rBuffer_S.size());
+    return V_WriteData(_TimeoutInMs_U32, _rNb_U32, reinterpret_cast<const uint8_t *>(_rBuffer_S.c_str()));
+  }
+
+  //NbIn_U32 and NbOut_U32 are the fill levels of the two rings, record headers included
+  BOFERR V_GetStatus(BOF_COM_CHANNEL_STATUS &_rStatus_X) override
+  {
+    _rStatus_X.Reset();
+    _rStatus_X.Sts_E = mErrorCode_E;
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      _rStatus_X.NbIn_U32    = mpuRxRing->GetNbElement() - mRxOffset_U32;
+      _rStatus_X.NbOut_U32   = mpuTxRing->GetNbElement();
+      _rStatus_X.Sts_E       = PeerStatus();
+      _rStatus_X.Connected_B = (_rStatus_X.Sts_E == BOF_ERR_NO_ERROR);
+    }
+    return mErrorCode_E;
+  }
+
+  //Drops everything already received
+  BOFERR V_FlushData(uint32_t /*_TimeoutInMs_U32*/) override
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      while (HoldRxRecord(0) == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = ReleaseRxRecord();
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_WaitForDataToRead(uint32_t _TimeoutInMs_U32, uint32_t &_rNbPendingByte_U32) override
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    _rNbPendingByte_U32 = 0;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      //The record stays held: the next V_ReadData gets it without waiting
+      Rts_E = HoldRxRecord(_TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        _rNbPendingByte_U32 = mRxRecordSize_U32 - mRxOffset_U32;
+      }
+    }
+    return Rts_E;
+  }
+
+  //BOF_ERR_NO_ERROR if the peer has both rings open, BOF_ERR_ENOTCONN if it is not there yet, BOF_ERR_EOWNERDEAD if it is gone
+  BOFERR PeerStatus()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = mpuRxRing->PeerStatus();
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = mpuTxRing->PeerStatus();
+      }
+    }
+    return Rts_E;
+  }
+
+  uint32_t MaxRecordSize() const
+  {
+    return mpuTxRing ? mpuTxRing->MaxRecordSize() : 0;
+  }
+
+  BOFERR ShmPipeStatistic(BOF_SHM_RING_STATISTIC &_rRxStatistic_X, BOF_SHM_RING_STATISTIC &_rTxStatistic_X) const
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mpuRxRing->ShmRingStatistic(_rRxStatistic_X);
+      mpuTxRing->ShmRingStatistic(_rTxStatistic_X);
+    }
+    return Rts_E;
+  }
+
+  void ResetShmPipeStatistic()
+  {
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      mpuRxRing->ResetStatistic();
+      mpuTxRing->ResetStatistic();
+    }
+  }
+
+  std::string ShmPipeDebugInfo()
+  {
+    std::string Rts_S = Bof_Sprintf("ShmPipe '%s' %s Sts %d Held %u/%u\n", mShmPipeParam_X.BaseChannelParam_X.ChannelName_S.c_str(),
+                                    mShmPipeParam_X.BaseChannelParam_X.ListenBackLog_U32 ? "Server" : "Client", mErrorCode_E, mRxOffset_U32, mRxRecordSize_U32);
+
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_S += mpuRxRing->ShmRingDebugInfo();
+      Rts_S += mpuTxRing->ShmRingDebugInfo();
+    }
+    return Rts_S;
+  }
+
+  //Removes the two ring segments of a pipe from the system
+  static BOFERR S_Destroy(const std::string &_rChannelName_S)
+  {
+    BOFERR Rts_E = BofShmRing::S_Destroy(S_RingName(_rChannelName_S, true));
+    BOFERR Sts_E = BofShmRing::S_Destroy(S_RingName(_rChannelName_S, false));
+
+    return (Rts_E == BOF_ERR_NO_ERROR) ? Sts_E : Rts_E;
+  }
+
+private:
+  static std::string S_RingName(const std::string &_rChannelName_S, bool _ServerToClient_B)
+  {
+    return _rChannelName_S + (_ServerToClient_B ? "_s2c" : "_c2s");
+  }
+
+  BOFERR HoldRxRecord(uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR     Rts_E = BOF_ERR_NO_ERROR;
+    const void *pRecord;
+
+    if (!mpRxRecord_U8)
+    {
+      Rts_E = mpuRxRing->Peek(pRecord, mRxRecordSize_U32, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mpRxRecord_U8 = static_cast<const uint8_t *>(pRecord);
+        mRxOffset_U32 = 0;
+      }
+      else if (Rts_E == BOF_ERR_EMPTY)
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR ReleaseRxRecord()
+  {
+    mpRxRecord_U8     = nullptr;
+    mRxRecordSize_U32 = 0;
+    mRxOffset_U32     = 0;
+    return mpuRxRing->Release();
+  }
+};
+
+/*** Function **************************************************************/
+
+/*!
+ * Description
+ * Creates the pipe channel matching _rPipeParam_X.PipeType_E: a BofShmPipe for BOF_PIPE_OVER_SHM (with a ring of
+ * BaseChannelParam_X.RcvBufferSize_U32 bytes if not 0), a BofPipe otherwise.
+ *
+ * Parameters
+ * _rPipeParam_X: Specifies the pipe parameters
+ *
+ * Returns
+ * std::unique_ptr<BofComChannel>: The channel, check its LastErrorCode()
+ */
+inline std::unique_ptr<BofComChannel> Bof_CreatePipe(const BOF_PIPE_PARAM &_rPipeParam_X)
+{
+  std::unique_ptr<BofComChannel> Rts;
+  BOF_SHM_PIPE_PARAM             ShmPipeParam_X;
+
+  if (_rPipeParam_X.PipeType_E == BOF_PIPE_TYPE::BOF_PIPE_OVER_SHM)
+  {
+    ShmPipeParam_X.BaseChannelParam_X = _rPipeParam_X.BaseChannelParam_X;
+    if (_rPipeParam_X.BaseChannelParam_X.RcvBufferSize_U32)
+    {
+      ShmPipeParam_X.RingSizeInByte_U32 = _rPipeParam_X.BaseChannelParam_X.RcvBufferSize_U32;
+    }
+    Rts.reset(new BofShmPipe(ShmPipeParam_X));
+  }
+  else
+  {
+    Rts.reset(new BofPipe(_rPipeParam_X));
+  }
+  return Rts;
+}
+
+END_BOF_NAMESPACE()
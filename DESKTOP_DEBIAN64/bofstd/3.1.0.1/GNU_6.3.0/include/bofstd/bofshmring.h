@@ -0,0 +1,890 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the BofShmRing class: a single producer/single
+ * consumer ring buffer living entirely inside a shared memory segment.
+ *
+ * Name:        bofshmring.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Process shared futexes only exist on Linux, the other
+ *              platforms return BOF_ERR_NOT_SUPPORTED.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsystem.h>
+#include <bofstd/bofstringformatter.h>
+#include <atomic>
+#include <chrono>
+#include <string.h>
+#if !defined (_WIN32)
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+const uint32_t BOF_SHM_RING_MAGIC               = 0x5A3C9E71;
+const uint32_t BOF_SHM_RING_VERSION             = 1;
+const uint32_t BOF_SHM_RING_RECORD_MAGIC        = 0xB0F5EC0D;   /*! Marks a record header in BOF_SHM_RING_MODE_BYTE_RECORD mode */
+const uint32_t BOF_SHM_RING_WRAP_MAGIC          = 0xB0F5EC0F;   /*! The rest of the data zone is unused, the next record starts at offset 0 */
+const uint32_t BOF_SHM_RING_RECORD_HEADER_SIZE  = 8;
+
+const uint32_t BOF_SHM_RING_STATE_FREE          = 0;
+const uint32_t BOF_SHM_RING_STATE_INITIALIZING  = 1;
+const uint32_t BOF_SHM_RING_STATE_READY         = 2;
+
+/*** Enum *****************************************************************/
+
+enum BOF_SHM_RING_MODE : uint32_t
+{
+  BOF_SHM_RING_MODE_BYTE_RECORD = 0,  /*! Variable size records, each one preceded by a BOF_SHM_RING_RECORD_HEADER_SIZE header */
+  BOF_SHM_RING_MODE_FIXED_ELEMENT,    /*! Array of NbElement_U32 slots of ElementSizeInByte_U32 */
+  BOF_SHM_RING_MODE_MAX
+};
+
+enum BOF_SHM_RING_ROLE
+{
+  BOF_SHM_RING_ROLE_PRODUCER = 0,
+  BOF_SHM_RING_ROLE_CONSUMER,
+  BOF_SHM_RING_ROLE_MAX
+};
+
+/*** Structure **************************************************************/
+
+//One per side, on its own cache line. Index_U64 is a monotonic byte offset: the position in the data zone is Index_U64 % DataSizeInByte_U32
+struct BOF_SHM_RING_ENDPOINT
+{
+  std::atomic<uint64_t> Index_U64;          /*! Producer: write index (published after the payload), consumer: read index */
+  std::atomic<uint64_t> HeartbeatMs_U64;    /*! CLOCK_MONOTONIC time of the last activity of this side */
+  std::atomic<uint32_t> Pid_U32;            /*! Process attached to this side, 0 if none */
+  std::atomic<uint32_t> NbAttach_U32;       /*! Incremented each time a process takes this side */
+  std::atomic<uint32_t> NbWaiter_U32;       /*! Number of threads of this side sleeping on WakeSeq_U32 */
+  std::atomic<uint32_t> WakeSeq_U32;        /*! Futex word this side sleeps on, incremented by the peer to wake it up */
+};
+
+//Lives at offset 0 of the shared memory segment, the data zone follows at DataOffset_U32. A fresh segment is zero filled so State_U32 starts at BOF_SHM_RING_STATE_FREE.
+struct BOF_SHM_RING_HEADER
+{
+  std::atomic<uint32_t>             State_U32;
+  uint32_t                          Magic_U32;
+  uint32_t                          Version_U32;
+  uint32_t                          Mode_U32;
+  uint32_t                          SlotSizeInByte_U32;   /*! BOF_SHM_RING_MODE_FIXED_ELEMENT: element size rounded to 8, otherwise 0 */
+  uint32_t                          DataSizeInByte_U32;
+  uint32_t                          DataOffset_U32;
+  alignas(64) BOF_SHM_RING_ENDPOINT Producer_X;
+  alignas(64) BOF_SHM_RING_ENDPOINT Consumer_X;
+};
+
+struct BOF_SHM_RING_PARAM
+{
+  std::string       Name_S;                     /*! Shared memory name, both processes must use the same one */
+  BOF_SHM_RING_ROLE Role_E;
+  BOF_SHM_RING_MODE Mode_E;
+  uint32_t          BufferSizeInByte_U32;       /*! BOF_SHM_RING_MODE_BYTE_RECORD: data zone size (rounded to 8). The maximum record size is half of it minus the record header */
+  uint32_t          NbElement_U32;              /*! BOF_SHM_RING_MODE_FIXED_ELEMENT: number of slots */
+  uint32_t          ElementSizeInByte_U32;      /*! BOF_SHM_RING_MODE_FIXED_ELEMENT: slot size */
+  uint32_t          OpenTimeoutInMs_U32;        /*! Time to wait for the peer to finish the initialization of the segment header */
+  uint32_t          PeerCheckPeriodInMs_U32;    /*! A blocked call checks the peer liveness at this rate */
+  uint32_t          HeartbeatTimeoutInMs_U32;   /*! If not 0, a peer whose heartbeat is older than this is considered dead even if its pid still exists */
+  uint32_t          SpinTimeInUs_U32;           /*! If not 0, a blocking call polls the peer index up to this long before sleeping on the futex (ignored on a single cpu) */
+
+  BOF_SHM_RING_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Name_S                   = "";
+    Role_E                   = BOF_SHM_RING_ROLE_PRODUCER;
+    Mode_E                   = BOF_SHM_RING_MODE_BYTE_RECORD;
+    BufferSizeInByte_U32     = 0;
+    NbElement_U32            = 0;
+    ElementSizeInByte_U32    = 0;
+    OpenTimeoutInMs_U32      = 1000;
+    PeerCheckPeriodInMs_U32  = 100;
+    HeartbeatTimeoutInMs_U32 = 0;
+    SpinTimeInUs_U32         = 0;
+  }
+};
+
+//Process local statistics of one side
+struct BOF_SHM_RING_STATISTIC
+{
+  uint64_t NbRecord_U64;          /*! Records/elements pushed (producer) or popped (consumer) */
+  uint64_t NbByte_U64;            /*! Payload bytes pushed or popped */
+  uint64_t NbWait_U64;            /*! Calls which had to block: ring full (producer) or empty (consumer) */
+  uint64_t NbTimeout_U64;
+  uint64_t NbWakeUpSent_U64;      /*! futex wake system calls issued to the peer */
+  uint64_t NbPeerDead_U64;
+  uint64_t MaxLevelInByte_U64;    /*! Maximum fill level seen by this side */
+  uint64_t NbSpinHit_U64;         /*! Waits satisfied while spinning, without any system call */
+  uint64_t NbSpinMiss_U64;        /*! Spins which ran out of budget and went on to the futex */
+
+  BOF_SHM_RING_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbRecord_U64       = 0;
+    NbByte_U64         = 0;
+    NbWait_U64         = 0;
+    NbTimeout_U64      = 0;
+    NbWakeUpSent_U64   = 0;
+    NbPeerDead_U64     = 0;
+    MaxLevelInByte_U64 = 0;
+    NbSpinHit_U64      = 0;
+    NbSpinMiss_U64     = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Inter process single producer/single consumer ring buffer
+ *
+ * Description
+ * Unlike BofRawCircularBuffer and BofCircularBuffer, whose indices, mutex and events are process local, everything the
+ * two sides share (header, indices and wait words) lives inside the BOF_SHARED_MEMORY segment:
+ *
+ *  BOF_SHM_RING_HEADER | Producer endpoint (cache line) | Consumer endpoint (cache line) | data zone
+ *
+ * The first process to open the segment initializes the header, the second one checks that its parameters match
+ * (BOF_ERR_WRONG_MODE/BOF_ERR_WRONG_SIZE otherwise). Each side only writes its own index; the producer publishes its
+ * index after the payload so a record is never seen half written, even if the producer dies in the middle of a copy.
+ *
+ * Nothing is locked on the fast path. A side which must block (ring full or empty) registers itself in its NbWaiter_U32
+ * and sleeps on a process shared futex; the peer only issues the wake system call when it sees a waiter. The sleep is
+ * cut in slices of PeerCheckPeriodInMs_U32 to check that the peer is still alive (kill(pid, 0) and optional heartbeat):
+ * a call blocked on a crashed peer returns BOF_ERR_EOWNERDEAD instead of hanging. A restarted process can take over a
+ * side whose owner is dead and continue from the published indices; a side owned by a live process gives BOF_ERR_EBUSY.
+ *
+ * With SpinTimeInUs_U32, a blocking call first polls the peer index before going to sleep: a peer which answers within
+ * a few microseconds is seen without any system call on either side, as a spinning side is not a registered waiter.
+ * The spin budget is adaptive: it doubles (up to SpinTimeInUs_U32) each time spinning pays off and halves each time the
+ * side had to sleep anyway, so a side whose peer is mostly idle stops burning cpu.
+ *
+ * Reserve/Commit and Peek/Release give direct access to the shared data zone: a frame can be produced in place and
+ * consumed in place, without any intermediate copy. Push/Pop are the copying convenience versions.
+ *
+ * In BOF_SHM_RING_MODE_BYTE_RECORD mode a record never wraps: when it does not fit in the end of the data zone the
+ * producer writes a BOF_SHM_RING_WRAP_MAGIC marker and restarts at offset 0.
+ *
+ * A BofShmRing object is used by a single thread of its process (one producer thread, one consumer thread).
+ *
+ * See Also
+ * BofRawCircularBuffer, Bof_OpenSharedMemory
+ */
+class BofShmRing
+{
+private:
+  BOF_SHM_RING_PARAM     mShmRingParam_X;
+  BOF_SHARED_MEMORY      mSharedMemory_X;
+  BOF_SHM_RING_HEADER    *mpHeader_X = nullptr;
+  BOF_SHM_RING_ENDPOINT  *mpSelf_X = nullptr;
+  BOF_SHM_RING_ENDPOINT  *mpPeer_X = nullptr;
+  uint8_t                *mpData_U8 = nullptr;
+  uint32_t               mDataSize_U32 = 0;
+  uint32_t               mSlotSize_U32 = 0;
+  uint64_t               mLocalIndex_U64 = 0;          /*! Private copy of our own index */
+  uint64_t               mCachedPeerIndex_U64 = 0;     /*! Last peer index read: avoids touching the peer cache line on each call */
+  uint64_t               mPendingIndex_U64 = 0;        /*! Index to publish on Commit/Release */
+  uint32_t               mPendingSize_U32 = 0;         /*! Size reserved by Reserve or returned by Peek, 0 if none */
+  uint32_t               mSpinBudgetInUs_U32 = 0;      /*! Current adaptive spin time, between SpinTimeInUs_U32 / 16 and SpinTimeInUs_U32 */
+  BOF_SHM_RING_STATISTIC mShmRingStatistic_X;
+  BOFERR                 mErrorCode_E = BOF_ERR_INIT;
+
+public:
+  BofShmRing(const BOF_SHM_RING_PARAM &_rShmRingParam_X)
+  {
+    mShmRingParam_X = _rShmRingParam_X;
+#if defined (_WIN32)
+    mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#else
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "BofShmRing needs address free 64 bits atomics");
+    //On a single cpu the peer can not run while we spin
+    if (sysconf(_SC_NPROCESSORS_ONLN) <= 1)
+    {
+      mShmRingParam_X.SpinTimeInUs_U32 = 0;
+    }
+    mSpinBudgetInUs_U32 = mShmRingParam_X.SpinTimeInUs_U32;
+    mErrorCode_E = Open();
+#endif
+  }
+
+  virtual ~BofShmRing()
+  {
+    Close();
+  }
+
+  BofShmRing &operator=(const BofShmRing &) = delete; // Disallow copying
+  BofShmRing(const BofShmRing &) = delete;
+
+  BOFERR LastErrorCode() const { return mErrorCode_E; }
+  BOF_SHM_RING_ROLE Role() const { return mShmRingParam_X.Role_E; }
+  //Payload capacity: bytes in BOF_SHM_RING_MODE_BYTE_RECORD mode, elements in BOF_SHM_RING_MODE_FIXED_ELEMENT mode
+  uint32_t GetCapacity() const { return mSlotSize_U32 ? mShmRingParam_X.NbElement_U32 : mDataSize_U32; }
+  uint32_t MaxRecordSize() const { return mSlotSize_U32 ? mShmRingParam_X.ElementSizeInByte_U32 : ((mDataSize_U32 / 2) & ~7u) - BOF_SHM_RING_RECORD_HEADER_SIZE; }
+
+  //Bytes (headers and padding included) or elements currently stored
+  uint32_t GetNbElement() const
+  {
+    uint32_t Rts_U32 = 0;
+
+    if (mpHeader_X)
+    {
+      Rts_U32 = static_cast<uint32_t>(mpHeader_X->Producer_X.Index_U64.load(std::memory_order_acquire) - mpHeader_X->Consumer_X.Index_U64.load(std::memory_order_acquire));
+      if (mSlotSize_U32)
+      {
+        Rts_U32 /= mSlotSize_U32;
+      }
+    }
+    return Rts_U32;
+  }
+
+  bool IsEmpty() const { return GetNbElement() == 0; }
+
+  uint32_t PeerPid() const { return mpPeer_X ? mpPeer_X->Pid_U32.load(std::memory_order_relaxed) : 0; }
+
+  //BOF_ERR_NO_ERROR if the peer is attached and alive, BOF_ERR_ENOTCONN if no peer is attached, BOF_ERR_EOWNERDEAD if it is gone
+  BOFERR PeerStatus()
+  {
+    BOFERR   Rts_E = BOF_ERR_INIT;
+#if !defined (_WIN32)
+    uint32_t Pid_U32;
+
+    if (mpPeer_X)
+    {
+      Rts_E   = BOF_ERR_ENOTCONN;
+      Pid_U32 = mpPeer_X->Pid_U32.load(std::memory_order_acquire);
+      if (Pid_U32)
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        if (!S_IsPidAlive(Pid_U32))
+        {
+          Rts_E = BOF_ERR_EOWNERDEAD;
+        }
+        else if ((mShmRingParam_X.HeartbeatTimeoutInMs_U32) && (S_NowMs() - mpPeer_X->HeartbeatMs_U64.load(std::memory_order_relaxed) > mShmRingParam_X.HeartbeatTimeoutInMs_U32))
+        {
+          Rts_E = BOF_ERR_EOWNERDEAD;
+        }
+      }
+    }
+#endif
+    return Rts_E;
+  }
+
+  //Refreshes our heartbeat. Data transfers do it implicitly: call it from an idle side when HeartbeatTimeoutInMs_U32 is used
+  void Heartbeat()
+  {
+    if (mpSelf_X)
+    {
+      mpSelf_X->HeartbeatMs_U64.store(S_NowMs(), std::memory_order_relaxed);
+    }
+  }
+
+  /*!
+   * Description
+   * Reserves room for one record (or one element) in the shared data zone. The caller writes its payload in place and
+   * publishes it with Commit.
+   *
+   * Parameters
+   * _Size_U32: Specifies the payload size (the maximum one if the final size is not known yet)
+   * _rpData: Returns a pointer to the reserved area inside the shared memory segment
+   * _TimeoutInMs_U32: Specifies how long to wait for free room (0: do not wait)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_FULL on timeout, BOF_ERR_EOWNERDEAD if the
+   * consumer died while we were waiting.
+   */
+  BOFERR Reserve(uint32_t _Size_U32, void *&_rpData, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR   Rts_E = CheckCall(BOF_SHM_RING_ROLE_PRODUCER);
+    uint32_t Pos_U32, Gap_U32 = 0, RecordSize_U32, Need_U32;
+
+    _rpData = nullptr;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_TOO_BIG;
+      if ((_Size_U32) && (_Size_U32 <= MaxRecordSize()))
+      {
+        Pos_U32 = static_cast<uint32_t>(mLocalIndex_U64 % mDataSize_U32);
+        if (mSlotSize_U32)
+        {
+          RecordSize_U32 = mSlotSize_U32;
+        }
+        else
+        {
+          RecordSize_U32 = BOF_SHM_RING_RECORD_HEADER_SIZE + S_Align8(_Size_U32);
+          if (Pos_U32 + RecordSize_U32 > mDataSize_U32)
+          {
+            Gap_U32 = mDataSize_U32 - Pos_U32;
+          }
+        }
+        Need_U32 = Gap_U32 + RecordSize_U32;
+        Rts_E    = WaitFor(Need_U32, _TimeoutInMs_U32);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          if (Gap_U32)
+          {
+            S_WriteRecordHeader(mpData_U8 + Pos_U32, BOF_SHM_RING_WRAP_MAGIC, Gap_U32);
+            Pos_U32 = 0;
+          }
+          mPendingIndex_U64 = mLocalIndex_U64 + Gap_U32;
+          mPendingSize_U32  = _Size_U32;
+          _rpData           = mpData_U8 + Pos_U32 + (mSlotSize_U32 ? 0 : BOF_SHM_RING_RECORD_HEADER_SIZE);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  //Publishes the record prepared after Reserve. In BOF_SHM_RING_MODE_BYTE_RECORD mode _Size_U32 can be smaller than the reserved size.
+  BOFERR Commit(uint32_t _Size_U32)
+  {
+    BOFERR   Rts_E = CheckCall(BOF_SHM_RING_ROLE_PRODUCER);
+    uint32_t Pos_U32, RecordSize_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_INVALID_STATE;
+      if (mPendingSize_U32)
+      {
+        Rts_E = BOF_ERR_WRONG_SIZE;
+        if ((_Size_U32) && (_Size_U32 <= mPendingSize_U32))
+        {
+          Rts_E = BOF_ERR_NO_ERROR;
+          if (mSlotSize_U32)
+          {
+            RecordSize_U32 = mSlotSize_U32;
+          }
+          else
+          {
+            Pos_U32        = static_cast<uint32_t>(mPendingIndex_U64 % mDataSize_U32);
+            RecordSize_U32 = BOF_SHM_RING_RECORD_HEADER_SIZE + S_Align8(_Size_U32);
+            S_WriteRecordHeader(mpData_U8 + Pos_U32, BOF_SHM_RING_RECORD_MAGIC, _Size_U32);
+          }
+          mShmRingStatistic_X.NbRecord_U64++;
+          mShmRingStatistic_X.NbByte_U64 += _Size_U32;
+          Publish(mPendingIndex_U64 + RecordSize_U32);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Gives access to the oldest record (or element) in place, in the shared data zone. It stays valid until Release.
+   *
+   * Parameters
+   * _rpData: Returns a pointer to the payload
+   * _rSize_U32: Returns the payload size
+   * _TimeoutInMs_U32: Specifies how long to wait for data (0: do not wait)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_EMPTY on timeout, BOF_ERR_EOWNERDEAD if the
+   * producer died while we were waiting and the ring is empty, BOF_ERR_BAD_STATUS if the segment is corrupted.
+   */
+  BOFERR Peek(const void *&_rpData, uint32_t &_rSize_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR   Rts_E = CheckCall(BOF_SHM_RING_ROLE_CONSUMER);
+    uint32_t Pos_U32, Magic_U32, Size_U32, RecordSize_U32 = 0;
+    uint64_t Index_U64;
+
+    _rpData    = nullptr;
+    _rSize_U32 = 0;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = WaitFor(mSlotSize_U32 ? mSlotSize_U32 : BOF_SHM_RING_RECORD_HEADER_SIZE, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Index_U64 = mLocalIndex_U64;
+        Pos_U32   = static_cast<uint32_t>(Index_U64 % mDataSize_U32);
+        if (mSlotSize_U32)
+        {
+          Size_U32       = mShmRingParam_X.ElementSizeInByte_U32;
+          RecordSize_U32 = mSlotSize_U32;
+        }
+        else
+        {
+          S_ReadRecordHeader(mpData_U8 + Pos_U32, Magic_U32, Size_U32);
+          if (Magic_U32 == BOF_SHM_RING_WRAP_MAGIC)
+          {
+            //The wrap marker and the record which follows are published together
+            Index_U64 += mDataSize_U32 - Pos_U32;
+            Pos_U32    = 0;
+            S_ReadRecordHeader(mpData_U8, Magic_U32, Size_U32);
+          }
+          if ((Magic_U32 == BOF_SHM_RING_RECORD_MAGIC) && (Size_U32) && (Size_U32 <= MaxRecordSize()))
+          {
+            RecordSize_U32 = BOF_SHM_RING_RECORD_HEADER_SIZE + S_Align8(Size_U32);
+          }
+        }
+        if ((RecordSize_U32) && (Index_U64 + RecordSize_U32 <= mCachedPeerIndex_U64))
+        {
+          mPendingIndex_U64 = Index_U64 + RecordSize_U32;
+          mPendingSize_U32  = Size_U32;
+          _rpData           = mpData_U8 + Pos_U32 + (mSlotSize_U32 ? 0 : BOF_SHM_RING_RECORD_HEADER_SIZE);
+          _rSize_U32        = Size_U32;
+        }
+        else
+        {
+          Rts_E = BOF_ERR_BAD_STATUS;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  //Gives the record returned by Peek back to the producer
+  BOFERR Release()
+  {
+    BOFERR Rts_E = CheckCall(BOF_SHM_RING_ROLE_CONSUMER);
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_INVALID_STATE;
+      if (mPendingSize_U32)
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        mShmRingStatistic_X.NbRecord_U64++;
+        mShmRingStatistic_X.NbByte_U64 += mPendingSize_U32;
+        Publish(mPendingIndex_U64);
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR Push(const void *_pData, uint32_t _Size_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    void   *pDst;
+
+    if (_pData)
+    {
+      Rts_E = BOF_ERR_WRONG_SIZE;
+      if ((!mSlotSize_U32) || (_Size_U32 == mShmRingParam_X.ElementSizeInByte_U32))
+      {
+        Rts_E = Reserve(_Size_U32, pDst, _TimeoutInMs_U32);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          memcpy(pDst, _pData, _Size_U32);
+          Rts_E = Commit(_Size_U32);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  //_rSize_U32: in: size of _pData, out: size of the record. A record larger than _pData is left in the ring (BOF_ERR_TOO_SMALL)
+  BOFERR Pop(void *_pData, uint32_t &_rSize_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR     Rts_E = BOF_ERR_EINVAL;
+    const void *pSrc;
+    uint32_t   Size_U32;
+
+    if (_pData)
+    {
+      Rts_E = Peek(pSrc, Size_U32, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        if (Size_U32 <= _rSize_U32)
+        {
+          memcpy(_pData, pSrc, Size_U32);
+          Rts_E = Release();
+        }
+        else
+        {
+          mPendingSize_U32 = 0;
+          Rts_E            = BOF_ERR_TOO_SMALL;
+        }
+        _rSize_U32 = Size_U32;
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR ShmRingStatistic(BOF_SHM_RING_STATISTIC &_rStatistic_X) const
+  {
+    _rStatistic_X = mShmRingStatistic_X;
+    return BOF_ERR_NO_ERROR;
+  }
+
+  void ResetStatistic()
+  {
+    mShmRingStatistic_X.Reset();
+  }
+
+  std::string ShmRingDebugInfo()
+  {
+    uint64_t Producer_U64 = mpHeader_X ? mpHeader_X->Producer_X.Index_U64.load() : 0;
+    uint64_t Consumer_U64 = mpHeader_X ? mpHeader_X->Consumer_X.Index_U64.load() : 0;
+
+    return Bof_Sprintf("ShmRing '%s' %s %s: Data %u Slot %u Prod %lld Cons %lld Level %u/%u Peer %u (%d) Rec %lld Byte %lld Wait %lld Tmo %lld Wake %lld Dead %lld MaxLvl %lld Spin %u/%u Hit %lld Miss %lld\n", mShmRingParam_X.Name_S.c_str(),
+                       (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? "Producer" : "Consumer", mSlotSize_U32 ? "Fixed" : "Record", mDataSize_U32, mSlotSize_U32,
+                       Producer_U64, Consumer_U64, GetNbElement(), GetCapacity(), PeerPid(), PeerStatus(), mShmRingStatistic_X.NbRecord_U64, mShmRingStatistic_X.NbByte_U64,
+                       mShmRingStatistic_X.NbWait_U64, mShmRingStatistic_X.NbTimeout_U64, mShmRingStatistic_X.NbWakeUpSent_U64, mShmRingStatistic_X.NbPeerDead_U64,
+                       mShmRingStatistic_X.MaxLevelInByte_U64, mSpinBudgetInUs_U32, mShmRingParam_X.SpinTimeInUs_U32, mShmRingStatistic_X.NbSpinHit_U64,
+                       mShmRingStatistic_X.NbSpinMiss_U64);
+  }
+
+  //Removes the segment name from the system. Processes which have it mapped keep using it.
+  static BOFERR S_Destroy(const std::string &_rName_S)
+  {
+    return Bof_DestroySharedMemory(_rName_S);
+  }
+
+private:
+#if !defined (_WIN32)
+  static uint64_t S_NowMs()
+  {
+    struct timespec Now_X;
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &Now_X);
+    return (static_cast<uint64_t>(Now_X.tv_sec) * 1000) + (Now_X.tv_nsec / 1000000);
+  }
+
+  static uint32_t S_GetPid()
+  {
+    return static_cast<uint32_t>(getpid());
+  }
+
+  static bool S_IsPidAlive(uint32_t _Pid_U32)
+  {
+    return (kill(static_cast<pid_t>(_Pid_U32), 0) == 0) || (errno != ESRCH);
+  }
+
+  //No FUTEX_PRIVATE_FLAG: the word is shared between processes
+  static void S_FutexWait(std::atomic<uint32_t> &_rWord, uint32_t _Expected_U32, uint32_t _TimeoutInMs_U32)
+  {
+    struct timespec Timeout_X;
+
+    Timeout_X.tv_sec  = _TimeoutInMs_U32 / 1000;
+    Timeout_X.tv_nsec = (_TimeoutInMs_U32 % 1000) * 1000000;
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_rWord), FUTEX_WAIT, _Expected_U32, &Timeout_X, nullptr, 0);
+  }
+
+  static void S_FutexWake(std::atomic<uint32_t> &_rWord)
+  {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&_rWord), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+  }
+#else
+  static uint64_t S_NowMs() { return Bof_GetMsTickCount(); }
+  static uint32_t S_GetPid() { return 0; }
+  static bool S_IsPidAlive(uint32_t /*_Pid_U32*/) { return true; }
+  static void S_FutexWait(std::atomic<uint32_t> & /*_rWord*/, uint32_t /*_Expected_U32*/, uint32_t _TimeoutInMs_U32) { Bof_MsSleep(_TimeoutInMs_U32); }
+  static void S_FutexWake(std::atomic<uint32_t> & /*_rWord*/) {}
+#endif
+
+  static void S_CpuRelax()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+  }
+
+  static uint32_t S_Align8(uint32_t _Size_U32)
+  {
+    return (_Size_U32 + 7) & ~7u;
+  }
+
+  static void S_WriteRecordHeader(uint8_t *_pRecord_U8, uint32_t _Magic_U32, uint32_t _Size_U32)
+  {
+    memcpy(_pRecord_U8, &_Size_U32, sizeof(uint32_t));
+    memcpy(_pRecord_U8 + sizeof(uint32_t), &_Magic_U32, sizeof(uint32_t));
+  }
+
+  static void S_ReadRecordHeader(const uint8_t *_pRecord_U8, uint32_t &_rMagic_U32, uint32_t &_rSize_U32)
+  {
+    memcpy(&_rSize_U32, _pRecord_U8, sizeof(uint32_t));
+    memcpy(&_rMagic_U32, _pRecord_U8 + sizeof(uint32_t), sizeof(uint32_t));
+  }
+
+  BOFERR CheckCall(BOF_SHM_RING_ROLE _Role_E) const
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (mShmRingParam_X.Role_E != _Role_E))
+    {
+      Rts_E = BOF_ERR_WRONG_MODE;
+    }
+    return Rts_E;
+  }
+
+  //Bytes available for our side according to _PeerIndex_U64: free room for the producer, stored data for the consumer
+  uint32_t Available(uint64_t _PeerIndex_U64) const
+  {
+    return (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? static_cast<uint32_t>(mDataSize_U32 - (mLocalIndex_U64 - _PeerIndex_U64))
+                                                                  : static_cast<uint32_t>(_PeerIndex_U64 - mLocalIndex_U64);
+  }
+
+  //Polls the peer index for at most the current spin budget and adapts the budget to the outcome
+  bool Spin(uint32_t _Need_U32)
+  {
+    bool                                  Rts_B = false;
+    std::chrono::steady_clock::time_point End;
+    uint32_t                              Loop_U32 = 0;
+    bool                                  Expired_B = false;
+
+    End = std::chrono::steady_clock::now() + std::chrono::microseconds(mSpinBudgetInUs_U32);
+    while ((!Rts_B) && (!Expired_B))
+    {
+      S_CpuRelax();
+      mCachedPeerIndex_U64 = mpPeer_X->Index_U64.load(std::memory_order_acquire);
+      Rts_B                = (Available(mCachedPeerIndex_U64) >= _Need_U32);
+      //Reading the clock costs more than a pause: only do it every few polls
+      if ((!Rts_B) && ((++Loop_U32 & 0x0F) == 0))
+      {
+        Expired_B = (std::chrono::steady_clock::now() >= End);
+      }
+    }
+    if (Rts_B)
+    {
+      mShmRingStatistic_X.NbSpinHit_U64++;
+      mSpinBudgetInUs_U32 = (mSpinBudgetInUs_U32 * 2 < mShmRingParam_X.SpinTimeInUs_U32) ? mSpinBudgetInUs_U32 * 2 : mShmRingParam_X.SpinTimeInUs_U32;
+    }
+    else
+    {
+      mShmRingStatistic_X.NbSpinMiss_U64++;
+      mSpinBudgetInUs_U32 = (mSpinBudgetInUs_U32 / 2 > mShmRingParam_X.SpinTimeInUs_U32 / 16) ? mSpinBudgetInUs_U32 / 2 : (mShmRingParam_X.SpinTimeInUs_U32 + 15) / 16;
+    }
+    return Rts_B;
+  }
+
+  //Waits until _Need_U32 bytes are available. The Dekker like ordering (NbWaiter_U32 then index here, index then NbWaiter_U32 in Publish) guarantees that a wake up is never lost.
+  BOFERR WaitFor(uint32_t _Need_U32, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR   Rts_E = BOF_ERR_NO_ERROR;
+    uint32_t Start_U32, Elapsed_U32, Seq_U32, Slice_U32;
+    bool     WaitCounted_B = false;
+
+    if (Available(mCachedPeerIndex_U64) < _Need_U32)
+    {
+      mCachedPeerIndex_U64 = mpPeer_X->Index_U64.load(std::memory_order_acquire);
+      if ((Available(mCachedPeerIndex_U64) < _Need_U32) && (_TimeoutInMs_U32) && (mShmRingParam_X.SpinTimeInUs_U32))
+      {
+        Spin(_Need_U32);
+      }
+      Start_U32            = Bof_GetMsTickCount();
+      while (Available(mCachedPeerIndex_U64) < _Need_U32)
+      {
+        //The consumer may still drain what a dead producer has published
+        Rts_E = PeerStatus();
+        if ((Rts_E != BOF_ERR_NO_ERROR) && (Rts_E != BOF_ERR_ENOTCONN))
+        {
+          mShmRingStatistic_X.NbPeerDead_U64++;
+          break;
+        }
+        Rts_E       = BOF_ERR_NO_ERROR;
+        Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+        if (Elapsed_U32 >= _TimeoutInMs_U32)
+        {
+          Rts_E = (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? BOF_ERR_FULL : BOF_ERR_EMPTY;
+          if (_TimeoutInMs_U32)
+          {
+            mShmRingStatistic_X.NbTimeout_U64++;
+          }
+          break;
+        }
+        if (!WaitCounted_B)
+        {
+          WaitCounted_B = true;
+          mShmRingStatistic_X.NbWait_U64++;
+        }
+        Slice_U32 = _TimeoutInMs_U32 - Elapsed_U32;
+        if (Slice_U32 > mShmRingParam_X.PeerCheckPeriodInMs_U32)
+        {
+          Slice_U32 = mShmRingParam_X.PeerCheckPeriodInMs_U32;
+        }
+        mpSelf_X->NbWaiter_U32.fetch_add(1);
+        Seq_U32              = mpSelf_X->WakeSeq_U32.load();
+        mCachedPeerIndex_U64 = mpPeer_X->Index_U64.load();
+        if (Available(mCachedPeerIndex_U64) < _Need_U32)
+        {
+          S_FutexWait(mpSelf_X->WakeSeq_U32, Seq_U32, Slice_U32 ? Slice_U32 : 1);
+          mCachedPeerIndex_U64 = mpPeer_X->Index_U64.load(std::memory_order_acquire);
+        }
+        mpSelf_X->NbWaiter_U32.fetch_sub(1);
+      }
+    }
+    return Rts_E;
+  }
+
+  void Publish(uint64_t _Index_U64)
+  {
+    uint64_t Level_U64;
+
+    mLocalIndex_U64  = _Index_U64;
+    mPendingSize_U32 = 0;
+    mpSelf_X->Index_U64.store(_Index_U64);
+    mpSelf_X->HeartbeatMs_U64.store(S_NowMs(), std::memory_order_relaxed);
+    if (mpPeer_X->NbWaiter_U32.load())
+    {
+      mpPeer_X->WakeSeq_U32.fetch_add(1);
+      S_FutexWake(mpPeer_X->WakeSeq_U32);
+      mShmRingStatistic_X.NbWakeUpSent_U64++;
+    }
+    Level_U64 = (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? (_Index_U64 - mCachedPeerIndex_U64) : (mCachedPeerIndex_U64 - _Index_U64);
+    if (Level_U64 > mShmRingStatistic_X.MaxLevelInByte_U64)
+    {
+      mShmRingStatistic_X.MaxLevelInByte_U64 = Level_U64;
+    }
+  }
+
+  BOFERR Open()
+  {
+    BOFERR   Rts_E = BOF_ERR_EINVAL;
+    uint32_t Expected_U32, Start_U32, Pid_U32, MyPid_U32;
+
+    if (mShmRingParam_X.Mode_E == BOF_SHM_RING_MODE_FIXED_ELEMENT)
+    {
+      if ((mShmRingParam_X.NbElement_U32) && (mShmRingParam_X.ElementSizeInByte_U32))
+      {
+        mSlotSize_U32 = S_Align8(mShmRingParam_X.ElementSizeInByte_U32);
+        mDataSize_U32 = mShmRingParam_X.NbElement_U32 * mSlotSize_U32;
+        Rts_E         = BOF_ERR_NO_ERROR;
+      }
+    }
+    else if (mShmRingParam_X.Mode_E == BOF_SHM_RING_MODE_BYTE_RECORD)
+    {
+      mDataSize_U32 = S_Align8(mShmRingParam_X.BufferSizeInByte_U32);
+      if (mDataSize_U32 >= 4 * BOF_SHM_RING_RECORD_HEADER_SIZE)
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+    }
+    if ((Rts_E == BOF_ERR_NO_ERROR) && ((mShmRingParam_X.Name_S.empty()) || (mShmRingParam_X.Role_E >= BOF_SHM_RING_ROLE_MAX) || (mShmRingParam_X.PeerCheckPeriodInMs_U32 == 0)))
+    {
+      Rts_E = BOF_ERR_EINVAL;
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      //The segment of an earlier run may still exist: both results are fine, the header state tells us who initializes it
+      Rts_E = Bof_OpenSharedMemory(mShmRingParam_X.Name_S, static_cast<uint32_t>(sizeof(BOF_SHM_RING_HEADER)) + mDataSize_U32, mSharedMemory_X);
+      if ((Rts_E == BOF_ERR_EEXIST) && (Bof_IsSharedMemoryValid(mSharedMemory_X)))
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mpHeader_X = static_cast<BOF_SHM_RING_HEADER *>(mSharedMemory_X.pBaseAddress);
+        Rts_E      = BOF_ERR_INIT;
+        if (mpHeader_X)
+        {
+          Expected_U32 = BOF_SHM_RING_STATE_FREE;
+          if (mpHeader_X->State_U32.compare_exchange_strong(Expected_U32, BOF_SHM_RING_STATE_INITIALIZING))
+          {
+            mpHeader_X->Magic_U32          = BOF_SHM_RING_MAGIC;
+            mpHeader_X->Version_U32        = BOF_SHM_RING_VERSION;
+            mpHeader_X->Mode_U32           = mShmRingParam_X.Mode_E;
+            mpHeader_X->SlotSizeInByte_U32 = mSlotSize_U32;
+            mpHeader_X->DataSizeInByte_U32 = mDataSize_U32;
+            mpHeader_X->DataOffset_U32     = static_cast<uint32_t>(sizeof(BOF_SHM_RING_HEADER));
+            mpHeader_X->State_U32.store(BOF_SHM_RING_STATE_READY);
+          }
+          Start_U32 = Bof_GetMsTickCount();
+          while ((mpHeader_X->State_U32.load() != BOF_SHM_RING_STATE_READY) && (Bof_ElapsedMsTime(Start_U32) < mShmRingParam_X.OpenTimeoutInMs_U32))
+          {
+            Bof_MsSleep(1);
+          }
+          if (mpHeader_X->State_U32.load() == BOF_SHM_RING_STATE_READY)
+          {
+            Rts_E = BOF_ERR_FORMAT;
+            if ((mpHeader_X->Magic_U32 == BOF_SHM_RING_MAGIC) && (mpHeader_X->Version_U32 == BOF_SHM_RING_VERSION))
+            {
+              Rts_E = BOF_ERR_WRONG_MODE;
+              if (mpHeader_X->Mode_U32 == static_cast<uint32_t>(mShmRingParam_X.Mode_E))
+              {
+                Rts_E = BOF_ERR_WRONG_SIZE;
+                if ((mpHeader_X->SlotSizeInByte_U32 == mSlotSize_U32) && (mpHeader_X->DataSizeInByte_U32 == mDataSize_U32))
+                {
+                  Rts_E = BOF_ERR_NO_ERROR;
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mpData_U8 = static_cast<uint8_t *>(mSharedMemory_X.pBaseAddress) + mpHeader_X->DataOffset_U32;
+      mpSelf_X  = (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? &mpHeader_X->Producer_X : &mpHeader_X->Consumer_X;
+      mpPeer_X  = (mShmRingParam_X.Role_E == BOF_SHM_RING_ROLE_PRODUCER) ? &mpHeader_X->Consumer_X : &mpHeader_X->Producer_X;
+      //Take our side if it is free or if its previous owner is dead
+      MyPid_U32 = S_GetPid();
+      Pid_U32   = mpSelf_X->Pid_U32.load();
+      Rts_E     = BOF_ERR_EBUSY;
+      if (((Pid_U32 == 0) || (!S_IsPidAlive(Pid_U32))) && (mpSelf_X->Pid_U32.compare_exchange_strong(Pid_U32, MyPid_U32)))
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        mpSelf_X->NbAttach_U32.fetch_add(1);
+        Heartbeat();
+        mLocalIndex_U64      = mpSelf_X->Index_U64.load();
+        mCachedPeerIndex_U64 = mpPeer_X->Index_U64.load();
+      }
+    }
+    if (Rts_E != BOF_ERR_NO_ERROR)
+    {
+      mpSelf_X = nullptr;
+      mpPeer_X = nullptr;
+      if (Bof_IsSharedMemoryValid(mSharedMemory_X))
+      {
+        Bof_CloseSharedMemory(mSharedMemory_X);
+      }
+      mpHeader_X = nullptr;
+      mpData_U8  = nullptr;
+    }
+    return Rts_E;
+  }
+
+  void Close()
+  {
+    if (mpSelf_X)
+    {
+      //Detach and wake a blocked peer so that it re-evaluates its wait at once
+      mpSelf_X->Pid_U32.store(0);
+      mpPeer_X->WakeSeq_U32.fetch_add(1);
+      S_FutexWake(mpPeer_X->WakeSeq_U32);
+      mpSelf_X = nullptr;
+      mpPeer_X = nullptr;
+    }
+    if (Bof_IsSharedMemoryValid(mSharedMemory_X))
+    {
+      Bof_CloseSharedMemory(mSharedMemory_X);
+    }
+    mpHeader_X   = nullptr;
+    mpData_U8    = nullptr;
+    mErrorCode_E = BOF_ERR_NOT_OPENED;
+  }
+};
+
+END_BOF_NAMESPACE()
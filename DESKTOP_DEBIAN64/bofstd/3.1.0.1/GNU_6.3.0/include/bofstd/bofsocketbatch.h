@@ -0,0 +1,574 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the batched udp datagram api (recvmmsg/sendmmsg with
+ * kernel time stamp, gso and gro) working on a BofSocket handle.
+ *
+ * Name:        bofsocketbatch.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only: the other platforms return BOF_ERR_NOT_SUPPORTED.
+ *              Gso needs a 4.18 kernel, gro a 5.0 one. They are probed and
+ *              silently disabled when the running kernel does not know them.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocket.h>
+#include <bofstd/bofsockettimestamp.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofsystem.h>
+#include <string.h>
+#include <vector>
+#if defined(__linux__)
+#include <errno.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if defined(__linux__)
+#define BOF_SOCKET_BATCH_AVAILABLE 1
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#else
+#define BOF_SOCKET_BATCH_AVAILABLE 0
+#endif
+
+#define BOF_SOCKET_BATCH_MAX_GSO_SEGMENT 64     /*! Kernel UDP_MAX_SEGMENTS on the oldest gso capable kernels */
+#define BOF_SOCKET_BATCH_MAX_GSO_SIZE    65000  /*! Udp payload limit of a gso super datagram minus some room for the headers */
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_DATAGRAM
+{
+  uint8_t            *pBuffer_U8;               /*! Caller owned datagram buffer */
+  uint32_t           BufferSizeInByte_U32;      /*! Read: capacity of pBuffer_U8. Write: unused */
+  uint32_t           Nb_U32;                    /*! Read: number of byte received. Write: number of byte to send */
+  BOF_SOCKET_ADDRESS PeerAddress_X;             /*! Read: source address. Write: destination, ignored when its family is AF_UNSPEC (connected socket) */
+  uint64_t           KernelTimeStampInNs_U64;   /*! Read: SO_TIMESTAMPNS/SO_TIMESTAMPING software reception time (CLOCK_REALTIME), 0 if not available */
+  uint64_t           HardwareTimeStampInNs_U64; /*! Read: SO_TIMESTAMPING raw hardware reception time (see BofSocketTimeStamp), 0 if not available */
+  uint16_t           SegmentSize_U16;           /*! Read: gro segment size when several datagrams were coalesced, 0 otherwise. Write: gso segment size, 0 for a plain datagram */
+  bool               Truncated_B;               /*! Read: the datagram did not fit in pBuffer_U8 */
+
+  BOF_SOCKET_DATAGRAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    pBuffer_U8 = nullptr;
+    BufferSizeInByte_U32 = 0;
+    Nb_U32 = 0;
+    PeerAddress_X.Reset();
+    memset(&PeerAddress_X.IpV4Address_X, 0, sizeof(PeerAddress_X.IpV4Address_X));
+    memset(&PeerAddress_X.IpV6Address_X, 0, sizeof(PeerAddress_X.IpV6Address_X));
+    KernelTimeStampInNs_U64 = 0;
+    HardwareTimeStampInNs_U64 = 0;
+    SegmentSize_U16 = 0;
+    Truncated_B = false;
+  }
+};
+
+struct BOF_SOCKET_DATAGRAM_BATCH_PARAM
+{
+  uint32_t MaxBatch_U32;         /*! Maximum number of datagram moved by one syscall */
+  bool     KernelTimeStamp_B;    /*! Ask SO_TIMESTAMPNS on the socket */
+  bool     Gro_B;                /*! Ask UDP_GRO on the socket: the buffers must then be large enough to get the coalesced datagrams (64 KB) */
+
+  BOF_SOCKET_DATAGRAM_BATCH_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    MaxBatch_U32 = 64;
+    KernelTimeStamp_B = true;
+    Gro_B = false;
+  }
+};
+
+struct BOF_SOCKET_DATAGRAM_BATCH_STATISTIC
+{
+  uint64_t NbReadCall_U64;
+  uint64_t NbReadTimeout_U64;
+  uint64_t NbDatagramRead_U64;
+  uint64_t NbByteRead_U64;
+  uint64_t NbGroDatagram_U64;       /*! Number of received buffers holding several coalesced datagrams */
+  uint64_t NbTruncated_U64;
+  uint64_t NbWriteCall_U64;
+  uint64_t NbDatagramWritten_U64;   /*! Number of buffers handed to the kernel (a gso buffer counts for one) */
+  uint64_t NbByteWritten_U64;
+  uint64_t NbGsoDatagram_U64;
+  uint64_t NbError_U64;
+
+  BOF_SOCKET_DATAGRAM_BATCH_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbReadCall_U64 = 0;
+    NbReadTimeout_U64 = 0;
+    NbDatagramRead_U64 = 0;
+    NbByteRead_U64 = 0;
+    NbGroDatagram_U64 = 0;
+    NbTruncated_U64 = 0;
+    NbWriteCall_U64 = 0;
+    NbDatagramWritten_U64 = 0;
+    NbByteWritten_U64 = 0;
+    NbGsoDatagram_U64 = 0;
+    NbError_U64 = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Batched udp datagram reader/writer
+ *
+ * Description
+ * Moves up to MaxBatch_U32 datagrams per syscall on an udp socket (recvmmsg/sendmmsg) instead of one
+ * recvfrom/sendto per datagram as BofSocket::V_ReadData/V_WriteData do. The datagram buffers stay owned by
+ * the caller: the object only keeps the preallocated msghdr, iovec, address and control arrays so that a
+ * call does not allocate. The socket is not owned either and must outlive the object.
+ * An object is not thread safe: use one per reading thread and one per writing thread.
+ *
+ * See Also
+ * BofSocket
+ */
+class BofSocketDatagramBatch
+{
+private:
+#if BOF_SOCKET_BATCH_AVAILABLE
+  static constexpr uint32_t S_CONTROL_SIZE = BOF_SOCKET_TIMESTAMP_CONTROL_SIZE + CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(uint16_t));
+#endif
+  BOFSOCKET                           mSocket;
+  BOF_SOCKET_DATAGRAM_BATCH_PARAM     mDatagramBatchParam_X;
+  BOFERR                              mErrorCode_E = BOF_ERR_INIT;
+  bool                                mKernelTimeStamp_B = false;
+  bool                                mGro_B = false;
+  bool                                mGso_B = false;
+  BOF_SOCKET_DATAGRAM_BATCH_STATISTIC mDatagramBatchStatistic_X;
+#if BOF_SOCKET_BATCH_AVAILABLE
+  std::vector<struct mmsghdr>          mMsgCollection;
+  std::vector<struct iovec>            mIoVecCollection;
+  std::vector<struct sockaddr_storage> mPeerCollection;
+  std::vector<uint8_t>                 mControlCollection;
+#endif
+
+public:
+  BofSocketDatagramBatch(BOFSOCKET _Socket, const BOF_SOCKET_DATAGRAM_BATCH_PARAM &_rDatagramBatchParam_X)
+  {
+    Open(_Socket, _rDatagramBatchParam_X);
+  }
+  BofSocketDatagramBatch(BofSocket &_rBofSocket, const BOF_SOCKET_DATAGRAM_BATCH_PARAM &_rDatagramBatchParam_X)
+  {
+    Open(_rBofSocket.GetSocketHandle(), _rDatagramBatchParam_X);
+  }
+  virtual ~BofSocketDatagramBatch()
+  {
+  }
+  BofSocketDatagramBatch &operator=(const BofSocketDatagramBatch &) = delete; // Disallow copying
+  BofSocketDatagramBatch(const BofSocketDatagramBatch &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+  bool IsKernelTimeStampEnabled() const
+  {
+    return mKernelTimeStamp_B;
+  }
+  bool IsGroEnabled() const
+  {
+    return mGro_B;
+  }
+  bool IsGsoSupported() const
+  {
+    return mGso_B;
+  }
+
+  /*!
+   * Description
+   * Reads up to _NbMax_U32 datagrams with a single recvmmsg. The call returns as soon as one datagram is there:
+   * the datagrams already queued behind it come in the same call, it does not wait to fill the batch.
+   *
+   * Parameters
+   * _TimeoutInMs_U32:  Specifies how long to wait for the first datagram. 0 does not wait.
+   * _NbMax_U32: Specifies the number of entries of _pDatagram_X (clipped to MaxBatch_U32)
+   * _pDatagram_X: Specifies the datagram array. pBuffer_U8/BufferSizeInByte_U32 must be set, the other fields are filled.
+   * _rNbRead_U32:  Returns the number of entries filled.
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if at least one datagram was read, BOF_ERR_ETIMEDOUT if none arrived in time.
+   */
+  BOFERR ReadDatagram(uint32_t _TimeoutInMs_U32, uint32_t _NbMax_U32, BOF_SOCKET_DATAGRAM *_pDatagram_X, uint32_t &_rNbRead_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_BATCH_AVAILABLE
+    uint32_t i_U32, Nb_U32;
+    int Sts_i;
+
+    _rNbRead_U32 = 0;
+    Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_pDatagram_X) && (_NbMax_U32))
+    {
+      Nb_U32 = (_NbMax_U32 > mDatagramBatchParam_X.MaxBatch_U32) ? mDatagramBatchParam_X.MaxBatch_U32 : _NbMax_U32;
+      for (i_U32 = 0; i_U32 < Nb_U32; i_U32++)
+      {
+        mIoVecCollection[i_U32].iov_base = _pDatagram_X[i_U32].pBuffer_U8;
+        mIoVecCollection[i_U32].iov_len = _pDatagram_X[i_U32].BufferSizeInByte_U32;
+        PrepareMsg(i_U32, sizeof(struct sockaddr_storage), S_CONTROL_SIZE);
+      }
+      Rts_E = WaitFor(POLLIN, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mDatagramBatchStatistic_X.NbReadCall_U64++;
+        Sts_i = recvmmsg(mSocket, mMsgCollection.data(), Nb_U32, MSG_DONTWAIT, nullptr);
+        if (Sts_i > 0)
+        {
+          _rNbRead_U32 = static_cast<uint32_t>(Sts_i);
+          for (i_U32 = 0; i_U32 < _rNbRead_U32; i_U32++)
+          {
+            FillDatagram(i_U32, _pDatagram_X[i_U32]);
+          }
+          mDatagramBatchStatistic_X.NbDatagramRead_U64 += _rNbRead_U32;
+        }
+        else
+        {
+          Rts_E = ErrnoToError(Sts_i);
+        }
+      }
+      if (Rts_E == BOF_ERR_ETIMEDOUT)
+      {
+        mDatagramBatchStatistic_X.NbReadTimeout_U64++;
+      }
+      else if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        mDatagramBatchStatistic_X.NbError_U64++;
+      }
+    }
+#else
+    _rNbRead_U32 = 0;
+#endif
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Writes _Nb_U32 datagrams with as few sendmmsg as possible. An entry with a non zero SegmentSize_U16 is a gso
+   * super datagram: the kernel (or the nic) splits it in Nb_U32 / SegmentSize_U16 wire datagrams, the last one
+   * being shorter if Nb_U32 is not a multiple of SegmentSize_U16.
+   *
+   * Parameters
+   * _TimeoutInMs_U32:  Specifies how long to wait for socket buffer space when the kernel pushes back. 0 does not wait.
+   * _Nb_U32: Specifies the number of entries of _pDatagram_X
+   * _pDatagram_X: Specifies the datagram array (pBuffer_U8, Nb_U32, PeerAddress_X and SegmentSize_U16 are used).
+   * _rNbWritten_U32:  Returns the number of entries handed to the kernel.
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if all the entries were written, BOF_ERR_ETIMEDOUT if the socket stayed full.
+   */
+  BOFERR WriteDatagram(uint32_t _TimeoutInMs_U32, uint32_t _Nb_U32, const BOF_SOCKET_DATAGRAM *_pDatagram_X, uint32_t &_rNbWritten_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_BATCH_AVAILABLE
+    uint32_t Start_U32, Elapsed_U32, i_U32, Nb_U32;
+    int Sts_i;
+
+    _rNbWritten_U32 = 0;
+    Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_pDatagram_X))
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      for (i_U32 = 0; (i_U32 < _Nb_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+      {
+        if (_pDatagram_X[i_U32].SegmentSize_U16)
+        {
+          Rts_E = mGso_B ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_SUPPORTED;
+          if ((Rts_E == BOF_ERR_NO_ERROR) && ((_pDatagram_X[i_U32].Nb_U32 > BOF_SOCKET_BATCH_MAX_GSO_SIZE) || (((_pDatagram_X[i_U32].Nb_U32 + _pDatagram_X[i_U32].SegmentSize_U16 - 1) / _pDatagram_X[i_U32].SegmentSize_U16) > BOF_SOCKET_BATCH_MAX_GSO_SEGMENT)))
+          {
+            Rts_E = BOF_ERR_TOO_BIG;
+          }
+        }
+      }
+      Start_U32 = Bof_GetMsTickCount();
+      while ((Rts_E == BOF_ERR_NO_ERROR) && (_rNbWritten_U32 < _Nb_U32))
+      {
+        Nb_U32 = _Nb_U32 - _rNbWritten_U32;
+        if (Nb_U32 > mDatagramBatchParam_X.MaxBatch_U32)
+        {
+          Nb_U32 = mDatagramBatchParam_X.MaxBatch_U32;
+        }
+        for (i_U32 = 0; i_U32 < Nb_U32; i_U32++)
+        {
+          PrepareWrite(i_U32, _pDatagram_X[_rNbWritten_U32 + i_U32]);
+        }
+        mDatagramBatchStatistic_X.NbWriteCall_U64++;
+        Sts_i = sendmmsg(mSocket, mMsgCollection.data(), Nb_U32, MSG_DONTWAIT);
+        if (Sts_i > 0)
+        {
+          for (i_U32 = 0; i_U32 < static_cast<uint32_t>(Sts_i); i_U32++)
+          {
+            mDatagramBatchStatistic_X.NbByteWritten_U64 += _pDatagram_X[_rNbWritten_U32 + i_U32].Nb_U32;
+            if (_pDatagram_X[_rNbWritten_U32 + i_U32].SegmentSize_U16)
+            {
+              mDatagramBatchStatistic_X.NbGsoDatagram_U64++;
+            }
+          }
+          _rNbWritten_U32 += static_cast<uint32_t>(Sts_i);
+          mDatagramBatchStatistic_X.NbDatagramWritten_U64 += static_cast<uint32_t>(Sts_i);
+        }
+        else
+        {
+          Rts_E = ErrnoToError(Sts_i);
+          if (Rts_E == BOF_ERR_ETIMEDOUT)
+          {
+            // Socket full: wait for space only while time remains, otherwise give up with BOF_ERR_ETIMEDOUT
+            Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+            if (Elapsed_U32 < _TimeoutInMs_U32)
+            {
+              Rts_E = WaitFor(POLLOUT, _TimeoutInMs_U32 - Elapsed_U32);
+            }
+          }
+        }
+      }
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        mDatagramBatchStatistic_X.NbError_U64++;
+      }
+    }
+#else
+    _rNbWritten_U32 = 0;
+#endif
+    return Rts_E;
+  }
+
+  BOF_SOCKET_DATAGRAM_BATCH_STATISTIC DatagramBatchStatistic() const
+  {
+    return mDatagramBatchStatistic_X;
+  }
+  void ResetDatagramBatchStatistic()
+  {
+    mDatagramBatchStatistic_X.Reset();
+  }
+  std::string DatagramBatchDebugInfo() const
+  {
+    const BOF_SOCKET_DATAGRAM_BATCH_STATISTIC &rStat_X = mDatagramBatchStatistic_X;
+
+    return Bof_Sprintf("Batch %d Ts %d Gro %d Gso %d Rd call %lld/%lld dg (%.2f/call) %lld B gro %lld trunc %lld to %lld Wr call %lld/%lld dg (%.2f/call) %lld B gso %lld Err %lld", mDatagramBatchParam_X.MaxBatch_U32,
+                       mKernelTimeStamp_B, mGro_B, mGso_B, rStat_X.NbReadCall_U64, rStat_X.NbDatagramRead_U64, rStat_X.NbReadCall_U64 ? static_cast<double>(rStat_X.NbDatagramRead_U64) / static_cast<double>(rStat_X.NbReadCall_U64) : 0.0,
+                       rStat_X.NbByteRead_U64, rStat_X.NbGroDatagram_U64, rStat_X.NbTruncated_U64, rStat_X.NbReadTimeout_U64, rStat_X.NbWriteCall_U64, rStat_X.NbDatagramWritten_U64,
+                       rStat_X.NbWriteCall_U64 ? static_cast<double>(rStat_X.NbDatagramWritten_U64) / static_cast<double>(rStat_X.NbWriteCall_U64) : 0.0, rStat_X.NbByteWritten_U64, rStat_X.NbGsoDatagram_U64,
+                       rStat_X.NbError_U64);
+  }
+
+private:
+  void Open(BOFSOCKET _Socket, const BOF_SOCKET_DATAGRAM_BATCH_PARAM &_rDatagramBatchParam_X)
+  {
+    mSocket = _Socket;
+    mDatagramBatchParam_X = _rDatagramBatchParam_X;
+    mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_BATCH_AVAILABLE
+    int Val_i, Type_i;
+    socklen_t Len;
+
+    mErrorCode_E = BOF_ERR_EINVAL;
+    Len = sizeof(Type_i);
+    if ((mSocket != BOFSOCKET_INVALID) && (mDatagramBatchParam_X.MaxBatch_U32) && (getsockopt(mSocket, SOL_SOCKET, SO_TYPE, &Type_i, &Len) == 0) && (Type_i == SOCK_DGRAM))
+    {
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      mMsgCollection.resize(mDatagramBatchParam_X.MaxBatch_U32);
+      mIoVecCollection.resize(mDatagramBatchParam_X.MaxBatch_U32);
+      mPeerCollection.resize(mDatagramBatchParam_X.MaxBatch_U32);
+      mControlCollection.resize(static_cast<size_t>(mDatagramBatchParam_X.MaxBatch_U32) * S_CONTROL_SIZE);
+      if (mDatagramBatchParam_X.KernelTimeStamp_B)
+      {
+        Val_i = 1;
+        mKernelTimeStamp_B = (setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMPNS, &Val_i, sizeof(Val_i)) == 0);
+      }
+      if (mDatagramBatchParam_X.Gro_B)
+      {
+        Val_i = 1;
+        mGro_B = (setsockopt(mSocket, SOL_UDP, UDP_GRO, &Val_i, sizeof(Val_i)) == 0);
+      }
+      // Probe only: the gso segment size is given per datagram with a cmsg
+      Len = sizeof(Val_i);
+      mGso_B = (getsockopt(mSocket, SOL_UDP, UDP_SEGMENT, &Val_i, &Len) == 0);
+    }
+#endif
+  }
+
+#if BOF_SOCKET_BATCH_AVAILABLE
+  BOFERR ErrnoToError(int _Sts_i) const
+  {
+    BOFERR Rts_E = BOF_ERR_EMPTY;
+
+    if (_Sts_i < 0)
+    {
+      Rts_E = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? BOF_ERR_ETIMEDOUT : static_cast<BOFERR>(errno);
+    }
+    return Rts_E;
+  }
+
+  // A 0 timeout does not poll and returns BOF_ERR_NO_ERROR: the caller then tries its non blocking call once
+  BOFERR WaitFor(short _Event_i, uint32_t _TimeoutInMs_U32) const
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+    struct pollfd Fd_X;
+    int Sts_i;
+
+    if (_TimeoutInMs_U32)
+    {
+      Fd_X.fd = mSocket;
+      Fd_X.events = _Event_i;
+      Fd_X.revents = 0;
+      do
+      {
+        Sts_i = poll(&Fd_X, 1, static_cast<int>(_TimeoutInMs_U32));
+      } while ((Sts_i < 0) && (errno == EINTR));
+      if (Sts_i == 0)
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+      }
+      else if (Sts_i < 0)
+      {
+        Rts_E = static_cast<BOFERR>(errno);
+      }
+    }
+    return Rts_E;
+  }
+
+  void PrepareMsg(uint32_t _Index_U32, socklen_t _NameLen, uint32_t _ControlLen_U32)
+  {
+    struct msghdr &rMsg_X = mMsgCollection[_Index_U32].msg_hdr;
+
+    rMsg_X.msg_name = _NameLen ? &mPeerCollection[_Index_U32] : nullptr;
+    rMsg_X.msg_namelen = _NameLen;
+    rMsg_X.msg_iov = &mIoVecCollection[_Index_U32];
+    rMsg_X.msg_iovlen = 1;
+    rMsg_X.msg_control = _ControlLen_U32 ? &mControlCollection[static_cast<size_t>(_Index_U32) * S_CONTROL_SIZE] : nullptr;
+    rMsg_X.msg_controllen = _ControlLen_U32;
+    rMsg_X.msg_flags = 0;
+    mMsgCollection[_Index_U32].msg_len = 0;
+  }
+
+  void PrepareWrite(uint32_t _Index_U32, const BOF_SOCKET_DATAGRAM &_rDatagram_X)
+  {
+    socklen_t NameLen = 0;
+    uint32_t ControlLen_U32 = 0;
+    struct cmsghdr *pCmsg_X;
+
+    mIoVecCollection[_Index_U32].iov_base = _rDatagram_X.pBuffer_U8;
+    mIoVecCollection[_Index_U32].iov_len = _rDatagram_X.Nb_U32;
+    if (_rDatagram_X.PeerAddress_X.IpV6_B)
+    {
+      if (_rDatagram_X.PeerAddress_X.IpV6Address_X.sin6_family == AF_INET6)
+      {
+        NameLen = sizeof(_rDatagram_X.PeerAddress_X.IpV6Address_X);
+        memcpy(&mPeerCollection[_Index_U32], &_rDatagram_X.PeerAddress_X.IpV6Address_X, NameLen);
+      }
+    }
+    else if (_rDatagram_X.PeerAddress_X.IpV4Address_X.sin_family == AF_INET)
+    {
+      NameLen = sizeof(_rDatagram_X.PeerAddress_X.IpV4Address_X);
+      memcpy(&mPeerCollection[_Index_U32], &_rDatagram_X.PeerAddress_X.IpV4Address_X, NameLen);
+    }
+    if (_rDatagram_X.SegmentSize_U16)
+    {
+      ControlLen_U32 = CMSG_SPACE(sizeof(uint16_t));
+    }
+    PrepareMsg(_Index_U32, NameLen, ControlLen_U32);
+    if (ControlLen_U32)
+    {
+      pCmsg_X = CMSG_FIRSTHDR(&mMsgCollection[_Index_U32].msg_hdr);
+      pCmsg_X->cmsg_level = SOL_UDP;
+      pCmsg_X->cmsg_type = UDP_SEGMENT;
+      pCmsg_X->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      memcpy(CMSG_DATA(pCmsg_X), &_rDatagram_X.SegmentSize_U16, sizeof(uint16_t));
+    }
+  }
+
+  void FillDatagram(uint32_t _Index_U32, BOF_SOCKET_DATAGRAM &_rDatagram_X)
+  {
+    const struct mmsghdr &rMsg_X = mMsgCollection[_Index_U32];
+    const struct sockaddr_storage &rPeer_X = mPeerCollection[_Index_U32];
+
+    _rDatagram_X.Nb_U32 = rMsg_X.msg_len;
+    _rDatagram_X.Truncated_B = ((rMsg_X.msg_hdr.msg_flags & MSG_TRUNC) != 0);
+    _rDatagram_X.PeerAddress_X.SocketType_E = BOF_SOCK_TYPE::BOF_SOCK_UDP;
+    _rDatagram_X.PeerAddress_X.ProtocolType_E = BOF_PROTOCOL_TYPE::BOF_PROTOCOL_UDP;
+    _rDatagram_X.PeerAddress_X.IpV6_B = (rPeer_X.ss_family == AF_INET6);
+    if (_rDatagram_X.PeerAddress_X.IpV6_B)
+    {
+      memcpy(&_rDatagram_X.PeerAddress_X.IpV6Address_X, &rPeer_X, sizeof(_rDatagram_X.PeerAddress_X.IpV6Address_X));
+    }
+    else
+    {
+      memcpy(&_rDatagram_X.PeerAddress_X.IpV4Address_X, &rPeer_X, sizeof(_rDatagram_X.PeerAddress_X.IpV4Address_X));
+    }
+    ParseControlMessage(rMsg_X.msg_hdr, _rDatagram_X);
+    mDatagramBatchStatistic_X.NbByteRead_U64 += _rDatagram_X.Nb_U32;
+    if (_rDatagram_X.Truncated_B)
+    {
+      mDatagramBatchStatistic_X.NbTruncated_U64++;
+    }
+    if (_rDatagram_X.SegmentSize_U16)
+    {
+      mDatagramBatchStatistic_X.NbGroDatagram_U64++;
+    }
+  }
+
+  // Extracts the reception time stamps and the gro segment size from the ancillary data of a received datagram
+  void ParseControlMessage(const struct msghdr &_rMsg_X, BOF_SOCKET_DATAGRAM &_rDatagram_X) const
+  {
+    BOF_SOCKET_TIMESTAMP TimeStamp_X;
+    struct cmsghdr *pCmsg_X;
+    int Segment_i;
+
+    Bof_SocketParseTimeStamp(_rMsg_X, TimeStamp_X);
+    _rDatagram_X.KernelTimeStampInNs_U64 = TimeStamp_X.SoftwareInNs_U64;
+    _rDatagram_X.HardwareTimeStampInNs_U64 = TimeStamp_X.HardwareInNs_U64;
+    _rDatagram_X.SegmentSize_U16 = 0;
+    for (pCmsg_X = CMSG_FIRSTHDR(&_rMsg_X); pCmsg_X != nullptr; pCmsg_X = CMSG_NXTHDR(const_cast<struct msghdr *>(&_rMsg_X), pCmsg_X))
+    {
+      if ((pCmsg_X->cmsg_level == SOL_UDP) && (pCmsg_X->cmsg_type == UDP_GRO))
+      {
+        memcpy(&Segment_i, CMSG_DATA(pCmsg_X), sizeof(Segment_i));
+        _rDatagram_X.SegmentSize_U16 = static_cast<uint16_t>(Segment_i);
+      }
+    }
+  }
+#endif
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,737 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the coalescing socket writer which gathers the pending
+ * write requests of a session into vectored sends.
+ *
+ * Name:        bofsocketcoalescingwriter.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Not available on Windows (BOF_ERR_NOT_SUPPORTED)
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocketio.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofsystem.h>
+#include <bofstd/boftimingwheel.h>
+#include <deque>
+#include <string>
+#include <vector>
+#if !defined(_WIN32)
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if defined(IOV_MAX)
+constexpr uint32_t BOF_SOCKET_COALESCING_WRITER_MAX_IOVEC = (IOV_MAX < 1024) ? IOV_MAX : 1024;
+#else
+constexpr uint32_t BOF_SOCKET_COALESCING_WRITER_MAX_IOVEC = 1024;
+#endif
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_COALESCING_FLUSH_REASON : uint32_t
+{
+  BOF_SOCKET_COALESCING_FLUSH_REASON_BYTE = 0,     //MaxCoalescedByte_U32 reached
+  BOF_SOCKET_COALESCING_FLUSH_REASON_COUNT,        //MaxCoalescedRequest_U32 reached
+  BOF_SOCKET_COALESCING_FLUSH_REASON_LATENCY,      //MaxLatencyInMs_U32 elapsed since the oldest pending request
+  BOF_SOCKET_COALESCING_FLUSH_REASON_EXPLICIT,     //Flush called by the user
+  BOF_SOCKET_COALESCING_FLUSH_REASON_MAX
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_COALESCING_WRITER_PARAM
+{
+  uint32_t       NbMaxPendingRequest_U32;   /*! Same meaning as BOF_SOCKET_IO_PARAM::NbMaxAsyncWritePendingRequest_U32: Write returns BOF_ERR_FULL above */
+  uint32_t       MaxCoalescedByte_U32;      /*! Byte budget: pending data is sent as soon as it reaches this size */
+  uint32_t       MaxCoalescedRequest_U32;   /*! Request budget: pending data is sent as soon as this number of request is queued (capped to the iovec limit) */
+  uint32_t       MaxLatencyInMs_U32;        /*! Latency budget: the oldest pending request is never held longer. 0 sends each request at once */
+  uint32_t       CopyThresholdInByte_U32;   /*! Smaller requests are copied so that the caller can reuse its buffer on return */
+  BofTimingWheel *pTimingWheel;             /*! Optional wheel driving the latency budget (see S_OnLatencyExpired). Without it, call FlushIfDue periodically */
+
+  BOF_SOCKET_COALESCING_WRITER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbMaxPendingRequest_U32 = 256;
+    MaxCoalescedByte_U32 = 64 * 1024;
+    MaxCoalescedRequest_U32 = 64;
+    MaxLatencyInMs_U32 = 2;
+    CopyThresholdInByte_U32 = 512;
+    pTimingWheel = nullptr;
+  }
+};
+
+struct BOF_SOCKET_COALESCING_WRITER_STATISTIC
+{
+  uint64_t NbRequest_U64;
+  uint64_t NbCopiedRequest_U64;
+  uint64_t NbRequestRejected_U64;           /*! BOF_ERR_FULL returned by Write */
+  uint64_t NbByteWritten_U64;
+  uint64_t NbSyscall_U64;                   /*! Number of sendmsg issued */
+  uint64_t NbPartialWrite_U64;              /*! sendmsg which did not take everything (socket buffer full) */
+  uint64_t pNbFlush_U64[static_cast<uint32_t>(BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_MAX)];
+  uint32_t NbMaxRequestPerSyscall_U32;
+  uint64_t NbError_U64;
+
+  BOF_SOCKET_COALESCING_WRITER_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    uint32_t i_U32;
+
+    NbRequest_U64 = 0;
+    NbCopiedRequest_U64 = 0;
+    NbRequestRejected_U64 = 0;
+    NbByteWritten_U64 = 0;
+    NbSyscall_U64 = 0;
+    NbPartialWrite_U64 = 0;
+    for (i_U32 = 0; i_U32 < static_cast<uint32_t>(BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_MAX); i_U32++)
+    {
+      pNbFlush_U64[i_U32] = 0;
+    }
+    NbMaxRequestPerSyscall_U32 = 0;
+    NbError_U64 = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Coalescing socket writer
+ *
+ * Description
+ * Queues the write requests of one session and sends all of them with a single sendmsg (writev) as soon as the
+ * byte or request budget is reached or when the oldest one has waited MaxLatencyInMs_U32. A control channel
+ * sending a burst of small replies then costs one syscall instead of one per reply.
+ * Each request is completed in order with IBofSocketIo::V_SignalDataWritten once all its bytes are in the
+ * socket, or with the error status if the socket fails (the not yet sent requests get it too). As with the
+ * BofSocketIo asynchronous writes, the buffer of a request bigger than CopyThresholdInByte_U32 must stay valid up
+ * to its completion.
+ * Write and Flush can be called from any thread, and from V_SignalDataWritten. The completions are delivered
+ * by one thread at a time, in order.
+ * When a timing wheel is used, its OnExpired callback must forward the expired timers to S_OnLatencyExpired and
+ * the writer must be destroyed on the thread which calls Advance (or once it has stopped).
+ *
+ * See Also
+ * BofSocketIo, BofTimingWheel
+ */
+class BofSocketCoalescingWriter
+{
+private:
+  struct WRITE_REQUEST
+  {
+    BOF_SOCKET_WRITE_PARAM WriteParam_X;
+    std::string            Copy_S;          /*! Owns the data of a copied request */
+    uint32_t               NbSent_U32;
+  };
+  struct WRITE_COMPLETION
+  {
+    BOFERR                 Sts_E;
+    BOF_SOCKET_WRITE_PARAM WriteParam_X;
+    std::string            Copy_S;
+    uint32_t               NbSent_U32;
+  };
+
+  BOFSOCKET                              mSocket;
+  IBofSocketIo                           *mpIBofSocketIo = nullptr;
+  BOF_SOCKET_COALESCING_WRITER_PARAM     mSocketCoalescingWriterParam_X;
+  BOFERR                                 mErrorCode_E = BOF_ERR_INIT;
+  BOF_MUTEX                              mMtx_X;
+  std::deque<WRITE_REQUEST>              mPendingCollection;
+  std::deque<WRITE_COMPLETION>           mCompletionCollection;
+  bool                                   mNotifying_B = false;
+  uint64_t                               mNbPendingByte_U64 = 0;
+  uint32_t                               mOldestPendingTimeInMs_U32 = 0;
+  BOF_TIMER_HANDLE                       mLatencyTimer = BOF_TIMER_HANDLE_INVALID;
+  std::vector<struct iovec>              mIoVecCollection;
+  BOF_SOCKET_COALESCING_WRITER_STATISTIC mSocketCoalescingWriterStatistic_X;
+
+public:
+  BofSocketCoalescingWriter(BOFSOCKET _Socket, IBofSocketIo *_pIBofSocketIo, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X);
+  BofSocketCoalescingWriter(std::shared_ptr<BofSocketIo> _psSocketSession, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X);
+  virtual ~BofSocketCoalescingWriter();
+
+  BofSocketCoalescingWriter &operator=(const BofSocketCoalescingWriter &) = delete; // Disallow copying
+  BofSocketCoalescingWriter(const BofSocketCoalescingWriter &) = delete;
+
+  BOFERR LastErrorCode() const;
+  BOFERR Write(uint32_t _Nb_U32, const uint8_t *_pBuffer_U8, void *_pWriteContext);
+  BOFERR Write(const std::string &_rBuffer_S, void *_pWriteContext);
+  BOFERR Flush(uint32_t _TimeoutInMs_U32);
+  BOFERR FlushIfDue();
+  uint32_t NextFlushInMs(uint32_t _MaxWaitInMs_U32);
+  uint32_t NbPendingRequest();
+  uint64_t NbPendingByte();
+  BOF_SOCKET_COALESCING_WRITER_STATISTIC SocketCoalescingWriterStatistic();
+  void ResetSocketCoalescingWriterStatistic();
+  std::string SocketCoalescingWriterDebugInfo();
+
+  static void S_OnLatencyExpired(const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection);
+
+private:
+  void Open(BOFSOCKET _Socket, IBofSocketIo *_pIBofSocketIo, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X);
+  BOFERR SendPending(BOF_SOCKET_COALESCING_FLUSH_REASON _Reason_E);
+  void FailPending(BOFERR _Sts_E);
+  void ArmLatencyTimer();
+  void CancelLatencyTimer();
+  void NotifyCompletion();
+};
+
+inline BofSocketCoalescingWriter::BofSocketCoalescingWriter(BOFSOCKET _Socket, IBofSocketIo *_pIBofSocketIo, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X)
+{
+  Open(_Socket, _pIBofSocketIo, _rSocketCoalescingWriterParam_X);
+}
+
+inline BofSocketCoalescingWriter::BofSocketCoalescingWriter(std::shared_ptr<BofSocketIo> _psSocketSession, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X)
+{
+  Open(_psSocketSession ? _psSocketSession->NativeSocketHandle() : BOFSOCKET_INVALID, _psSocketSession.get(), _rSocketCoalescingWriterParam_X);
+}
+
+inline BofSocketCoalescingWriter::~BofSocketCoalescingWriter()
+{
+  if (mErrorCode_E == BOF_ERR_NO_ERROR)
+  {
+    Flush(0);
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      CancelLatencyTimer();
+      FailPending(BOF_ERR_CANCEL);
+      Bof_UnlockMutex(mMtx_X);
+    }
+    NotifyCompletion();
+    Bof_DestroyMutex(mMtx_X);
+  }
+}
+
+inline void BofSocketCoalescingWriter::Open(BOFSOCKET _Socket, IBofSocketIo *_pIBofSocketIo, const BOF_SOCKET_COALESCING_WRITER_PARAM &_rSocketCoalescingWriterParam_X)
+{
+  mSocket = _Socket;
+  mpIBofSocketIo = _pIBofSocketIo;
+  mSocketCoalescingWriterParam_X = _rSocketCoalescingWriterParam_X;
+  if (mSocketCoalescingWriterParam_X.MaxCoalescedRequest_U32 > BOF_SOCKET_COALESCING_WRITER_MAX_IOVEC)
+  {
+    mSocketCoalescingWriterParam_X.MaxCoalescedRequest_U32 = BOF_SOCKET_COALESCING_WRITER_MAX_IOVEC;
+  }
+#if defined(_WIN32)
+  mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#else
+  mErrorCode_E = BOF_ERR_EINVAL;
+  if ((mSocket != BOFSOCKET_INVALID) && (mSocketCoalescingWriterParam_X.NbMaxPendingRequest_U32) && (mSocketCoalescingWriterParam_X.MaxCoalescedByte_U32) && (mSocketCoalescingWriterParam_X.MaxCoalescedRequest_U32))
+  {
+    mErrorCode_E = Bof_CreateMutex("BofSocketCoalescingWriter", true, true, mMtx_X);
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      mIoVecCollection.resize(mSocketCoalescingWriterParam_X.MaxCoalescedRequest_U32);
+    }
+  }
+#endif
+}
+
+inline BOFERR BofSocketCoalescingWriter::LastErrorCode() const
+{
+  return mErrorCode_E;
+}
+
+/*!
+ * Description
+ * Queues a write request. It is sent at once if it makes the pending data reach the byte or request budget
+ * (or if MaxLatencyInMs_U32 is 0), otherwise when the latency budget of the oldest pending request expires.
+ *
+ * Parameters
+ * _Nb_U32: Specifies the number of byte to write
+ * _pBuffer_U8: Specifies the data. If _Nb_U32 is above CopyThresholdInByte_U32 it must stay valid up to V_SignalDataWritten
+ * _pWriteContext: Specifies the context given back by V_SignalDataWritten
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the request is queued (or sent), BOF_ERR_FULL if NbMaxPendingRequest_U32 requests are pending
+ */
+inline BOFERR BofSocketCoalescingWriter::Write(uint32_t _Nb_U32, const uint8_t *_pBuffer_U8, void *_pWriteContext)
+{
+  BOFERR Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+  BOF_SOCKET_COALESCING_FLUSH_REASON Reason_E;
+  WRITE_REQUEST Request_X;
+
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_pBuffer_U8) && (_Nb_U32))
+  {
+    Request_X.WriteParam_X.Nb_U32 = _Nb_U32;
+    Request_X.WriteParam_X.pBuffer_U8 = _pBuffer_U8;
+    Request_X.WriteParam_X.pWriteContext = _pWriteContext;
+    Request_X.NbSent_U32 = 0;
+    if (_Nb_U32 <= mSocketCoalescingWriterParam_X.CopyThresholdInByte_U32)
+    {
+      Request_X.Copy_S.assign(reinterpret_cast<const char *>(_pBuffer_U8), _Nb_U32);
+    }
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mPendingCollection.size() >= mSocketCoalescingWriterParam_X.NbMaxPendingRequest_U32)
+      {
+        Rts_E = BOF_ERR_FULL;
+        mSocketCoalescingWriterStatistic_X.NbRequestRejected_U64++;
+      }
+      else
+      {
+        if (mPendingCollection.empty())
+        {
+          mOldestPendingTimeInMs_U32 = Bof_GetMsTickCount();
+        }
+        mPendingCollection.push_back(std::move(Request_X));
+        // The deque keeps its elements in place: the copy can be pointed to from now on
+        if (!mPendingCollection.back().Copy_S.empty())
+        {
+          mPendingCollection.back().WriteParam_X.pBuffer_U8 = reinterpret_cast<const uint8_t *>(mPendingCollection.back().Copy_S.data());
+          mSocketCoalescingWriterStatistic_X.NbCopiedRequest_U64++;
+        }
+        mNbPendingByte_U64 += _Nb_U32;
+        mSocketCoalescingWriterStatistic_X.NbRequest_U64++;
+
+        if (mNbPendingByte_U64 >= mSocketCoalescingWriterParam_X.MaxCoalescedByte_U32)
+        {
+          Reason_E = BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_BYTE;
+        }
+        else if (mPendingCollection.size() >= mSocketCoalescingWriterParam_X.MaxCoalescedRequest_U32)
+        {
+          Reason_E = BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_COUNT;
+        }
+        else if (mSocketCoalescingWriterParam_X.MaxLatencyInMs_U32 == 0)
+        {
+          Reason_E = BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_LATENCY;
+        }
+        else
+        {
+          Reason_E = BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_MAX;
+        }
+        if (Reason_E != BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_MAX)
+        {
+          // A full socket is not an error here: what is left waits for the next flush
+          Rts_E = SendPending(Reason_E);
+          if (Rts_E == BOF_ERR_EAGAIN)
+          {
+            Rts_E = BOF_ERR_NO_ERROR;
+          }
+        }
+        if (!mPendingCollection.empty())
+        {
+          ArmLatencyTimer();
+        }
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+    NotifyCompletion();
+  }
+  return Rts_E;
+}
+
+inline BOFERR BofSocketCoalescingWriter::Write(const std::string &_rBuffer_S, void *_pWriteContext)
+{
+  return Write(static_cast<uint32_t>(_rBuffer_S.size()), reinterpret_cast<const uint8_t *>(_rBuffer_S.data()), _pWriteContext);
+}
+
+/*!
+ * Description
+ * Sends all the pending requests now, waiting up to _TimeoutInMs_U32 for socket buffer space.
+ *
+ * Parameters
+ * _TimeoutInMs_U32: Specifies the maximum time to wait when the socket is full. 0 does not wait.
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if nothing is pending anymore, BOF_ERR_EAGAIN if the socket stayed full
+ */
+inline BOFERR BofSocketCoalescingWriter::Flush(uint32_t _TimeoutInMs_U32)
+{
+  BOFERR Rts_E = mErrorCode_E;
+#if !defined(_WIN32)
+  uint32_t Start_U32, Elapsed_U32;
+  struct pollfd Fd_X;
+  int Sts_i;
+
+  Start_U32 = Bof_GetMsTickCount();
+  while (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = SendPending(BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_EXPLICIT);
+      if (mPendingCollection.empty())
+      {
+        CancelLatencyTimer();
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+    NotifyCompletion();
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      // Everything sent: leave the loop with BOF_ERR_NO_ERROR
+      Rts_E = BOF_ERR_FINISHED;
+    }
+    else if (Rts_E == BOF_ERR_EAGAIN)
+    {
+      Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+      if (Elapsed_U32 < _TimeoutInMs_U32)
+      {
+        Fd_X.fd = mSocket;
+        Fd_X.events = POLLOUT;
+        Fd_X.revents = 0;
+        Sts_i = poll(&Fd_X, 1, static_cast<int>(_TimeoutInMs_U32 - Elapsed_U32));
+        Rts_E = ((Sts_i >= 0) || (errno == EINTR)) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+      }
+    }
+  }
+  if (Rts_E == BOF_ERR_FINISHED)
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+  }
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Sends the pending requests if the latency budget of the oldest one has expired. To be called from a poll loop
+ * when no timing wheel is given (see NextFlushInMs to compute the wait timeout).
+ *
+ * Parameters
+ * None
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+inline BOFERR BofSocketCoalescingWriter::FlushIfDue()
+{
+  BOFERR Rts_E = mErrorCode_E;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if ((!mPendingCollection.empty()) && (Bof_ElapsedMsTime(mOldestPendingTimeInMs_U32) >= mSocketCoalescingWriterParam_X.MaxLatencyInMs_U32))
+      {
+        Rts_E = SendPending(BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_LATENCY);
+        if (Rts_E == BOF_ERR_EAGAIN)
+        {
+          Rts_E = BOF_ERR_NO_ERROR;
+        }
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+    NotifyCompletion();
+  }
+  return Rts_E;
+}
+
+//Time before the latency budget of the oldest pending request expires, _MaxWaitInMs_U32 if nothing is pending
+inline uint32_t BofSocketCoalescingWriter::NextFlushInMs(uint32_t _MaxWaitInMs_U32)
+{
+  uint32_t Rts_U32 = _MaxWaitInMs_U32, Elapsed_U32;
+
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR))
+  {
+    if (!mPendingCollection.empty())
+    {
+      Elapsed_U32 = Bof_ElapsedMsTime(mOldestPendingTimeInMs_U32);
+      Rts_U32 = (Elapsed_U32 < mSocketCoalescingWriterParam_X.MaxLatencyInMs_U32) ? mSocketCoalescingWriterParam_X.MaxLatencyInMs_U32 - Elapsed_U32 : 0;
+      if (Rts_U32 > _MaxWaitInMs_U32)
+      {
+        Rts_U32 = _MaxWaitInMs_U32;
+      }
+    }
+    Bof_UnlockMutex(mMtx_X);
+  }
+  return Rts_U32;
+}
+
+inline uint32_t BofSocketCoalescingWriter::NbPendingRequest()
+{
+  uint32_t Rts_U32 = 0;
+
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR))
+  {
+    Rts_U32 = static_cast<uint32_t>(mPendingCollection.size());
+    Bof_UnlockMutex(mMtx_X);
+  }
+  return Rts_U32;
+}
+
+inline uint64_t BofSocketCoalescingWriter::NbPendingByte()
+{
+  uint64_t Rts_U64 = 0;
+
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR))
+  {
+    Rts_U64 = mNbPendingByte_U64;
+    Bof_UnlockMutex(mMtx_X);
+  }
+  return Rts_U64;
+}
+
+inline BOF_SOCKET_COALESCING_WRITER_STATISTIC BofSocketCoalescingWriter::SocketCoalescingWriterStatistic()
+{
+  BOF_SOCKET_COALESCING_WRITER_STATISTIC Rts_X;
+
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR))
+  {
+    Rts_X = mSocketCoalescingWriterStatistic_X;
+    Bof_UnlockMutex(mMtx_X);
+  }
+  return Rts_X;
+}
+
+inline void BofSocketCoalescingWriter::ResetSocketCoalescingWriterStatistic()
+{
+  if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR))
+  {
+    mSocketCoalescingWriterStatistic_X.Reset();
+    Bof_UnlockMutex(mMtx_X);
+  }
+}
+
+inline std::string BofSocketCoalescingWriter::SocketCoalescingWriterDebugInfo()
+{
+  BOF_SOCKET_COALESCING_WRITER_STATISTIC Stat_X = SocketCoalescingWriterStatistic();
+
+  return Bof_Sprintf("Pending %d req %lld B Req %lld copied %lld rejected %lld Syscall %lld (%.2f req/call, max %d) partial %lld %lld B Flush byte %lld count %lld latency %lld explicit %lld Err %lld", NbPendingRequest(), NbPendingByte(),
+                     Stat_X.NbRequest_U64, Stat_X.NbCopiedRequest_U64, Stat_X.NbRequestRejected_U64, Stat_X.NbSyscall_U64,
+                     Stat_X.NbSyscall_U64 ? static_cast<double>(Stat_X.NbRequest_U64) / static_cast<double>(Stat_X.NbSyscall_U64) : 0.0, Stat_X.NbMaxRequestPerSyscall_U32, Stat_X.NbPartialWrite_U64,
+                     Stat_X.NbByteWritten_U64, Stat_X.pNbFlush_U64[0], Stat_X.pNbFlush_U64[1], Stat_X.pNbFlush_U64[2], Stat_X.pNbFlush_U64[3], Stat_X.NbError_U64);
+}
+
+/*!
+ * Description
+ * Expiry callback to plug in the OnExpired of the timing wheel given in BOF_SOCKET_COALESCING_WRITER_PARAM. Each
+ * expired timer flushes the writer it belongs to.
+ *
+ * Parameters
+ * _rExpiredCollection: Specifies the expired timers
+ *
+ * Returns
+ * None
+ */
+inline void BofSocketCoalescingWriter::S_OnLatencyExpired(const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection)
+{
+  BofSocketCoalescingWriter *pWriter;
+
+  for (const BOF_TIMING_WHEEL_EXPIRED &rExpired_X : _rExpiredCollection)
+  {
+    pWriter = reinterpret_cast<BofSocketCoalescingWriter *>(rExpired_X.pUserArg);
+    if ((pWriter) && (Bof_LockMutex(pWriter->mMtx_X) == BOF_ERR_NO_ERROR))
+    {
+      if (pWriter->mLatencyTimer == rExpired_X.TimerHandle)
+      {
+        pWriter->mLatencyTimer = BOF_TIMER_HANDLE_INVALID;
+        pWriter->SendPending(BOF_SOCKET_COALESCING_FLUSH_REASON::BOF_SOCKET_COALESCING_FLUSH_REASON_LATENCY);
+        if (!pWriter->mPendingCollection.empty())
+        {
+          // Socket full: try again one latency budget later
+          pWriter->ArmLatencyTimer();
+        }
+      }
+      Bof_UnlockMutex(pWriter->mMtx_X);
+      pWriter->NotifyCompletion();
+    }
+  }
+}
+
+//Called with mMtx_X locked. Returns BOF_ERR_EAGAIN if the socket could not take everything
+inline BOFERR BofSocketCoalescingWriter::SendPending(BOF_SOCKET_COALESCING_FLUSH_REASON _Reason_E)
+{
+  BOFERR Rts_E = BOF_ERR_NO_ERROR;
+#if !defined(_WIN32)
+  struct msghdr Msg_X;
+  uint32_t NbIoVec_U32, Nb_U32;
+  uint64_t NbByte_U64;
+  ssize_t Sts;
+  bool SocketFull_B = false;
+
+  if (!mPendingCollection.empty())
+  {
+    mSocketCoalescingWriterStatistic_X.pNbFlush_U64[static_cast<uint32_t>(_Reason_E)]++;
+  }
+  while ((Rts_E == BOF_ERR_NO_ERROR) && (!SocketFull_B) && (!mPendingCollection.empty()))
+  {
+    NbIoVec_U32 = 0;
+    NbByte_U64 = 0;
+    for (auto It = mPendingCollection.begin(); (It != mPendingCollection.end()) && (NbIoVec_U32 < mIoVecCollection.size()) && (NbByte_U64 < mSocketCoalescingWriterParam_X.MaxCoalescedByte_U32); It++)
+    {
+      mIoVecCollection[NbIoVec_U32].iov_base = const_cast<uint8_t *>(It->WriteParam_X.pBuffer_U8 + It->NbSent_U32);
+      mIoVecCollection[NbIoVec_U32].iov_len = It->WriteParam_X.Nb_U32 - It->NbSent_U32;
+      NbByte_U64 += mIoVecCollection[NbIoVec_U32].iov_len;
+      NbIoVec_U32++;
+    }
+    memset(&Msg_X, 0, sizeof(Msg_X));
+    Msg_X.msg_iov = mIoVecCollection.data();
+    Msg_X.msg_iovlen = NbIoVec_U32;
+    Sts = sendmsg(mSocket, &Msg_X, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (Sts >= 0)
+    {
+      mSocketCoalescingWriterStatistic_X.NbSyscall_U64++;
+      mSocketCoalescingWriterStatistic_X.NbByteWritten_U64 += static_cast<uint64_t>(Sts);
+      mNbPendingByte_U64 -= static_cast<uint64_t>(Sts);
+      if (static_cast<uint64_t>(Sts) < NbByte_U64)
+      {
+        SocketFull_B = true;
+        mSocketCoalescingWriterStatistic_X.NbPartialWrite_U64++;
+      }
+      if (NbIoVec_U32 > mSocketCoalescingWriterStatistic_X.NbMaxRequestPerSyscall_U32)
+      {
+        mSocketCoalescingWriterStatistic_X.NbMaxRequestPerSyscall_U32 = NbIoVec_U32;
+      }
+      // Completes, in order, every request fully sent and records the progress of the last partial one
+      while (Sts > 0)
+      {
+        WRITE_REQUEST &rRequest_X = mPendingCollection.front();
+
+        Nb_U32 = rRequest_X.WriteParam_X.Nb_U32 - rRequest_X.NbSent_U32;
+        if (static_cast<uint64_t>(Sts) >= Nb_U32)
+        {
+          Sts -= Nb_U32;
+          rRequest_X.NbSent_U32 = rRequest_X.WriteParam_X.Nb_U32;
+          mCompletionCollection.push_back(WRITE_COMPLETION{BOF_ERR_NO_ERROR, rRequest_X.WriteParam_X, std::move(rRequest_X.Copy_S), rRequest_X.NbSent_U32});
+          mPendingCollection.pop_front();
+        }
+        else
+        {
+          rRequest_X.NbSent_U32 += static_cast<uint32_t>(Sts);
+          Sts = 0;
+        }
+      }
+    }
+    else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+    {
+      SocketFull_B = true;
+    }
+    else if (errno != EINTR)
+    {
+      Rts_E = static_cast<BOFERR>(errno);
+      mSocketCoalescingWriterStatistic_X.NbError_U64++;
+      FailPending(Rts_E);
+    }
+  }
+  if (mPendingCollection.empty())
+  {
+    CancelLatencyTimer();
+  }
+  else
+  {
+    mOldestPendingTimeInMs_U32 = Bof_GetMsTickCount();
+  }
+  if ((Rts_E == BOF_ERR_NO_ERROR) && (SocketFull_B))
+  {
+    Rts_E = BOF_ERR_EAGAIN;
+  }
+#endif
+  return Rts_E;
+}
+
+//Called with mMtx_X locked
+inline void BofSocketCoalescingWriter::FailPending(BOFERR _Sts_E)
+{
+  while (!mPendingCollection.empty())
+  {
+    WRITE_REQUEST &rRequest_X = mPendingCollection.front();
+
+    mCompletionCollection.push_back(WRITE_COMPLETION{_Sts_E, rRequest_X.WriteParam_X, std::move(rRequest_X.Copy_S), rRequest_X.NbSent_U32});
+    mPendingCollection.pop_front();
+  }
+  mNbPendingByte_U64 = 0;
+}
+
+//Called with mMtx_X locked
+inline void BofSocketCoalescingWriter::ArmLatencyTimer()
+{
+  if ((mSocketCoalescingWriterParam_X.pTimingWheel) && (mLatencyTimer == BOF_TIMER_HANDLE_INVALID))
+  {
+    if (mSocketCoalescingWriterParam_X.pTimingWheel->Schedule(mSocketCoalescingWriterParam_X.MaxLatencyInMs_U32, this, mLatencyTimer) != BOF_ERR_NO_ERROR)
+    {
+      mLatencyTimer = BOF_TIMER_HANDLE_INVALID;
+    }
+  }
+}
+
+//Called with mMtx_X locked
+inline void BofSocketCoalescingWriter::CancelLatencyTimer()
+{
+  if ((mSocketCoalescingWriterParam_X.pTimingWheel) && (mLatencyTimer != BOF_TIMER_HANDLE_INVALID))
+  {
+    mSocketCoalescingWriterParam_X.pTimingWheel->Cancel(mLatencyTimer);
+    mLatencyTimer = BOF_TIMER_HANDLE_INVALID;
+  }
+}
+
+//Called without mMtx_X. Only one thread delivers the completions at a time so that they stay in order, even when
+//V_SignalDataWritten writes again or when several threads flush the same writer.
+inline void BofSocketCoalescingWriter::NotifyCompletion()
+{
+  WRITE_COMPLETION Completion_X;
+  bool Notify_B = false;
+
+  if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+  {
+    if ((!mNotifying_B) && (!mCompletionCollection.empty()))
+    {
+      mNotifying_B = true;
+      Notify_B = true;
+    }
+    Bof_UnlockMutex(mMtx_X);
+  }
+  while (Notify_B)
+  {
+    Notify_B = false;
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      if (mCompletionCollection.empty())
+      {
+        mNotifying_B = false;
+      }
+      else
+      {
+        Completion_X = std::move(mCompletionCollection.front());
+        mCompletionCollection.pop_front();
+        if (!Completion_X.Copy_S.empty())
+        {
+          // The copy has moved with the completion (short string storage): point to its new location
+          Completion_X.WriteParam_X.pBuffer_U8 = reinterpret_cast<const uint8_t *>(Completion_X.Copy_S.data());
+        }
+        Notify_B = true;
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+    if ((Notify_B) && (mpIBofSocketIo))
+    {
+      mpIBofSocketIo->V_SignalDataWritten(Completion_X.Sts_E, Completion_X.NbSent_U32, Completion_X.WriteParam_X.pBuffer_U8, Completion_X.WriteParam_X.Nb_U32 - Completion_X.NbSent_U32,
+                                          Completion_X.WriteParam_X.pBuffer_U8 + Completion_X.NbSent_U32, Completion_X.WriteParam_X.pWriteContext);
+    }
+  }
+}
+
+END_BOF_NAMESPACE()
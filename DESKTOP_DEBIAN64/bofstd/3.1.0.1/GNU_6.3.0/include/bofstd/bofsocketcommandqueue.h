@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the lock free multi producer command queue used to
+ * control a poll thread through an eventfd.
+ *
+ * Name:        bofsocketcommandqueue.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofstd.h>
+#include <bofstd/bofstringformatter.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#if !defined(_WIN32)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Structure **************************************************************/
+
+typedef std::function<BOFERR()> BOF_SOCKET_COMMAND_CALLBACK;
+
+struct BOF_SOCKET_COMMAND
+{
+  BOF_SOCKET_COMMAND_CALLBACK Run;
+  std::promise<BOFERR>        Answer;
+};
+
+struct BOF_SOCKET_COMMAND_QUEUE_STATISTIC
+{
+  uint64_t NbPost_U64;
+  uint64_t NbSignal_U64;        /*! eventfd writes: a burst of post is signaled once */
+  uint64_t NbProcess_U64;       /*! Process calls which found the eventfd set */
+  uint64_t NbCommand_U64;       /*! Commands executed */
+  uint32_t MaxCommandPerProcess_U32;
+
+  BOF_SOCKET_COMMAND_QUEUE_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbPost_U64 = 0;
+    NbSignal_U64 = 0;
+    NbProcess_U64 = 0;
+    NbCommand_U64 = 0;
+    MaxCommandPerProcess_U32 = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Lock free multi producer single consumer queue
+ *
+ * Description
+ * Linked list queue (D. Vyukov): Push is one atomic exchange and can be called from any thread, Pop must only be
+ * called by a single consumer thread. A producer preempted in the middle of Push hides the elements pushed after
+ * it until it resumes: the consumer sees an empty queue, it never sees a broken one.
+ *
+ * See Also
+ * BofSocketCommandQueue
+ */
+template <typename T>
+class BofMpscQueue
+{
+private:
+  struct NODE
+  {
+    std::atomic<NODE *> pNext_X;
+    T                   Value;
+
+    NODE() : pNext_X(nullptr)
+    {
+    }
+  };
+
+  std::atomic<NODE *> mpHead_X;               //Last pushed node (producers)
+  uint8_t             mpPad_U8[64];           //Keeps the producer and consumer ends on different cache lines
+  NODE                *mpTail_X;              //Stub node, its successor is the next one to pop (consumer)
+
+public:
+  BofMpscQueue()
+  {
+    mpTail_X = new NODE();
+    mpHead_X.store(mpTail_X, std::memory_order_relaxed);
+  }
+  virtual ~BofMpscQueue()
+  {
+    T Value;
+
+    while (Pop(Value))
+    {
+    }
+    delete mpTail_X;
+  }
+  BofMpscQueue &operator=(const BofMpscQueue &) = delete; // Disallow copying
+  BofMpscQueue(const BofMpscQueue &) = delete;
+
+  void Push(T &&_rrValue)
+  {
+    NODE *pNode_X = new NODE();
+    NODE *pPrevious_X;
+
+    pNode_X->Value = std::move(_rrValue);
+    pPrevious_X = mpHead_X.exchange(pNode_X, std::memory_order_acq_rel);
+    pPrevious_X->pNext_X.store(pNode_X, std::memory_order_release);
+  }
+
+  bool Pop(T &_rValue)
+  {
+    bool Rts_B = false;
+    NODE *pNext_X = mpTail_X->pNext_X.load(std::memory_order_acquire);
+
+    if (pNext_X)
+    {
+      //pNext_X becomes the new stub: its value is moved out and the old stub is freed
+      _rValue = std::move(pNext_X->Value);
+      delete mpTail_X;
+      mpTail_X = pNext_X;
+      Rts_B = true;
+    }
+    return Rts_B;
+  }
+
+  //Only meaningful in the consumer thread
+  bool IsEmpty() const
+  {
+    return mpTail_X->pNext_X.load(std::memory_order_acquire) == nullptr;
+  }
+};
+
+/*!
+ * Summary
+ * Poll thread command queue
+ *
+ * Description
+ * Any thread posts a command and gets a std::future on its result. The poll thread registers EventFd() in its
+ * poller and calls Process when it is readable: the commands are run in post order in the poll thread and their
+ * futures are fulfilled with the value they return.
+ * The eventfd is only written when it is not already set, so a burst of commands costs a single wake up and the
+ * poll thread drains it in one go. Destroying the queue completes the commands not run with BOF_ERR_CANCEL.
+ * A command must never wait for the future of another command of the same queue: it would wait for itself.
+ *
+ * See Also
+ * BofSocketPollServer
+ */
+class BofSocketCommandQueue
+{
+private:
+  BOFERR                                 mErrorCode_E = BOF_ERR_INIT;
+  int                                    mEventFd_i = -1;
+  std::atomic<bool>                      mSignaled_B;
+  BofMpscQueue<BOF_SOCKET_COMMAND>       mCommandQueue;
+  std::atomic<uint64_t>                  mNbPost;
+  std::atomic<uint64_t>                  mNbSignal;
+  BOF_SOCKET_COMMAND_QUEUE_STATISTIC     mConsumerStatistic_X;   //Only written by the Process thread
+
+public:
+  BofSocketCommandQueue() : mSignaled_B(false), mNbPost(0), mNbSignal(0)
+  {
+#if defined(_WIN32)
+    mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#else
+    mEventFd_i = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    mErrorCode_E = (mEventFd_i >= 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+#endif
+  }
+  virtual ~BofSocketCommandQueue()
+  {
+    BOF_SOCKET_COMMAND Command_X;
+
+    while (mCommandQueue.Pop(Command_X))
+    {
+      Command_X.Answer.set_value(BOF_ERR_CANCEL);
+    }
+#if !defined(_WIN32)
+    if (mEventFd_i >= 0)
+    {
+      close(mEventFd_i);
+    }
+#endif
+  }
+  BofSocketCommandQueue &operator=(const BofSocketCommandQueue &) = delete; // Disallow copying
+  BofSocketCommandQueue(const BofSocketCommandQueue &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  //Descriptor to poll for BOF_POLL_IN (level triggered)
+  int EventFd() const
+  {
+    return mEventFd_i;
+  }
+
+  /*!
+   * Description
+   * Queue a command for the poll thread. Can be called from any thread.
+   *
+   * Parameters
+   * _Command: Specifies the function to run in the poll thread
+   *
+   * Returns
+   * std::future<BOFERR>: Gives the value returned by _Command, BOF_ERR_CANCEL if the queue is destroyed before it runs,
+   * or at once the queue error code if it could not be created
+   */
+  std::future<BOFERR> Post(BOF_SOCKET_COMMAND_CALLBACK _Command)
+  {
+    std::future<BOFERR> Rts;
+    BOF_SOCKET_COMMAND Command_X;
+
+    Rts = Command_X.Answer.get_future();
+    if ((mErrorCode_E != BOF_ERR_NO_ERROR) || (!_Command))
+    {
+      Command_X.Answer.set_value((mErrorCode_E != BOF_ERR_NO_ERROR) ? mErrorCode_E : BOF_ERR_EINVAL);
+    }
+    else
+    {
+      Command_X.Run = std::move(_Command);
+      mCommandQueue.Push(std::move(Command_X));
+      mNbPost.fetch_add(1, std::memory_order_relaxed);
+      //Checked after the push: either we signal, or Process has not cleared the flag yet and will see our command
+      if (!mSignaled_B.exchange(true, std::memory_order_acq_rel))
+      {
+        Signal();
+      }
+    }
+    return Rts;
+  }
+
+  /*!
+   * Description
+   * Run the queued commands. Must always be called from the same thread, typically when EventFd() is readable.
+   *
+   * Parameters
+   * None
+   *
+   * Returns
+   * uint32_t: Number of commands run
+   */
+  uint32_t Process()
+  {
+    uint32_t Rts_U32 = 0;
+    BOF_SOCKET_COMMAND Command_X;
+    BOFERR Sts_E;
+
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      ClearSignal();
+      //Cleared before draining: a command pushed from now on will signal again
+      mSignaled_B.store(false, std::memory_order_release);
+      while (mCommandQueue.Pop(Command_X))
+      {
+        Sts_E = Command_X.Run();
+        Command_X.Answer.set_value(Sts_E);
+        Command_X.Run = nullptr;
+        Rts_U32++;
+      }
+      mConsumerStatistic_X.NbProcess_U64++;
+      mConsumerStatistic_X.NbCommand_U64 += Rts_U32;
+      if (Rts_U32 > mConsumerStatistic_X.MaxCommandPerProcess_U32)
+      {
+        mConsumerStatistic_X.MaxCommandPerProcess_U32 = Rts_U32;
+      }
+    }
+    return Rts_U32;
+  }
+
+  //To call from the Process thread
+  BOF_SOCKET_COMMAND_QUEUE_STATISTIC SocketCommandQueueStatistic() const
+  {
+    BOF_SOCKET_COMMAND_QUEUE_STATISTIC Rts_X = mConsumerStatistic_X;
+
+    Rts_X.NbPost_U64 = mNbPost.load(std::memory_order_relaxed);
+    Rts_X.NbSignal_U64 = mNbSignal.load(std::memory_order_relaxed);
+    return Rts_X;
+  }
+  void ResetSocketCommandQueueStatistic()
+  {
+    mNbPost.store(0, std::memory_order_relaxed);
+    mNbSignal.store(0, std::memory_order_relaxed);
+    mConsumerStatistic_X.Reset();
+  }
+  std::string SocketCommandQueueDebugInfo() const
+  {
+    BOF_SOCKET_COMMAND_QUEUE_STATISTIC Statistic_X = SocketCommandQueueStatistic();
+
+    return Bof_Sprintf("CmdQueue fd %d Post %lld Signal %lld Process %lld Cmd %lld MaxPerProcess %u", mEventFd_i, Statistic_X.NbPost_U64, Statistic_X.NbSignal_U64,
+                       Statistic_X.NbProcess_U64, Statistic_X.NbCommand_U64, Statistic_X.MaxCommandPerProcess_U32);
+  }
+
+private:
+  void Signal()
+  {
+#if !defined(_WIN32)
+    uint64_t Value_U64 = 1;
+
+    //EAGAIN means the counter is saturated: the descriptor is readable anyway
+    if (write(mEventFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64))
+    {
+      mNbSignal.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+  }
+
+  void ClearSignal()
+  {
+#if !defined(_WIN32)
+    uint64_t Value_U64;
+
+    while (read(mEventFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64))
+    {
+    }
+#endif
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the socket framer which splits a received byte stream
+ * according to the BofSocketIo notify modes and hands the frames off as
+ * shared buffer slices.
+ *
+ * Name:        bofsocketframer.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofdelimiterscanner.h>
+#include <bofstd/bofsharedbuffer.h>
+#include <bofstd/bofsocketio.h>
+#include <bofstd/bofstringformatter.h>
+#include <functional>
+#if !defined(_WIN32)
+#include <errno.h>
+#include <sys/socket.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Structure **************************************************************/
+
+//_rFrame is a slice of the framer storage: the consumer can keep it (std::move) as long as it wants, no data is copied.
+//_DelimiterFound_B is false when the frame has been cut because the buffer was full or the stream closed.
+typedef std::function<BOFERR(BofSharedBuffer &_rFrame, bool _DelimiterFound_B)> BOF_SOCKET_FRAMER_CALLBACK;
+
+struct BOF_SOCKET_FRAMER_PARAM
+{
+  BOF_SOCKET_IO_NOTIFY_TYPE  NotifyType_E;
+  std::string                Delimiter_S;                /*! WHEN_FULL_OR_DELIMITER_FOUND: one or more bytes ("\r\n" for a line protocol) */
+  bool                       KeepDelimiter_B;            /*! true to leave the delimiter at the end of the frames */
+  uint32_t                   NotifyRcvBufferSize_U32;    /*! Maximum frame size: the frame is handed off when it reaches it */
+  uint32_t                   StorageSizeInByte_U32;      /*! Size of each receive storage (>= NotifyRcvBufferSize_U32). Several frames share one storage */
+  IBofAllocator              *pAllocator;                /*! Storage allocator, nullptr for the heap */
+  BOF_SOCKET_FRAMER_CALLBACK OnFrame;
+
+  BOF_SOCKET_FRAMER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NotifyType_E = BOF_SOCKET_IO_NOTIFY_TYPE::WHEN_FULL_OR_DELIMITER_FOUND;
+    Delimiter_S = "\r\n";
+    KeepDelimiter_B = false;
+    NotifyRcvBufferSize_U32 = 0x1000;
+    StorageSizeInByte_U32 = 0x10000;
+    pAllocator = nullptr;
+    OnFrame = nullptr;
+  }
+};
+
+struct BOF_SOCKET_FRAMER_STATISTIC
+{
+  uint64_t NbByteIn_U64;
+  uint64_t NbFrame_U64;
+  uint64_t NbDelimiterFrame_U64;
+  uint64_t NbFullFrame_U64;
+  uint64_t NbStorage_U64;            /*! Number of storage allocated */
+  uint64_t NbByteCopied_U64;         /*! Partial frame bytes moved to a new storage */
+
+  BOF_SOCKET_FRAMER_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbByteIn_U64 = 0;
+    NbFrame_U64 = 0;
+    NbDelimiterFrame_U64 = 0;
+    NbFullFrame_U64 = 0;
+    NbStorage_U64 = 0;
+    NbByteCopied_U64 = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Zero copy socket stream framer
+ *
+ * Description
+ * The data is received straight into a reference counted storage (RxSpace/Commit or Read) and only the newly
+ * received bytes are scanned for the delimiter (simd). Each frame is handed to OnFrame as a BofSharedBuffer slice
+ * of that storage: the consumer takes ownership of it by keeping the slice, there is no memcpy to a notify buffer.
+ * When the storage is exhausted a new one is allocated and only the incomplete frame at its end is copied; the old
+ * storage is freed when the last frame slice using it is released.
+ * The notify modes are the BofSocketIo ones:
+ *  - ASAP: everything received is handed off at each Commit
+ *  - WHEN_FULL_OR_CLOSED: frames of NotifyRcvBufferSize_U32 bytes, the remainder on Close
+ *  - WHEN_FULL_OR_DELIMITER_FOUND: one frame per delimiter, cut at NotifyRcvBufferSize_U32 if none is found
+ * The framer only writes after the last byte handed off, so the frames already delivered are never modified.
+ * An object is not thread safe: it belongs to the thread reading the socket.
+ *
+ * See Also
+ * BofDelimiterScanner, BofSharedBuffer
+ */
+class BofSocketFramer
+{
+private:
+  BOF_SOCKET_FRAMER_PARAM     mSocketFramerParam_X;
+  BOFERR                      mErrorCode_E = BOF_ERR_INIT;
+  BofDelimiterScanner         mDelimiterScanner;
+  BofSharedBuffer             mPending;            /*! View on the bytes received and not handed off yet */
+  BOF_SOCKET_FRAMER_STATISTIC mSocketFramerStatistic_X;
+
+public:
+  BofSocketFramer(const BOF_SOCKET_FRAMER_PARAM &_rSocketFramerParam_X)
+  {
+    mSocketFramerParam_X = _rSocketFramerParam_X;
+    if (mSocketFramerParam_X.StorageSizeInByte_U32 < mSocketFramerParam_X.NotifyRcvBufferSize_U32)
+    {
+      mSocketFramerParam_X.StorageSizeInByte_U32 = mSocketFramerParam_X.NotifyRcvBufferSize_U32;
+    }
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mSocketFramerParam_X.NotifyRcvBufferSize_U32) && (mSocketFramerParam_X.OnFrame))
+    {
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      if (mSocketFramerParam_X.NotifyType_E == BOF_SOCKET_IO_NOTIFY_TYPE::WHEN_FULL_OR_DELIMITER_FOUND)
+      {
+        mErrorCode_E = mDelimiterScanner.Delimiter(mSocketFramerParam_X.Delimiter_S);
+      }
+    }
+  }
+  virtual ~BofSocketFramer()
+  {
+  }
+  BofSocketFramer &operator=(const BofSocketFramer &) = delete; // Disallow copying
+  BofSocketFramer(const BofSocketFramer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+  uint32_t NbPendingByte() const
+  {
+    return static_cast<uint32_t>(mPending.Size());
+  }
+
+  /*!
+   * Description
+   * Returns where the next received bytes must be written. A new storage is set up if the current one is full.
+   *
+   * Parameters
+   * _rpData_U8: Returns the write pointer
+   * _rSpace_U32: Returns the number of byte which can be written there (never more than what completes a full frame)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+   */
+  BOFERR RxSpace(uint8_t *&_rpData_U8, uint32_t &_rSpace_U32)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    BofSharedBuffer Storage;
+    uint64_t Space_U64;
+
+    _rpData_U8 = nullptr;
+    _rSpace_U32 = 0;
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (mPending.Capacity() <= mPending.Size()))
+    {
+      Rts_E = BofSharedBuffer::S_Create(mSocketFramerParam_X.StorageSizeInByte_U32, mSocketFramerParam_X.pAllocator, Storage);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mSocketFramerStatistic_X.NbStorage_U64++;
+        if (mPending.Size())
+        {
+          Storage.Append(mPending.Size(), mPending.Data());
+          mSocketFramerStatistic_X.NbByteCopied_U64 += mPending.Size();
+        }
+        mPending = std::move(Storage);
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Space_U64 = mPending.Capacity() - mPending.Size();
+      if (Space_U64 > mSocketFramerParam_X.NotifyRcvBufferSize_U32 - mPending.Size())
+      {
+        Space_U64 = mSocketFramerParam_X.NotifyRcvBufferSize_U32 - mPending.Size();
+      }
+      _rpData_U8 = mPending.Data() + mPending.Size();
+      _rSpace_U32 = static_cast<uint32_t>(Space_U64);
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Declares _Nb_U32 bytes written at the RxSpace pointer and hands off the frames they complete.
+   *
+   * Parameters
+   * _Nb_U32: Specifies the number of byte received
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, or the first error returned by OnFrame
+   */
+  BOFERR Commit(uint32_t _Nb_U32)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    uint32_t Pos_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = mPending.Resize(mPending.Size() + _Nb_U32);
+    }
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (_Nb_U32))
+    {
+      mSocketFramerStatistic_X.NbByteIn_U64 += _Nb_U32;
+      switch (mSocketFramerParam_X.NotifyType_E)
+      {
+        case BOF_SOCKET_IO_NOTIFY_TYPE::WHEN_FULL_OR_DELIMITER_FOUND:
+          Pos_U32 = mDelimiterScanner.Scan(mPending.Data(), static_cast<uint32_t>(mPending.Size()));
+          while ((Rts_E == BOF_ERR_NO_ERROR) && (Pos_U32 != BOF_DELIMITER_NOT_FOUND))
+          {
+            Rts_E = HandOff(Pos_U32, Pos_U32 + mDelimiterScanner.DelimiterSize(), true);
+            Pos_U32 = (Rts_E == BOF_ERR_NO_ERROR) ? mDelimiterScanner.Scan(mPending.Data(), static_cast<uint32_t>(mPending.Size())) : BOF_DELIMITER_NOT_FOUND;
+          }
+          if ((Rts_E == BOF_ERR_NO_ERROR) && (mPending.Size() >= mSocketFramerParam_X.NotifyRcvBufferSize_U32))
+          {
+            Rts_E = HandOff(static_cast<uint32_t>(mPending.Size()), static_cast<uint32_t>(mPending.Size()), false);
+          }
+          break;
+
+        case BOF_SOCKET_IO_NOTIFY_TYPE::WHEN_FULL_OR_CLOSED:
+          if (mPending.Size() >= mSocketFramerParam_X.NotifyRcvBufferSize_U32)
+          {
+            Rts_E = HandOff(static_cast<uint32_t>(mPending.Size()), static_cast<uint32_t>(mPending.Size()), false);
+          }
+          break;
+
+        case BOF_SOCKET_IO_NOTIFY_TYPE::ASAP:
+        default:
+          Rts_E = HandOff(static_cast<uint32_t>(mPending.Size()), static_cast<uint32_t>(mPending.Size()), false);
+          break;
+      }
+    }
+    return Rts_E;
+  }
+
+  //Copies data coming from elsewhere (BofSocketIo::V_SignalDataRead for example) and frames it
+  BOFERR Push(uint32_t _Nb_U32, const uint8_t *_pData_U8)
+  {
+    BOFERR Rts_E = (_pData_U8 || (_Nb_U32 == 0)) ? mErrorCode_E : BOF_ERR_EINVAL;
+    uint8_t *pSpace_U8;
+    uint32_t Space_U32;
+
+    while ((Rts_E == BOF_ERR_NO_ERROR) && (_Nb_U32))
+    {
+      Rts_E = RxSpace(pSpace_U8, Space_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        if (Space_U32 > _Nb_U32)
+        {
+          Space_U32 = _Nb_U32;
+        }
+        memcpy(pSpace_U8, _pData_U8, Space_U32);
+        _pData_U8 += Space_U32;
+        _Nb_U32 -= Space_U32;
+        Rts_E = Commit(Space_U32);
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Receives what is available on a socket straight into the framer storage and frames it. On end of stream the
+   * pending bytes are handed off as with Close.
+   *
+   * Parameters
+   * _Socket: Specifies the socket (typically BofSocketIo::NativeSocketHandle from a poll callback)
+   * _rNbRead_U32: Returns the number of byte received
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if data was read, BOF_ERR_EAGAIN if there was none, BOF_ERR_EOF if the peer closed
+   */
+  BOFERR Read(BOFSOCKET _Socket, uint32_t &_rNbRead_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if !defined(_WIN32)
+    uint8_t *pSpace_U8;
+    uint32_t Space_U32;
+    ssize_t Sts;
+
+    _rNbRead_U32 = 0;
+    Rts_E = RxSpace(pSpace_U8, Space_U32);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      do
+      {
+        Sts = recv(_Socket, pSpace_U8, Space_U32, MSG_DONTWAIT);
+      } while ((Sts < 0) && (errno == EINTR));
+      if (Sts > 0)
+      {
+        _rNbRead_U32 = static_cast<uint32_t>(Sts);
+        Rts_E = Commit(_rNbRead_U32);
+      }
+      else if (Sts == 0)
+      {
+        Rts_E = Close();
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = BOF_ERR_EOF;
+        }
+      }
+      else
+      {
+        Rts_E = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? BOF_ERR_EAGAIN : static_cast<BOFERR>(errno);
+      }
+    }
+#else
+    _rNbRead_U32 = 0;
+#endif
+    return Rts_E;
+  }
+
+  //Hands off the pending bytes, if any, as an incomplete frame (end of stream)
+  BOFERR Close()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (mPending.Size()))
+    {
+      Rts_E = HandOff(static_cast<uint32_t>(mPending.Size()), static_cast<uint32_t>(mPending.Size()), false);
+    }
+    return Rts_E;
+  }
+
+  BOF_SOCKET_FRAMER_STATISTIC SocketFramerStatistic() const
+  {
+    return mSocketFramerStatistic_X;
+  }
+  void ResetSocketFramerStatistic()
+  {
+    mSocketFramerStatistic_X.Reset();
+  }
+  std::string SocketFramerDebugInfo() const
+  {
+    return Bof_Sprintf("Pending %d B In %lld B Frame %lld (delimiter %lld full %lld) Storage %lld Copied %lld B", static_cast<uint32_t>(mPending.Size()), mSocketFramerStatistic_X.NbByteIn_U64,
+                       mSocketFramerStatistic_X.NbFrame_U64, mSocketFramerStatistic_X.NbDelimiterFrame_U64, mSocketFramerStatistic_X.NbFullFrame_U64, mSocketFramerStatistic_X.NbStorage_U64,
+                       mSocketFramerStatistic_X.NbByteCopied_U64);
+  }
+
+private:
+  //_FrameSize_U32: bytes given to the consumer, _Consumed_U32: bytes removed from the pending view (frame + delimiter)
+  BOFERR HandOff(uint32_t _FrameSize_U32, uint32_t _Consumed_U32, bool _DelimiterFound_B)
+  {
+    BOFERR Rts_E;
+    BofSharedBuffer Frame;
+
+    if ((_DelimiterFound_B) && (mSocketFramerParam_X.KeepDelimiter_B))
+    {
+      _FrameSize_U32 = _Consumed_U32;
+    }
+    Rts_E = mPending.Slice(0, _FrameSize_U32, Frame);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mPending.Consume(_Consumed_U32);
+      mDelimiterScanner.Consume(_Consumed_U32);
+      if (!_DelimiterFound_B)
+      {
+        mDelimiterScanner.Reset();
+      }
+      mSocketFramerStatistic_X.NbFrame_U64++;
+      if (_DelimiterFound_B)
+      {
+        mSocketFramerStatistic_X.NbDelimiterFrame_U64++;
+      }
+      else
+      {
+        mSocketFramerStatistic_X.NbFullFrame_U64++;
+      }
+      Rts_E = mSocketFramerParam_X.OnFrame(Frame, _DelimiterFound_B);
+    }
+    return Rts_E;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,1080 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the io_uring completion based socket server: batched
+ * accept/recv/write submissions dispatched into the IBofSocketIo callbacks.
+ *
+ * Name:        bofsocketiouring.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Falls back to BofSocketPollServer (epoll) if io_uring is not usable
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofiouring.h>
+#include <bofstd/bofsocketpoller.h>
+#include <thread>
+#include <unordered_map>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_IO_URING_PARAM
+{
+  BOF_SOCKET_SERVER_PARAM SocketServerParam_X;        /*! Name_S, thread attributes and NbMaxSession_U32 (fixed file table size) are used */
+  BOF_SOCKET_PARAM        AcceptedSocketParam_X;      /*! Used to build the BofSocket of each accepted connection */
+  uint32_t                NbSqEntry_U32;              /*! Submission ring size */
+  uint32_t                NbRecvBuffer_U32;           /*! Provided buffer ring shared by the multishot recv of every session (power of 2) */
+  uint32_t                RecvBufferSizeInByte_U32;
+  uint32_t                NbWriteBuffer_U32;          /*! Preallocated buffers into which Write copies small payloads */
+  uint32_t                WriteBufferSizeInByte_U32;
+  uint32_t                PollTimeoutInMs_U32;        /*! Maximum sleep time of the completion thread: bounds the Stop latency */
+  bool                    FallbackToEpoll_B;          /*! Use a BofSocketPollServer (epoll, data read dispatch) if io_uring is not usable */
+
+  BOF_SOCKET_IO_URING_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    SocketServerParam_X.Reset();
+    SocketServerParam_X.ServerMode_E = BOF_SOCKET_SERVER_MODE::BOF_SOCKET_SERVER_POLLER;
+    AcceptedSocketParam_X.Reset();
+    NbSqEntry_U32             = 256;
+    NbRecvBuffer_U32          = 1024;
+    RecvBufferSizeInByte_U32  = 2048;
+    NbWriteBuffer_U32         = 256;
+    WriteBufferSizeInByte_U32 = 2048;
+    PollTimeoutInMs_U32       = 250;
+    FallbackToEpoll_B         = true;
+  }
+};
+
+struct BOF_SOCKET_IO_URING_STATISTIC
+{
+  uint64_t NbSubmitCall_U64;      /*! io_uring_enter calls made to submit */
+  uint64_t NbSqe_U64;
+  uint64_t NbCqe_U64;
+  uint64_t NbAccept_U64;
+  uint64_t NbRejectedAccept_U64;
+  uint64_t NbRecv_U64;
+  uint64_t NbRecvByte_U64;
+  uint64_t NbRecvNoBuffer_U64;    /*! Provided buffer ring exhausted: the recv is re-armed */
+  uint64_t NbWrite_U64;
+  uint64_t NbWriteCopied_U64;     /*! Writes copied into a preallocated write buffer */
+  uint64_t NbWriteQueued_U64;     /*! Writes queued behind the write in progress of their session */
+  uint64_t NbWritePartial_U64;    /*! Short sends whose remainder was submitted again */
+  uint64_t NbWriteByte_U64;
+  uint64_t NbRearm_U64;           /*! Multishot requests terminated by the kernel and re-armed */
+  uint64_t NbPeerClosed_U64;
+  uint64_t NbStaleCqe_U64;
+
+  BOF_SOCKET_IO_URING_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbSubmitCall_U64     = 0;
+    NbSqe_U64            = 0;
+    NbCqe_U64            = 0;
+    NbAccept_U64         = 0;
+    NbRejectedAccept_U64 = 0;
+    NbRecv_U64           = 0;
+    NbRecvByte_U64       = 0;
+    NbRecvNoBuffer_U64   = 0;
+    NbWrite_U64          = 0;
+    NbWriteCopied_U64    = 0;
+    NbWriteQueued_U64    = 0;
+    NbWritePartial_U64   = 0;
+    NbWriteByte_U64      = 0;
+    NbRearm_U64          = 0;
+    NbPeerClosed_U64     = 0;
+    NbStaleCqe_U64       = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * io_uring socket server
+ *
+ * Description
+ * Sessions are put in a fixed file table and served by one multishot recv each, fed by a provided buffer ring:
+ * V_SignalDataRead is called with the kernel filled buffer which is recycled when the callback returns.
+ * Listeners use a multishot accept; each connection goes through IBofSocketSessionFactory::V_OpenSession.
+ * Write copies small payloads into a preallocated buffer and sends the others from the caller buffer, which must stay
+ * valid up to V_SignalDataWritten. Both use IORING_OP_SEND with MSG_NOSIGNAL (IORING_OP_WRITE_FIXED would raise
+ * SIGPIPE once the peer has closed). A session has one write in progress at a time, the next ones wait in its queue:
+ * a short send is completed by submitting its remainder before the next write starts, so the bytes of two writes are
+ * never interleaved on the stream. Submissions made from the completion thread
+ * (typically from a callback) are batched with the next wait in a single io_uring_enter.
+ * If io_uring is not usable and FallbackToEpoll_B is set, the same API is served by a BofSocketPollServer
+ * (epoll, BOF_SOCKET_POLLER_DISPATCH_DATA_READ) and Write becomes a V_WriteData call; check IsIoUring.
+ *
+ * See Also
+ * BofIoUring, BofSocketPollServer
+ */
+class BofSocketIoUringServer : public BofThread
+{
+private:
+  enum IO_URING_OP : uint8_t
+  {
+    IO_URING_OP_ACCEPT = 1,
+    IO_URING_OP_RECV,
+    IO_URING_OP_WRITE,
+    IO_URING_OP_CANCEL,
+    IO_URING_OP_WAKEUP,
+  };
+
+  struct SESSION_SLOT
+  {
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    uint32_t                     Generation_U32;
+    uint32_t                     NextFree_U32;
+    uint32_t                     FirstWrite_U32;         //Write queue, the first one is in progress (NO_INDEX: empty)
+    uint32_t                     LastWrite_U32;
+  };
+
+  struct WRITE_REQUEST
+  {
+    uint32_t      Slot_U32;
+    uint32_t      Generation_U32;
+    const uint8_t *pBuffer_U8;
+    uint32_t      Nb_U32;
+    uint32_t      NbSent_U32;
+    void          *pWriteContext;
+    uint32_t      WriteBufferIndex_U32;   //NO_INDEX if sent from the caller buffer
+    uint32_t      Next_U32;               //Next free request or next write of the session queue
+  };
+
+  static constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+  static constexpr uint16_t RECV_BUFFER_GROUP = 0;
+
+  IBofSocketSessionFactory                     *mpIBofSocketSessionFactory = nullptr;
+  BOF_SOCKET_IO_URING_PARAM                    mSocketIoUringParam_X;
+  BOFERR                                       mErrorCode_E = BOF_ERR_INIT;
+  std::unique_ptr<BofSocketPollServer>         mpuFallbackServer = nullptr;
+  std::mutex                                   mMtx;   //Protects the submission ring and the tables below
+  std::thread::id                              mCompletionThreadId;
+  uint32_t                                     mNextSessionIndex_U32 = 0;
+  uint32_t                                     mNbSession_U32 = 0;
+  std::vector<SESSION_SLOT>                    mSessionSlotCollection;
+  uint32_t                                     mFirstFreeSlot_U32 = NO_INDEX;
+  std::unordered_map<const BofSocketIo *, uint32_t> mSlotIndexCollection;
+  std::vector<WRITE_REQUEST>                   mWriteRequestCollection;
+  uint32_t                                     mFirstFreeWriteRequest_U32 = NO_INDEX;
+  std::vector<uint32_t>                        mFreeWriteBufferCollection;
+  std::vector<uint8_t>                         mWriteBuffer;
+  std::vector<std::unique_ptr<BofSocket>>      mListenerCollection;
+  BOF_SOCKET_IO_URING_STATISTIC                mSocketIoUringStatistic_X;
+#if BOF_IO_URING_AVAILABLE
+  BofIoUring                                   mIoUring;
+  BofIoUringBufferRing                         mRecvBufferRing;
+#endif
+
+public:
+  BofSocketIoUringServer(IBofSocketSessionFactory *_pIBofSocketSessionFactory, const BOF_SOCKET_IO_URING_PARAM &_rSocketIoUringParam_X)
+  {
+    BOF_SOCKET_POLL_SERVER_PARAM SocketPollServerParam_X;
+
+    mpIBofSocketSessionFactory = _pIBofSocketSessionFactory;
+    mSocketIoUringParam_X = _rSocketIoUringParam_X;
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mpIBofSocketSessionFactory) && (mSocketIoUringParam_X.SocketServerParam_X.NbMaxSession_U32) && (mSocketIoUringParam_X.SocketServerParam_X.NbMaxSession_U32 < NO_INDEX) &&
+        (mSocketIoUringParam_X.NbSqEntry_U32))
+    {
+      mErrorCode_E = OpenIoUring();
+      if ((mErrorCode_E != BOF_ERR_NO_ERROR) && (mSocketIoUringParam_X.FallbackToEpoll_B))
+      {
+        SocketPollServerParam_X.SocketServerParam_X = mSocketIoUringParam_X.SocketServerParam_X;
+        SocketPollServerParam_X.Engine_E = BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_EPOLL;
+        SocketPollServerParam_X.PollTimeoutInMs_U32 = mSocketIoUringParam_X.PollTimeoutInMs_U32;
+        mpuFallbackServer.reset(new BofSocketPollServer(mpIBofSocketSessionFactory, SocketPollServerParam_X));
+        mErrorCode_E = mpuFallbackServer->LastErrorCode();
+      }
+    }
+  }
+  virtual ~BofSocketIoUringServer()
+  {
+    Wakeup();
+    DestroyBofProcessingThread("~BofSocketIoUringServer");
+    mpuFallbackServer.reset(nullptr);
+#if BOF_IO_URING_AVAILABLE
+    mRecvBufferRing.Close();
+    mIoUring.Close();
+#endif
+  }
+  BofSocketIoUringServer &operator=(const BofSocketIoUringServer &) = delete; // Disallow copying
+  BofSocketIoUringServer(const BofSocketIoUringServer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  bool IsIoUring() const
+  {
+    return (mErrorCode_E == BOF_ERR_NO_ERROR) && (!mpuFallbackServer);
+  }
+
+  BOFERR Start()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mpuFallbackServer)
+      {
+        Rts_E = mpuFallbackServer->Start();
+      }
+      else
+      {
+        Rts_E = LaunchBofProcessingThread(mSocketIoUringParam_X.SocketServerParam_X.Name_S, false, 0, mSocketIoUringParam_X.SocketServerParam_X.ThreadSchedulerPolicy_E,
+                                          mSocketIoUringParam_X.SocketServerParam_X.ThreadPriority_E, mSocketIoUringParam_X.SocketServerParam_X.ThreadCpuCoreAffinityMask_U64, 2000, 0);
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR Stop()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mpuFallbackServer)
+      {
+        Rts_E = mpuFallbackServer->Stop();
+      }
+      else
+      {
+        Wakeup();
+        Rts_E = DestroyBofProcessingThread("BofSocketIoUringServer::Stop");
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Add a listening socket served by a multishot accept. The listener is owned by the server.
+   */
+  BOFERR AddListener(std::unique_ptr<BofSocket> _puListener)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if (_puListener)
+      {
+        if (mpuFallbackServer)
+        {
+          Rts_E = mpuFallbackServer->AddListener(std::move(_puListener), BOF_SOCKET_POLLER_DISPATCH::BOF_SOCKET_POLLER_DISPATCH_DATA_READ,
+                                                 BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT);
+        }
+#if BOF_IO_URING_AVAILABLE
+        else
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          mListenerCollection.push_back(std::move(_puListener));
+          Rts_E = PrepAccept(static_cast<uint32_t>(mListenerCollection.size() - 1));
+          if (Rts_E == BOF_ERR_NO_ERROR)
+          {
+            Rts_E = SubmitIfNotCompletionThread();
+          }
+        }
+#endif
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR AddSession(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_psSocketSession) && (_psSocketSession->NativeBofSocketPointer()))
+      {
+        if (mpuFallbackServer)
+        {
+          Rts_E = mpuFallbackServer->AddSession(_psSocketSession, BOF_POLL_IN | BOF_POLL_RDHUP, BOF_SOCKET_POLLER_DISPATCH::BOF_SOCKET_POLLER_DISPATCH_DATA_READ,
+                                                BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT);
+        }
+#if BOF_IO_URING_AVAILABLE
+        else
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          Rts_E = OpenSlot(_psSocketSession);
+        }
+#endif
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Stop serving a session. The session is not closed: the caller keeps its ownership.
+   */
+  BOFERR RemoveSession(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if (_psSocketSession)
+      {
+        if (mpuFallbackServer)
+        {
+          Rts_E = mpuFallbackServer->RemoveSession(_psSocketSession);
+        }
+#if BOF_IO_URING_AVAILABLE
+        else
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          Rts_E = CloseSlot(_psSocketSession.get(), nullptr);
+        }
+#endif
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Queue a write. The completion is reported by _psSocketSession->V_SignalDataWritten from the completion thread.
+   * The writes of a session are sent in call order, each one completely (or up to an error) before the next.
+   *
+   * Parameters
+   * _psSocketSession: Specifies the session
+   * _Nb_U32:          Specifies the number of byte to write
+   * _pBuffer_U8:      Specifies the data. Copied if it fits in a write buffer, otherwise it must stay valid up to V_SignalDataWritten
+   * _pWriteContext:   Specifies a caller context given back to V_SignalDataWritten
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Write(std::shared_ptr<BofSocketIo> _psSocketSession, uint32_t _Nb_U32, const uint8_t *_pBuffer_U8, void *_pWriteContext)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    uint32_t Nb_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_psSocketSession) && (_psSocketSession->NativeBofSocketPointer()) && (_Nb_U32) && (_pBuffer_U8))
+      {
+        if (mpuFallbackServer)
+        {
+          Nb_U32 = _Nb_U32;
+          Rts_E = _psSocketSession->NativeBofSocketPointer()->V_WriteData(mSocketIoUringParam_X.PollTimeoutInMs_U32, Nb_U32, _pBuffer_U8);
+          _psSocketSession->V_SignalDataWritten(Rts_E, Nb_U32, _pBuffer_U8, _Nb_U32 - Nb_U32, _pBuffer_U8 + Nb_U32, _pWriteContext);
+        }
+#if BOF_IO_URING_AVAILABLE
+        else
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          Rts_E = PrepWrite(_psSocketSession.get(), _Nb_U32, _pBuffer_U8, _pWriteContext);
+          if (Rts_E == BOF_ERR_NO_ERROR)
+          {
+            Rts_E = SubmitIfNotCompletionThread();
+          }
+        }
+#endif
+      }
+    }
+    return Rts_E;
+  }
+
+  uint32_t NbSession()
+  {
+    uint32_t Rts_U32;
+
+    if (mpuFallbackServer)
+    {
+      Rts_U32 = mpuFallbackServer->NbSession();
+    }
+    else
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      Rts_U32 = mNbSession_U32;
+    }
+    return Rts_U32;
+  }
+
+  BOFERR Wakeup()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mpuFallbackServer)
+      {
+        Rts_E = mpuFallbackServer->Wakeup();
+      }
+#if BOF_IO_URING_AVAILABLE
+      else
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        struct io_uring_sqe *pSqe_X = GetSqe();
+
+        Rts_E = BOF_ERR_FULL;
+        if (pSqe_X)
+        {
+          pSqe_X->opcode = IORING_OP_NOP;
+          pSqe_X->user_data = UserData(IO_URING_OP_WAKEUP, 0, 0);
+          Rts_E = Submit();
+        }
+      }
+#endif
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Submit the pending requests, wait for completions and dispatch them. Used by the completion thread or by the
+   * owner when the server is not started (the calling thread then becomes the completion thread).
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies the maximum wait time
+   * _rNbCqe_U32:      Returns the number of completions processed
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Poll(uint32_t _TimeoutInMs_U32, uint32_t &_rNbCqe_U32)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    _rNbCqe_U32 = 0;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      if (mpuFallbackServer)
+      {
+        Rts_E = mpuFallbackServer->Poll(_TimeoutInMs_U32, _rNbCqe_U32);
+      }
+#if BOF_IO_URING_AVAILABLE
+      else
+      {
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          mCompletionThreadId = std::this_thread::get_id();
+          Rts_E = Submit();
+        }
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = mIoUring.Wait(1, _TimeoutInMs_U32);
+          _rNbCqe_U32 = mIoUring.ForEachCqe([this](const struct io_uring_cqe &_rCqe_X) { OnCqe(_rCqe_X); });
+          std::lock_guard<std::mutex> Lock(mMtx);
+          mSocketIoUringStatistic_X.NbCqe_U64 += _rNbCqe_U32;
+        }
+      }
+#endif
+    }
+    return Rts_E;
+  }
+
+  BOF_SOCKET_IO_URING_STATISTIC SocketIoUringStatistic()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    return mSocketIoUringStatistic_X;
+  }
+
+  void ResetSocketIoUringStatistic()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    mSocketIoUringStatistic_X.Reset();
+  }
+
+  std::string SocketIoUringDebugInfo()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    if (mpuFallbackServer)
+    {
+      return mpuFallbackServer->SocketPollServerDebugInfo();
+    }
+    return Bof_Sprintf("IoUringServer '%s': Session %u/%u Enter %lld Sqe %lld Cqe %lld Acc %lld Rej %lld Recv %lld/%lld NoBuf %lld Wr %lld Copied %lld Queued %lld Partial %lld WrByte %lld Rearm %lld PeerClose %lld Stale %lld\n",
+                       mSocketIoUringParam_X.SocketServerParam_X.Name_S.c_str(), mNbSession_U32, mSocketIoUringParam_X.SocketServerParam_X.NbMaxSession_U32,
+                       mSocketIoUringStatistic_X.NbSubmitCall_U64, mSocketIoUringStatistic_X.NbSqe_U64, mSocketIoUringStatistic_X.NbCqe_U64, mSocketIoUringStatistic_X.NbAccept_U64,
+                       mSocketIoUringStatistic_X.NbRejectedAccept_U64, mSocketIoUringStatistic_X.NbRecv_U64, mSocketIoUringStatistic_X.NbRecvByte_U64,
+                       mSocketIoUringStatistic_X.NbRecvNoBuffer_U64, mSocketIoUringStatistic_X.NbWrite_U64, mSocketIoUringStatistic_X.NbWriteCopied_U64,
+                       mSocketIoUringStatistic_X.NbWriteQueued_U64, mSocketIoUringStatistic_X.NbWritePartial_U64, mSocketIoUringStatistic_X.NbWriteByte_U64, mSocketIoUringStatistic_X.NbRearm_U64, mSocketIoUringStatistic_X.NbPeerClosed_U64,
+                       mSocketIoUringStatistic_X.NbStaleCqe_U64);
+  }
+
+private:
+  //user_data: op (8 bits) | generation (24 bits) | index (32 bits)
+  static uint64_t UserData(IO_URING_OP _Op_E, uint32_t _Generation_U32, uint32_t _Index_U32)
+  {
+    return (static_cast<uint64_t>(_Op_E) << 56) | (static_cast<uint64_t>(_Generation_U32 & 0xFFFFFF) << 32) | _Index_U32;
+  }
+
+  BOFERR V_OnProcessing() override
+  {
+    uint32_t NbCqe_U32;
+
+    if (!IsThreadLoopMustExit())
+    {
+      Poll(mSocketIoUringParam_X.PollTimeoutInMs_U32, NbCqe_U32);
+    }
+    return BOF_ERR_NO_ERROR;
+  }
+
+#if BOF_IO_URING_AVAILABLE
+  BOFERR OpenIoUring()
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+    uint32_t i_U32, NbSlot_U32 = mSocketIoUringParam_X.SocketServerParam_X.NbMaxSession_U32;
+
+    if (BofIoUring::S_IsSupported())
+    {
+      Rts_E = mIoUring.Open(mSocketIoUringParam_X.NbSqEntry_U32, 0);
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = mIoUring.RegisterSparseFile(NbSlot_U32);
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = mRecvBufferRing.Open(&mIoUring, RECV_BUFFER_GROUP, mSocketIoUringParam_X.NbRecvBuffer_U32, mSocketIoUringParam_X.RecvBufferSizeInByte_U32);
+    }
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (mSocketIoUringParam_X.NbWriteBuffer_U32) && (mSocketIoUringParam_X.WriteBufferSizeInByte_U32))
+    {
+      mWriteBuffer.resize(static_cast<size_t>(mSocketIoUringParam_X.NbWriteBuffer_U32) * mSocketIoUringParam_X.WriteBufferSizeInByte_U32);
+      for (i_U32 = 0; i_U32 < mSocketIoUringParam_X.NbWriteBuffer_U32; i_U32++)
+      {
+        mFreeWriteBufferCollection.push_back(mSocketIoUringParam_X.NbWriteBuffer_U32 - 1 - i_U32);
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mSessionSlotCollection.resize(NbSlot_U32);
+      for (i_U32 = 0; i_U32 < NbSlot_U32; i_U32++)
+      {
+        mSessionSlotCollection[i_U32].Generation_U32 = 0;
+        mSessionSlotCollection[i_U32].NextFree_U32 = (i_U32 + 1 < NbSlot_U32) ? i_U32 + 1 : NO_INDEX;
+        mSessionSlotCollection[i_U32].FirstWrite_U32 = NO_INDEX;
+        mSessionSlotCollection[i_U32].LastWrite_U32 = NO_INDEX;
+      }
+      mFirstFreeSlot_U32 = 0;
+      mSlotIndexCollection.reserve(NbSlot_U32);
+    }
+    else
+    {
+      mRecvBufferRing.Close();
+      mIoUring.Close();
+      mWriteBuffer.clear();
+      mFreeWriteBufferCollection.clear();
+    }
+    return Rts_E;
+  }
+
+  //The functions below are called with mMtx held
+  struct io_uring_sqe *GetSqe()
+  {
+    struct io_uring_sqe *pRts_X = mIoUring.GetSqe();
+
+    if (!pRts_X)
+    {
+      Submit();
+      pRts_X = mIoUring.GetSqe();
+    }
+    if (pRts_X)
+    {
+      mSocketIoUringStatistic_X.NbSqe_U64++;
+    }
+    return pRts_X;
+  }
+
+  BOFERR Submit()
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+
+    if (mIoUring.NbPendingSqe())
+    {
+      mSocketIoUringStatistic_X.NbSubmitCall_U64++;
+      Rts_E = mIoUring.Submit(0, 0);
+    }
+    return Rts_E;
+  }
+
+  //From the completion thread the submission is deferred to the next Poll to batch it with the wait
+  BOFERR SubmitIfNotCompletionThread()
+  {
+    return (std::this_thread::get_id() == mCompletionThreadId) ? BOF_ERR_NO_ERROR : Submit();
+  }
+
+  BOFERR PrepAccept(uint32_t _ListenerIndex_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    struct io_uring_sqe *pSqe_X = GetSqe();
+
+    if (pSqe_X)
+    {
+      pSqe_X->opcode = IORING_OP_ACCEPT;
+      pSqe_X->fd = mListenerCollection[_ListenerIndex_U32]->GetSocketHandle();
+      pSqe_X->ioprio = IORING_ACCEPT_MULTISHOT;
+      pSqe_X->accept_flags = SOCK_CLOEXEC;
+      pSqe_X->user_data = UserData(IO_URING_OP_ACCEPT, 0, _ListenerIndex_U32);
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+    return Rts_E;
+  }
+
+  BOFERR PrepRecv(uint32_t _Slot_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    struct io_uring_sqe *pSqe_X = GetSqe();
+
+    if (pSqe_X)
+    {
+      pSqe_X->opcode = IORING_OP_RECV;
+      pSqe_X->fd = static_cast<int32_t>(_Slot_U32);
+      pSqe_X->flags = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+      pSqe_X->ioprio = IORING_RECV_MULTISHOT;
+      pSqe_X->buf_group = mRecvBufferRing.GroupId();
+      pSqe_X->user_data = UserData(IO_URING_OP_RECV, mSessionSlotCollection[_Slot_U32].Generation_U32, _Slot_U32);
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+    return Rts_E;
+  }
+
+  //Queues a write behind the one in progress of the session, or starts it if the queue is empty
+  BOFERR PrepWrite(const BofSocketIo *_pSocketSession, uint32_t _Nb_U32, const uint8_t *_pBuffer_U8, void *_pWriteContext)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    std::unordered_map<const BofSocketIo *, uint32_t>::iterator It;
+    uint32_t Index_U32;
+    WRITE_REQUEST WriteRequest_X;
+
+    It = mSlotIndexCollection.find(_pSocketSession);
+    if (It != mSlotIndexCollection.end())
+    {
+      SESSION_SLOT &rSlot_X = mSessionSlotCollection[It->second];
+
+      WriteRequest_X.Slot_U32 = It->second;
+      WriteRequest_X.Generation_U32 = rSlot_X.Generation_U32;
+      WriteRequest_X.pBuffer_U8 = _pBuffer_U8;
+      WriteRequest_X.Nb_U32 = _Nb_U32;
+      WriteRequest_X.NbSent_U32 = 0;
+      WriteRequest_X.pWriteContext = _pWriteContext;
+      WriteRequest_X.WriteBufferIndex_U32 = NO_INDEX;
+      WriteRequest_X.Next_U32 = NO_INDEX;
+      if ((_Nb_U32 <= mSocketIoUringParam_X.WriteBufferSizeInByte_U32) && (mFreeWriteBufferCollection.size()))
+      {
+        WriteRequest_X.WriteBufferIndex_U32 = mFreeWriteBufferCollection.back();
+        mFreeWriteBufferCollection.pop_back();
+        memcpy(WriteBuffer(WriteRequest_X.WriteBufferIndex_U32), _pBuffer_U8, _Nb_U32);
+      }
+      if (mFirstFreeWriteRequest_U32 != NO_INDEX)
+      {
+        Index_U32 = mFirstFreeWriteRequest_U32;
+        mFirstFreeWriteRequest_U32 = mWriteRequestCollection[Index_U32].Next_U32;
+        mWriteRequestCollection[Index_U32] = WriteRequest_X;
+      }
+      else
+      {
+        Index_U32 = static_cast<uint32_t>(mWriteRequestCollection.size());
+        mWriteRequestCollection.push_back(WriteRequest_X);
+      }
+      if (rSlot_X.FirstWrite_U32 == NO_INDEX)
+      {
+        Rts_E = PrepWriteSqe(Index_U32);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          rSlot_X.FirstWrite_U32 = Index_U32;
+          rSlot_X.LastWrite_U32 = Index_U32;
+        }
+        else
+        {
+          FreeWriteRequest(Index_U32);
+        }
+      }
+      else
+      {
+        mWriteRequestCollection[rSlot_X.LastWrite_U32].Next_U32 = Index_U32;
+        rSlot_X.LastWrite_U32 = Index_U32;
+        mSocketIoUringStatistic_X.NbWriteQueued_U64++;
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        mSocketIoUringStatistic_X.NbWrite_U64++;
+        if (WriteRequest_X.WriteBufferIndex_U32 != NO_INDEX)
+        {
+          mSocketIoUringStatistic_X.NbWriteCopied_U64++;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  uint8_t *WriteBuffer(uint32_t _WriteBufferIndex_U32)
+  {
+    return &mWriteBuffer[static_cast<size_t>(_WriteBufferIndex_U32) * mSocketIoUringParam_X.WriteBufferSizeInByte_U32];
+  }
+
+  //Sends what remains of a write, from its write buffer or from the caller buffer
+  BOFERR PrepWriteSqe(uint32_t _Index_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    const WRITE_REQUEST &rWriteRequest_X = mWriteRequestCollection[_Index_U32];
+    const uint8_t *pBuffer_U8 = (rWriteRequest_X.WriteBufferIndex_U32 != NO_INDEX) ? WriteBuffer(rWriteRequest_X.WriteBufferIndex_U32) : rWriteRequest_X.pBuffer_U8;
+    struct io_uring_sqe *pSqe_X = GetSqe();
+
+    if (pSqe_X)
+    {
+      pSqe_X->opcode = IORING_OP_SEND;
+      pSqe_X->fd = static_cast<int32_t>(rWriteRequest_X.Slot_U32);
+      pSqe_X->flags = IOSQE_FIXED_FILE;
+      pSqe_X->addr = reinterpret_cast<uint64_t>(pBuffer_U8 + rWriteRequest_X.NbSent_U32);
+      pSqe_X->len = rWriteRequest_X.Nb_U32 - rWriteRequest_X.NbSent_U32;
+      pSqe_X->msg_flags = MSG_NOSIGNAL;
+      pSqe_X->user_data = UserData(IO_URING_OP_WRITE, 0, _Index_U32);
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+    return Rts_E;
+  }
+
+  void FreeWriteRequest(uint32_t _Index_U32)
+  {
+    if (mWriteRequestCollection[_Index_U32].WriteBufferIndex_U32 != NO_INDEX)
+    {
+      mFreeWriteBufferCollection.push_back(mWriteRequestCollection[_Index_U32].WriteBufferIndex_U32);
+    }
+    mWriteRequestCollection[_Index_U32].Next_U32 = mFirstFreeWriteRequest_U32;
+    mFirstFreeWriteRequest_U32 = _Index_U32;
+  }
+
+  BOFERR OpenSlot(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    uint32_t Slot_U32;
+
+    if (mSlotIndexCollection.find(_psSocketSession.get()) != mSlotIndexCollection.end())
+    {
+      Rts_E = BOF_ERR_EEXIST;
+    }
+    else if (mFirstFreeSlot_U32 != NO_INDEX)
+    {
+      Slot_U32 = mFirstFreeSlot_U32;
+      Rts_E = mIoUring.UpdateFile(Slot_U32, _psSocketSession->NativeSocketHandle());
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        //A new generation makes the late completions of the previous user of the slot stale
+        mFirstFreeSlot_U32 = mSessionSlotCollection[Slot_U32].NextFree_U32;
+        mSessionSlotCollection[Slot_U32].psSocketSession = _psSocketSession;
+        mSessionSlotCollection[Slot_U32].Generation_U32 = (mSessionSlotCollection[Slot_U32].Generation_U32 + 1) & 0xFFFFFF;
+        mSessionSlotCollection[Slot_U32].FirstWrite_U32 = NO_INDEX;
+        mSessionSlotCollection[Slot_U32].LastWrite_U32 = NO_INDEX;
+        mSlotIndexCollection[_psSocketSession.get()] = Slot_U32;
+        mNbSession_U32++;
+        Rts_E = PrepRecv(Slot_U32);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = SubmitIfNotCompletionThread();
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR CloseSlot(const BofSocketIo *_pSocketSession, std::shared_ptr<BofSocketIo> *_ppsSocketSession)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    std::unordered_map<const BofSocketIo *, uint32_t>::iterator It;
+    struct io_uring_sqe *pSqe_X;
+    uint32_t Slot_U32, Index_U32, Next_U32;
+
+    It = mSlotIndexCollection.find(_pSocketSession);
+    if (It != mSlotIndexCollection.end())
+    {
+      Slot_U32 = It->second;
+      pSqe_X = GetSqe();
+      if (pSqe_X)
+      {
+        pSqe_X->opcode = IORING_OP_ASYNC_CANCEL;
+        pSqe_X->fd = -1;
+        pSqe_X->addr = UserData(IO_URING_OP_RECV, mSessionSlotCollection[Slot_U32].Generation_U32, Slot_U32);
+        pSqe_X->user_data = UserData(IO_URING_OP_CANCEL, 0, Slot_U32);
+      }
+      Submit();
+      mIoUring.UpdateFile(Slot_U32, -1);
+      if (_ppsSocketSession)
+      {
+        *_ppsSocketSession = mSessionSlotCollection[Slot_U32].psSocketSession;
+      }
+      mSessionSlotCollection[Slot_U32].psSocketSession.reset();
+      //The write in progress is freed by its (now stale) completion, the queued ones are dropped without notification
+      Index_U32 = mSessionSlotCollection[Slot_U32].FirstWrite_U32;
+      if (Index_U32 != NO_INDEX)
+      {
+        Index_U32 = mWriteRequestCollection[Index_U32].Next_U32;
+        while (Index_U32 != NO_INDEX)
+        {
+          Next_U32 = mWriteRequestCollection[Index_U32].Next_U32;
+          FreeWriteRequest(Index_U32);
+          Index_U32 = Next_U32;
+        }
+      }
+      mSessionSlotCollection[Slot_U32].FirstWrite_U32 = NO_INDEX;
+      mSessionSlotCollection[Slot_U32].LastWrite_U32 = NO_INDEX;
+      mSessionSlotCollection[Slot_U32].Generation_U32 = (mSessionSlotCollection[Slot_U32].Generation_U32 + 1) & 0xFFFFFF;
+      mSessionSlotCollection[Slot_U32].NextFree_U32 = mFirstFreeSlot_U32;
+      mFirstFreeSlot_U32 = Slot_U32;
+      mSlotIndexCollection.erase(It);
+      mNbSession_U32--;
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+    return Rts_E;
+  }
+
+  void CloseSessionFromCompletion(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    BOFERR Sts_E;
+
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      Sts_E = CloseSlot(_psSocketSession.get(), &psSocketSession);
+      if (Sts_E == BOF_ERR_NO_ERROR)
+      {
+        mSocketIoUringStatistic_X.NbPeerClosed_U64++;
+      }
+    }
+    if (Sts_E == BOF_ERR_NO_ERROR)
+    {
+      mpIBofSocketSessionFactory->V_CloseSession(psSocketSession);
+    }
+  }
+
+  void OnCqe(const struct io_uring_cqe &_rCqe_X)
+  {
+    IO_URING_OP Op_E = static_cast<IO_URING_OP>(_rCqe_X.user_data >> 56);
+    uint32_t Generation_U32 = static_cast<uint32_t>(_rCqe_X.user_data >> 32) & 0xFFFFFF;
+    uint32_t Index_U32 = static_cast<uint32_t>(_rCqe_X.user_data);
+    bool More_B = ((_rCqe_X.flags & IORING_CQE_F_MORE) != 0);
+
+    switch (Op_E)
+    {
+      case IO_URING_OP_ACCEPT:
+        OnAccept(Index_U32, _rCqe_X.res, More_B);
+        break;
+
+      case IO_URING_OP_RECV:
+        OnRecv(Index_U32, Generation_U32, _rCqe_X, More_B);
+        break;
+
+      case IO_URING_OP_WRITE:
+        OnWrite(Index_U32, _rCqe_X.res);
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void OnAccept(uint32_t _ListenerIndex_U32, int _Res_i, bool _More_B)
+  {
+    std::unique_ptr<BofSocket> puSocket;
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    bool Full_B = true;
+
+    if (_Res_i >= 0)
+    {
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        Full_B = (mNbSession_U32 >= mSocketIoUringParam_X.SocketServerParam_X.NbMaxSession_U32);
+        if (Full_B)
+        {
+          mSocketIoUringStatistic_X.NbRejectedAccept_U64++;
+        }
+        else
+        {
+          mSocketIoUringStatistic_X.NbAccept_U64++;
+        }
+      }
+      if (Full_B)
+      {
+        close(_Res_i);
+      }
+      else
+      {
+        puSocket.reset(new BofSocket(static_cast<BOFSOCKET>(_Res_i), mSocketIoUringParam_X.AcceptedSocketParam_X));
+        psSocketSession = mpIBofSocketSessionFactory->V_OpenSession(BOF_SOCKET_SESSION_TYPE::POLL_CHANNEL, mNextSessionIndex_U32++, std::move(puSocket));
+        if ((psSocketSession) && (AddSession(psSocketSession) != BOF_ERR_NO_ERROR))
+        {
+          mpIBofSocketSessionFactory->V_CloseSession(psSocketSession);
+        }
+      }
+    }
+    if (!_More_B)
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      mSocketIoUringStatistic_X.NbRearm_U64++;
+      PrepAccept(_ListenerIndex_U32);
+    }
+  }
+
+  void OnRecv(uint32_t _Slot_U32, uint32_t _Generation_U32, const struct io_uring_cqe &_rCqe_X, bool _More_B)
+  {
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    uint16_t BufferId_U16 = static_cast<uint16_t>(_rCqe_X.flags >> IORING_CQE_BUFFER_SHIFT);
+    bool Stale_B;
+
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      Stale_B = ((_Slot_U32 >= mSessionSlotCollection.size()) || (mSessionSlotCollection[_Slot_U32].Generation_U32 != _Generation_U32) ||
+                 (!mSessionSlotCollection[_Slot_U32].psSocketSession));
+      if (Stale_B)
+      {
+        mSocketIoUringStatistic_X.NbStaleCqe_U64++;
+      }
+      else
+      {
+        psSocketSession = mSessionSlotCollection[_Slot_U32].psSocketSession;
+        if (_rCqe_X.res > 0)
+        {
+          mSocketIoUringStatistic_X.NbRecv_U64++;
+          mSocketIoUringStatistic_X.NbRecvByte_U64 += static_cast<uint32_t>(_rCqe_X.res);
+        }
+        else if (_rCqe_X.res == -ENOBUFS)
+        {
+          mSocketIoUringStatistic_X.NbRecvNoBuffer_U64++;
+        }
+      }
+    }
+    if (_rCqe_X.res > 0)
+    {
+      if (psSocketSession)
+      {
+        psSocketSession->V_SignalDataRead(static_cast<uint32_t>(_rCqe_X.res), mRecvBufferRing.Buffer(BufferId_U16));
+      }
+      //The buffer is given back even for a stale completion
+      if (_rCqe_X.flags & IORING_CQE_F_BUFFER)
+      {
+        mRecvBufferRing.Recycle(BufferId_U16);
+      }
+    }
+    if (psSocketSession)
+    {
+      if ((_rCqe_X.res == 0) || ((_rCqe_X.res < 0) && (_rCqe_X.res != -ENOBUFS) && (_rCqe_X.res != -ECANCELED)))
+      {
+        if (_rCqe_X.res < 0)
+        {
+          psSocketSession->V_SignalError(static_cast<BOFERR>(-_rCqe_X.res), "BofSocketIoUringServer recv", true);
+        }
+        CloseSessionFromCompletion(psSocketSession);
+      }
+      else if (!_More_B)
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        if (mSessionSlotCollection[_Slot_U32].Generation_U32 == _Generation_U32)
+        {
+          mSocketIoUringStatistic_X.NbRearm_U64++;
+          PrepRecv(_Slot_U32);
+        }
+      }
+    }
+  }
+
+  //Completes the write in progress of a session or submits its remainder after a short send, then starts the next one
+  void OnWrite(uint32_t _Index_U32, int _Res_i)
+  {
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    WRITE_REQUEST WriteRequest_X;
+    std::vector<WRITE_REQUEST> FailedCollection;
+    BOFERR Sts_E = (_Res_i >= 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(-_Res_i);
+    bool Done_B = true;
+    uint32_t Index_U32;
+
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      WRITE_REQUEST &rWriteRequest_X = mWriteRequestCollection[_Index_U32];
+      SESSION_SLOT &rSlot_X = mSessionSlotCollection[rWriteRequest_X.Slot_U32];
+
+      if (_Res_i > 0)
+      {
+        rWriteRequest_X.NbSent_U32 += static_cast<uint32_t>(_Res_i);
+        mSocketIoUringStatistic_X.NbWriteByte_U64 += static_cast<uint32_t>(_Res_i);
+      }
+      if ((rSlot_X.Generation_U32 == rWriteRequest_X.Generation_U32) && (rSlot_X.psSocketSession))
+      {
+        psSocketSession = rSlot_X.psSocketSession;
+        if ((_Res_i > 0) && (rWriteRequest_X.NbSent_U32 < rWriteRequest_X.Nb_U32))
+        {
+          Sts_E = PrepWriteSqe(_Index_U32);
+          Done_B = (Sts_E != BOF_ERR_NO_ERROR);
+          if (!Done_B)
+          {
+            mSocketIoUringStatistic_X.NbWritePartial_U64++;
+          }
+        }
+        if (Done_B)
+        {
+          //Start the next write of the session: if it cannot be submitted it fails, as the ones behind it
+          rSlot_X.FirstWrite_U32 = rWriteRequest_X.Next_U32;
+          Index_U32 = rSlot_X.FirstWrite_U32;
+          while ((Index_U32 != NO_INDEX) && (PrepWriteSqe(Index_U32) != BOF_ERR_NO_ERROR))
+          {
+            FailedCollection.push_back(mWriteRequestCollection[Index_U32]);
+            rSlot_X.FirstWrite_U32 = mWriteRequestCollection[Index_U32].Next_U32;
+            FreeWriteRequest(Index_U32);
+            Index_U32 = rSlot_X.FirstWrite_U32;
+          }
+          if (rSlot_X.FirstWrite_U32 == NO_INDEX)
+          {
+            rSlot_X.LastWrite_U32 = NO_INDEX;
+          }
+        }
+      }
+      if (Done_B)
+      {
+        WriteRequest_X = rWriteRequest_X;
+        FreeWriteRequest(_Index_U32);
+      }
+    }
+    if ((psSocketSession) && (Done_B))
+    {
+      psSocketSession->V_SignalDataWritten(Sts_E, WriteRequest_X.NbSent_U32, WriteRequest_X.pBuffer_U8, WriteRequest_X.Nb_U32 - WriteRequest_X.NbSent_U32,
+                                           WriteRequest_X.pBuffer_U8 + WriteRequest_X.NbSent_U32, WriteRequest_X.pWriteContext);
+      for (const WRITE_REQUEST &rFailed_X : FailedCollection)
+      {
+        psSocketSession->V_SignalDataWritten(BOF_ERR_FULL, 0, rFailed_X.pBuffer_U8, rFailed_X.Nb_U32, rFailed_X.pBuffer_U8, rFailed_X.pWriteContext);
+      }
+    }
+  }
+#else
+  BOFERR OpenIoUring()
+  {
+    return BOF_ERR_NOT_SUPPORTED;
+  }
+#endif
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the multi reactor socket server which shards the
+ * sessions across several pinned BofSocketPollServer threads.
+ *
+ * Name:        bofsocketmultireactor.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocketpoller.h>
+#if !defined(_WIN32)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_REACTOR_ACCEPT_MODE : uint32_t
+{
+  BOF_SOCKET_REACTOR_ACCEPT_MODE_REUSEPORT = 0,  //One SO_REUSEPORT listener per reactor: the kernel spreads the connections
+  BOF_SOCKET_REACTOR_ACCEPT_MODE_ROUND_ROBIN,    //One listener on reactor 0 which hands the connections off in turn
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_MULTI_REACTOR_PARAM
+{
+  BOF_SOCKET_POLL_SERVER_PARAM   ReactorParam_X;                        /*! Template of each reactor: NbMaxSession_U32 is per reactor, Name_S gets a #index suffix */
+  uint32_t                       NbReactor_U32;
+  std::vector<uint64_t>          ReactorCpuCoreAffinityMaskCollection;  /*! Entry i pins reactor i. Missing entries use ReactorParam_X affinity */
+  BOF_SOCKET_REACTOR_ACCEPT_MODE AcceptMode_E;
+  BOF_SOCKET_POLLER_DISPATCH     Dispatch_E;                            /*! Dispatch mode of the accepted sessions */
+  BOF_SOCKET_PARAM               ListenerSocketParam_X;                 /*! Used to wrap the listening sockets created by Listen */
+
+  BOF_SOCKET_MULTI_REACTOR_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    ReactorParam_X.Reset();
+    NbReactor_U32 = 1;
+    ReactorCpuCoreAffinityMaskCollection.clear();
+    AcceptMode_E = BOF_SOCKET_REACTOR_ACCEPT_MODE::BOF_SOCKET_REACTOR_ACCEPT_MODE_REUSEPORT;
+    Dispatch_E = BOF_SOCKET_POLLER_DISPATCH::BOF_SOCKET_POLLER_DISPATCH_DATA_READ;
+    ListenerSocketParam_X.Reset();
+    ListenerSocketParam_X.BaseChannelParam_X.ListenBackLog_U32 = 1024;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Multi reactor socket server
+ *
+ * Description
+ * Runs NbReactor_U32 BofSocketPollServer, each one with its own poller and thread pinned on its own core(s).
+ * A session is added to one reactor and stays there for its lifetime: all its callbacks run on that thread.
+ * Connections are spread either by the kernel (SO_REUSEPORT, one listener per reactor) or by a single listener
+ * on reactor 0 handing them off in turn (round robin, skipping the full reactors).
+ *
+ * See Also
+ * BofSocketPollServer
+ */
+class BofSocketMultiReactorServer
+{
+private:
+  IBofSocketSessionFactory                          *mpIBofSocketSessionFactory = nullptr;
+  BOF_SOCKET_MULTI_REACTOR_PARAM                    mSocketMultiReactorParam_X;
+  BOFERR                                            mErrorCode_E = BOF_ERR_INIT;
+  std::vector<std::unique_ptr<BofSocketPollServer>> mReactorCollection;
+  std::atomic<uint32_t>                             mNextReactor;
+  std::atomic<uint32_t>                             mNextSessionIndex;
+  std::atomic<uint64_t>                             mNbHandOffRejected;
+
+public:
+  BofSocketMultiReactorServer(IBofSocketSessionFactory *_pIBofSocketSessionFactory, const BOF_SOCKET_MULTI_REACTOR_PARAM &_rSocketMultiReactorParam_X)
+  {
+    BOF_SOCKET_POLL_SERVER_PARAM ReactorParam_X;
+    uint32_t i_U32;
+
+    mpIBofSocketSessionFactory = _pIBofSocketSessionFactory;
+    mSocketMultiReactorParam_X = _rSocketMultiReactorParam_X;
+    mNextReactor.store(0);
+    mNextSessionIndex.store(0);
+    mNbHandOffRejected.store(0);
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mpIBofSocketSessionFactory) && (mSocketMultiReactorParam_X.NbReactor_U32))
+    {
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      for (i_U32 = 0; (i_U32 < mSocketMultiReactorParam_X.NbReactor_U32) && (mErrorCode_E == BOF_ERR_NO_ERROR); i_U32++)
+      {
+        ReactorParam_X = mSocketMultiReactorParam_X.ReactorParam_X;
+        ReactorParam_X.SocketServerParam_X.Name_S += "#" + std::to_string(i_U32);
+        if (i_U32 < mSocketMultiReactorParam_X.ReactorCpuCoreAffinityMaskCollection.size())
+        {
+          ReactorParam_X.SocketServerParam_X.ThreadCpuCoreAffinityMask_U64 = mSocketMultiReactorParam_X.ReactorCpuCoreAffinityMaskCollection[i_U32];
+        }
+        ReactorParam_X.OnAccept = nullptr;
+        if ((i_U32 == 0) && (mSocketMultiReactorParam_X.AcceptMode_E == BOF_SOCKET_REACTOR_ACCEPT_MODE::BOF_SOCKET_REACTOR_ACCEPT_MODE_ROUND_ROBIN))
+        {
+          ReactorParam_X.OnAccept = [this](std::unique_ptr<BofSocket> &_rpuSocket) { return HandOff(_rpuSocket); };
+        }
+        mReactorCollection.emplace_back(new BofSocketPollServer(mpIBofSocketSessionFactory, ReactorParam_X));
+        mErrorCode_E = mReactorCollection.back()->LastErrorCode();
+      }
+    }
+  }
+  virtual ~BofSocketMultiReactorServer()
+  {
+    Stop();
+  }
+  BofSocketMultiReactorServer &operator=(const BofSocketMultiReactorServer &) = delete; // Disallow copying
+  BofSocketMultiReactorServer(const BofSocketMultiReactorServer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  uint32_t NbReactor() const
+  {
+    return static_cast<uint32_t>(mReactorCollection.size());
+  }
+
+  BofSocketPollServer *Reactor(uint32_t _Index_U32)
+  {
+    return (_Index_U32 < mReactorCollection.size()) ? mReactorCollection[_Index_U32].get() : nullptr;
+  }
+
+  BOFERR Start()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    uint32_t i_U32;
+
+    for (i_U32 = 0; (i_U32 < mReactorCollection.size()) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+    {
+      Rts_E = mReactorCollection[i_U32]->Start();
+    }
+    return Rts_E;
+  }
+
+  BOFERR Stop()
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR, Sts_E;
+    uint32_t i_U32;
+
+    for (i_U32 = 0; i_U32 < mReactorCollection.size(); i_U32++)
+    {
+      Sts_E = mReactorCollection[i_U32]->Stop();
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = Sts_E;
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Create the listening socket(s) for an address according to AcceptMode_E.
+   *
+   * Parameters
+   * _rAddress_S: Specifies the address to listen on such as "tcp://0.0.0.0:8080"
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Listen(const std::string &_rAddress_S)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    std::unique_ptr<BofSocket> puListener;
+    bool ReusePort_B = (mSocketMultiReactorParam_X.AcceptMode_E == BOF_SOCKET_REACTOR_ACCEPT_MODE::BOF_SOCKET_REACTOR_ACCEPT_MODE_REUSEPORT);
+    uint32_t i_U32, NbListener_U32 = ReusePort_B ? NbReactor() : 1;
+
+    for (i_U32 = 0; (i_U32 < NbListener_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+    {
+      Rts_E = S_CreateListener(_rAddress_S, ReusePort_B, mSocketMultiReactorParam_X.ListenerSocketParam_X, puListener);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = mReactorCollection[i_U32]->AddListener(std::move(puListener), mSocketMultiReactorParam_X.Dispatch_E, BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT);
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Add an existing session to the reactor which has the fewest sessions.
+   */
+  BOFERR AddSession(std::shared_ptr<BofSocketIo> _psSocketSession, uint16_t _Event_U16, BOF_SOCKET_POLLER_DISPATCH _Dispatch_E, BOF_SOCKET_POLLER_TRIGGER _Trigger_E)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    uint32_t i_U32, Best_U32 = 0, Nb_U32, BestNb_U32 = 0xFFFFFFFF;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      for (i_U32 = 0; i_U32 < mReactorCollection.size(); i_U32++)
+      {
+        Nb_U32 = mReactorCollection[i_U32]->NbSession();
+        if (Nb_U32 < BestNb_U32)
+        {
+          BestNb_U32 = Nb_U32;
+          Best_U32 = i_U32;
+        }
+      }
+      Rts_E = mReactorCollection[Best_U32]->AddSession(_psSocketSession, _Event_U16, _Dispatch_E, _Trigger_E);
+    }
+    return Rts_E;
+  }
+
+  BOFERR RemoveSession(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    uint32_t i_U32;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_NOT_FOUND;
+      for (i_U32 = 0; (i_U32 < mReactorCollection.size()) && (Rts_E == BOF_ERR_NOT_FOUND); i_U32++)
+      {
+        Rts_E = mReactorCollection[i_U32]->RemoveSession(_psSocketSession);
+      }
+    }
+    return Rts_E;
+  }
+
+  uint32_t NbSession()
+  {
+    uint32_t Rts_U32 = 0, i_U32;
+
+    for (i_U32 = 0; i_U32 < mReactorCollection.size(); i_U32++)
+    {
+      Rts_U32 += mReactorCollection[i_U32]->NbSession();
+    }
+    return Rts_U32;
+  }
+
+  /*!
+   * Description
+   * Sum of the statistics of every reactor. MaxEventPerWait_U32 is the maximum over the reactors.
+   */
+  BOF_SOCKET_POLL_SERVER_STATISTIC SocketServerStatistic()
+  {
+    BOF_SOCKET_POLL_SERVER_STATISTIC Rts_X, Reactor_X;
+    uint32_t i_U32;
+
+    for (i_U32 = 0; i_U32 < mReactorCollection.size(); i_U32++)
+    {
+      Reactor_X = mReactorCollection[i_U32]->SocketPollServerStatistic();
+      Rts_X.NbWait_U64 += Reactor_X.NbWait_U64;
+      Rts_X.NbEvent_U64 += Reactor_X.NbEvent_U64;
+      Rts_X.NbStaleEvent_U64 += Reactor_X.NbStaleEvent_U64;
+      Rts_X.NbAdd_U64 += Reactor_X.NbAdd_U64;
+      Rts_X.NbRemove_U64 += Reactor_X.NbRemove_U64;
+      Rts_X.NbAccept_U64 += Reactor_X.NbAccept_U64;
+      Rts_X.NbRejectedAccept_U64 += Reactor_X.NbRejectedAccept_U64;
+      Rts_X.NbPeerClosed_U64 += Reactor_X.NbPeerClosed_U64;
+      Rts_X.NbDispatchError_U64 += Reactor_X.NbDispatchError_U64;
+      if (Reactor_X.MaxEventPerWait_U32 > Rts_X.MaxEventPerWait_U32)
+      {
+        Rts_X.MaxEventPerWait_U32 = Reactor_X.MaxEventPerWait_U32;
+      }
+    }
+    Rts_X.NbRejectedAccept_U64 += mNbHandOffRejected.load();
+    return Rts_X;
+  }
+
+  std::string SocketServerDebugInfo()
+  {
+    std::string Rts_S;
+    BOF_SOCKET_POLL_SERVER_STATISTIC Total_X = SocketServerStatistic();
+    uint32_t i_U32;
+
+    Rts_S = Bof_Sprintf("MultiReactor '%s' %u reactor(s) %s: Session %u Wait %lld Evt %lld MaxEvt %u Stale %lld Acc %lld Rej %lld PeerClose %lld DispErr %lld\n",
+                        mSocketMultiReactorParam_X.ReactorParam_X.SocketServerParam_X.Name_S.c_str(), NbReactor(),
+                        (mSocketMultiReactorParam_X.AcceptMode_E == BOF_SOCKET_REACTOR_ACCEPT_MODE::BOF_SOCKET_REACTOR_ACCEPT_MODE_REUSEPORT) ? "reuseport" : "round robin",
+                        NbSession(), Total_X.NbWait_U64, Total_X.NbEvent_U64, Total_X.MaxEventPerWait_U32, Total_X.NbStaleEvent_U64, Total_X.NbAccept_U64,
+                        Total_X.NbRejectedAccept_U64, Total_X.NbPeerClosed_U64, Total_X.NbDispatchError_U64);
+    for (i_U32 = 0; i_U32 < mReactorCollection.size(); i_U32++)
+    {
+      Rts_S += "  " + mReactorCollection[i_U32]->SocketPollServerDebugInfo();
+    }
+    return Rts_S;
+  }
+
+  /*!
+   * Description
+   * Create, bind and listen a tcp socket and wrap it in a BofSocket.
+   *
+   * Parameters
+   * _rAddress_S:             Specifies the address to listen on
+   * _ReusePort_B:            Specifies if SO_REUSEPORT must be set before the bind
+   * _rListenerSocketParam_X: Specifies the BofSocket parameters
+   * _rpuListener:            Returns the listening socket
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  static BOFERR S_CreateListener(const std::string &_rAddress_S, bool _ReusePort_B, const BOF_SOCKET_PARAM &_rListenerSocketParam_X, std::unique_ptr<BofSocket> &_rpuListener)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if !defined(_WIN32)
+    BOF_SOCKET_ADDRESS SocketAddress_X;
+    BOF_SOCKET_PARAM ListenerSocketParam_X = _rListenerSocketParam_X;
+    const struct sockaddr *pSockAddr_X;
+    socklen_t SockAddrLen;
+    int Fd_i, Val_i = 1;
+
+    _rpuListener.reset(nullptr);
+    Rts_E = Bof_IpAddressToSocketAddress(_rAddress_S, SocketAddress_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      pSockAddr_X = SocketAddress_X.IpV6_B ? reinterpret_cast<const struct sockaddr *>(&SocketAddress_X.IpV6Address_X) : reinterpret_cast<const struct sockaddr *>(&SocketAddress_X.IpV4Address_X);
+      SockAddrLen = SocketAddress_X.IpV6_B ? sizeof(SocketAddress_X.IpV6Address_X) : sizeof(SocketAddress_X.IpV4Address_X);
+      Fd_i = socket(SocketAddress_X.IpV6_B ? AF_INET6 : AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      Rts_E = (Fd_i >= 0) ? BOF_ERR_NO_ERROR : BOF_ERR_CREATE;
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        if ((setsockopt(Fd_i, SOL_SOCKET, SO_REUSEADDR, &Val_i, sizeof(Val_i)) < 0) ||
+            ((_ReusePort_B) && (setsockopt(Fd_i, SOL_SOCKET, SO_REUSEPORT, &Val_i, sizeof(Val_i)) < 0)) ||
+            (bind(Fd_i, pSockAddr_X, SockAddrLen) < 0) ||
+            (listen(Fd_i, static_cast<int>(ListenerSocketParam_X.BaseChannelParam_X.ListenBackLog_U32 ? ListenerSocketParam_X.BaseChannelParam_X.ListenBackLog_U32 : SOMAXCONN)) < 0))
+        {
+          Rts_E = static_cast<BOFERR>(errno);
+          close(Fd_i);
+        }
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        ListenerSocketParam_X.BindIpAddress_S = _rAddress_S;
+        if (ListenerSocketParam_X.BaseChannelParam_X.ListenBackLog_U32 == 0)
+        {
+          ListenerSocketParam_X.BaseChannelParam_X.ListenBackLog_U32 = SOMAXCONN;
+        }
+        _rpuListener.reset(new BofSocket(static_cast<BOFSOCKET>(Fd_i), ListenerSocketParam_X));
+        Rts_E = _rpuListener->LastErrorCode();
+        if (Rts_E != BOF_ERR_NO_ERROR)
+        {
+          _rpuListener.reset(nullptr);
+        }
+      }
+    }
+#else
+    (void)_rAddress_S;
+    (void)_ReusePort_B;
+    (void)_rListenerSocketParam_X;
+    _rpuListener.reset(nullptr);
+#endif
+    return Rts_E;
+  }
+
+private:
+  //Called from the reactor 0 thread for each connection accepted in round robin mode. The session is opened once, with
+  //the first reactor which has room: if its AddSession still fails with BOF_ERR_FULL (the count was read without lock),
+  //the same session is offered to the next reactors. _rpuSocket is left untouched if no reactor has room.
+  BOFERR HandOff(std::unique_ptr<BofSocket> &_rpuSocket)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    uint32_t i_U32, Index_U32, NbReactor_U32 = NbReactor();
+
+    for (i_U32 = 0; (i_U32 < NbReactor_U32) && (Rts_E == BOF_ERR_FULL); i_U32++)
+    {
+      Index_U32 = mNextReactor.fetch_add(1) % NbReactor_U32;
+      if (mReactorCollection[Index_U32]->NbSession() < mSocketMultiReactorParam_X.ReactorParam_X.SocketServerParam_X.NbMaxSession_U32)
+      {
+        if (!psSocketSession)
+        {
+          psSocketSession = mpIBofSocketSessionFactory->V_OpenSession(BOF_SOCKET_SESSION_TYPE::POLL_CHANNEL, mNextSessionIndex.fetch_add(1), std::move(_rpuSocket));
+          if (!psSocketSession)
+          {
+            Rts_E = BOF_ERR_CANNOT_START;
+          }
+        }
+        if (psSocketSession)
+        {
+          Rts_E = mReactorCollection[Index_U32]->AddSession(psSocketSession, BOF_POLL_IN | BOF_POLL_RDHUP, mSocketMultiReactorParam_X.Dispatch_E, BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT);
+        }
+      }
+    }
+    if (Rts_E != BOF_ERR_NO_ERROR)
+    {
+      if (psSocketSession)
+      {
+        mpIBofSocketSessionFactory->V_CloseSession(psSocketSession);
+      }
+      mNbHandOffRejected++;
+    }
+    return Rts_E;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,912 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the token bucket used to pace and rate limit socket
+ * sends and the socket pacer built on it.
+ *
+ * Name:        bofsocketpacer.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         The kernel modes need the matching queueing discipline on the
+ *              egress interface (tc qdisc ... fq for SO_MAX_PACING_RATE, etf
+ *              or fq for SO_TXTIME): the kernel accepts the socket options
+ *              whatever the qdisc, so the pacer reads the egress qdisc with
+ *              rtnetlink and falls back to the user space mode, which works
+ *              everywhere, loopback included, when it is not there.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocket.h>
+#include <bofstd/bofstatistics.h>
+#include <bofstd/bofstringformatter.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <ifaddrs.h>
+#include <linux/errqueue.h>
+#include <linux/netlink.h>
+#include <linux/pkt_sched.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if defined(__linux__)
+#ifndef SO_MAX_PACING_RATE
+#define SO_MAX_PACING_RATE 47
+#endif
+#ifndef SO_TXTIME
+#define SO_TXTIME 61
+#define SCM_TXTIME SO_TXTIME
+#endif
+#ifndef SO_BINDTOIFINDEX
+#define SO_BINDTOIFINDEX 62
+#endif
+#ifndef SO_EE_ORIGIN_TXTIME
+#define SO_EE_ORIGIN_TXTIME 6
+#define SO_EE_CODE_TXTIME_INVALID_PARAM 1
+#define SO_EE_CODE_TXTIME_MISSED 2
+#endif
+#define BOF_SOCKET_PACER_TXTIME_REPORT_ERRORS (1 << 1)   //SOF_TXTIME_REPORT_ERRORS (an enum in linux/net_tstamp.h)
+#endif
+
+#define BOF_SOCKET_PACER_NS_PER_S 1000000000ULL
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_PACING_MODE : uint32_t
+{
+  BOF_SOCKET_PACING_MODE_USER_SPACE = 0,  //Each send waits for its departure time (sleep then spin)
+  BOF_SOCKET_PACING_MODE_KERNEL_FQ,       //SO_MAX_PACING_RATE: the fq qdisc spaces the packets of the socket
+  BOF_SOCKET_PACING_MODE_KERNEL_TXTIME,   //SO_TXTIME: each packet carries its departure time, the etf (or fq) qdisc holds it until then
+  BOF_SOCKET_PACING_MODE_MAX
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_PACER_PARAM
+{
+  BOF_SOCKET_PACING_MODE Mode_E;
+  uint64_t               RateInBytePerS_U64;     /*! Long term rate, 0 disables pacing */
+  uint32_t               BurstInByte_U32;        /*! Bytes which can leave back to back after an idle period (at least one packet) */
+  uint32_t               SpinThresholdInUs_U32;  /*! User space mode: the last part of a wait is a busy loop on the clock */
+  int                    TxTimeClockId_i;        /*! Kernel txtime mode: clock of the departure times (etf needs CLOCK_TAI, fq takes CLOCK_MONOTONIC) */
+  std::string            EgressInterface_S;      /*! Kernel modes: interface whose qdisc is checked, "" to take the one of the socket local address */
+
+  BOF_SOCKET_PACER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Mode_E = BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE;
+    RateInBytePerS_U64 = 0;
+    BurstInByte_U32 = 1500;
+    SpinThresholdInUs_U32 = 50;
+#if defined(__linux__)
+    TxTimeClockId_i = CLOCK_TAI;
+#else
+    TxTimeClockId_i = 0;
+#endif
+    EgressInterface_S = "";
+  }
+};
+
+struct BOF_SOCKET_PACER_STATISTIC
+{
+  uint64_t                    NbPacket_U64;
+  uint64_t                    NbByte_U64;
+  uint64_t                    NbDelayed_U64;             /*! Sends which had to wait for tokens */
+  uint64_t                    NbTimeout_U64;             /*! Sends refused because their departure time was beyond the timeout */
+  uint64_t                    NbWouldBlock_U64;
+  uint64_t                    NbTxTimeMissed_U64;        /*! Kernel txtime mode: packets dropped by the qdisc as their departure time had passed */
+  uint64_t                    NbTxTimeInvalid_U64;       /*! Kernel txtime mode: packets dropped by the qdisc for a bad departure time or clock */
+  uint64_t                    TotalDelayInNs_U64;        /*! Sum of the waits imposed by the bucket */
+  uint64_t                    FirstDepartureInNs_U64;
+  uint64_t                    LastDepartureInNs_U64;
+  BOF_STAT_VARIABLE<uint64_t> InterDepartureInNs_X;      /*! Time between two consecutive sends */
+  BOF_STAT_VARIABLE<uint64_t> LatenessInNs_X;            /*! User space mode: achieved send time - scheduled departure time (jitter) */
+
+  BOF_SOCKET_PACER_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbPacket_U64 = 0;
+    NbByte_U64 = 0;
+    NbDelayed_U64 = 0;
+    NbTimeout_U64 = 0;
+    NbWouldBlock_U64 = 0;
+    NbTxTimeMissed_U64 = 0;
+    NbTxTimeInvalid_U64 = 0;
+    TotalDelayInNs_U64 = 0;
+    FirstDepartureInNs_U64 = 0;
+    LastDepartureInNs_U64 = 0;
+    InterDepartureInNs_X.Reset();
+    LatenessInNs_X.Reset();
+  }
+
+  //Achieved rate between the first and the last send
+  uint64_t AchievedRateInBytePerS() const
+  {
+    uint64_t Duration_U64 = LastDepartureInNs_U64 - FirstDepartureInNs_U64;
+
+    return ((NbPacket_U64 > 1) && (Duration_U64)) ? static_cast<uint64_t>((static_cast<double>(NbByte_U64) * BOF_SOCKET_PACER_NS_PER_S) / Duration_U64) : 0;
+  }
+};
+
+/*** Function **************************************************************/
+
+inline uint64_t Bof_SocketPacerNowInNs(int _ClockId_i)
+{
+  uint64_t Rts_U64 = 0;
+#if defined(__linux__)
+  struct timespec Now_X;
+
+  if (clock_gettime(_ClockId_i, &Now_X) == 0)
+  {
+    Rts_U64 = (static_cast<uint64_t>(Now_X.tv_sec) * BOF_SOCKET_PACER_NS_PER_S) + static_cast<uint64_t>(Now_X.tv_nsec);
+  }
+#else
+  (void)_ClockId_i;
+#endif
+  return Rts_U64;
+}
+
+/*!
+ * Description
+ * Waits until a CLOCK_MONOTONIC time: sleeps up to _SpinThresholdInNs_U64 before it and then spins on the clock,
+ * as the sleep wake up latency is far larger than the inter packet time of a high rate stream.
+ *
+ * Parameters
+ * _DeadlineInNs_U64: Specifies the CLOCK_MONOTONIC time to reach
+ * _SpinThresholdInNs_U64: Specifies the busy wait part
+ *
+ * Returns
+ * uint64_t: The time at which the wait ended
+ */
+inline uint64_t Bof_SocketPacerWaitUntil(uint64_t _DeadlineInNs_U64, uint64_t _SpinThresholdInNs_U64)
+{
+  uint64_t Rts_U64 = 0;
+#if defined(__linux__)
+  struct timespec Deadline_X;
+
+  Rts_U64 = Bof_SocketPacerNowInNs(CLOCK_MONOTONIC);
+  if ((Rts_U64 + _SpinThresholdInNs_U64) < _DeadlineInNs_U64)
+  {
+    Deadline_X.tv_sec = static_cast<time_t>((_DeadlineInNs_U64 - _SpinThresholdInNs_U64) / BOF_SOCKET_PACER_NS_PER_S);
+    Deadline_X.tv_nsec = static_cast<long>((_DeadlineInNs_U64 - _SpinThresholdInNs_U64) % BOF_SOCKET_PACER_NS_PER_S);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Deadline_X, nullptr) == EINTR)
+    {
+    }
+    Rts_U64 = Bof_SocketPacerNowInNs(CLOCK_MONOTONIC);
+  }
+  while (Rts_U64 < _DeadlineInNs_U64)
+  {
+    Rts_U64 = Bof_SocketPacerNowInNs(CLOCK_MONOTONIC);
+  }
+#else
+  (void)_DeadlineInNs_U64;
+  (void)_SpinThresholdInNs_U64;
+#endif
+  return Rts_U64;
+}
+
+/*!
+ * Description
+ * Returns the interface a socket sends on: the one it is bound to (SO_BINDTODEVICE) or the one owning its local
+ * address (bound or chosen by connect). An unconnected socket bound to the wildcard address has no fixed egress
+ * interface.
+ *
+ * Parameters
+ * _Socket: Specifies the socket
+ *
+ * Returns
+ * uint32_t: The interface index, 0 if it cannot be known
+ */
+inline uint32_t Bof_SocketPacerEgressInterface(BOFSOCKET _Socket)
+{
+  uint32_t Rts_U32 = 0;
+#if defined(__linux__)
+  int IfIndex_i = 0;
+  socklen_t Len = sizeof(IfIndex_i);
+  struct sockaddr_storage Local_X;
+  struct ifaddrs *pIfAddrList_X, *pIfAddr_X;
+  const struct sockaddr_in *pIpV4_X, *pLocalIpV4_X;
+  const struct sockaddr_in6 *pIpV6_X, *pLocalIpV6_X;
+
+  if ((getsockopt(_Socket, SOL_SOCKET, SO_BINDTOIFINDEX, &IfIndex_i, &Len) == 0) && (IfIndex_i > 0))
+  {
+    Rts_U32 = static_cast<uint32_t>(IfIndex_i);
+  }
+  else
+  {
+    Len = sizeof(Local_X);
+    if ((getsockname(_Socket, reinterpret_cast<struct sockaddr *>(&Local_X), &Len) == 0) && (getifaddrs(&pIfAddrList_X) == 0))
+    {
+      pLocalIpV4_X = reinterpret_cast<const struct sockaddr_in *>(&Local_X);
+      pLocalIpV6_X = reinterpret_cast<const struct sockaddr_in6 *>(&Local_X);
+      for (pIfAddr_X = pIfAddrList_X; (pIfAddr_X) && (Rts_U32 == 0); pIfAddr_X = pIfAddr_X->ifa_next)
+      {
+        if ((pIfAddr_X->ifa_addr) && (pIfAddr_X->ifa_addr->sa_family == Local_X.ss_family))
+        {
+          if (Local_X.ss_family == AF_INET)
+          {
+            pIpV4_X = reinterpret_cast<const struct sockaddr_in *>(pIfAddr_X->ifa_addr);
+            if ((pLocalIpV4_X->sin_addr.s_addr != htonl(INADDR_ANY)) && (pIpV4_X->sin_addr.s_addr == pLocalIpV4_X->sin_addr.s_addr))
+            {
+              Rts_U32 = if_nametoindex(pIfAddr_X->ifa_name);
+            }
+          }
+          else if (Local_X.ss_family == AF_INET6)
+          {
+            pIpV6_X = reinterpret_cast<const struct sockaddr_in6 *>(pIfAddr_X->ifa_addr);
+            if ((!IN6_IS_ADDR_UNSPECIFIED(&pLocalIpV6_X->sin6_addr)) && (IN6_ARE_ADDR_EQUAL(&pIpV6_X->sin6_addr, &pLocalIpV6_X->sin6_addr)))
+            {
+              Rts_U32 = if_nametoindex(pIfAddr_X->ifa_name);
+            }
+          }
+        }
+      }
+      freeifaddrs(pIfAddrList_X);
+    }
+  }
+#else
+  (void)_Socket;
+#endif
+  return Rts_U32;
+}
+
+/*!
+ * Description
+ * Tells if a queueing discipline of a given kind shapes the egress of an interface. The qdisc list is dumped with
+ * rtnetlink (RTM_GETQDISC, like "tc qdisc show"). The kind matches if it is the one of the root qdisc or, for a multi
+ * queue root (mq, mqprio, taprio), the one of at least one of its children (etf is usually installed on the queue
+ * selected by the socket priority).
+ *
+ * Parameters
+ * _IfIndex_U32: Specifies the interface index
+ * _pKind_c: Specifies the qdisc kind ("fq", "etf"...)
+ * _rRootKind_S: Returns the kind of the root qdisc ("noqueue" if the interface has none)
+ * _rFound_B: Returns true if the kind shapes the interface
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the qdisc list could be read
+ */
+inline BOFERR Bof_SocketPacerFindQdisc(uint32_t _IfIndex_U32, const char *_pKind_c, std::string &_rRootKind_S, bool &_rFound_B)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if defined(__linux__)
+  struct
+  {
+    struct nlmsghdr Header_X;
+    struct tcmsg    Tc_X;
+  } Request_X;
+  std::vector<uint8_t> Buffer;
+  std::vector<std::pair<uint32_t, std::string>> ChildCollection;  //Parent handle, kind
+  uint32_t RootHandle_U32 = 0;
+  int Fd_i, Len_i, AttrLen_i;
+  bool Done_B;
+  const struct nlmsghdr *pHeader_X;
+  const struct tcmsg *pTc_X;
+  struct rtattr *pAttr_X;
+  std::string Kind_S;
+
+  _rRootKind_S = "noqueue";
+  _rFound_B = false;
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_IfIndex_U32) && (_pKind_c))
+  {
+    Rts_E = BOF_ERR_ENOENT;
+    Fd_i = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (Fd_i >= 0)
+    {
+      memset(&Request_X, 0, sizeof(Request_X));
+      Request_X.Header_X.nlmsg_len = NLMSG_LENGTH(sizeof(struct tcmsg));
+      Request_X.Header_X.nlmsg_type = RTM_GETQDISC;
+      Request_X.Header_X.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+      Request_X.Tc_X.tcm_family = AF_UNSPEC;
+      Request_X.Tc_X.tcm_ifindex = static_cast<int>(_IfIndex_U32);
+      if (send(Fd_i, &Request_X, Request_X.Header_X.nlmsg_len, 0) == static_cast<ssize_t>(Request_X.Header_X.nlmsg_len))
+      {
+        Buffer.resize(32768);
+        Done_B = false;
+        while (!Done_B)
+        {
+          Len_i = static_cast<int>(recv(Fd_i, Buffer.data(), Buffer.size(), 0));
+          if ((Len_i < 0) && (errno != EINTR))
+          {
+            Done_B = true;
+          }
+          for (pHeader_X = reinterpret_cast<const struct nlmsghdr *>(Buffer.data()); (!Done_B) && (Len_i > 0) && (NLMSG_OK(pHeader_X, Len_i)); pHeader_X = NLMSG_NEXT(pHeader_X, Len_i))
+          {
+            if (pHeader_X->nlmsg_type == NLMSG_DONE)
+            {
+              Rts_E = BOF_ERR_NO_ERROR;
+              Done_B = true;
+            }
+            else if (pHeader_X->nlmsg_type == NLMSG_ERROR)
+            {
+              Done_B = true;
+            }
+            else if (pHeader_X->nlmsg_type == RTM_NEWQDISC)
+            {
+              pTc_X = reinterpret_cast<const struct tcmsg *>(NLMSG_DATA(pHeader_X));
+              if (pTc_X->tcm_ifindex == static_cast<int>(_IfIndex_U32))
+              {
+                Kind_S = "";
+                AttrLen_i = static_cast<int>(TCA_PAYLOAD(pHeader_X));
+                for (pAttr_X = TCA_RTA(pTc_X); RTA_OK(pAttr_X, AttrLen_i); pAttr_X = RTA_NEXT(pAttr_X, AttrLen_i))
+                {
+                  if (pAttr_X->rta_type == TCA_KIND)
+                  {
+                    Kind_S = reinterpret_cast<const char *>(RTA_DATA(pAttr_X));
+                  }
+                }
+                if (pTc_X->tcm_parent == TC_H_ROOT)
+                {
+                  _rRootKind_S = Kind_S;
+                  RootHandle_U32 = pTc_X->tcm_handle;
+                }
+                else
+                {
+                  ChildCollection.push_back(std::make_pair(pTc_X->tcm_parent, Kind_S));
+                }
+              }
+            }
+          }
+        }
+      }
+      close(Fd_i);
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      _rFound_B = (_rRootKind_S == _pKind_c);
+      if ((!_rFound_B) && ((_rRootKind_S == "mq") || (_rRootKind_S == "mqprio") || (_rRootKind_S == "taprio")))
+      {
+        for (const auto &rChild : ChildCollection)
+        {
+          if ((TC_H_MAJ(rChild.first) == TC_H_MAJ(RootHandle_U32)) && (rChild.second == _pKind_c))
+          {
+            _rFound_B = true;
+          }
+        }
+      }
+    }
+  }
+#else
+  (void)_IfIndex_U32;
+  (void)_pKind_c;
+  _rRootKind_S = "";
+  _rFound_B = false;
+#endif
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Token bucket
+ *
+ * Description
+ * Token bucket written in its virtual scheduling form (GCRA): instead of a token count it keeps the theoretical
+ * time at which all the bytes already sent will have been paid for. A packet can leave as soon as this time plus
+ * its own cost is no more than the burst tolerance (BurstInByte_U32 / rate) ahead, which is exactly a bucket of
+ * BurstInByte_U32 tokens refilled at the rate. Integer nanosecond arithmetic only. Not thread safe.
+ *
+ * See Also
+ * BofSocketPacer
+ */
+class BofTokenBucket
+{
+private:
+  uint64_t mRateInBytePerS_U64 = 0;
+  uint64_t mToleranceInNs_U64 = 0;
+  uint64_t mTheoreticalTimeInNs_U64 = 0;
+
+public:
+  BofTokenBucket()
+  {
+  }
+  BofTokenBucket(uint64_t _RateInBytePerS_U64, uint32_t _BurstInByte_U32)
+  {
+    SetRate(_RateInBytePerS_U64, _BurstInByte_U32);
+  }
+
+  //A zero rate lets everything leave at once
+  void SetRate(uint64_t _RateInBytePerS_U64, uint32_t _BurstInByte_U32)
+  {
+    mRateInBytePerS_U64 = _RateInBytePerS_U64;
+    mToleranceInNs_U64 = _RateInBytePerS_U64 ? CostInNs(_BurstInByte_U32) : 0;
+  }
+  uint64_t RateInBytePerS() const
+  {
+    return mRateInBytePerS_U64;
+  }
+  uint32_t BurstInByte() const
+  {
+    return mRateInBytePerS_U64 ? static_cast<uint32_t>((mToleranceInNs_U64 * mRateInBytePerS_U64) / BOF_SOCKET_PACER_NS_PER_S) : 0;
+  }
+
+  //Time needed to send _Nb_U32 bytes at the rate
+  uint64_t CostInNs(uint32_t _Nb_U32) const
+  {
+    return mRateInBytePerS_U64 ? ((static_cast<uint64_t>(_Nb_U32) * BOF_SOCKET_PACER_NS_PER_S) + mRateInBytePerS_U64 - 1) / mRateInBytePerS_U64 : 0;
+  }
+
+  /*!
+   * Description
+   * Returns the earliest time a packet can leave. The bucket is not changed: call Commit once it is sent.
+   *
+   * Parameters
+   * _Nb_U32: Specifies the packet size
+   * _NowInNs_U64: Specifies the current time
+   *
+   * Returns
+   * uint64_t: Departure time, _NowInNs_U64 if the packet can leave now
+   */
+  uint64_t DepartureTime(uint32_t _Nb_U32, uint64_t _NowInNs_U64) const
+  {
+    uint64_t Rts_U64 = _NowInNs_U64;
+    uint64_t Cost_U64, Tolerance_U64, Theoretical_U64;
+
+    if (mRateInBytePerS_U64)
+    {
+      Cost_U64 = CostInNs(_Nb_U32);
+      //A packet larger than the burst can always leave once the bucket is full
+      Tolerance_U64 = (Cost_U64 > mToleranceInNs_U64) ? Cost_U64 : mToleranceInNs_U64;
+      Theoretical_U64 = ((mTheoreticalTimeInNs_U64 > _NowInNs_U64) ? mTheoreticalTimeInNs_U64 : _NowInNs_U64) + Cost_U64;
+      if (Theoretical_U64 > (_NowInNs_U64 + Tolerance_U64))
+      {
+        Rts_U64 = Theoretical_U64 - Tolerance_U64;
+      }
+    }
+    return Rts_U64;
+  }
+
+  //Takes the tokens of a packet which leaves at _DepartureInNs_U64 (value returned by DepartureTime)
+  void Commit(uint32_t _Nb_U32, uint64_t _DepartureInNs_U64)
+  {
+    mTheoreticalTimeInNs_U64 = ((mTheoreticalTimeInNs_U64 > _DepartureInNs_U64) ? mTheoreticalTimeInNs_U64 : _DepartureInNs_U64) + CostInNs(_Nb_U32);
+  }
+
+  void Reset()
+  {
+    mTheoreticalTimeInNs_U64 = 0;
+  }
+};
+
+/*!
+ * Summary
+ * Socket send pacer
+ *
+ * Description
+ * Paces and rate limits the sends made on one socket (typically a constant bit rate udp stream) so that an
+ * application burst leaves as evenly spaced packets instead of overflowing the switch buffers:
+ * - BOF_SOCKET_PACING_MODE_USER_SPACE: Write waits for the departure time given by the token bucket, sleeping and
+ *   then spinning on CLOCK_MONOTONIC. The achieved lateness is measured (jitter statistic).
+ * - BOF_SOCKET_PACING_MODE_KERNEL_FQ: the rate is given to the kernel with SO_MAX_PACING_RATE and Write sends at
+ *   once; the fq qdisc spaces the packets. The burst is the one of fq (quantum).
+ * - BOF_SOCKET_PACING_MODE_KERNEL_TXTIME: Write computes the departure time with the token bucket and sends at once
+ *   with a SCM_TXTIME control message; the etf (or fq) qdisc releases the packet at that time. The qdisc reports the
+ *   packets it drops (deadline missed, bad clock) on the socket error queue: Write drains it and counts them in
+ *   NbTxTimeMissed_U64/NbTxTimeInvalid_U64, so do not read tx time stamps (BofSocketTimeStamp) on the same socket.
+ * The kernel accepts SO_MAX_PACING_RATE and SO_TXTIME whatever the qdisc, so Open checks the qdisc of the egress
+ * interface (EgressInterface_S or the one of the socket local address) and falls back to the user space mode if the
+ * interface is unknown (unconnected socket bound to the wildcard address), if the qdisc is not there (pfifo_fast,
+ * fq_codel, noqueue...) or if the socket refuses the option: check Mode(). A tcp socket paces itself without fq.
+ * Write is not thread safe: one pacer per sending thread and socket.
+ *
+ * See Also
+ * BofTokenBucket
+ */
+class BofSocketPacer
+{
+private:
+  BOF_SOCKET_PACER_PARAM     mSocketPacerParam_X;
+  BOFERR                     mErrorCode_E = BOF_ERR_INIT;
+  BOFSOCKET                  mSocket = BOFSOCKET_INVALID;
+  BOF_SOCKET_PACING_MODE     mMode_E = BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE;
+  BofTokenBucket             mTokenBucket;
+  BOF_SOCKET_PACER_STATISTIC mSocketPacerStatistic_X;
+  std::string                mEgressQdisc_S;
+
+public:
+  BofSocketPacer(BOFSOCKET _Socket, const BOF_SOCKET_PACER_PARAM &_rSocketPacerParam_X)
+  {
+    Open(_Socket, _rSocketPacerParam_X);
+  }
+  BofSocketPacer(BofSocket &_rSocket, const BOF_SOCKET_PACER_PARAM &_rSocketPacerParam_X)
+  {
+    Open(_rSocket.GetSocketHandle(), _rSocketPacerParam_X);
+  }
+  virtual ~BofSocketPacer()
+  {
+  }
+  BofSocketPacer &operator=(const BofSocketPacer &) = delete; // Disallow copying
+  BofSocketPacer(const BofSocketPacer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+  //Mode really used, after a possible fall back
+  BOF_SOCKET_PACING_MODE Mode() const
+  {
+    return mMode_E;
+  }
+  //Kind of the root qdisc of the egress interface ("" if it was not checked)
+  const std::string &EgressQdisc() const
+  {
+    return mEgressQdisc_S;
+  }
+  uint64_t RateInBytePerS() const
+  {
+    return mTokenBucket.RateInBytePerS();
+  }
+  uint32_t BurstInByte() const
+  {
+    return mTokenBucket.BurstInByte();
+  }
+
+  /*!
+   * Description
+   * Changes the rate and the burst. Can be called between two Write.
+   *
+   * Parameters
+   * _RateInBytePerS_U64: Specifies the rate, 0 to stop pacing
+   * _BurstInByte_U32: Specifies the burst size
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR SetRate(uint64_t _RateInBytePerS_U64, uint32_t _BurstInByte_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+#if defined(__linux__)
+    uint64_t Rate_U64;
+#endif
+
+    mSocketPacerParam_X.RateInBytePerS_U64 = _RateInBytePerS_U64;
+    mSocketPacerParam_X.BurstInByte_U32 = _BurstInByte_U32;
+    mTokenBucket.SetRate(_RateInBytePerS_U64, _BurstInByte_U32);
+#if defined(__linux__)
+    if (mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_FQ)
+    {
+      Rate_U64 = _RateInBytePerS_U64 ? _RateInBytePerS_U64 : ~0ULL;  //~0 is "unlimited" for the kernel
+      if (setsockopt(mSocket, SOL_SOCKET, SO_MAX_PACING_RATE, &Rate_U64, sizeof(Rate_U64)) != 0)
+      {
+        Rts_E = static_cast<BOFERR>(errno);
+      }
+    }
+#endif
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Sends one packet at its paced departure time.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies the maximum time to wait for the departure time and for room in the socket buffer.
+   * A packet whose departure time is further than this is not sent and does not take any token.
+   * _Nb_U32: Specifies the packet size
+   * _pBuffer_U8: Specifies the packet
+   * _pPeer_X: Specifies the destination of an unconnected udp socket, nullptr for a connected one
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the packet has been sent, BOF_ERR_ETIMEDOUT if it could not leave in time
+   */
+  BOFERR Write(uint32_t _TimeoutInMs_U32, uint32_t _Nb_U32, const uint8_t *_pBuffer_U8, const BOF_SOCKET_ADDRESS *_pPeer_X)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+#if defined(__linux__)
+    uint64_t Now_U64, Departure_U64, Sent_U64;
+    struct sockaddr_storage Peer_X;
+    socklen_t PeerLen = 0;
+    struct msghdr Msg_X;
+    struct iovec Iov_X;
+    struct cmsghdr *pCmsg_X;
+    uint64_t TxTime_U64;
+    uint8_t pControl_U8[CMSG_SPACE(sizeof(uint64_t))];
+    ssize_t Sts;
+    int Sts_i;
+    struct pollfd Fd_X;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_pBuffer_U8) || (_Nb_U32 == 0))
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        if (_pPeer_X)
+        {
+          PeerLen = ToSockAddr(*_pPeer_X, Peer_X);
+          Rts_E = PeerLen ? BOF_ERR_NO_ERROR : BOF_ERR_EINVAL;
+        }
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Now_U64 = Bof_SocketPacerNowInNs(CLOCK_MONOTONIC);
+      Departure_U64 = (mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_FQ) ? Now_U64 : mTokenBucket.DepartureTime(_Nb_U32, Now_U64);
+      if ((Departure_U64 - Now_U64) > (static_cast<uint64_t>(_TimeoutInMs_U32) * 1000000ULL))
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+        mSocketPacerStatistic_X.NbTimeout_U64++;
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      memset(&Msg_X, 0, sizeof(Msg_X));
+      Iov_X.iov_base = const_cast<uint8_t *>(_pBuffer_U8);
+      Iov_X.iov_len = _Nb_U32;
+      Msg_X.msg_iov = &Iov_X;
+      Msg_X.msg_iovlen = 1;
+      Msg_X.msg_name = PeerLen ? &Peer_X : nullptr;
+      Msg_X.msg_namelen = PeerLen;
+      if (mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_TXTIME)
+      {
+        ReadTxTimeError();
+        //Departure time converted from CLOCK_MONOTONIC to the txtime clock
+        TxTime_U64 = Departure_U64 - Now_U64 + Bof_SocketPacerNowInNs(mSocketPacerParam_X.TxTimeClockId_i);
+        memset(pControl_U8, 0, sizeof(pControl_U8));
+        Msg_X.msg_control = pControl_U8;
+        Msg_X.msg_controllen = sizeof(pControl_U8);
+        pCmsg_X = CMSG_FIRSTHDR(&Msg_X);
+        pCmsg_X->cmsg_level = SOL_SOCKET;
+        pCmsg_X->cmsg_type = SCM_TXTIME;
+        pCmsg_X->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        memcpy(CMSG_DATA(pCmsg_X), &TxTime_U64, sizeof(uint64_t));
+      }
+      else if ((mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE) && (Departure_U64 > Now_U64))
+      {
+        mSocketPacerStatistic_X.NbDelayed_U64++;
+        mSocketPacerStatistic_X.TotalDelayInNs_U64 += (Departure_U64 - Now_U64);
+        Bof_SocketPacerWaitUntil(Departure_U64, static_cast<uint64_t>(mSocketPacerParam_X.SpinThresholdInUs_U32) * 1000ULL);
+      }
+      Sent_U64 = Bof_SocketPacerNowInNs(CLOCK_MONOTONIC);
+      do
+      {
+        Sts = sendmsg(mSocket, &Msg_X, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if ((Sts < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+          //Socket buffer full: the rest of the timeout is spent waiting for room
+          mSocketPacerStatistic_X.NbWouldBlock_U64++;
+          Fd_X.fd = mSocket;
+          Fd_X.events = POLLOUT;
+          Fd_X.revents = 0;
+          Sts_i = poll(&Fd_X, 1, static_cast<int>(RemainingInMs(Now_U64, _TimeoutInMs_U32)));
+          if (Sts_i == 0)
+          {
+            errno = ETIMEDOUT;
+          }
+          else if (Sts_i > 0)
+          {
+            errno = EINTR;
+          }
+        }
+      } while ((Sts < 0) && (errno == EINTR));
+      if (Sts < 0)
+      {
+        Rts_E = (errno == ETIMEDOUT) ? BOF_ERR_ETIMEDOUT : static_cast<BOFERR>(errno);
+      }
+      else
+      {
+        mTokenBucket.Commit(static_cast<uint32_t>(Sts), Departure_U64);
+        UpdateStatistic(static_cast<uint32_t>(Sts), Departure_U64, Sent_U64);
+        Rts_E = (static_cast<uint32_t>(Sts) == _Nb_U32) ? BOF_ERR_NO_ERROR : BOF_ERR_WRITE;
+      }
+    }
+#else
+    (void)_TimeoutInMs_U32;
+    (void)_Nb_U32;
+    (void)_pBuffer_U8;
+    (void)_pPeer_X;
+#endif
+    return Rts_E;
+  }
+
+  BOF_SOCKET_PACER_STATISTIC SocketPacerStatistic() const
+  {
+    return mSocketPacerStatistic_X;
+  }
+  void ResetSocketPacerStatistic()
+  {
+    mSocketPacerStatistic_X.Reset();
+  }
+  std::string SocketPacerDebugInfo() const
+  {
+    static const char *S_pModeName_c[] = { "user", "fq", "txtime" };
+
+    return Bof_Sprintf("Pacer %s qdisc '%s' TxTimeDrop %lld/%lld rate %lld B/s (achieved %lld) burst %u B Pkt %lld Byte %lld Delayed %lld Timeout %lld WouldBlock %lld InterDep %lld/%lld/%lld ns Late %lld/%lld/%lld ns",
+                       (mMode_E < BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_MAX) ? S_pModeName_c[static_cast<uint32_t>(mMode_E)] : "?", mEgressQdisc_S.c_str(),
+                       mSocketPacerStatistic_X.NbTxTimeMissed_U64, mSocketPacerStatistic_X.NbTxTimeInvalid_U64, mTokenBucket.RateInBytePerS(),
+                       mSocketPacerStatistic_X.AchievedRateInBytePerS(), mTokenBucket.BurstInByte(), mSocketPacerStatistic_X.NbPacket_U64, mSocketPacerStatistic_X.NbByte_U64,
+                       mSocketPacerStatistic_X.NbDelayed_U64, mSocketPacerStatistic_X.NbTimeout_U64, mSocketPacerStatistic_X.NbWouldBlock_U64, mSocketPacerStatistic_X.InterDepartureInNs_X.Min,
+                       mSocketPacerStatistic_X.InterDepartureInNs_X.Mean, mSocketPacerStatistic_X.InterDepartureInNs_X.Max, mSocketPacerStatistic_X.LatenessInNs_X.Min,
+                       mSocketPacerStatistic_X.LatenessInNs_X.Mean, mSocketPacerStatistic_X.LatenessInNs_X.Max);
+  }
+
+private:
+  void Open(BOFSOCKET _Socket, const BOF_SOCKET_PACER_PARAM &_rSocketPacerParam_X)
+  {
+    mSocketPacerParam_X = _rSocketPacerParam_X;
+    mSocket = _Socket;
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mSocket != BOFSOCKET_INVALID) && (mSocketPacerParam_X.Mode_E < BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_MAX))
+    {
+#if defined(__linux__)
+      struct
+      {
+        clockid_t ClockId;
+        uint32_t  Flag_U32;
+      } TxTime_X;
+
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      mMode_E = mSocketPacerParam_X.Mode_E;
+      if ((mMode_E != BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE) && (!IsKernelPacingPossible(mMode_E)))
+      {
+        mMode_E = BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE;
+      }
+      if (mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_TXTIME)
+      {
+        TxTime_X.ClockId = mSocketPacerParam_X.TxTimeClockId_i;   //struct sock_txtime
+        TxTime_X.Flag_U32 = BOF_SOCKET_PACER_TXTIME_REPORT_ERRORS;
+        if (setsockopt(mSocket, SOL_SOCKET, SO_TXTIME, &TxTime_X, sizeof(TxTime_X)) != 0)
+        {
+          mMode_E = BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE;
+        }
+      }
+      if (SetRate(mSocketPacerParam_X.RateInBytePerS_U64, mSocketPacerParam_X.BurstInByte_U32) != BOF_ERR_NO_ERROR)
+      {
+        mMode_E = BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE;
+      }
+#else
+      mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#endif
+    }
+  }
+
+#if defined(__linux__)
+  //fq (or tcp internal pacing) for SO_MAX_PACING_RATE, etf (or fq) for SO_TXTIME, on the egress interface
+  bool IsKernelPacingPossible(BOF_SOCKET_PACING_MODE _Mode_E)
+  {
+    bool Rts_B = false;
+    int Type_i = 0;
+    socklen_t Len = sizeof(Type_i);
+    uint32_t IfIndex_U32;
+
+    if ((_Mode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_FQ) && (getsockopt(mSocket, SOL_SOCKET, SO_TYPE, &Type_i, &Len) == 0) && (Type_i == SOCK_STREAM))
+    {
+      Rts_B = true;
+    }
+    else
+    {
+      IfIndex_U32 = (mSocketPacerParam_X.EgressInterface_S != "") ? if_nametoindex(mSocketPacerParam_X.EgressInterface_S.c_str()) : Bof_SocketPacerEgressInterface(mSocket);
+      if (_Mode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_KERNEL_TXTIME)
+      {
+        if ((Bof_SocketPacerFindQdisc(IfIndex_U32, "etf", mEgressQdisc_S, Rts_B) == BOF_ERR_NO_ERROR) && (!Rts_B))
+        {
+          //fq also honours the departure times but only on CLOCK_MONOTONIC
+          Bof_SocketPacerFindQdisc(IfIndex_U32, "fq", mEgressQdisc_S, Rts_B);
+          if (Rts_B)
+          {
+            mSocketPacerParam_X.TxTimeClockId_i = CLOCK_MONOTONIC;
+          }
+        }
+      }
+      else
+      {
+        Bof_SocketPacerFindQdisc(IfIndex_U32, "fq", mEgressQdisc_S, Rts_B);
+      }
+    }
+    return Rts_B;
+  }
+
+  //Counts the packets dropped by the txtime qdisc (SOF_TXTIME_REPORT_ERRORS)
+  void ReadTxTimeError()
+  {
+    struct msghdr Msg_X;
+    struct cmsghdr *pCmsg_X;
+    const struct sock_extended_err *pErr_X;
+    uint8_t pControl_U8[256];
+    bool Again_B = true;
+
+    while (Again_B)
+    {
+      memset(&Msg_X, 0, sizeof(Msg_X));
+      Msg_X.msg_control = pControl_U8;
+      Msg_X.msg_controllen = sizeof(pControl_U8);
+      Again_B = (recvmsg(mSocket, &Msg_X, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0);
+      for (pCmsg_X = Again_B ? CMSG_FIRSTHDR(&Msg_X) : nullptr; pCmsg_X != nullptr; pCmsg_X = CMSG_NXTHDR(&Msg_X, pCmsg_X))
+      {
+        if (((pCmsg_X->cmsg_level == SOL_IP) && (pCmsg_X->cmsg_type == IP_RECVERR)) || ((pCmsg_X->cmsg_level == SOL_IPV6) && (pCmsg_X->cmsg_type == IPV6_RECVERR)))
+        {
+          pErr_X = reinterpret_cast<const struct sock_extended_err *>(CMSG_DATA(pCmsg_X));
+          if (pErr_X->ee_origin == SO_EE_ORIGIN_TXTIME)
+          {
+            if (pErr_X->ee_code == SO_EE_CODE_TXTIME_MISSED)
+            {
+              mSocketPacerStatistic_X.NbTxTimeMissed_U64++;
+            }
+            else
+            {
+              mSocketPacerStatistic_X.NbTxTimeInvalid_U64++;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  static socklen_t ToSockAddr(const BOF_SOCKET_ADDRESS &_rPeer_X, struct sockaddr_storage &_rSockAddr_X)
+  {
+    socklen_t Rts = 0;
+
+    if ((_rPeer_X.IpV6_B) && (_rPeer_X.IpV6Address_X.sin6_family == AF_INET6))
+    {
+      Rts = sizeof(_rPeer_X.IpV6Address_X);
+      memcpy(&_rSockAddr_X, &_rPeer_X.IpV6Address_X, Rts);
+    }
+    else if ((!_rPeer_X.IpV6_B) && (_rPeer_X.IpV4Address_X.sin_family == AF_INET))
+    {
+      Rts = sizeof(_rPeer_X.IpV4Address_X);
+      memcpy(&_rSockAddr_X, &_rPeer_X.IpV4Address_X, Rts);
+    }
+    return Rts;
+  }
+
+  static uint32_t RemainingInMs(uint64_t _StartInNs_U64, uint32_t _TimeoutInMs_U32)
+  {
+    uint64_t Elapsed_U64 = (Bof_SocketPacerNowInNs(CLOCK_MONOTONIC) - _StartInNs_U64) / 1000000ULL;
+
+    return (Elapsed_U64 < _TimeoutInMs_U32) ? static_cast<uint32_t>(_TimeoutInMs_U32 - Elapsed_U64) : 0;
+  }
+#endif
+
+  void UpdateStatistic(uint32_t _Nb_U32, uint64_t _DepartureInNs_U64, uint64_t _SentInNs_U64)
+  {
+    if (mSocketPacerStatistic_X.NbPacket_U64 == 0)
+    {
+      mSocketPacerStatistic_X.FirstDepartureInNs_U64 = _SentInNs_U64;
+    }
+    else
+    {
+      Bof_UpdateStatVar(mSocketPacerStatistic_X.InterDepartureInNs_X, _SentInNs_U64 - mSocketPacerStatistic_X.LastDepartureInNs_U64);
+    }
+    if (mMode_E == BOF_SOCKET_PACING_MODE::BOF_SOCKET_PACING_MODE_USER_SPACE)
+    {
+      Bof_UpdateStatVar(mSocketPacerStatistic_X.LatenessInNs_X, (_SentInNs_U64 > _DepartureInNs_U64) ? (_SentInNs_U64 - _DepartureInNs_U64) : static_cast<uint64_t>(0));
+    }
+    mSocketPacerStatistic_X.LastDepartureInNs_U64 = _SentInNs_U64;
+    mSocketPacerStatistic_X.NbPacket_U64++;
+    mSocketPacerStatistic_X.NbByte_U64 += _Nb_U32;
+  }
+};
+
+END_BOF_NAMESPACE()
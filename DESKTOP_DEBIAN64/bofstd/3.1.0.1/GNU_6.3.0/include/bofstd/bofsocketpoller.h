@@ -0,0 +1,1415 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the socket readiness poller engines (poll, epoll, io_uring) and
+ * the poll server which dispatches ready sessions to their BofSocketIo.
+ *
+ * Name:        bofsocketpoller.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocketsessionmanager.h>
+#include <bofstd/bofsocketio.h>
+#include <bofstd/bofsocket.h>
+#include <bofstd/ibofsocketsessionfactory.h>
+#include <bofstd/bofiouring.h>
+#include <bofstd/bofsocketcommandqueue.h>
+#include <bofstd/bofsocketsessiontable.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+#if !defined(_WIN32)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#define BOF_SOCKET_POLLER_WAKEUP_COOKIE 0xFFFFFFFFFFFFFFFFULL  /*! Reserved cookie of the internal wake up descriptor */
+#define BOF_SOCKET_POLLER_COMMAND_COOKIE 0xFFFFFFFFFFFFFFFDULL /*! Reserved cookie of the BofSocketPollServer command queue eventfd */
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_POLLER_ENGINE : uint32_t
+{
+  BOF_SOCKET_POLLER_ENGINE_POLL = 0,    //poll(): O(n) per wait, portable behaviour of BofSocketSessionManager
+  BOF_SOCKET_POLLER_ENGINE_EPOLL,       //epoll: O(ready) per wait
+  BOF_SOCKET_POLLER_ENGINE_IO_URING,    //io_uring multishot poll: O(ready) per wait, falls back to epoll if the kernel lacks support
+};
+
+enum class BOF_SOCKET_POLLER_TRIGGER : uint32_t
+{
+  BOF_SOCKET_POLLER_TRIGGER_DEFAULT = 0,  //Use BOF_SOCKET_POLL_SERVER_PARAM::DefaultTrigger_E
+  BOF_SOCKET_POLLER_TRIGGER_LEVEL,        //Signaled as long as the condition holds
+  BOF_SOCKET_POLLER_TRIGGER_EDGE,         //Signaled once per state change: the socket must be drained up to EAGAIN (epoll only)
+};
+
+enum class BOF_SOCKET_POLLER_DISPATCH : uint32_t
+{
+  BOF_SOCKET_POLLER_DISPATCH_SIGNAL_POLL = 0,  //Call V_SignalPoll(REvent, session) as BOF_SOCKET_SERVER_POLLER does
+  BOF_SOCKET_POLLER_DISPATCH_DATA_READ,        //Read the socket and call V_SignalDataRead as BOF_SOCKET_SERVER_SESSION does
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_POLLER_EVENT
+{
+  uint64_t Cookie_U64;
+  uint16_t REvent_U16;  /*! BOF_POLL_xxx flags */
+};
+
+/*! Accepted connection hand off: return BOF_ERR_NO_ERROR after taking _rpuSocket, otherwise the connection is dropped */
+typedef std::function<BOFERR(std::unique_ptr<BofSocket> &_rpuSocket)> BOF_SOCKET_POLL_SERVER_ACCEPT_CALLBACK;
+
+struct BOF_SOCKET_POLL_SERVER_PARAM
+{
+  BOF_SOCKET_SERVER_PARAM   SocketServerParam_X;    /*! Name_S, thread attributes and NbMaxSession_U32 are used */
+  BOF_SOCKET_POLLER_ENGINE  Engine_E;
+  BOF_SOCKET_POLLER_TRIGGER DefaultTrigger_E;
+  uint32_t                  MaxEventPerWait_U32;    /*! Maximum number of ready descriptors returned by one engine wait */
+  uint32_t                  PollTimeoutInMs_U32;    /*! Maximum sleep time of the poll thread: bounds the Stop latency */
+  uint32_t                  NbMaxFd_U32;            /*! Size of the descriptor indexed session table, 0 for the process descriptor limit */
+  BOF_SOCKET_POLL_SERVER_ACCEPT_CALLBACK OnAccept;  /*! If not nullptr, accepted connections are given to it instead of V_OpenSession/AddSession */
+
+  BOF_SOCKET_POLL_SERVER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    SocketServerParam_X.Reset();
+    SocketServerParam_X.ServerMode_E = BOF_SOCKET_SERVER_MODE::BOF_SOCKET_SERVER_POLLER;
+    Engine_E            = BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_EPOLL;
+    DefaultTrigger_E    = BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_LEVEL;
+    MaxEventPerWait_U32 = 256;
+    PollTimeoutInMs_U32 = 250;
+    NbMaxFd_U32         = 0;
+    OnAccept            = nullptr;
+  }
+};
+
+struct BOF_SOCKET_POLL_SERVER_STATISTIC
+{
+  uint64_t NbWait_U64;
+  uint64_t NbEvent_U64;
+  uint64_t NbStaleEvent_U64;     /*! Event received for a descriptor removed or re-used in between */
+  uint64_t NbAdd_U64;
+  uint64_t NbRemove_U64;
+  uint64_t NbAccept_U64;
+  uint64_t NbRejectedAccept_U64; /*! NbMaxSession_U32 reached */
+  uint64_t NbPeerClosed_U64;
+  uint64_t NbDispatchError_U64;
+  uint32_t MaxEventPerWait_U32;
+
+  BOF_SOCKET_POLL_SERVER_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbWait_U64           = 0;
+    NbEvent_U64          = 0;
+    NbStaleEvent_U64     = 0;
+    NbAdd_U64            = 0;
+    NbRemove_U64         = 0;
+    NbAccept_U64         = 0;
+    NbRejectedAccept_U64 = 0;
+    NbPeerClosed_U64     = 0;
+    NbDispatchError_U64  = 0;
+    MaxEventPerWait_U32  = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Socket readiness poller engine interface
+ *
+ * Description
+ * V_Add/V_Modify/V_Remove can be called from any thread while another one is blocked in V_Wait. The cookie is
+ * returned as is with each ready event. V_Wakeup makes a pending V_Wait return without any event.
+ *
+ * See Also
+ * BofSocketPollServer
+ */
+class IBofSocketPollerEngine
+{
+public:
+  virtual ~IBofSocketPollerEngine() {}
+  virtual BOFERR V_Add(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) = 0;
+  virtual BOFERR V_Modify(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) = 0;
+  virtual BOFERR V_Remove(BOFSOCKET _Fd) = 0;
+  virtual BOFERR V_Wait(uint32_t _TimeoutInMs_U32, uint32_t _MaxEvent_U32, std::vector<BOF_SOCKET_POLLER_EVENT> &_rEventCollection) = 0;
+  virtual BOFERR V_Wakeup() = 0;
+  virtual const char *V_Name() const = 0;
+};
+
+#if !defined(_WIN32)
+/*!
+ * Summary
+ * epoll poller engine
+ *
+ * Description
+ * Registrations go straight to epoll_ctl which is thread safe: no control socket round trip with the poll thread.
+ * The BOF_POLL_xxx flags have the same values as the EPOLLxxx ones on Linux but are translated explicitly.
+ */
+class BofEpollEngine : public IBofSocketPollerEngine
+{
+private:
+  int mEpollFd_i = -1;
+  int mWakeupFd_i = -1;
+  std::vector<struct epoll_event> mEpollEventCollection;
+
+public:
+  BofEpollEngine()
+  {
+    struct epoll_event Event_X;
+
+    mEpollFd_i = epoll_create1(EPOLL_CLOEXEC);
+    mWakeupFd_i = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((mEpollFd_i >= 0) && (mWakeupFd_i >= 0))
+    {
+      Event_X.events = EPOLLIN;
+      Event_X.data.u64 = BOF_SOCKET_POLLER_WAKEUP_COOKIE;
+      if (epoll_ctl(mEpollFd_i, EPOLL_CTL_ADD, mWakeupFd_i, &Event_X) < 0)
+      {
+        close(mWakeupFd_i);
+        mWakeupFd_i = -1;
+      }
+    }
+  }
+  virtual ~BofEpollEngine()
+  {
+    if (mWakeupFd_i >= 0)
+    {
+      close(mWakeupFd_i);
+    }
+    if (mEpollFd_i >= 0)
+    {
+      close(mEpollFd_i);
+    }
+  }
+  BofEpollEngine &operator=(const BofEpollEngine &) = delete; // Disallow copying
+  BofEpollEngine(const BofEpollEngine &) = delete;
+
+  bool IsValid() const
+  {
+    return (mEpollFd_i >= 0) && (mWakeupFd_i >= 0);
+  }
+
+  static uint32_t S_ToEpollEvent(uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E)
+  {
+    uint32_t Rts_U32 = 0;
+
+    if (_Event_U16 & BOF_POLL_IN)
+    {
+      Rts_U32 |= EPOLLIN;
+    }
+    if (_Event_U16 & BOF_POLL_OUT)
+    {
+      Rts_U32 |= EPOLLOUT;
+    }
+    if (_Event_U16 & BOF_POLL_RDHUP)
+    {
+      Rts_U32 |= EPOLLRDHUP;
+    }
+    if (_Trigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE)
+    {
+      Rts_U32 |= EPOLLET;
+    }
+    return Rts_U32;
+  }
+
+  static uint16_t S_FromEpollEvent(uint32_t _EpollEvent_U32)
+  {
+    uint16_t Rts_U16 = 0;
+
+    if (_EpollEvent_U32 & EPOLLIN)
+    {
+      Rts_U16 |= BOF_POLL_IN;
+    }
+    if (_EpollEvent_U32 & EPOLLOUT)
+    {
+      Rts_U16 |= BOF_POLL_OUT;
+    }
+    if (_EpollEvent_U32 & EPOLLRDHUP)
+    {
+      Rts_U16 |= BOF_POLL_RDHUP;
+    }
+    if (_EpollEvent_U32 & EPOLLHUP)
+    {
+      Rts_U16 |= BOF_POLL_HUP;
+    }
+    if (_EpollEvent_U32 & EPOLLERR)
+    {
+      Rts_U16 |= BOF_POLL_ERR;
+    }
+    return Rts_U16;
+  }
+
+  BOFERR V_Add(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    return Control(EPOLL_CTL_ADD, _Fd, _Event_U16, _Trigger_E, _Cookie_U64);
+  }
+
+  BOFERR V_Modify(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    return Control(EPOLL_CTL_MOD, _Fd, _Event_U16, _Trigger_E, _Cookie_U64);
+  }
+
+  BOFERR V_Remove(BOFSOCKET _Fd) override
+  {
+    return Control(EPOLL_CTL_DEL, _Fd, 0, BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_LEVEL, 0);
+  }
+
+  BOFERR V_Wait(uint32_t _TimeoutInMs_U32, uint32_t _MaxEvent_U32, std::vector<BOF_SOCKET_POLLER_EVENT> &_rEventCollection) override
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    BOF_SOCKET_POLLER_EVENT Event_X;
+    uint64_t Value_U64;
+    int i, Nb_i;
+
+    _rEventCollection.clear();
+    if ((IsValid()) && (_MaxEvent_U32))
+    {
+      if (mEpollEventCollection.size() < _MaxEvent_U32)
+      {
+        mEpollEventCollection.resize(_MaxEvent_U32);
+      }
+      Rts_E = BOF_ERR_NO_ERROR;
+      Nb_i = epoll_wait(mEpollFd_i, mEpollEventCollection.data(), static_cast<int>(_MaxEvent_U32), static_cast<int>(_TimeoutInMs_U32));
+      if (Nb_i < 0)
+      {
+        Rts_E = (errno == EINTR) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+      }
+      for (i = 0; i < Nb_i; i++)
+      {
+        if (mEpollEventCollection[i].data.u64 == BOF_SOCKET_POLLER_WAKEUP_COOKIE)
+        {
+          while (read(mWakeupFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64))
+          {
+          }
+        }
+        else
+        {
+          Event_X.Cookie_U64 = mEpollEventCollection[i].data.u64;
+          Event_X.REvent_U16 = S_FromEpollEvent(mEpollEventCollection[i].events);
+          _rEventCollection.push_back(Event_X);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Wakeup() override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_OPENED;
+    uint64_t Value_U64 = 1;
+
+    if (IsValid())
+    {
+      //EAGAIN means that the counter is saturated: a wake up is already pending
+      Rts_E = ((write(mWakeupFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64)) || (errno == EAGAIN)) ? BOF_ERR_NO_ERROR : BOF_ERR_WRITE;
+    }
+    return Rts_E;
+  }
+
+  const char *V_Name() const override
+  {
+    return "epoll";
+  }
+
+private:
+  BOFERR Control(int _Op_i, BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_OPENED;
+    struct epoll_event Event_X;
+
+    if (IsValid())
+    {
+      Event_X.events = S_ToEpollEvent(_Event_U16, _Trigger_E);
+      Event_X.data.u64 = _Cookie_U64;
+      Rts_E = (epoll_ctl(mEpollFd_i, _Op_i, _Fd, &Event_X) == 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+    }
+    return Rts_E;
+  }
+};
+
+/*!
+ * Summary
+ * poll poller engine
+ *
+ * Description
+ * Keeps the behaviour of BofSocketSessionManager (one O(n) scan per wait) but registrations are applied under a
+ * lock and the waiting thread is kicked through an eventfd instead of the poll control listener socket. Edge
+ * triggering is not supported.
+ */
+class BofPollEngine : public IBofSocketPollerEngine
+{
+private:
+  std::mutex mMtx;
+  int mWakeupFd_i = -1;
+  std::vector<struct pollfd> mPollFdCollection;     //Index 0 is the wake up descriptor
+  std::vector<uint64_t> mCookieCollection;
+  std::map<BOFSOCKET, uint32_t> mIndexCollection;
+  std::vector<struct pollfd> mWaitPollFdCollection; //Snapshot used by V_Wait outside of the lock
+  std::vector<uint64_t> mWaitCookieCollection;
+  bool mChanged_B = true;
+
+public:
+  BofPollEngine()
+  {
+    struct pollfd PollFd_X;
+
+    mWakeupFd_i = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    PollFd_X.fd = mWakeupFd_i;
+    PollFd_X.events = POLLIN;
+    PollFd_X.revents = 0;
+    mPollFdCollection.push_back(PollFd_X);
+    mCookieCollection.push_back(BOF_SOCKET_POLLER_WAKEUP_COOKIE);
+  }
+  virtual ~BofPollEngine()
+  {
+    if (mWakeupFd_i >= 0)
+    {
+      close(mWakeupFd_i);
+    }
+  }
+  BofPollEngine &operator=(const BofPollEngine &) = delete; // Disallow copying
+  BofPollEngine(const BofPollEngine &) = delete;
+
+  bool IsValid() const
+  {
+    return (mWakeupFd_i >= 0);
+  }
+
+  BOFERR V_Add(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+    struct pollfd PollFd_X;
+
+    if (_Trigger_E != BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE)
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      Rts_E = BOF_ERR_EEXIST;
+      if (mIndexCollection.find(_Fd) == mIndexCollection.end())
+      {
+        PollFd_X.fd = _Fd;
+        PollFd_X.events = static_cast<short>(_Event_U16);
+        PollFd_X.revents = 0;
+        mIndexCollection[_Fd] = static_cast<uint32_t>(mPollFdCollection.size());
+        mPollFdCollection.push_back(PollFd_X);
+        mCookieCollection.push_back(_Cookie_U64);
+        mChanged_B = true;
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = V_Wakeup();
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Modify(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+    std::map<BOFSOCKET, uint32_t>::iterator It;
+
+    if (_Trigger_E != BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE)
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      Rts_E = BOF_ERR_NOT_FOUND;
+      It = mIndexCollection.find(_Fd);
+      if (It != mIndexCollection.end())
+      {
+        mPollFdCollection[It->second].events = static_cast<short>(_Event_U16);
+        mCookieCollection[It->second] = _Cookie_U64;
+        mChanged_B = true;
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = V_Wakeup();
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Remove(BOFSOCKET _Fd) override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    std::map<BOFSOCKET, uint32_t>::iterator It;
+    uint32_t Index_U32, Last_U32;
+
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      It = mIndexCollection.find(_Fd);
+      if (It != mIndexCollection.end())
+      {
+        //Swap with the last entry to keep the array compact
+        Index_U32 = It->second;
+        Last_U32 = static_cast<uint32_t>(mPollFdCollection.size() - 1);
+        if (Index_U32 != Last_U32)
+        {
+          mPollFdCollection[Index_U32] = mPollFdCollection[Last_U32];
+          mCookieCollection[Index_U32] = mCookieCollection[Last_U32];
+          mIndexCollection[mPollFdCollection[Index_U32].fd] = Index_U32;
+        }
+        mPollFdCollection.pop_back();
+        mCookieCollection.pop_back();
+        mIndexCollection.erase(_Fd);
+        mChanged_B = true;
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = V_Wakeup();
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Wait(uint32_t _TimeoutInMs_U32, uint32_t _MaxEvent_U32, std::vector<BOF_SOCKET_POLLER_EVENT> &_rEventCollection) override
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    BOF_SOCKET_POLLER_EVENT Event_X;
+    uint64_t Value_U64;
+    uint32_t i_U32;
+    int Nb_i;
+
+    _rEventCollection.clear();
+    if ((IsValid()) && (_MaxEvent_U32))
+    {
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        if (mChanged_B)
+        {
+          mWaitPollFdCollection = mPollFdCollection;
+          mWaitCookieCollection = mCookieCollection;
+          mChanged_B = false;
+        }
+      }
+      Rts_E = BOF_ERR_NO_ERROR;
+      Nb_i = poll(mWaitPollFdCollection.data(), static_cast<nfds_t>(mWaitPollFdCollection.size()), static_cast<int>(_TimeoutInMs_U32));
+      if (Nb_i < 0)
+      {
+        Rts_E = (errno == EINTR) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+      }
+      for (i_U32 = 0; (Nb_i > 0) && (i_U32 < mWaitPollFdCollection.size()); i_U32++)
+      {
+        if (mWaitPollFdCollection[i_U32].revents)
+        {
+          Nb_i--;
+          if (mWaitCookieCollection[i_U32] == BOF_SOCKET_POLLER_WAKEUP_COOKIE)
+          {
+            while (read(mWakeupFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64))
+            {
+            }
+          }
+          else if (_rEventCollection.size() < _MaxEvent_U32)
+          {
+            Event_X.Cookie_U64 = mWaitCookieCollection[i_U32];
+            Event_X.REvent_U16 = static_cast<uint16_t>(mWaitPollFdCollection[i_U32].revents);
+            _rEventCollection.push_back(Event_X);
+          }
+          mWaitPollFdCollection[i_U32].revents = 0;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Wakeup() override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_OPENED;
+    uint64_t Value_U64 = 1;
+
+    if (IsValid())
+    {
+      Rts_E = ((write(mWakeupFd_i, &Value_U64, sizeof(Value_U64)) == sizeof(Value_U64)) || (errno == EAGAIN)) ? BOF_ERR_NO_ERROR : BOF_ERR_WRITE;
+    }
+    return Rts_E;
+  }
+
+  const char *V_Name() const override
+  {
+    return "poll";
+  }
+};
+
+#if BOF_IO_URING_AVAILABLE
+/*!
+ * Summary
+ * io_uring poller engine
+ *
+ * Description
+ * Readiness through IORING_OP_POLL_ADD requests: multishot for edge triggering, one shot re-armed at the start
+ * of the next V_Wait (after the dispatch) for level triggering. A multishot request terminated by the kernel (no
+ * IORING_CQE_F_MORE) is re-armed the same way.
+ */
+class BofIoUringPollerEngine : public IBofSocketPollerEngine
+{
+private:
+  static constexpr uint64_t INTERNAL_COOKIE = BOF_SOCKET_POLLER_WAKEUP_COOKIE - 1;  //Completion of a remove request
+
+  struct POLL_REGISTRATION
+  {
+    uint64_t                  Cookie_U64;
+    uint16_t                  Event_U16;
+    BOF_SOCKET_POLLER_TRIGGER Trigger_E;
+  };
+
+  std::mutex                              mMtx;     //Protects the submission side and the registration collection
+  BofIoUring                              mIoUring;
+  std::map<BOFSOCKET, POLL_REGISTRATION>  mRegistrationCollection;
+  std::map<uint64_t, BOFSOCKET>           mCookieCollection;
+  std::vector<uint64_t>                   mRearmCollection;   //Only used by the V_Wait thread
+
+public:
+  BofIoUringPollerEngine(uint32_t _NbEntry_U32)
+  {
+    if (mIoUring.Open(_NbEntry_U32, 0) == BOF_ERR_NO_ERROR)
+    {
+      if ((!mIoUring.IsOpcodeSupported(IORING_OP_POLL_ADD)) || (!mIoUring.IsOpcodeSupported(IORING_OP_POLL_REMOVE)) || (!mIoUring.IsOpcodeSupported(IORING_OP_NOP)))
+      {
+        mIoUring.Close();
+      }
+    }
+  }
+  virtual ~BofIoUringPollerEngine()
+  {
+  }
+  BofIoUringPollerEngine &operator=(const BofIoUringPollerEngine &) = delete; // Disallow copying
+  BofIoUringPollerEngine(const BofIoUringPollerEngine &) = delete;
+
+  bool IsValid() const
+  {
+    return mIoUring.IsOpen();
+  }
+
+  BOFERR V_Add(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    BOFERR Rts_E = BOF_ERR_EEXIST;
+    POLL_REGISTRATION Registration_X;
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    if (mRegistrationCollection.find(_Fd) == mRegistrationCollection.end())
+    {
+      Registration_X.Cookie_U64 = _Cookie_U64;
+      Registration_X.Event_U16 = _Event_U16;
+      Registration_X.Trigger_E = _Trigger_E;
+      Rts_E = PrepPollAdd(_Fd, Registration_X);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = mIoUring.Submit(0, 0);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          mRegistrationCollection[_Fd] = Registration_X;
+          mCookieCollection[_Cookie_U64] = _Fd;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Modify(BOFSOCKET _Fd, uint16_t _Event_U16, BOF_SOCKET_POLLER_TRIGGER _Trigger_E, uint64_t _Cookie_U64) override
+  {
+    BOFERR Rts_E;
+
+    Rts_E = V_Remove(_Fd);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = V_Add(_Fd, _Event_U16, _Trigger_E, _Cookie_U64);
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Remove(BOFSOCKET _Fd) override
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    std::map<BOFSOCKET, POLL_REGISTRATION>::iterator It;
+    struct io_uring_sqe *pSqe_X;
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    It = mRegistrationCollection.find(_Fd);
+    if (It != mRegistrationCollection.end())
+    {
+      pSqe_X = GetSqe();
+      Rts_E = BOF_ERR_FULL;
+      if (pSqe_X)
+      {
+        pSqe_X->opcode = IORING_OP_POLL_REMOVE;
+        pSqe_X->fd = -1;
+        pSqe_X->addr = It->second.Cookie_U64;
+        pSqe_X->user_data = INTERNAL_COOKIE;
+        Rts_E = mIoUring.Submit(0, 0);
+      }
+      //The registration is forgotten even if the cancel failed: a late completion is reported as a stale event
+      mCookieCollection.erase(It->second.Cookie_U64);
+      mRegistrationCollection.erase(It);
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Wait(uint32_t _TimeoutInMs_U32, uint32_t _MaxEvent_U32, std::vector<BOF_SOCKET_POLLER_EVENT> &_rEventCollection) override
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    BOF_SOCKET_POLLER_EVENT Event_X;
+    std::map<uint64_t, BOFSOCKET>::iterator It;
+    uint32_t i_U32;
+
+    _rEventCollection.clear();
+    if ((IsValid()) && (_MaxEvent_U32))
+    {
+      //Re-arm the requests completed by the previous call now that their events have been dispatched
+      if (mRearmCollection.size())
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        for (i_U32 = 0; i_U32 < mRearmCollection.size(); i_U32++)
+        {
+          It = mCookieCollection.find(mRearmCollection[i_U32]);
+          if (It != mCookieCollection.end())
+          {
+            PrepPollAdd(It->second, mRegistrationCollection[It->second]);
+          }
+        }
+        mRearmCollection.clear();
+        mIoUring.Submit(0, 0);
+      }
+      Rts_E = mIoUring.Wait(1, _TimeoutInMs_U32);
+      //All the available completions are consumed: _MaxEvent_U32 only sizes the buffer of the other engines
+      mIoUring.ForEachCqe([&](const struct io_uring_cqe &_rCqe_X) {
+        if ((_rCqe_X.user_data != BOF_SOCKET_POLLER_WAKEUP_COOKIE) && (_rCqe_X.user_data != INTERNAL_COOKIE))
+        {
+          if (_rCqe_X.res >= 0)
+          {
+            Event_X.Cookie_U64 = _rCqe_X.user_data;
+            Event_X.REvent_U16 = static_cast<uint16_t>(_rCqe_X.res);
+            _rEventCollection.push_back(Event_X);
+          }
+          else if ((_rCqe_X.res != -ECANCELED) && (_rCqe_X.res != -ENOENT))
+          {
+            Event_X.Cookie_U64 = _rCqe_X.user_data;
+            Event_X.REvent_U16 = BOF_POLL_ERR;
+            _rEventCollection.push_back(Event_X);
+          }
+          if ((!(_rCqe_X.flags & IORING_CQE_F_MORE)) && (_rCqe_X.res != -ECANCELED))
+          {
+            mRearmCollection.push_back(_rCqe_X.user_data);
+          }
+        }
+      });
+    }
+    return Rts_E;
+  }
+
+  BOFERR V_Wakeup() override
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    struct io_uring_sqe *pSqe_X;
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    pSqe_X = GetSqe();
+    if (pSqe_X)
+    {
+      pSqe_X->opcode = IORING_OP_NOP;
+      pSqe_X->user_data = BOF_SOCKET_POLLER_WAKEUP_COOKIE;
+      Rts_E = mIoUring.Submit(0, 0);
+    }
+    return Rts_E;
+  }
+
+  const char *V_Name() const override
+  {
+    return "io_uring";
+  }
+
+private:
+  //Called with mMtx held
+  struct io_uring_sqe *GetSqe()
+  {
+    struct io_uring_sqe *pRts_X = mIoUring.GetSqe();
+
+    if (!pRts_X)
+    {
+      mIoUring.Submit(0, 0);
+      pRts_X = mIoUring.GetSqe();
+    }
+    return pRts_X;
+  }
+
+  //Called with mMtx held
+  BOFERR PrepPollAdd(BOFSOCKET _Fd, const POLL_REGISTRATION &_rRegistration_X)
+  {
+    BOFERR Rts_E = BOF_ERR_FULL;
+    struct io_uring_sqe *pSqe_X = GetSqe();
+
+    if (pSqe_X)
+    {
+      pSqe_X->opcode = IORING_OP_POLL_ADD;
+      pSqe_X->fd = _Fd;
+      pSqe_X->poll32_events = _rRegistration_X.Event_U16;   //BOF_POLL_xxx are the poll(2) values
+      //Multishot poll reports each wake up of the socket (edge). A one shot poll re-armed after the dispatch
+      //completes again at once while the condition holds (level).
+      if (_rRegistration_X.Trigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE)
+      {
+        pSqe_X->len = IORING_POLL_ADD_MULTI;
+      }
+      pSqe_X->user_data = _rRegistration_X.Cookie_U64;
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+    return Rts_E;
+  }
+};
+#endif
+#endif
+
+/*!
+ * Description
+ * Create a poller engine.
+ *
+ * Parameters
+ * _Engine_E:  Specifies the engine type
+ * _rpuEngine: Returns the engine
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_NOT_SUPPORTED if the engine does not exist on this platform.
+ * BOF_SOCKET_POLLER_ENGINE_IO_URING silently falls back to epoll when io_uring is not usable: check V_Name.
+ */
+inline BOFERR Bof_CreateSocketPollerEngine(BOF_SOCKET_POLLER_ENGINE _Engine_E, std::unique_ptr<IBofSocketPollerEngine> &_rpuEngine)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+
+  _rpuEngine.reset(nullptr);
+#if !defined(_WIN32)
+#if BOF_IO_URING_AVAILABLE
+  if (_Engine_E == BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_IO_URING)
+  {
+    std::unique_ptr<BofIoUringPollerEngine> puEngine(new BofIoUringPollerEngine(256));
+
+    if (puEngine->IsValid())
+    {
+      _rpuEngine = std::move(puEngine);
+      Rts_E = BOF_ERR_NO_ERROR;
+    }
+  }
+#endif
+  if ((!_rpuEngine) && ((_Engine_E == BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_EPOLL) || (_Engine_E == BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_IO_URING)))
+  {
+    std::unique_ptr<BofEpollEngine> puEngine(new BofEpollEngine());
+
+    Rts_E = puEngine->IsValid() ? BOF_ERR_NO_ERROR : BOF_ERR_CREATE;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      _rpuEngine = std::move(puEngine);
+    }
+  }
+  else if (_Engine_E == BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_POLL)
+  {
+    std::unique_ptr<BofPollEngine> puEngine(new BofPollEngine());
+
+    Rts_E = puEngine->IsValid() ? BOF_ERR_NO_ERROR : BOF_ERR_CREATE;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      _rpuEngine = std::move(puEngine);
+    }
+  }
+#else
+  (void)_Engine_E;
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Summary
+ * Socket poll server
+ *
+ * Description
+ * Alternative to the poll loop of BofSocketSessionManager built on an IBofSocketPollerEngine. Sessions are added
+ * and removed directly in the engine from any thread and only the ready descriptors are visited after each wait.
+ * Each registration selects how its readiness is reported:
+ * - BOF_SOCKET_POLLER_DISPATCH_SIGNAL_POLL: V_SignalPoll(REvent, session), as in BOF_SOCKET_SERVER_POLLER mode.
+ *   With an edge triggered registration the callback must consume the socket up to EAGAIN.
+ * - BOF_SOCKET_POLLER_DISPATCH_DATA_READ: ParseAndDispatchIncomingData which ends in V_SignalDataRead, as in
+ *   BOF_SOCKET_SERVER_SESSION mode. With an edge triggered registration the socket is drained by the server.
+ * On peer hang up or error the session is removed and given back to IBofSocketSessionFactory::V_CloseSession.
+ * Callbacks are called from the poll thread (or the Poll caller) without any internal lock held.
+ * Sessions are kept in a descriptor indexed table (BofSocketSessionTable): the poll thread finds the entry of each
+ * ready descriptor without lock nor reference count traffic and the generation in the event cookie rejects the
+ * events of a removed descriptor. Removed entries are destroyed by the next Poll call, so only one thread may poll.
+ * The Xxx_Async methods post the operation on a lock free command queue signaled through an eventfd which is polled
+ * with the sessions: the operation runs in the poll thread and its std::future gives the result, there is no
+ * control socket nor answer ticket. A burst of commands costs one wake up. Never wait for such a future from a
+ * poll callback: the poll thread would wait for itself.
+ *
+ * See Also
+ * BofSocketSessionManager, IBofSocketPollerEngine
+ */
+class BofSocketPollServer : public BofThread
+{
+private:
+  struct POLL_ENTRY
+  {
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    std::unique_ptr<BofSocket>   puListener;         //Not null for a listener entry
+    BOF_SOCKET_POLLER_DISPATCH   Dispatch_E;         //For a listener: dispatch mode of the accepted sessions
+    BOF_SOCKET_POLLER_TRIGGER    Trigger_E;
+    uint16_t                     Event_U16;
+    uint32_t                     Generation_U32;
+  };
+
+  IBofSocketSessionFactory                        *mpIBofSocketSessionFactory = nullptr;
+  BOF_SOCKET_POLL_SERVER_PARAM                    mSocketPollServerParam_X;
+  BOFERR                                          mErrorCode_E = BOF_ERR_INIT;
+  std::unique_ptr<IBofSocketPollerEngine>         mpuEngine = nullptr;
+  std::mutex                                      mMtx;               //Serializes the writers of mPollEntryTable, the poll thread reads it without lock
+  BofSocketSessionTable<POLL_ENTRY>               mPollEntryTable;
+  std::vector<std::unique_ptr<POLL_ENTRY>>        mRetiredPollEntryCollection;
+  uint32_t                                        mNextSessionIndex_U32 = 0;
+  uint32_t                                        mNbSession_U32 = 0;
+  std::vector<BOF_SOCKET_POLLER_EVENT>            mEventCollection;
+  BOF_SOCKET_POLL_SERVER_STATISTIC                mSocketPollServerStatistic_X;
+  BofSocketCommandQueue                           mCommandQueue;
+
+public:
+  BofSocketPollServer(IBofSocketSessionFactory *_pIBofSocketSessionFactory, const BOF_SOCKET_POLL_SERVER_PARAM &_rSocketPollServerParam_X)
+    : mPollEntryTable(_rSocketPollServerParam_X.NbMaxFd_U32)
+  {
+    mpIBofSocketSessionFactory = _pIBofSocketSessionFactory;
+    mSocketPollServerParam_X = _rSocketPollServerParam_X;
+    if (mSocketPollServerParam_X.DefaultTrigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT)
+    {
+      mSocketPollServerParam_X.DefaultTrigger_E = BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_LEVEL;
+    }
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mSocketPollServerParam_X.SocketServerParam_X.NbMaxSession_U32) && (mSocketPollServerParam_X.MaxEventPerWait_U32))
+    {
+      mErrorCode_E = Bof_CreateSocketPollerEngine(mSocketPollServerParam_X.Engine_E, mpuEngine);
+      mEventCollection.reserve(mSocketPollServerParam_X.MaxEventPerWait_U32);
+      if (mErrorCode_E == BOF_ERR_NO_ERROR)
+      {
+        mErrorCode_E = mCommandQueue.LastErrorCode();
+        if (mErrorCode_E == BOF_ERR_NO_ERROR)
+        {
+          mErrorCode_E = mpuEngine->V_Add(mCommandQueue.EventFd(), BOF_POLL_IN, BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_LEVEL, BOF_SOCKET_POLLER_COMMAND_COOKIE);
+        }
+      }
+    }
+  }
+  virtual ~BofSocketPollServer()
+  {
+    if (mpuEngine)
+    {
+      mpuEngine->V_Wakeup();
+    }
+    DestroyBofProcessingThread("~BofSocketPollServer");
+  }
+  BofSocketPollServer &operator=(const BofSocketPollServer &) = delete; // Disallow copying
+  BofSocketPollServer(const BofSocketPollServer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  const char *EngineName() const
+  {
+    return mpuEngine ? mpuEngine->V_Name() : "none";
+  }
+
+  /*!
+   * Description
+   * Start the poll thread. The server can also be driven without thread by calling Poll.
+   */
+  BOFERR Start()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = LaunchBofProcessingThread(mSocketPollServerParam_X.SocketServerParam_X.Name_S, false, 0, mSocketPollServerParam_X.SocketServerParam_X.ThreadSchedulerPolicy_E,
+                                        mSocketPollServerParam_X.SocketServerParam_X.ThreadPriority_E, mSocketPollServerParam_X.SocketServerParam_X.ThreadCpuCoreAffinityMask_U64, 2000, 0);
+    }
+    return Rts_E;
+  }
+
+  BOFERR Stop()
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      mpuEngine->V_Wakeup();
+      Rts_E = DestroyBofProcessingThread("BofSocketPollServer::Stop");
+    }
+    return Rts_E;
+  }
+
+  BOFERR Wakeup()
+  {
+    return (mErrorCode_E == BOF_ERR_NO_ERROR) ? mpuEngine->V_Wakeup() : mErrorCode_E;
+  }
+
+  /*!
+   * Description
+   * Add a listening socket. Each accepted connection is given to IBofSocketSessionFactory::V_OpenSession
+   * (BOF_SOCKET_SESSION_TYPE::POLL_CHANNEL) and the returned session is added with _Dispatch_E and _Trigger_E,
+   * unless BOF_SOCKET_POLL_SERVER_PARAM::OnAccept is set. The listener is switched to non blocking mode and owned
+   * by the server.
+   */
+  BOFERR AddListener(std::unique_ptr<BofSocket> _puListener, BOF_SOCKET_POLLER_DISPATCH _Dispatch_E, BOF_SOCKET_POLLER_TRIGGER _Trigger_E)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    std::unique_ptr<POLL_ENTRY> puPollEntry;
+    BOFSOCKET Fd;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_puListener) && (mpIBofSocketSessionFactory))
+      {
+        Rts_E = _puListener->SetNonBlockingMode(true);
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Fd = _puListener->GetSocketHandle();
+          puPollEntry.reset(new POLL_ENTRY());
+          puPollEntry->puListener = std::move(_puListener);
+          puPollEntry->Dispatch_E = _Dispatch_E;
+          puPollEntry->Trigger_E = ResolveTrigger(_Trigger_E);
+          puPollEntry->Event_U16 = BOF_POLL_IN;
+          Rts_E = Register(Fd, std::move(puPollEntry), false);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR AddSession(std::shared_ptr<BofSocketIo> _psSocketSession, uint16_t _Event_U16, BOF_SOCKET_POLLER_DISPATCH _Dispatch_E, BOF_SOCKET_POLLER_TRIGGER _Trigger_E)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    std::unique_ptr<POLL_ENTRY> puPollEntry;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_psSocketSession) && (_psSocketSession->NativeBofSocketPointer()) && (_Event_U16))
+      {
+        puPollEntry.reset(new POLL_ENTRY());
+        puPollEntry->psSocketSession = _psSocketSession;
+        puPollEntry->Dispatch_E = _Dispatch_E;
+        puPollEntry->Trigger_E = ResolveTrigger(_Trigger_E);
+        puPollEntry->Event_U16 = _Event_U16;
+        Rts_E = BOF_ERR_NO_ERROR;
+        if (puPollEntry->Trigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE)
+        {
+          Rts_E = _psSocketSession->NativeBofSocketPointer()->SetNonBlockingMode(true);
+        }
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = Register(_psSocketSession->NativeSocketHandle(), std::move(puPollEntry), true);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR ModifySession(std::shared_ptr<BofSocketIo> _psSocketSession, uint16_t _Event_U16)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    POLL_ENTRY *pPollEntry_X;
+    BOFSOCKET Fd;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if ((_psSocketSession) && (_Event_U16))
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        Rts_E = BOF_ERR_NOT_FOUND;
+        Fd = _psSocketSession->NativeSocketHandle();
+        pPollEntry_X = mPollEntryTable.Find(Fd);
+        if ((pPollEntry_X) && (pPollEntry_X->psSocketSession == _psSocketSession))
+        {
+          Rts_E = mpuEngine->V_Modify(Fd, _Event_U16, pPollEntry_X->Trigger_E, Cookie(Fd, pPollEntry_X->Generation_U32));
+          if (Rts_E == BOF_ERR_NO_ERROR)
+          {
+            pPollEntry_X->Event_U16 = _Event_U16;
+          }
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Remove a session from the poller. The session is not closed: the caller keeps its ownership.
+   */
+  BOFERR RemoveSession(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_EINVAL;
+      if (_psSocketSession)
+      {
+        Rts_E = Unregister(_psSocketSession->NativeSocketHandle(), _psSocketSession.get());
+      }
+    }
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Post AddSession to the poll thread.
+   *
+   * Parameters
+   * Same as AddSession
+   *
+   * Returns
+   * std::future<BOFERR>: Gives the AddSession result once the poll thread has registered the session
+   */
+  std::future<BOFERR> AddSession_Async(std::shared_ptr<BofSocketIo> _psSocketSession, uint16_t _Event_U16, BOF_SOCKET_POLLER_DISPATCH _Dispatch_E, BOF_SOCKET_POLLER_TRIGGER _Trigger_E)
+  {
+    return mCommandQueue.Post([this, _psSocketSession, _Event_U16, _Dispatch_E, _Trigger_E]() { return AddSession(_psSocketSession, _Event_U16, _Dispatch_E, _Trigger_E); });
+  }
+
+  //Post RemoveSession to the poll thread: once the future is ready no callback is running or will run for the session
+  std::future<BOFERR> RemoveSession_Async(std::shared_ptr<BofSocketIo> _psSocketSession)
+  {
+    return mCommandQueue.Post([this, _psSocketSession]() { return RemoveSession(_psSocketSession); });
+  }
+
+  //Make the poll thread leave its current wait: the future is ready when it has done so
+  std::future<BOFERR> CancelWait_Async()
+  {
+    return mCommandQueue.Post([]() { return BOF_ERR_NO_ERROR; });
+  }
+
+  //Run any operation in the poll thread, serialized with the dispatch of the sessions
+  std::future<BOFERR> Post_Async(BOF_SOCKET_COMMAND_CALLBACK _Command)
+  {
+    return mCommandQueue.Post(std::move(_Command));
+  }
+
+  uint32_t NbSession()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    return mNbSession_U32;
+  }
+
+  /*!
+   * Description
+   * Wait for ready descriptors and dispatch them. Used by the poll thread or by the owner when the server is not started.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies the maximum wait time
+   * _rNbEvent_U32:    Returns the number of ready descriptors dispatched
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+   */
+  BOFERR Poll(uint32_t _TimeoutInMs_U32, uint32_t &_rNbEvent_U32)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+    POLL_ENTRY *pPollEntry_X;
+    uint32_t i_U32, NbStale_U32 = 0;
+    bool Command_B = false;
+
+    _rNbEvent_U32 = 0;
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = mpuEngine->V_Wait(_TimeoutInMs_U32, mSocketPollServerParam_X.MaxEventPerWait_U32, mEventCollection);
+      _rNbEvent_U32 = static_cast<uint32_t>(mEventCollection.size());
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        mSocketPollServerStatistic_X.NbWait_U64++;
+        mSocketPollServerStatistic_X.NbEvent_U64 += _rNbEvent_U32;
+        if (_rNbEvent_U32 > mSocketPollServerStatistic_X.MaxEventPerWait_U32)
+        {
+          mSocketPollServerStatistic_X.MaxEventPerWait_U32 = _rNbEvent_U32;
+        }
+      }
+      for (i_U32 = 0; i_U32 < _rNbEvent_U32; i_U32++)
+      {
+        if (mEventCollection[i_U32].Cookie_U64 == BOF_SOCKET_POLLER_COMMAND_COOKIE)
+        {
+          Command_B = true;
+        }
+        else
+        {
+          //Lock free: the entry stays valid until ReclaimRetiredPollEntry even if another thread removes it meanwhile
+          pPollEntry_X = mPollEntryTable.Lookup(static_cast<BOFSOCKET>(mEventCollection[i_U32].Cookie_U64 & 0xFFFFFFFF), static_cast<uint32_t>(mEventCollection[i_U32].Cookie_U64 >> 32));
+          if (pPollEntry_X == nullptr)
+          {
+            NbStale_U32++;
+          }
+          else if (pPollEntry_X->puListener)
+          {
+            Accept(*pPollEntry_X);
+          }
+          else
+          {
+            Dispatch(*pPollEntry_X, mEventCollection[i_U32].REvent_U16);
+          }
+        }
+      }
+      //Commands run after the dispatch of the ready sessions, so a removed session is never called back afterwards
+      if (Command_B)
+      {
+        _rNbEvent_U32--;
+        mCommandQueue.Process();
+      }
+      ReclaimRetiredPollEntry(NbStale_U32);
+    }
+    return Rts_E;
+  }
+
+  BOF_SOCKET_POLL_SERVER_STATISTIC SocketPollServerStatistic()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    return mSocketPollServerStatistic_X;
+  }
+
+  void ResetSocketPollServerStatistic()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+    mSocketPollServerStatistic_X.Reset();
+  }
+
+  //Statistic of the command queue, to call from the poll thread (Post_Async) for an exact snapshot
+  BOF_SOCKET_COMMAND_QUEUE_STATISTIC SocketCommandQueueStatistic() const
+  {
+    return mCommandQueue.SocketCommandQueueStatistic();
+  }
+
+  std::string SocketPollServerDebugInfo()
+  {
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    return Bof_Sprintf("PollServer '%s' %s: Session %u/%u Wait %lld Evt %lld MaxEvt %u Stale %lld Add %lld Rem %lld Acc %lld Rej %lld PeerClose %lld DispErr %lld\n",
+                       mSocketPollServerParam_X.SocketServerParam_X.Name_S.c_str(), EngineName(), mNbSession_U32, mSocketPollServerParam_X.SocketServerParam_X.NbMaxSession_U32,
+                       mSocketPollServerStatistic_X.NbWait_U64, mSocketPollServerStatistic_X.NbEvent_U64, mSocketPollServerStatistic_X.MaxEventPerWait_U32,
+                       mSocketPollServerStatistic_X.NbStaleEvent_U64, mSocketPollServerStatistic_X.NbAdd_U64, mSocketPollServerStatistic_X.NbRemove_U64,
+                       mSocketPollServerStatistic_X.NbAccept_U64, mSocketPollServerStatistic_X.NbRejectedAccept_U64, mSocketPollServerStatistic_X.NbPeerClosed_U64,
+                       mSocketPollServerStatistic_X.NbDispatchError_U64);
+  }
+
+private:
+  static uint64_t Cookie(BOFSOCKET _Fd, uint32_t _Generation_U32)
+  {
+    return (static_cast<uint64_t>(_Generation_U32) << 32) | static_cast<uint32_t>(_Fd);
+  }
+
+  BOF_SOCKET_POLLER_TRIGGER ResolveTrigger(BOF_SOCKET_POLLER_TRIGGER _Trigger_E) const
+  {
+    return (_Trigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_DEFAULT) ? mSocketPollServerParam_X.DefaultTrigger_E : _Trigger_E;
+  }
+
+  BOFERR Register(BOFSOCKET _Fd, std::unique_ptr<POLL_ENTRY> _puPollEntry, bool _IsSession_B)
+  {
+    BOFERR Rts_E;
+    POLL_ENTRY *pPollEntry_X = _puPollEntry.get();
+    uint32_t Generation_U32;
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    Rts_E = BOF_ERR_FULL;
+    if ((!_IsSession_B) || (mNbSession_U32 < mSocketPollServerParam_X.SocketServerParam_X.NbMaxSession_U32))
+    {
+      //The generation makes the events still queued for a closed and re-used descriptor stale
+      Rts_E = mPollEntryTable.Insert(_Fd, std::move(_puPollEntry), Generation_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        pPollEntry_X->Generation_U32 = Generation_U32;
+        Rts_E = mpuEngine->V_Add(_Fd, pPollEntry_X->Event_U16, pPollEntry_X->Trigger_E, Cookie(_Fd, Generation_U32));
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          mSocketPollServerStatistic_X.NbAdd_U64++;
+          if (_IsSession_B)
+          {
+            mNbSession_U32++;
+          }
+        }
+        else
+        {
+          mPollEntryTable.Remove(_Fd);
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  BOFERR Unregister(BOFSOCKET _Fd, const BofSocketIo *_pSocketSession)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    POLL_ENTRY *pPollEntry_X;
+    std::lock_guard<std::mutex> Lock(mMtx);
+
+    pPollEntry_X = mPollEntryTable.Find(_Fd);
+    if ((pPollEntry_X) && (pPollEntry_X->psSocketSession.get() == _pSocketSession))
+    {
+      Rts_E = mpuEngine->V_Remove(_Fd);
+      //Retired, not destroyed: the poll thread may be dispatching it right now
+      mPollEntryTable.Remove(_Fd);
+      mSocketPollServerStatistic_X.NbRemove_U64++;
+      if (_pSocketSession)
+      {
+        mNbSession_U32--;
+      }
+    }
+    return Rts_E;
+  }
+
+  void Accept(POLL_ENTRY &_rListenerEntry)
+  {
+    BofComChannel *pBofComChannel;
+    std::unique_ptr<BofSocket> puSocket;
+    std::shared_ptr<BofSocketIo> psSocketSession;
+    bool Full_B;
+
+    //The listener is non blocking: accept everything which is pending, whatever the trigger mode
+    while ((pBofComChannel = _rListenerEntry.puListener->V_Listen(0, "")) != nullptr)
+    {
+      puSocket.reset(static_cast<BofSocket *>(pBofComChannel));
+      {
+        std::lock_guard<std::mutex> Lock(mMtx);
+        //With a hand off the capacity is checked by the receiver
+        Full_B = (!mSocketPollServerParam_X.OnAccept) && (mNbSession_U32 >= mSocketPollServerParam_X.SocketServerParam_X.NbMaxSession_U32);
+        if (Full_B)
+        {
+          mSocketPollServerStatistic_X.NbRejectedAccept_U64++;
+        }
+        else
+        {
+          mSocketPollServerStatistic_X.NbAccept_U64++;
+        }
+      }
+      if (Full_B)
+      {
+        puSocket.reset(nullptr);
+      }
+      else if (mSocketPollServerParam_X.OnAccept)
+      {
+        mSocketPollServerParam_X.OnAccept(puSocket);
+        puSocket.reset(nullptr);
+      }
+      else
+      {
+        psSocketSession = mpIBofSocketSessionFactory->V_OpenSession(BOF_SOCKET_SESSION_TYPE::POLL_CHANNEL, mNextSessionIndex_U32++, std::move(puSocket));
+        if (psSocketSession)
+        {
+          if (AddSession(psSocketSession, BOF_POLL_IN | BOF_POLL_RDHUP, _rListenerEntry.Dispatch_E, _rListenerEntry.Trigger_E) != BOF_ERR_NO_ERROR)
+          {
+            mpIBofSocketSessionFactory->V_CloseSession(psSocketSession);
+          }
+        }
+      }
+    }
+  }
+
+  //Called from Poll only: _rPollEntry stays valid until ReclaimRetiredPollEntry, even if it is unregistered here
+  void Dispatch(POLL_ENTRY &_rPollEntry, uint16_t _REvent_U16)
+  {
+    BOFERR Sts_E = BOF_ERR_NO_ERROR;
+    const std::shared_ptr<BofSocketIo> &rpsSocketSession = _rPollEntry.psSocketSession;
+    uint32_t NbPending_U32;
+    bool PeerClosed_B = ((_REvent_U16 & (BOF_POLL_HUP | BOF_POLL_RDHUP | BOF_POLL_ERR | BOF_POLL_NVAL)) != 0);
+
+    if (_rPollEntry.Dispatch_E == BOF_SOCKET_POLLER_DISPATCH::BOF_SOCKET_POLLER_DISPATCH_SIGNAL_POLL)
+    {
+      Sts_E = rpsSocketSession->V_SignalPoll(_REvent_U16, rpsSocketSession);
+    }
+    else
+    {
+      if (_REvent_U16 & BOF_POLL_IN)
+      {
+        //Edge triggered: read until the socket is empty as no new event will come for the data already queued
+        do
+        {
+          NbPending_U32 = 0;
+          Sts_E = rpsSocketSession->ParseAndDispatchIncomingData(0);
+          if ((Sts_E == BOF_ERR_NO_ERROR) && (_rPollEntry.Trigger_E == BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_EDGE))
+          {
+            rpsSocketSession->NativeBofSocketPointer()->V_WaitForDataToRead(0, NbPending_U32);
+          }
+        } while (NbPending_U32);
+      }
+      if (_REvent_U16 & BOF_POLL_OUT)
+      {
+        Sts_E = rpsSocketSession->V_SignalPoll(_REvent_U16, rpsSocketSession);
+      }
+    }
+    if ((Sts_E != BOF_ERR_NO_ERROR) && (!PeerClosed_B))
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      mSocketPollServerStatistic_X.NbDispatchError_U64++;
+    }
+    if (PeerClosed_B)
+    {
+      if (Unregister(rpsSocketSession->NativeSocketHandle(), rpsSocketSession.get()) == BOF_ERR_NO_ERROR)
+      {
+        {
+          std::lock_guard<std::mutex> Lock(mMtx);
+          mSocketPollServerStatistic_X.NbPeerClosed_U64++;
+        }
+        if (mpIBofSocketSessionFactory)
+        {
+          mpIBofSocketSessionFactory->V_CloseSession(rpsSocketSession);
+        }
+      }
+    }
+  }
+
+  //Called by the poll thread when it no longer holds any entry pointer: destroys the entries removed since the last call
+  void ReclaimRetiredPollEntry(uint32_t _NbStale_U32)
+  {
+    {
+      std::lock_guard<std::mutex> Lock(mMtx);
+      mSocketPollServerStatistic_X.NbStaleEvent_U64 += _NbStale_U32;
+      mPollEntryTable.ExtractRetired(mRetiredPollEntryCollection);
+    }
+    //Outside of the lock: the last reference to a session may be released here
+    mRetiredPollEntryCollection.clear();
+  }
+
+  BOFERR V_OnProcessing() override
+  {
+    uint32_t NbEvent_U32;
+
+    if (!IsThreadLoopMustExit())
+    {
+      Poll(mSocketPollServerParam_X.PollTimeoutInMs_U32, NbEvent_U32);
+    }
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+END_BOF_NAMESPACE()
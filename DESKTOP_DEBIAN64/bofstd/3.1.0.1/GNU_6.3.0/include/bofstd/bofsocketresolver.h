@@ -0,0 +1,961 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the asynchronous host name resolver with its ttl
+ * cache, negative cache and coalescing of identical lookups.
+ *
+ * Name:        bofsocketresolver.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         The system lookup reads the hosts file, then queries the dns with
+ *              res_nquery to get the record ttl, then falls back to getaddrinfo
+ *              (other nss sources) with DefaultTtlInMs_U32. Always link with
+ *              -lresolv: ns_initparse/ns_parserr are only in libresolv, even
+ *              with glibc 2.34 and later.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocketos.h>
+#include <bofstd/bofsystem.h>
+#include <bofstd/bofstringformatter.h>
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#if !defined(_WIN32)
+#include <arpa/inet.h>
+#include <arpa/nameser.h>
+#include <netdb.h>
+#include <resolv.h>
+#include <strings.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Structure **************************************************************/
+
+/*!
+ * Lookup backend: fills _rAddressCollection (port 0) and _rTtlInMs_U32 (0 means DefaultTtlInMs_U32). Called from a
+ * resolver worker thread, it can block.
+ */
+typedef std::function<BOFERR(const std::string &_rHostName_S, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInMs_U32)> BOF_SOCKET_RESOLVER_LOOKUP;
+
+struct BOF_SOCKET_RESOLVER_PARAM
+{
+  uint32_t                   NbWorker_U32;          /*! Threads running the lookups: as many cold lookups can be in progress at once */
+  uint32_t                   MaxEntry_U32;          /*! Cache size, the least recently used entry is evicted when it is full */
+  uint32_t                   DefaultTtlInMs_U32;    /*! Validity of a positive answer when the lookup does not give a ttl */
+  uint32_t                   MinTtlInMs_U32;        /*! Ttl given by the lookup are clamped to [MinTtlInMs_U32, MaxTtlInMs_U32] */
+  uint32_t                   MaxTtlInMs_U32;
+  uint32_t                   NegativeTtlInMs_U32;   /*! Validity of a failed lookup: the next ones fail at once instead of hitting the dns again */
+  uint32_t                   ServeStaleInMs_U32;    /*! When a refresh fails, the last good answer is still given if it expired less than this ago (0: never) */
+  BOF_SOCKET_RESOLVER_LOOKUP Lookup;                /*! nullptr: Bof_SocketResolverSystemLookup (hosts file, dns with ttl, getaddrinfo) */
+
+  BOF_SOCKET_RESOLVER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbWorker_U32 = 2;
+    MaxEntry_U32 = 1024;
+    DefaultTtlInMs_U32 = 60000;
+    MinTtlInMs_U32 = 1000;
+    MaxTtlInMs_U32 = 3600000;
+    NegativeTtlInMs_U32 = 5000;
+    ServeStaleInMs_U32 = 30000;
+    Lookup = nullptr;
+  }
+};
+
+struct BOF_SOCKET_RESOLVER_ANSWER
+{
+  BOFERR                          Sts_E;
+  std::vector<BOF_SOCKET_ADDRESS> AddressCollection;   /*! Port is 0 */
+  bool                            Stale_B;             /*! Last good answer given because its refresh failed */
+
+  BOF_SOCKET_RESOLVER_ANSWER()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Sts_E = BOF_ERR_NO_ERROR;
+    AddressCollection.clear();
+    Stale_B = false;
+  }
+};
+
+struct BOF_SOCKET_RESOLVER_STATISTIC
+{
+  uint64_t NbRequest_U64;
+  uint64_t NbLiteral_U64;        /*! Numeric addresses answered without cache nor lookup */
+  uint64_t NbHit_U64;            /*! Answered from a valid positive entry */
+  uint64_t NbNegativeHit_U64;    /*! Answered from a valid negative entry */
+  uint64_t NbCoalesced_U64;      /*! Joined a lookup already in progress for the same name */
+  uint64_t NbMiss_U64;           /*! Started a lookup */
+  uint64_t NbLookupError_U64;
+  uint64_t NbStaleAnswer_U64;
+  uint64_t NbEviction_U64;
+  uint64_t NbCancel_U64;         /*! Lookups not run because the resolver was destroyed */
+  uint32_t NbEntry_U32;
+  uint32_t MaxLookupInMs_U32;
+
+  BOF_SOCKET_RESOLVER_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbRequest_U64 = 0;
+    NbLiteral_U64 = 0;
+    NbHit_U64 = 0;
+    NbNegativeHit_U64 = 0;
+    NbCoalesced_U64 = 0;
+    NbMiss_U64 = 0;
+    NbLookupError_U64 = 0;
+    NbStaleAnswer_U64 = 0;
+    NbEviction_U64 = 0;
+    NbCancel_U64 = 0;
+    NbEntry_U32 = 0;
+    MaxLookupInMs_U32 = 0;
+  }
+};
+
+/*** Function ***************************************************************/
+
+/*!
+ * Description
+ * Converts a numeric ipv4 or ipv6 address (without port nor brackets) into a BOF_SOCKET_ADDRESS with a port of 0.
+ *
+ * Parameters
+ * _rIpAddress_S: Specifies the numeric address
+ * _rAddress_X:   Returns the address
+ *
+ * Returns
+ * bool: true if _rIpAddress_S is a numeric address
+ */
+inline bool Bof_SocketResolverParseLiteral(const std::string &_rIpAddress_S, BOF_SOCKET_ADDRESS &_rAddress_X)
+{
+  bool Rts_B = false;
+
+  _rAddress_X.Reset();
+#if !defined(_WIN32)
+  if (inet_pton(AF_INET, _rIpAddress_S.c_str(), &_rAddress_X.IpV4Address_X.sin_addr) == 1)
+  {
+    _rAddress_X.IpV4Address_X.sin_family = AF_INET;
+    Rts_B = true;
+  }
+  else if (inet_pton(AF_INET6, _rIpAddress_S.c_str(), &_rAddress_X.IpV6Address_X.sin6_addr) == 1)
+  {
+    _rAddress_X.IpV6_B = true;
+    _rAddress_X.IpV6Address_X.sin6_family = AF_INET6;
+    Rts_B = true;
+  }
+#endif
+  return Rts_B;
+}
+
+inline void Bof_SocketResolverSetPort(uint16_t _Port_U16, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection)
+{
+  uint32_t i_U32;
+
+  for (i_U32 = 0; i_U32 < _rAddressCollection.size(); i_U32++)
+  {
+    if (_rAddressCollection[i_U32].IpV6_B)
+    {
+      _rAddressCollection[i_U32].IpV6Address_X.sin6_port = htons(_Port_U16);
+    }
+    else
+    {
+      _rAddressCollection[i_U32].IpV4Address_X.sin_port = htons(_Port_U16);
+    }
+  }
+}
+
+/*!
+ * Description
+ * Lookup backend using getaddrinfo (every source configured in nsswitch.conf). Duplicated addresses (one per socket
+ * type) are removed, ipv4 addresses come first.
+ *
+ * Parameters
+ * _rHostName_S: Specifies the name to resolve
+ * _rAddressCollection: Returns the addresses
+ * _rTtlInMs_U32: Returns 0: getaddrinfo does not give the record ttl
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_NOT_FOUND if the name does not exist,
+ * BOF_ERR_EAGAIN if the name server could not be reached.
+ */
+inline BOFERR Bof_SocketResolverGetAddrInfoLookup(const std::string &_rHostName_S, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInMs_U32)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if !defined(_WIN32)
+  struct addrinfo Hint_X, *pResult_X, *pAddrInfo_X;
+  BOF_SOCKET_ADDRESS Address_X;
+  std::vector<BOF_SOCKET_ADDRESS> IpV6Collection;
+  bool Duplicated_B;
+  uint32_t i_U32;
+  int Sts_i;
+
+  _rAddressCollection.clear();
+  _rTtlInMs_U32 = 0;
+  memset(&Hint_X, 0, sizeof(Hint_X));
+  Hint_X.ai_family = AF_UNSPEC;
+  Hint_X.ai_socktype = SOCK_STREAM;
+  Hint_X.ai_flags = AI_ADDRCONFIG;
+  pResult_X = nullptr;
+  Sts_i = getaddrinfo(_rHostName_S.c_str(), nullptr, &Hint_X, &pResult_X);
+  if (Sts_i == 0)
+  {
+    for (pAddrInfo_X = pResult_X; pAddrInfo_X; pAddrInfo_X = pAddrInfo_X->ai_next)
+    {
+      Address_X.Reset();
+      if ((pAddrInfo_X->ai_family == AF_INET) && (pAddrInfo_X->ai_addrlen >= sizeof(Address_X.IpV4Address_X)))
+      {
+        memcpy(&Address_X.IpV4Address_X, pAddrInfo_X->ai_addr, sizeof(Address_X.IpV4Address_X));
+        Duplicated_B = false;
+        for (i_U32 = 0; i_U32 < _rAddressCollection.size(); i_U32++)
+        {
+          Duplicated_B |= (_rAddressCollection[i_U32].IpV4Address_X.sin_addr.s_addr == Address_X.IpV4Address_X.sin_addr.s_addr);
+        }
+        if (!Duplicated_B)
+        {
+          _rAddressCollection.push_back(Address_X);
+        }
+      }
+      else if ((pAddrInfo_X->ai_family == AF_INET6) && (pAddrInfo_X->ai_addrlen >= sizeof(Address_X.IpV6Address_X)))
+      {
+        Address_X.IpV6_B = true;
+        memcpy(&Address_X.IpV6Address_X, pAddrInfo_X->ai_addr, sizeof(Address_X.IpV6Address_X));
+        Duplicated_B = false;
+        for (i_U32 = 0; i_U32 < IpV6Collection.size(); i_U32++)
+        {
+          Duplicated_B |= (memcmp(&IpV6Collection[i_U32].IpV6Address_X.sin6_addr, &Address_X.IpV6Address_X.sin6_addr, sizeof(Address_X.IpV6Address_X.sin6_addr)) == 0);
+        }
+        if (!Duplicated_B)
+        {
+          IpV6Collection.push_back(Address_X);
+        }
+      }
+    }
+    freeaddrinfo(pResult_X);
+    _rAddressCollection.insert(_rAddressCollection.end(), IpV6Collection.begin(), IpV6Collection.end());
+    Rts_E = _rAddressCollection.size() ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_FOUND;
+  }
+  else
+  {
+    switch (Sts_i)
+    {
+      case EAI_NONAME:
+#if defined(EAI_NODATA) && (EAI_NODATA != EAI_NONAME)
+      case EAI_NODATA:
+#endif
+        Rts_E = BOF_ERR_NOT_FOUND;
+        break;
+      case EAI_AGAIN:
+        Rts_E = BOF_ERR_EAGAIN;
+        break;
+      case EAI_MEMORY:
+        Rts_E = BOF_ERR_ENOMEM;
+        break;
+      case EAI_SYSTEM:
+        Rts_E = static_cast<BOFERR>(errno);
+        break;
+      default:
+        Rts_E = BOF_ERR_NOT_AVAILABLE;
+        break;
+    }
+  }
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Builds a lookup backend reading a file in the hosts(5) format ("address name [alias...]", '#' starts a comment).
+ * The file is read at each lookup so that a test can change it between two of them. Names are case insensitive.
+ *
+ * Parameters
+ * _rPath_S:     Specifies the hosts file
+ * _TtlInMs_U32: Specifies the ttl given to the answers (0: DefaultTtlInMs_U32 of the resolver)
+ *
+ * Returns
+ * BOF_SOCKET_RESOLVER_LOOKUP: The backend, it returns BOF_ERR_NOT_FOUND for a missing name and BOF_ERR_ENOENT if the
+ * file cannot be read.
+ */
+inline BOF_SOCKET_RESOLVER_LOOKUP Bof_SocketResolverHostsFileLookup(const std::string &_rPath_S, uint32_t _TtlInMs_U32)
+{
+  return [_rPath_S, _TtlInMs_U32](const std::string &_rHostName_S, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInMs_U32) -> BOFERR {
+    BOFERR Rts_E = BOF_ERR_ENOENT;
+    std::ifstream HostsFile(_rPath_S);
+    std::string Line_S, Ip_S, Name_S;
+    BOF_SOCKET_ADDRESS Address_X;
+    size_t Pos;
+    bool Match_B;
+
+    _rAddressCollection.clear();
+    _rTtlInMs_U32 = _TtlInMs_U32;
+    if (HostsFile.is_open())
+    {
+      while (std::getline(HostsFile, Line_S))
+      {
+        Pos = Line_S.find('#');
+        if (Pos != std::string::npos)
+        {
+          Line_S.resize(Pos);
+        }
+        std::istringstream LineStream(Line_S);
+        if ((LineStream >> Ip_S) && (Bof_SocketResolverParseLiteral(Ip_S, Address_X)))
+        {
+          Match_B = false;
+          while ((!Match_B) && (LineStream >> Name_S))
+          {
+            Match_B = (strcasecmp(Name_S.c_str(), _rHostName_S.c_str()) == 0);
+          }
+          if (Match_B)
+          {
+            _rAddressCollection.push_back(Address_X);
+          }
+        }
+      }
+      Rts_E = _rAddressCollection.size() ? BOF_ERR_NO_ERROR : BOF_ERR_NOT_FOUND;
+    }
+    return Rts_E;
+  };
+}
+
+#if !defined(_WIN32)
+//Runs one res_nquery of _Type_i (ns_t_a or ns_t_aaaa): appends its addresses and lowers _rTtlInSec_U32 to the smallest ttl of the answer records (cname included)
+inline BOFERR Bof_SocketResolverDnsQuery(res_state _pResState_X, const std::string &_rHostName_S, int _Type_i, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInSec_U32)
+{
+  BOFERR Rts_E;
+  std::vector<uint8_t> Answer(4096);
+  BOF_SOCKET_ADDRESS Address_X;
+  ns_msg Msg_X;
+  ns_rr Rr_X;
+  int Len_i, i_i;
+
+  Len_i = res_nquery(_pResState_X, _rHostName_S.c_str(), ns_c_in, _Type_i, Answer.data(), static_cast<int>(Answer.size()));
+  if (Len_i > static_cast<int>(Answer.size()))
+  {
+    //Answer larger than the buffer (tcp fallback): ask again with the right size
+    Answer.resize(Len_i);
+    Len_i = res_nquery(_pResState_X, _rHostName_S.c_str(), ns_c_in, _Type_i, Answer.data(), static_cast<int>(Answer.size()));
+  }
+  if (Len_i < 0)
+  {
+    switch (_pResState_X->res_h_errno)
+    {
+      case HOST_NOT_FOUND:
+        Rts_E = BOF_ERR_NOT_FOUND;
+        break;
+      case NO_DATA:
+        //The name exists without record of this type
+        Rts_E = BOF_ERR_NO_ERROR;
+        break;
+      case TRY_AGAIN:
+        Rts_E = BOF_ERR_EAGAIN;
+        break;
+      default:
+        Rts_E = BOF_ERR_NOT_AVAILABLE;
+        break;
+    }
+  }
+  else if ((Len_i > static_cast<int>(Answer.size())) || (ns_initparse(Answer.data(), Len_i, &Msg_X) != 0))
+  {
+    Rts_E = BOF_ERR_FORMAT;
+  }
+  else
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+    for (i_i = 0; i_i < ns_msg_count(Msg_X, ns_s_an); i_i++)
+    {
+      if (ns_parserr(&Msg_X, ns_s_an, i_i, &Rr_X) == 0)
+      {
+        _rTtlInSec_U32 = std::min(_rTtlInSec_U32, static_cast<uint32_t>(ns_rr_ttl(Rr_X)));
+        Address_X.Reset();
+        if ((ns_rr_type(Rr_X) == ns_t_a) && (ns_rr_rdlen(Rr_X) == sizeof(Address_X.IpV4Address_X.sin_addr)))
+        {
+          Address_X.IpV4Address_X.sin_family = AF_INET;
+          memcpy(&Address_X.IpV4Address_X.sin_addr, ns_rr_rdata(Rr_X), sizeof(Address_X.IpV4Address_X.sin_addr));
+          _rAddressCollection.push_back(Address_X);
+        }
+        else if ((ns_rr_type(Rr_X) == ns_t_aaaa) && (ns_rr_rdlen(Rr_X) == sizeof(Address_X.IpV6Address_X.sin6_addr)))
+        {
+          Address_X.IpV6_B = true;
+          Address_X.IpV6Address_X.sin6_family = AF_INET6;
+          memcpy(&Address_X.IpV6Address_X.sin6_addr, ns_rr_rdata(Rr_X), sizeof(Address_X.IpV6Address_X.sin6_addr));
+          _rAddressCollection.push_back(Address_X);
+        }
+      }
+    }
+  }
+  return Rts_E;
+}
+#endif
+
+/*!
+ * Description
+ * Lookup backend querying the dns servers of resolv.conf with res_nquery (a and aaaa records, ipv4 addresses first).
+ * Unlike getaddrinfo it gives the ttl of the answer: the smallest one of its records, cname included. The hosts file
+ * and the other nss sources are not used.
+ *
+ * Parameters
+ * _rHostName_S: Specifies the name to resolve
+ * _rAddressCollection: Returns the addresses
+ * _rTtlInMs_U32: Returns the record ttl (a record ttl of 0 gives 1 ms: the resolver clamps it to MinTtlInMs_U32)
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_NOT_FOUND if the name does not exist,
+ * BOF_ERR_EAGAIN if the name server could not be reached, BOF_ERR_NOT_AVAILABLE if there is no usable name server.
+ */
+inline BOFERR Bof_SocketResolverDnsLookup(const std::string &_rHostName_S, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInMs_U32)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if !defined(_WIN32)
+  struct __res_state ResState_X;
+  BOFERR StsV6_E;
+  uint32_t TtlInSec_U32 = 0xFFFFFFFF;
+
+  _rAddressCollection.clear();
+  _rTtlInMs_U32 = 0;
+  memset(&ResState_X, 0, sizeof(ResState_X));
+  Rts_E = BOF_ERR_NOT_AVAILABLE;
+  if (res_ninit(&ResState_X) == 0)
+  {
+    Rts_E = Bof_SocketResolverDnsQuery(&ResState_X, _rHostName_S, ns_t_a, _rAddressCollection, TtlInSec_U32);
+    if (Rts_E != BOF_ERR_NOT_FOUND)
+    {
+      StsV6_E = Bof_SocketResolverDnsQuery(&ResState_X, _rHostName_S, ns_t_aaaa, _rAddressCollection, TtlInSec_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = StsV6_E;
+      }
+    }
+    if (_rAddressCollection.size())
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      _rTtlInMs_U32 = (TtlInSec_U32 == 0) ? 1 : (std::min(TtlInSec_U32, static_cast<uint32_t>(0xFFFFFFFF / 1000)) * 1000);
+    }
+    else if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_NOT_FOUND;
+    }
+    res_nclose(&ResState_X);
+  }
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Default lookup backend, in the order of the usual "hosts: files dns" of nsswitch.conf: the hosts file, then
+ * Bof_SocketResolverDnsLookup so that the cache honours the record ttl. A name unknown to both (or a host without
+ * name server) goes to Bof_SocketResolverGetAddrInfoLookup for the other nss sources (myhostname, mdns...), which
+ * costs a second dns query for a missing name. Answers which do not come from the dns use DefaultTtlInMs_U32.
+ *
+ * Parameters
+ * _rHostName_S: Specifies the name to resolve
+ * _rAddressCollection: Returns the addresses
+ * _rTtlInMs_U32: Returns the record ttl for a dns answer, 0 otherwise
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_NOT_FOUND if the name does not exist,
+ * BOF_ERR_EAGAIN if the name server could not be reached.
+ */
+inline BOFERR Bof_SocketResolverSystemLookup(const std::string &_rHostName_S, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection, uint32_t &_rTtlInMs_U32)
+{
+  BOFERR Rts_E;
+
+  Rts_E = Bof_SocketResolverHostsFileLookup("/etc/hosts", 0)(_rHostName_S, _rAddressCollection, _rTtlInMs_U32);
+  if (Rts_E != BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_SocketResolverDnsLookup(_rHostName_S, _rAddressCollection, _rTtlInMs_U32);
+    if ((Rts_E == BOF_ERR_NOT_FOUND) || (Rts_E == BOF_ERR_NOT_AVAILABLE) || (Rts_E == BOF_ERR_NOT_SUPPORTED))
+    {
+      Rts_E = Bof_SocketResolverGetAddrInfoLookup(_rHostName_S, _rAddressCollection, _rTtlInMs_U32);
+    }
+  }
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Asynchronous host name resolver with cache
+ *
+ * Description
+ * ResolveAsync never blocks: the answer comes from the cache, from a lookup already in progress for the same name
+ * (all the callers share one std::shared_future, so a reconnect storm costs one lookup per name) or from a new lookup
+ * run by one of the NbWorker_U32 worker threads.
+ * Positive answers are kept for the ttl given by the lookup (the dns record ttl with the default backend, else
+ * DefaultTtlInMs_U32), failed lookups for NegativeTtlInMs_U32. When the refresh of an expired name
+ * fails (network blip) the previous addresses are still given for ServeStaleInMs_U32 with Stale_B set.
+ * Numeric addresses are answered at once without touching the cache. The lookup backend is replaceable (hosts file,
+ * stub for tests) through BOF_SOCKET_RESOLVER_PARAM::Lookup.
+ * Bof_UrlAddressToSocketAddressCollection keeps its synchronous behaviour: callers which must not block use this class.
+ *
+ * See Also
+ * Bof_UrlAddressToSocketAddressCollection, Bof_SocketResolverHostsFileLookup
+ */
+class BofSocketResolver
+{
+private:
+  struct CACHE_ENTRY
+  {
+    std::shared_future<BOF_SOCKET_RESOLVER_ANSWER> Answer;
+    bool                                           Pending_B;
+    bool                                           Positive_B;
+    uint32_t                                       Start_U32;            //Answer validity: [Start_U32, Start_U32 + ValidityInMs_U32[
+    uint32_t                                       ValidityInMs_U32;
+    uint32_t                                       LastUse_U32;
+    std::vector<BOF_SOCKET_ADDRESS>                GoodAddressCollection; //Last positive answer, for stale serving
+    uint32_t                                       GoodStart_U32;
+    uint32_t                                       GoodValidityInMs_U32;
+
+    CACHE_ENTRY() : Pending_B(false), Positive_B(false), Start_U32(0), ValidityInMs_U32(0), LastUse_U32(0), GoodStart_U32(0), GoodValidityInMs_U32(0)
+    {
+    }
+  };
+  struct LOOKUP_JOB
+  {
+    std::string                                           HostName_S;
+    std::shared_ptr<std::promise<BOF_SOCKET_RESOLVER_ANSWER>> psAnswer;
+  };
+
+  BOF_SOCKET_RESOLVER_PARAM          mResolverParam_X;
+  BOFERR                             mErrorCode_E = BOF_ERR_INIT;
+  BOF_MUTEX                          mMtx_X;               //Protects everything below
+  BOF_SEMAPHORE                      mJobSem_X;            //One count per job pushed in mJobCollection, plus one per worker at exit
+  bool                               mStop_B = false;
+  std::map<std::string, CACHE_ENTRY> mCacheCollection;
+  std::deque<LOOKUP_JOB>             mJobCollection;
+  BOF_SOCKET_RESOLVER_STATISTIC      mStatistic_X;
+  std::vector<std::thread>           mWorkerCollection;
+
+public:
+  BofSocketResolver(const BOF_SOCKET_RESOLVER_PARAM &_rResolverParam_X) : mResolverParam_X(_rResolverParam_X)
+  {
+    uint32_t i_U32;
+
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mResolverParam_X.NbWorker_U32) && (mResolverParam_X.MaxEntry_U32) && (mResolverParam_X.MinTtlInMs_U32 <= mResolverParam_X.MaxTtlInMs_U32))
+    {
+      if (!mResolverParam_X.Lookup)
+      {
+        mResolverParam_X.Lookup = Bof_SocketResolverSystemLookup;
+      }
+      mErrorCode_E = Bof_CreateMutex("BofSocketResolver", true, true, mMtx_X);
+      if (mErrorCode_E == BOF_ERR_NO_ERROR)
+      {
+        mErrorCode_E = Bof_CreateSemaphore("BofSocketResolver", 0, mJobSem_X);
+      }
+      if (mErrorCode_E == BOF_ERR_NO_ERROR)
+      {
+        for (i_U32 = 0; i_U32 < mResolverParam_X.NbWorker_U32; i_U32++)
+        {
+          mWorkerCollection.emplace_back(&BofSocketResolver::Worker, this);
+        }
+      }
+    }
+  }
+  virtual ~BofSocketResolver()
+  {
+    std::deque<LOOKUP_JOB> JobCollection;
+    BOF_SOCKET_RESOLVER_ANSWER Answer_X;
+    uint32_t i_U32;
+
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      mStop_B = true;
+      JobCollection.swap(mJobCollection);
+      mStatistic_X.NbCancel_U64 += JobCollection.size();
+      Bof_UnlockMutex(mMtx_X);
+    }
+    for (i_U32 = 0; i_U32 < mWorkerCollection.size(); i_U32++)
+    {
+      Bof_SignalSemaphore(mJobSem_X);
+    }
+    for (i_U32 = 0; i_U32 < mWorkerCollection.size(); i_U32++)
+    {
+      mWorkerCollection[i_U32].join();
+    }
+    Answer_X.Sts_E = BOF_ERR_CANCEL;
+    for (i_U32 = 0; i_U32 < JobCollection.size(); i_U32++)
+    {
+      JobCollection[i_U32].psAnswer->set_value(Answer_X);
+    }
+    Bof_DestroySemaphore(mJobSem_X);
+    Bof_DestroyMutex(mMtx_X);
+  }
+  BofSocketResolver &operator=(const BofSocketResolver &) = delete; // Disallow copying
+  BofSocketResolver(const BofSocketResolver &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  /*!
+   * Description
+   * Starts the resolution of a host name or numeric address. Can be called from any thread, never blocks.
+   *
+   * Parameters
+   * _rHostName_S: Specifies the host name or numeric address
+   *
+   * Returns
+   * std::shared_future<BOF_SOCKET_RESOLVER_ANSWER>: Gives the answer, ready at once for a numeric address, a cache hit
+   * or an invalid resolver. The addresses have a port of 0, see Bof_SocketResolverSetPort.
+   */
+  std::shared_future<BOF_SOCKET_RESOLVER_ANSWER> ResolveAsync(const std::string &_rHostName_S)
+  {
+    std::shared_future<BOF_SOCKET_RESOLVER_ANSWER> Rts;
+    BOF_SOCKET_RESOLVER_ANSWER Answer_X;
+    BOF_SOCKET_ADDRESS Address_X;
+    LOOKUP_JOB Job_X;
+    bool Start_B = false;
+
+    if (mErrorCode_E != BOF_ERR_NO_ERROR)
+    {
+      Answer_X.Sts_E = mErrorCode_E;
+      Rts = S_ReadyAnswer(Answer_X);
+    }
+    else if (_rHostName_S.empty())
+    {
+      Answer_X.Sts_E = BOF_ERR_EINVAL;
+      Rts = S_ReadyAnswer(Answer_X);
+    }
+    else if (Bof_SocketResolverParseLiteral(_rHostName_S, Address_X))
+    {
+      Answer_X.AddressCollection.push_back(Address_X);
+      Rts = S_ReadyAnswer(Answer_X);
+      if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+      {
+        mStatistic_X.NbRequest_U64++;
+        mStatistic_X.NbLiteral_U64++;
+        Bof_UnlockMutex(mMtx_X);
+      }
+    }
+    else if (Bof_LockMutex(mMtx_X) != BOF_ERR_NO_ERROR)
+    {
+      Answer_X.Sts_E = BOF_ERR_LOCK;
+      Rts = S_ReadyAnswer(Answer_X);
+    }
+    else
+    {
+      std::map<std::string, CACHE_ENTRY>::iterator It;
+
+      mStatistic_X.NbRequest_U64++;
+      It = mCacheCollection.find(_rHostName_S);
+      if (It == mCacheCollection.end())
+      {
+        EvictIfFull();
+        if (mCacheCollection.size() < mResolverParam_X.MaxEntry_U32)
+        {
+          It = mCacheCollection.emplace(_rHostName_S, CACHE_ENTRY()).first;
+          Start_B = true;
+        }
+        else
+        {
+          //Every entry has a lookup in progress
+          Answer_X.Sts_E = BOF_ERR_FULL;
+          Rts = S_ReadyAnswer(Answer_X);
+        }
+      }
+      else if (It->second.Pending_B)
+      {
+        mStatistic_X.NbCoalesced_U64++;
+        Rts = It->second.Answer;
+      }
+      else if (Bof_ElapsedMsTime(It->second.Start_U32) < It->second.ValidityInMs_U32)
+      {
+        if (It->second.Positive_B)
+        {
+          mStatistic_X.NbHit_U64++;
+        }
+        else
+        {
+          mStatistic_X.NbNegativeHit_U64++;
+        }
+        Rts = It->second.Answer;
+      }
+      else
+      {
+        Start_B = true;
+      }
+      if (Start_B)
+      {
+        mStatistic_X.NbMiss_U64++;
+        Job_X.HostName_S = _rHostName_S;
+        Job_X.psAnswer = std::make_shared<std::promise<BOF_SOCKET_RESOLVER_ANSWER>>();
+        It->second.Answer = Job_X.psAnswer->get_future().share();
+        It->second.Pending_B = true;
+        Rts = It->second.Answer;
+        mJobCollection.push_back(std::move(Job_X));
+      }
+      if (It != mCacheCollection.end())
+      {
+        It->second.LastUse_U32 = Bof_GetMsTickCount();
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+    if (Start_B)
+    {
+      Bof_SignalSemaphore(mJobSem_X);
+    }
+    return Rts;
+  }
+
+  /*!
+   * Description
+   * Resolves a host name or numeric address and waits for the answer.
+   *
+   * Parameters
+   * _rHostName_S:    Specifies the host name or numeric address
+   * _Port_U16:       Specifies the port to set in the returned addresses
+   * _TimeoutInMs_U32: Specifies the maximum wait. The lookup goes on after a timeout and will fill the cache.
+   * _rAddressCollection: Returns the addresses
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_ETIMEDOUT or the lookup error otherwise
+   */
+  BOFERR Resolve(const std::string &_rHostName_S, uint16_t _Port_U16, uint32_t _TimeoutInMs_U32, std::vector<BOF_SOCKET_ADDRESS> &_rAddressCollection)
+  {
+    BOFERR Rts_E = BOF_ERR_ETIMEDOUT;
+    std::shared_future<BOF_SOCKET_RESOLVER_ANSWER> Answer;
+
+    _rAddressCollection.clear();
+    Answer = ResolveAsync(_rHostName_S);
+    if (Answer.wait_for(std::chrono::milliseconds(_TimeoutInMs_U32)) == std::future_status::ready)
+    {
+      Rts_E = Answer.get().Sts_E;
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        _rAddressCollection = Answer.get().AddressCollection;
+        Bof_SocketResolverSetPort(_Port_U16, _rAddressCollection);
+      }
+    }
+    return Rts_E;
+  }
+
+  //Forgets one name (empty: every name). Lookups in progress are kept and will complete normally.
+  void Flush(const std::string &_rHostName_S)
+  {
+    std::map<std::string, CACHE_ENTRY>::iterator It;
+
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      It = _rHostName_S.empty() ? mCacheCollection.begin() : mCacheCollection.find(_rHostName_S);
+      while (It != mCacheCollection.end())
+      {
+        if (It->second.Pending_B)
+        {
+          It++;
+        }
+        else
+        {
+          It = mCacheCollection.erase(It);
+        }
+        if (!_rHostName_S.empty())
+        {
+          It = mCacheCollection.end();
+        }
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+
+  BOF_SOCKET_RESOLVER_STATISTIC SocketResolverStatistic()
+  {
+    BOF_SOCKET_RESOLVER_STATISTIC Rts_X;
+
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      Rts_X = mStatistic_X;
+      Rts_X.NbEntry_U32 = static_cast<uint32_t>(mCacheCollection.size());
+      Bof_UnlockMutex(mMtx_X);
+    }
+    return Rts_X;
+  }
+  void ResetSocketResolverStatistic()
+  {
+    if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+    {
+      mStatistic_X.Reset();
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+  std::string SocketResolverDebugInfo()
+  {
+    BOF_SOCKET_RESOLVER_STATISTIC Statistic_X = SocketResolverStatistic();
+
+    return Bof_Sprintf("Resolver Entry %u Req %lld Literal %lld Hit %lld NegHit %lld Coalesced %lld Miss %lld LookupErr %lld Stale %lld Evict %lld Cancel %lld MaxLookup %u ms",
+                       Statistic_X.NbEntry_U32, Statistic_X.NbRequest_U64, Statistic_X.NbLiteral_U64, Statistic_X.NbHit_U64, Statistic_X.NbNegativeHit_U64, Statistic_X.NbCoalesced_U64,
+                       Statistic_X.NbMiss_U64, Statistic_X.NbLookupError_U64, Statistic_X.NbStaleAnswer_U64, Statistic_X.NbEviction_U64, Statistic_X.NbCancel_U64, Statistic_X.MaxLookupInMs_U32);
+  }
+
+private:
+  static std::shared_future<BOF_SOCKET_RESOLVER_ANSWER> S_ReadyAnswer(const BOF_SOCKET_RESOLVER_ANSWER &_rAnswer_X)
+  {
+    std::promise<BOF_SOCKET_RESOLVER_ANSWER> Answer;
+
+    Answer.set_value(_rAnswer_X);
+    return Answer.get_future().share();
+  }
+
+  //mMtx_X is locked: drops the expired entries, then the least recently used one if the cache is still full
+  void EvictIfFull()
+  {
+    std::map<std::string, CACHE_ENTRY>::iterator It, Lru;
+    uint32_t Age_U32, MaxAge_U32;
+
+    if (mCacheCollection.size() >= mResolverParam_X.MaxEntry_U32)
+    {
+      Lru = mCacheCollection.end();
+      MaxAge_U32 = 0;
+      It = mCacheCollection.begin();
+      while (It != mCacheCollection.end())
+      {
+        if (It->second.Pending_B)
+        {
+          It++;
+        }
+        else if (Bof_ElapsedMsTime(It->second.Start_U32) >= It->second.ValidityInMs_U32 + (It->second.Positive_B ? mResolverParam_X.ServeStaleInMs_U32 : 0))
+        {
+          mStatistic_X.NbEviction_U64++;
+          It = mCacheCollection.erase(It);
+        }
+        else
+        {
+          Age_U32 = Bof_ElapsedMsTime(It->second.LastUse_U32);
+          if ((Lru == mCacheCollection.end()) || (Age_U32 >= MaxAge_U32))
+          {
+            Lru = It;
+            MaxAge_U32 = Age_U32;
+          }
+          It++;
+        }
+      }
+      if ((mCacheCollection.size() >= mResolverParam_X.MaxEntry_U32) && (Lru != mCacheCollection.end()))
+      {
+        mStatistic_X.NbEviction_U64++;
+        mCacheCollection.erase(Lru);
+      }
+    }
+  }
+
+  void Worker()
+  {
+    LOOKUP_JOB Job_X;
+    BOF_SOCKET_RESOLVER_ANSWER Answer_X;
+    std::map<std::string, CACHE_ENTRY>::iterator It;
+    uint32_t TtlInMs_U32, Start_U32, Elapsed_U32;
+    bool Run_B = true, Job_B;
+
+    while (Run_B)
+    {
+      //The timeout only bounds the wait: the queue is checked after a timeout as after a signal
+      Bof_WaitForSemaphore(mJobSem_X, 1000);
+      Job_B = false;
+      if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+      {
+        Run_B = !mStop_B;
+        if ((Run_B) && (!mJobCollection.empty()))
+        {
+          Job_B = true;
+          Job_X = std::move(mJobCollection.front());
+          mJobCollection.pop_front();
+        }
+        Bof_UnlockMutex(mMtx_X);
+      }
+      if (Job_B)
+      {
+        Answer_X.Reset();
+        TtlInMs_U32 = 0;
+        Start_U32 = Bof_GetMsTickCount();
+        Answer_X.Sts_E = mResolverParam_X.Lookup(Job_X.HostName_S, Answer_X.AddressCollection, TtlInMs_U32);
+        Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+        if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+        {
+          if (Elapsed_U32 > mStatistic_X.MaxLookupInMs_U32)
+          {
+            mStatistic_X.MaxLookupInMs_U32 = Elapsed_U32;
+          }
+          //A pending entry is never evicted nor flushed
+          It = mCacheCollection.find(Job_X.HostName_S);
+          if (It != mCacheCollection.end())
+          {
+            UpdateEntry(It->second, TtlInMs_U32, Answer_X);
+          }
+          Bof_UnlockMutex(mMtx_X);
+        }
+        Job_X.psAnswer->set_value(Answer_X);
+        Job_X.psAnswer.reset();
+      }
+    }
+  }
+
+  //mMtx_X is locked: stores the lookup result and turns it into a stale answer if needed
+  void UpdateEntry(CACHE_ENTRY &_rEntry_X, uint32_t _TtlInMs_U32, BOF_SOCKET_RESOLVER_ANSWER &_rAnswer_X)
+  {
+    _rEntry_X.Pending_B = false;
+    _rEntry_X.Start_U32 = Bof_GetMsTickCount();
+    if ((_rAnswer_X.Sts_E == BOF_ERR_NO_ERROR) && (_rAnswer_X.AddressCollection.size()))
+    {
+      if (_TtlInMs_U32 == 0)
+      {
+        _TtlInMs_U32 = mResolverParam_X.DefaultTtlInMs_U32;
+      }
+      _rEntry_X.Positive_B = true;
+      _rEntry_X.ValidityInMs_U32 = std::min(std::max(_TtlInMs_U32, mResolverParam_X.MinTtlInMs_U32), mResolverParam_X.MaxTtlInMs_U32);
+      _rEntry_X.GoodAddressCollection = _rAnswer_X.AddressCollection;
+      _rEntry_X.GoodStart_U32 = _rEntry_X.Start_U32;
+      _rEntry_X.GoodValidityInMs_U32 = _rEntry_X.ValidityInMs_U32;
+    }
+    else
+    {
+      mStatistic_X.NbLookupError_U64++;
+      if (_rAnswer_X.Sts_E == BOF_ERR_NO_ERROR)
+      {
+        _rAnswer_X.Sts_E = BOF_ERR_NOT_FOUND;
+      }
+      _rEntry_X.Positive_B = false;
+      _rEntry_X.ValidityInMs_U32 = mResolverParam_X.NegativeTtlInMs_U32;
+      if ((_rEntry_X.GoodAddressCollection.size()) && (Bof_ElapsedMsTime(_rEntry_X.GoodStart_U32) < _rEntry_X.GoodValidityInMs_U32 + mResolverParam_X.ServeStaleInMs_U32))
+      {
+        //Stale answer: given until the next refresh attempt, after NegativeTtlInMs_U32
+        mStatistic_X.NbStaleAnswer_U64++;
+        _rAnswer_X.Sts_E = BOF_ERR_NO_ERROR;
+        _rAnswer_X.AddressCollection = _rEntry_X.GoodAddressCollection;
+        _rAnswer_X.Stale_B = true;
+        _rEntry_X.Positive_B = true;
+      }
+    }
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the dense descriptor indexed session table with
+ * generation counters used by the socket poll server.
+ *
+ * Name:        bofsocketsessiontable.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocketos.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#define BOF_SOCKET_SESSION_TABLE_CHUNK_SHIFT 12                                          /*! 4096 slots per chunk */
+#define BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE  (1 << BOF_SOCKET_SESSION_TABLE_CHUNK_SHIFT)
+#define BOF_SOCKET_SESSION_TABLE_MAX_FD      (1 << 24)                                   /*! Upper bound used when the descriptor limit is unlimited */
+#define BOF_SOCKET_SESSION_TABLE_NO_GENERATION 0                                         /*! Generation of an empty slot */
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Descriptor indexed session table
+ *
+ * Description
+ * Entries are stored in a slot array indexed by the descriptor value, allocated by chunks of 4096 slots when a
+ * descriptor in the range is first inserted, so a lookup is two loads and no tree walk. Each insertion gets a new
+ * generation (never BOF_SOCKET_SESSION_TABLE_NO_GENERATION): a handle made of a descriptor and an old generation
+ * is detected as stale once the descriptor has been closed and re-used.
+ * Insert, Remove, Find and ExtractRetired must be serialized by the caller (writer lock). Lookup can be called
+ * without any lock by one reader thread (the poll thread). To make this possible, a removed entry is not destroyed:
+ * it is retired and the reader destroys the retired entries with ExtractRetired when it no longer holds any pointer
+ * returned by Lookup (between two poll waits).
+ *
+ * See Also
+ * BofSocketPollServer
+ */
+template <typename T>
+class BofSocketSessionTable
+{
+private:
+  struct SLOT
+  {
+    std::atomic<uint32_t> Generation_U32;
+    std::atomic<T *>      pEntry;
+
+    SLOT() : Generation_U32(BOF_SOCKET_SESSION_TABLE_NO_GENERATION), pEntry(nullptr)
+    {
+    }
+  };
+
+  uint32_t                              mNbMaxFd_U32 = 0;
+  uint32_t                              mNbChunk_U32 = 0;
+  std::unique_ptr<std::atomic<SLOT *>[]> mpuChunkCollection;
+  uint32_t                              mGeneration_U32 = 0;
+  uint32_t                              mNbEntry_U32 = 0;
+  std::vector<std::unique_ptr<T>>       mRetiredCollection;
+
+public:
+  /*!
+   * Description
+   * Constructor
+   *
+   * Parameters
+   * _NbMaxFd_U32: Specifies the highest descriptor value + 1 the table can hold. 0 uses the process descriptor limit.
+   */
+  BofSocketSessionTable(uint32_t _NbMaxFd_U32)
+  {
+    uint32_t i_U32;
+#if !defined(_WIN32)
+    struct rlimit Limit_X;
+
+    if ((_NbMaxFd_U32 == 0) && (getrlimit(RLIMIT_NOFILE, &Limit_X) == 0))
+    {
+      //The hard limit as the soft one can be raised later by the process
+      _NbMaxFd_U32 = ((Limit_X.rlim_max == RLIM_INFINITY) || (Limit_X.rlim_max > BOF_SOCKET_SESSION_TABLE_MAX_FD)) ? BOF_SOCKET_SESSION_TABLE_MAX_FD
+                                                                                                                   : static_cast<uint32_t>(Limit_X.rlim_max);
+    }
+#endif
+    if ((_NbMaxFd_U32 == 0) || (_NbMaxFd_U32 > BOF_SOCKET_SESSION_TABLE_MAX_FD))
+    {
+      _NbMaxFd_U32 = BOF_SOCKET_SESSION_TABLE_MAX_FD;
+    }
+    mNbMaxFd_U32 = _NbMaxFd_U32;
+    mNbChunk_U32 = (mNbMaxFd_U32 + BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE - 1) >> BOF_SOCKET_SESSION_TABLE_CHUNK_SHIFT;
+    mpuChunkCollection.reset(new std::atomic<SLOT *>[mNbChunk_U32]);
+    for (i_U32 = 0; i_U32 < mNbChunk_U32; i_U32++)
+    {
+      mpuChunkCollection[i_U32].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+  virtual ~BofSocketSessionTable()
+  {
+    uint32_t i_U32, j_U32;
+    SLOT *pChunk_X;
+
+    for (i_U32 = 0; i_U32 < mNbChunk_U32; i_U32++)
+    {
+      pChunk_X = mpuChunkCollection[i_U32].load(std::memory_order_relaxed);
+      if (pChunk_X)
+      {
+        for (j_U32 = 0; j_U32 < BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE; j_U32++)
+        {
+          delete pChunk_X[j_U32].pEntry.load(std::memory_order_relaxed);
+        }
+        delete[] pChunk_X;
+      }
+    }
+  }
+  BofSocketSessionTable &operator=(const BofSocketSessionTable &) = delete; // Disallow copying
+  BofSocketSessionTable(const BofSocketSessionTable &) = delete;
+
+  uint32_t NbMaxFd() const
+  {
+    return mNbMaxFd_U32;
+  }
+  uint32_t NbEntry() const
+  {
+    return mNbEntry_U32;
+  }
+  uint32_t NbRetired() const
+  {
+    return static_cast<uint32_t>(mRetiredCollection.size());
+  }
+
+  /*!
+   * Description
+   * Store an entry for a descriptor. Writer side.
+   *
+   * Parameters
+   * _Fd: Specifies the descriptor
+   * _puEntry: Specifies the entry, owned by the table from now on
+   * _rGeneration_U32: Returns the generation given to the entry
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_EEXIST if the descriptor is already in the table,
+   * BOF_ERR_TOO_BIG if it is beyond NbMaxFd
+   */
+  BOFERR Insert(BOFSOCKET _Fd, std::unique_ptr<T> _puEntry, uint32_t &_rGeneration_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_EINVAL;
+    SLOT *pSlot_X;
+
+    _rGeneration_U32 = BOF_SOCKET_SESSION_TABLE_NO_GENERATION;
+    if ((_puEntry) && (_Fd >= 0))
+    {
+      Rts_E = BOF_ERR_TOO_BIG;
+      pSlot_X = Slot(_Fd, true);
+      if (pSlot_X)
+      {
+        Rts_E = BOF_ERR_EEXIST;
+        if (pSlot_X->pEntry.load(std::memory_order_relaxed) == nullptr)
+        {
+          mGeneration_U32++;
+          if (mGeneration_U32 == BOF_SOCKET_SESSION_TABLE_NO_GENERATION)
+          {
+            mGeneration_U32++;
+          }
+          //Entry first, generation last: a reader which sees the new generation also sees the new entry
+          pSlot_X->pEntry.store(_puEntry.release(), std::memory_order_release);
+          pSlot_X->Generation_U32.store(mGeneration_U32, std::memory_order_release);
+          _rGeneration_U32 = mGeneration_U32;
+          mNbEntry_U32++;
+          Rts_E = BOF_ERR_NO_ERROR;
+        }
+      }
+    }
+    return Rts_E;
+  }
+
+  //Writer side: take the entry out of the table and retire it until the next ExtractRetired
+  BOFERR Remove(BOFSOCKET _Fd)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_FOUND;
+    SLOT *pSlot_X = Slot(_Fd, false);
+    T *pEntry;
+
+    if (pSlot_X)
+    {
+      pEntry = pSlot_X->pEntry.load(std::memory_order_relaxed);
+      if (pEntry)
+      {
+        pSlot_X->Generation_U32.store(BOF_SOCKET_SESSION_TABLE_NO_GENERATION, std::memory_order_release);
+        pSlot_X->pEntry.store(nullptr, std::memory_order_release);
+        mRetiredCollection.emplace_back(pEntry);
+        mNbEntry_U32--;
+        Rts_E = BOF_ERR_NO_ERROR;
+      }
+    }
+    return Rts_E;
+  }
+
+  //Writer side: current entry of a descriptor or nullptr
+  T *Find(BOFSOCKET _Fd) const
+  {
+    SLOT *pSlot_X = Slot(_Fd, false);
+
+    return pSlot_X ? pSlot_X->pEntry.load(std::memory_order_relaxed) : nullptr;
+  }
+
+  /*!
+   * Description
+   * Lock free lookup of a descriptor handle. Reader side.
+   *
+   * Parameters
+   * _Fd: Specifies the descriptor
+   * _Generation_U32: Specifies the generation returned by Insert when the handle was made
+   *
+   * Returns
+   * T *: The entry, or nullptr if the handle is stale (descriptor removed or re-used). The pointer stays valid until
+   * the reader calls ExtractRetired.
+   */
+  T *Lookup(BOFSOCKET _Fd, uint32_t _Generation_U32) const
+  {
+    T *pRts = nullptr;
+    SLOT *pSlot_X = Slot(_Fd, false);
+
+    if ((pSlot_X) && (_Generation_U32 != BOF_SOCKET_SESSION_TABLE_NO_GENERATION) && (pSlot_X->Generation_U32.load(std::memory_order_acquire) == _Generation_U32))
+    {
+      pRts = pSlot_X->pEntry.load(std::memory_order_acquire);
+      //Checked again: the slot may have been removed and re-used between the two loads
+      if (pSlot_X->Generation_U32.load(std::memory_order_acquire) != _Generation_U32)
+      {
+        pRts = nullptr;
+      }
+    }
+    return pRts;
+  }
+
+  //Writer side, called by the reader when it holds no Lookup pointer: gives the retired entries to destroy (outside of the writer lock)
+  void ExtractRetired(std::vector<std::unique_ptr<T>> &_rRetiredCollection)
+  {
+    _rRetiredCollection.clear();
+    _rRetiredCollection.swap(mRetiredCollection);
+  }
+
+  //Writer side: calls _Function(Fd, Entry) for each entry
+  template <typename F>
+  void ForEach(F _Function) const
+  {
+    uint32_t i_U32, j_U32;
+    SLOT *pChunk_X;
+    T *pEntry;
+
+    for (i_U32 = 0; i_U32 < mNbChunk_U32; i_U32++)
+    {
+      pChunk_X = mpuChunkCollection[i_U32].load(std::memory_order_acquire);
+      if (pChunk_X)
+      {
+        for (j_U32 = 0; j_U32 < BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE; j_U32++)
+        {
+          pEntry = pChunk_X[j_U32].pEntry.load(std::memory_order_relaxed);
+          if (pEntry)
+          {
+            _Function(static_cast<BOFSOCKET>((i_U32 << BOF_SOCKET_SESSION_TABLE_CHUNK_SHIFT) + j_U32), *pEntry);
+          }
+        }
+      }
+    }
+  }
+
+private:
+  SLOT *Slot(BOFSOCKET _Fd, bool _Create_B) const
+  {
+    SLOT *pRts_X = nullptr;
+    SLOT *pChunk_X;
+    uint32_t Chunk_U32;
+
+    if ((_Fd >= 0) && (static_cast<uint32_t>(_Fd) < mNbMaxFd_U32))
+    {
+      Chunk_U32 = static_cast<uint32_t>(_Fd) >> BOF_SOCKET_SESSION_TABLE_CHUNK_SHIFT;
+      pChunk_X = mpuChunkCollection[Chunk_U32].load(std::memory_order_acquire);
+      if ((!pChunk_X) && (_Create_B))
+      {
+        //Only the (serialized) writer creates chunks, they live as long as the table
+        pChunk_X = new SLOT[BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE];
+        mpuChunkCollection[Chunk_U32].store(pChunk_X, std::memory_order_release);
+      }
+      if (pChunk_X)
+      {
+        pRts_X = &pChunk_X[static_cast<uint32_t>(_Fd) & (BOF_SOCKET_SESSION_TABLE_CHUNK_SIZE - 1)];
+      }
+    }
+    return pRts_X;
+  }
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,494 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the socket session idle and io timeout tracker
+ * based on BofTimingWheel.
+ *
+ * Name:        bofsocketsessiontimer.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/boftimingwheel.h>
+#include <bofstd/bofsocketsessionmanager.h>
+#include <unordered_map>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_SESSION_TIMEOUT_TYPE : uint32_t
+{
+  IDLE = 0,                   //No io during BofSocketIo::NoIoCloseTimeoutInMs()
+  IO,                         //Deadline armed by ArmIoTimeout (connect, command reply, data transfer,...) not disarmed in time
+};
+
+/*** Structure **************************************************************/
+
+typedef std::function<void(std::shared_ptr<BofSocketIo> _psSocketSession, BOF_SOCKET_SESSION_TIMEOUT_TYPE _TimeoutType_E)> BOF_SOCKET_SESSION_TIMEOUT_CALLBACK;
+
+struct BOF_SOCKET_SESSION_TIMER_PARAM
+{
+  uint32_t                            NbMaxSession_U32;         /*! Maximum number of session tracked at the same time */
+  uint32_t                            TickInMs_U32;             /*! Timing wheel resolution */
+  bool                                DedicatedThread_B;        /*! true: a BofTimingWheelThread drives the timers, false: the owner must call Advance (from its poll loop) */
+  BOF_THREAD_SCHEDULER_POLICY         ThreadSchedulerPolicy_E;  /*! Used if DedicatedThread_B is true */
+  BOF_THREAD_PRIORITY                 ThreadPriority_E;
+  uint64_t                            ThreadCpuCoreAffinityMask_U64;
+  BOF_SOCKET_SESSION_TIMEOUT_CALLBACK OnTimeout;                /*! Called without any internal lock held. If nullptr, the session is removed from pSessionManager */
+  BofSocketSessionManager             *pSessionManager;
+  BOF_TIMING_WHEEL_WAKE_UP_CALLBACK   OnWakeUp;                 /*! Used if DedicatedThread_B is false: wakes up the owner poll loop when a timer is armed before its current wait deadline */
+
+  BOF_SOCKET_SESSION_TIMER_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbMaxSession_U32              = 0;
+    TickInMs_U32                  = 50;
+    DedicatedThread_B             = true;
+    ThreadSchedulerPolicy_E       = BOF_THREAD_SCHEDULER_POLICY_OTHER;
+    ThreadPriority_E              = BOF_THREAD_DEFAULT_PRIORITY;
+    ThreadCpuCoreAffinityMask_U64 = 0;
+    OnTimeout                     = nullptr;
+    pSessionManager               = nullptr;
+    OnWakeUp                      = nullptr;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Socket session timeout tracker
+ *
+ * Description
+ * Replaces the per poll scan of every session by one timing wheel timer per session and per timeout type.
+ * The idle timer is lazily re-armed: BofSocketIo updates LastIoTimeInMs on each io without touching the wheel
+ * and, when the idle timer expires, it is re-armed for the remaining time if an io occurred in between. A
+ * busy session thus costs at most one timer expiry per NoIoCloseTimeoutInMs period.
+ *
+ * See Also
+ * BofTimingWheel
+ */
+class BofSocketSessionTimer
+{
+private:
+  static constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+
+  struct SESSION_TIMER
+  {
+    std::weak_ptr<BofSocketIo> pwSocketSession;
+    BOF_TIMER_HANDLE           IdleTimer;
+    BOF_TIMER_HANDLE           IoTimer;
+    uint32_t                   NextFree_U32;
+  };
+
+  BOF_SOCKET_SESSION_TIMER_PARAM                mSocketSessionTimerParam_X;
+  BOFERR                                        mErrorCode_E = BOF_ERR_INIT;
+  BOF_MUTEX                                     mMtx_X;
+  std::unique_ptr<BofTimingWheelThread>         mpuTimingWheelThread = nullptr;
+  std::unique_ptr<BofTimingWheel>               mpuTimingWheel = nullptr;
+  BofTimingWheel                                *mpTimingWheel = nullptr;
+  std::vector<SESSION_TIMER>                    mSessionTimerCollection;
+  std::unordered_map<const BofSocketIo *, uint32_t> mSessionIndexCollection;
+  uint32_t                                      mFirstFree_U32 = NO_INDEX;
+
+public:
+  BofSocketSessionTimer(const BOF_SOCKET_SESSION_TIMER_PARAM &_rSocketSessionTimerParam_X);
+  virtual ~BofSocketSessionTimer();
+
+  BofSocketSessionTimer &operator=(const BofSocketSessionTimer &) = delete; // Disallow copying
+  BofSocketSessionTimer(const BofSocketSessionTimer &) = delete;
+
+  BOFERR LastErrorCode() const;
+  BOFERR Track(std::shared_ptr<BofSocketIo> _psSocketSession);
+  BOFERR Untrack(const BofSocketIo *_pSocketSession);
+  BOFERR RefreshIdleTimeout(std::shared_ptr<BofSocketIo> _psSocketSession);
+  BOFERR ArmIoTimeout(std::shared_ptr<BofSocketIo> _psSocketSession, uint32_t _TimeoutInMs_U32);
+  BOFERR DisarmIoTimeout(std::shared_ptr<BofSocketIo> _psSocketSession);
+  uint32_t NbTrackedSession();
+  uint32_t Advance();
+  uint32_t NextExpiryInMs(uint32_t _MaxWaitInMs_U32);
+  BofTimingWheel &TimingWheel();
+
+private:
+  void OnExpired(const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection);
+  BOFERR ArmIdleTimer(SESSION_TIMER &_rSessionTimer_X, const BofSocketIo *_pSocketSession, uint32_t _Index_U32);
+  void *TimerUserArg(uint32_t _Index_U32, BOF_SOCKET_SESSION_TIMEOUT_TYPE _TimeoutType_E) const;
+  uint32_t FindIndex(const BofSocketIo *_pSocketSession) const;
+};
+
+inline BofSocketSessionTimer::BofSocketSessionTimer(const BOF_SOCKET_SESSION_TIMER_PARAM &_rSocketSessionTimerParam_X)
+{
+  BOF_TIMING_WHEEL_PARAM TimingWheelParam_X;
+  uint32_t               i_U32;
+
+  mSocketSessionTimerParam_X = _rSocketSessionTimerParam_X;
+  mErrorCode_E               = BOF_ERR_EINVAL;
+  if ((mSocketSessionTimerParam_X.NbMaxSession_U32) && (mSocketSessionTimerParam_X.NbMaxSession_U32 < NO_INDEX) &&
+      ((mSocketSessionTimerParam_X.OnTimeout) || (mSocketSessionTimerParam_X.pSessionManager)))
+  {
+    mErrorCode_E = Bof_CreateMutex("BofSocketSessionTimer", true, true, mMtx_X);
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      mSessionTimerCollection.resize(mSocketSessionTimerParam_X.NbMaxSession_U32);
+      for (i_U32 = 0; i_U32 < mSocketSessionTimerParam_X.NbMaxSession_U32; i_U32++)
+      {
+        mSessionTimerCollection[i_U32].IdleTimer    = BOF_TIMER_HANDLE_INVALID;
+        mSessionTimerCollection[i_U32].IoTimer      = BOF_TIMER_HANDLE_INVALID;
+        mSessionTimerCollection[i_U32].NextFree_U32 = (i_U32 + 1 < mSocketSessionTimerParam_X.NbMaxSession_U32) ? i_U32 + 1 : NO_INDEX;
+      }
+      mFirstFree_U32 = 0;
+      mSessionIndexCollection.reserve(mSocketSessionTimerParam_X.NbMaxSession_U32);
+
+      TimingWheelParam_X.MultiThreadAware_B = true;
+      TimingWheelParam_X.TickInMs_U32       = mSocketSessionTimerParam_X.TickInMs_U32;
+      TimingWheelParam_X.NbMaxTimer_U32     = mSocketSessionTimerParam_X.NbMaxSession_U32 * 2;  //Idle and io
+      TimingWheelParam_X.OnExpired          = [this](const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection) { OnExpired(_rExpiredCollection); };
+      if (mSocketSessionTimerParam_X.DedicatedThread_B)
+      {
+        mpuTimingWheelThread.reset(new BofTimingWheelThread(TimingWheelParam_X));
+        mpTimingWheel = &mpuTimingWheelThread->TimingWheel();
+        mErrorCode_E  = mpuTimingWheelThread->Start("SessionTimer", mSocketSessionTimerParam_X.ThreadSchedulerPolicy_E, mSocketSessionTimerParam_X.ThreadPriority_E, mSocketSessionTimerParam_X.ThreadCpuCoreAffinityMask_U64);
+      }
+      else
+      {
+        TimingWheelParam_X.OnWakeUp = mSocketSessionTimerParam_X.OnWakeUp;
+        mpuTimingWheel.reset(new BofTimingWheel(TimingWheelParam_X));
+        mpTimingWheel = mpuTimingWheel.get();
+        mErrorCode_E  = mpuTimingWheel->LastErrorCode();
+      }
+    }
+  }
+}
+
+inline BofSocketSessionTimer::~BofSocketSessionTimer()
+{
+  //Stop the thread first: it can call OnExpired
+  mpuTimingWheelThread.reset(nullptr);
+  mpuTimingWheel.reset(nullptr);
+  Bof_DestroyMutex(mMtx_X);
+}
+
+inline BOFERR BofSocketSessionTimer::LastErrorCode() const
+{
+  return mErrorCode_E;
+}
+
+inline BofTimingWheel &BofSocketSessionTimer::TimingWheel()
+{
+  return *mpTimingWheel;
+}
+
+/*!
+ * Description
+ * Start to monitor a session. The idle timer is armed if the session NoIoCloseTimeoutInMs is not 0.
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_FULL if NbMaxSession_U32 sessions are tracked
+ */
+inline BOFERR BofSocketSessionTimer::Track(std::shared_ptr<BofSocketIo> _psSocketSession)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = BOF_ERR_EINVAL;
+    if (_psSocketSession)
+    {
+      Rts_E = Bof_LockMutex(mMtx_X);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        if (FindIndex(_psSocketSession.get()) != NO_INDEX)
+        {
+          Rts_E = BOF_ERR_EEXIST;
+        }
+        else if (mFirstFree_U32 == NO_INDEX)
+        {
+          Rts_E = BOF_ERR_FULL;
+        }
+        else
+        {
+          Index_U32 = mFirstFree_U32;
+          SESSION_TIMER &rSessionTimer_X = mSessionTimerCollection[Index_U32];
+
+          mFirstFree_U32                  = rSessionTimer_X.NextFree_U32;
+          rSessionTimer_X.pwSocketSession = _psSocketSession;
+          rSessionTimer_X.IdleTimer       = BOF_TIMER_HANDLE_INVALID;
+          rSessionTimer_X.IoTimer         = BOF_TIMER_HANDLE_INVALID;
+          mSessionIndexCollection[_psSocketSession.get()] = Index_U32;
+          Rts_E = ArmIdleTimer(rSessionTimer_X, _psSocketSession.get(), Index_U32);
+        }
+        Bof_UnlockMutex(mMtx_X);
+      }
+    }
+  }
+  return Rts_E;
+}
+
+inline BOFERR BofSocketSessionTimer::Untrack(const BofSocketIo *_pSocketSession)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = FindIndex(_pSocketSession);
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        SESSION_TIMER &rSessionTimer_X = mSessionTimerCollection[Index_U32];
+
+        mpTimingWheel->Cancel(rSessionTimer_X.IdleTimer);
+        mpTimingWheel->Cancel(rSessionTimer_X.IoTimer);
+        rSessionTimer_X.IdleTimer = BOF_TIMER_HANDLE_INVALID;
+        rSessionTimer_X.IoTimer   = BOF_TIMER_HANDLE_INVALID;
+        rSessionTimer_X.pwSocketSession.reset();
+        rSessionTimer_X.NextFree_U32 = mFirstFree_U32;
+        mFirstFree_U32               = Index_U32;
+        mSessionIndexCollection.erase(_pSocketSession);
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+  return Rts_E;
+}
+
+//To call after BofSocketIo::NoIoCloseTimeoutInMs has been changed
+inline BOFERR BofSocketSessionTimer::RefreshIdleTimeout(std::shared_ptr<BofSocketIo> _psSocketSession)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = FindIndex(_psSocketSession.get());
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        mpTimingWheel->Cancel(mSessionTimerCollection[Index_U32].IdleTimer);
+        mSessionTimerCollection[Index_U32].IdleTimer = BOF_TIMER_HANDLE_INVALID;
+        Rts_E = ArmIdleTimer(mSessionTimerCollection[Index_U32], _psSocketSession.get(), Index_U32);
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Arm (or re-arm) the io deadline of a session. If DisarmIoTimeout is not called within _TimeoutInMs_U32,
+ * OnTimeout is called with BOF_SOCKET_SESSION_TIMEOUT_TYPE::IO.
+ */
+inline BOFERR BofSocketSessionTimer::ArmIoTimeout(std::shared_ptr<BofSocketIo> _psSocketSession, uint32_t _TimeoutInMs_U32)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = FindIndex(_psSocketSession.get());
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        SESSION_TIMER &rSessionTimer_X = mSessionTimerCollection[Index_U32];
+
+        Rts_E = mpTimingWheel->Reschedule(rSessionTimer_X.IoTimer, _TimeoutInMs_U32);
+        if (Rts_E != BOF_ERR_NO_ERROR)
+        {
+          Rts_E = mpTimingWheel->Schedule(_TimeoutInMs_U32, TimerUserArg(Index_U32, BOF_SOCKET_SESSION_TIMEOUT_TYPE::IO), rSessionTimer_X.IoTimer);
+        }
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+  return Rts_E;
+}
+
+inline BOFERR BofSocketSessionTimer::DisarmIoTimeout(std::shared_ptr<BofSocketIo> _psSocketSession)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = Bof_LockMutex(mMtx_X);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = FindIndex(_psSocketSession.get());
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        Rts_E = mpTimingWheel->Cancel(mSessionTimerCollection[Index_U32].IoTimer);
+        mSessionTimerCollection[Index_U32].IoTimer = BOF_TIMER_HANDLE_INVALID;
+      }
+      Bof_UnlockMutex(mMtx_X);
+    }
+  }
+  return Rts_E;
+}
+
+inline uint32_t BofSocketSessionTimer::NbTrackedSession()
+{
+  uint32_t Rts_U32 = 0;
+
+  if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+  {
+    Rts_U32 = static_cast<uint32_t>(mSessionIndexCollection.size());
+    Bof_UnlockMutex(mMtx_X);
+  }
+  return Rts_U32;
+}
+
+//Only if DedicatedThread_B is false: call it from the poll loop after each poll wake up
+inline uint32_t BofSocketSessionTimer::Advance()
+{
+  return mpuTimingWheelThread ? 0 : mpTimingWheel->Advance();
+}
+
+//Only if DedicatedThread_B is false: use it to bound the poll timeout
+inline uint32_t BofSocketSessionTimer::NextExpiryInMs(uint32_t _MaxWaitInMs_U32)
+{
+  return mpuTimingWheelThread ? _MaxWaitInMs_U32 : mpTimingWheel->NextExpiryInMs(_MaxWaitInMs_U32);
+}
+
+inline void BofSocketSessionTimer::OnExpired(const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection)
+{
+  std::vector<std::pair<std::shared_ptr<BofSocketIo>, BOF_SOCKET_SESSION_TIMEOUT_TYPE>> TimeoutCollection;
+  std::shared_ptr<BofSocketIo> psSocketSession;
+  BOF_SOCKET_SESSION_TIMEOUT_TYPE TimeoutType_E;
+  uint32_t Index_U32, TimeoutInMs_U32, ElapsedInMs_U32, SessionIndex_U32;
+
+  if (Bof_LockMutex(mMtx_X) == BOF_ERR_NO_ERROR)
+  {
+    for (const BOF_TIMING_WHEEL_EXPIRED &rExpired_X : _rExpiredCollection)
+    {
+      Index_U32     = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(rExpired_X.pUserArg) >> 1);
+      TimeoutType_E = (reinterpret_cast<uintptr_t>(rExpired_X.pUserArg) & 1) ? BOF_SOCKET_SESSION_TIMEOUT_TYPE::IO : BOF_SOCKET_SESSION_TIMEOUT_TYPE::IDLE;
+      SESSION_TIMER &rSessionTimer_X = mSessionTimerCollection[Index_U32];
+
+      //The session can have been untracked (or the timer re-armed) between the expiry detection and this point
+      if (TimeoutType_E == BOF_SOCKET_SESSION_TIMEOUT_TYPE::IO)
+      {
+        if (rSessionTimer_X.IoTimer != rExpired_X.TimerHandle)
+        {
+          continue;
+        }
+        rSessionTimer_X.IoTimer = BOF_TIMER_HANDLE_INVALID;
+      }
+      else
+      {
+        if (rSessionTimer_X.IdleTimer != rExpired_X.TimerHandle)
+        {
+          continue;
+        }
+        rSessionTimer_X.IdleTimer = BOF_TIMER_HANDLE_INVALID;
+      }
+      psSocketSession = rSessionTimer_X.pwSocketSession.lock();
+      if (psSocketSession)
+      {
+        if (TimeoutType_E == BOF_SOCKET_SESSION_TIMEOUT_TYPE::IDLE)
+        {
+          TimeoutInMs_U32 = psSocketSession->NoIoCloseTimeoutInMs();
+          ElapsedInMs_U32 = Bof_ElapsedMsTime(psSocketSession->LastIoTimeInMs());
+          if ((TimeoutInMs_U32) && (ElapsedInMs_U32 < TimeoutInMs_U32))
+          {
+            //Io occured since the timer was armed: lazy re-arm for the remaining time
+            mpTimingWheel->Schedule(TimeoutInMs_U32 - ElapsedInMs_U32, rExpired_X.pUserArg, rSessionTimer_X.IdleTimer);
+            continue;
+          }
+          if (TimeoutInMs_U32 == 0)
+          {
+            continue;
+          }
+        }
+        TimeoutCollection.emplace_back(psSocketSession, TimeoutType_E);
+      }
+    }
+    Bof_UnlockMutex(mMtx_X);
+  }
+
+  for (auto &rTimeout : TimeoutCollection)
+  {
+    if (mSocketSessionTimerParam_X.OnTimeout)
+    {
+      mSocketSessionTimerParam_X.OnTimeout(rTimeout.first, rTimeout.second);
+    }
+    else
+    {
+      mSocketSessionTimerParam_X.pSessionManager->RemoveFromPollList(mSocketSessionTimerParam_X.pSessionManager->SocketServerParam().PollControlListenerTimeoutInMs_U32, rTimeout.first, SessionIndex_U32);
+      Untrack(rTimeout.first.get());
+    }
+  }
+}
+
+//Called with mMtx_X locked
+inline BOFERR BofSocketSessionTimer::ArmIdleTimer(SESSION_TIMER &_rSessionTimer_X, const BofSocketIo *_pSocketSession, uint32_t _Index_U32)
+{
+  BOFERR   Rts_E = BOF_ERR_NO_ERROR;
+  uint32_t TimeoutInMs_U32, ElapsedInMs_U32;
+
+  TimeoutInMs_U32 = _pSocketSession->NoIoCloseTimeoutInMs();
+  if (TimeoutInMs_U32)
+  {
+    ElapsedInMs_U32 = Bof_ElapsedMsTime(_pSocketSession->LastIoTimeInMs());
+    Rts_E = mpTimingWheel->Schedule((ElapsedInMs_U32 < TimeoutInMs_U32) ? TimeoutInMs_U32 - ElapsedInMs_U32 : 0, TimerUserArg(_Index_U32, BOF_SOCKET_SESSION_TIMEOUT_TYPE::IDLE),
+                                    _rSessionTimer_X.IdleTimer);
+  }
+  return Rts_E;
+}
+
+inline void *BofSocketSessionTimer::TimerUserArg(uint32_t _Index_U32, BOF_SOCKET_SESSION_TIMEOUT_TYPE _TimeoutType_E) const
+{
+  return reinterpret_cast<void *>((static_cast<uintptr_t>(_Index_U32) << 1) | ((_TimeoutType_E == BOF_SOCKET_SESSION_TIMEOUT_TYPE::IO) ? 1 : 0));
+}
+
+inline uint32_t BofSocketSessionTimer::FindIndex(const BofSocketIo *_pSocketSession) const
+{
+  auto It = mSessionIndexCollection.find(_pSocketSession);
+
+  return (It == mSessionIndexCollection.end()) ? NO_INDEX : It->second;
+}
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,637 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the kernel packet time stamping: software and
+ * hardware reception time stamps given with each read, transmit time
+ * stamps read back from the socket error queue.
+ *
+ * Name:        bofsockettimestamp.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only: the other platforms return BOF_ERR_NOT_SUPPORTED.
+ *              Software time stamps are CLOCK_REALTIME and work on any
+ *              interface (loopback included). Hardware ones are in the nic
+ *              clock domain (PHC) and need Bof_SocketEnableHardwareTimeStamp
+ *              on the interface first (CAP_NET_ADMIN).
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsocket.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofsystem.h>
+#include <string.h>
+#include <vector>
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if defined(__linux__)
+#define BOF_SOCKET_TIMESTAMP_AVAILABLE 1
+#ifndef SCM_TIMESTAMPING
+#define SCM_TIMESTAMPING 37
+#endif
+#ifndef SO_EE_ORIGIN_TIMESTAMPING
+#define SO_EE_ORIGIN_TIMESTAMPING 4
+#endif
+//Control buffer of one received datagram: SCM_TIMESTAMPNS, SCM_TIMESTAMPING (3 timespec) and room for the other cmsg (gro, pktinfo...)
+#define BOF_SOCKET_TIMESTAMP_CONTROL_SIZE (CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(3 * sizeof(struct timespec)))
+#else
+#define BOF_SOCKET_TIMESTAMP_AVAILABLE 0
+#endif
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_TX_TIMESTAMP_POINT : uint32_t
+{
+  BOF_SOCKET_TX_TIMESTAMP_POINT_SEND = 0,  //Handed to the driver (software) or put on the wire (hardware)
+  BOF_SOCKET_TX_TIMESTAMP_POINT_SCHED,     //Entered the qdisc: SEND - SCHED is the time spent in the traffic control layer
+  BOF_SOCKET_TX_TIMESTAMP_POINT_ACK,       //Tcp only: every byte up to this one has been acknowledged by the peer
+  BOF_SOCKET_TX_TIMESTAMP_POINT_MAX
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_TIMESTAMP
+{
+  uint64_t SoftwareInNs_U64;   /*! CLOCK_REALTIME kernel time stamp, 0 if not available */
+  uint64_t HardwareInNs_U64;   /*! Raw nic clock time stamp, 0 if not available */
+
+  BOF_SOCKET_TIMESTAMP()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    SoftwareInNs_U64 = 0;
+    HardwareInNs_U64 = 0;
+  }
+};
+
+struct BOF_SOCKET_TX_TIMESTAMP
+{
+  uint32_t                      Id_U32;        /*! Id returned by BofSocketTimeStamp::Write: datagram counter, or offset of the last byte for tcp */
+  BOF_SOCKET_TX_TIMESTAMP_POINT Point_E;
+  BOF_SOCKET_TIMESTAMP          TimeStamp_X;
+
+  BOF_SOCKET_TX_TIMESTAMP()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Id_U32 = 0;
+    Point_E = BOF_SOCKET_TX_TIMESTAMP_POINT::BOF_SOCKET_TX_TIMESTAMP_POINT_SEND;
+    TimeStamp_X.Reset();
+  }
+};
+
+struct BOF_SOCKET_TIMESTAMP_PARAM
+{
+  bool RxSoftware_B;    /*! Software reception time stamp of each read */
+  bool RxHardware_B;    /*! Hardware reception time stamp of each read */
+  bool TxSoftware_B;    /*! Software transmit time stamp (SEND point) in the error queue */
+  bool TxHardware_B;    /*! Hardware transmit time stamp (SEND point) in the error queue */
+  bool TxSched_B;       /*! SCHED point in the error queue */
+  bool TxAck_B;         /*! ACK point in the error queue (tcp) */
+
+  BOF_SOCKET_TIMESTAMP_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    RxSoftware_B = true;
+    RxHardware_B = false;
+    TxSoftware_B = true;
+    TxHardware_B = false;
+    TxSched_B = false;
+    TxAck_B = false;
+  }
+};
+
+struct BOF_SOCKET_TIMESTAMP_STATISTIC
+{
+  uint64_t NbRead_U64;
+  uint64_t NbRxSoftware_U64;    /*! Reads which got a software time stamp */
+  uint64_t NbRxHardware_U64;    /*! Reads which got a hardware time stamp */
+  uint64_t NbWrite_U64;
+  uint64_t NbTxTimeStamp_U64;   /*! Entries read from the error queue */
+  uint64_t NbError_U64;
+
+  BOF_SOCKET_TIMESTAMP_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbRead_U64 = 0;
+    NbRxSoftware_U64 = 0;
+    NbRxHardware_U64 = 0;
+    NbWrite_U64 = 0;
+    NbTxTimeStamp_U64 = 0;
+    NbError_U64 = 0;
+  }
+};
+
+/*** Function ***************************************************************/
+
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+inline uint64_t Bof_SocketTimeStampToNs(const struct timespec &_rTs_X)
+{
+  return (static_cast<uint64_t>(_rTs_X.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(_rTs_X.tv_nsec);
+}
+
+/*!
+ * Description
+ * Extracts the kernel time stamps from the ancillary data of a received message: SCM_TIMESTAMPNS (SO_TIMESTAMPNS) and
+ * SCM_TIMESTAMPING (SO_TIMESTAMPING, software in ts[0], raw hardware in ts[2]). The other cmsg are ignored.
+ *
+ * Parameters
+ * _rMsg_X:       Specifies the message filled by recvmsg/recvmmsg
+ * _rTimeStamp_X: Returns the time stamps, 0 for the missing ones
+ *
+ * Returns
+ * bool: true if at least one time stamp was found
+ */
+inline bool Bof_SocketParseTimeStamp(const struct msghdr &_rMsg_X, BOF_SOCKET_TIMESTAMP &_rTimeStamp_X)
+{
+  struct cmsghdr *pCmsg_X;
+  struct timespec pTs_X[3];
+
+  _rTimeStamp_X.Reset();
+  for (pCmsg_X = CMSG_FIRSTHDR(&_rMsg_X); pCmsg_X != nullptr; pCmsg_X = CMSG_NXTHDR(const_cast<struct msghdr *>(&_rMsg_X), pCmsg_X))
+  {
+    if ((pCmsg_X->cmsg_level == SOL_SOCKET) && (pCmsg_X->cmsg_type == SCM_TIMESTAMPNS) && (pCmsg_X->cmsg_len >= CMSG_LEN(sizeof(struct timespec))))
+    {
+      memcpy(&pTs_X[0], CMSG_DATA(pCmsg_X), sizeof(struct timespec));
+      _rTimeStamp_X.SoftwareInNs_U64 = Bof_SocketTimeStampToNs(pTs_X[0]);
+    }
+    else if ((pCmsg_X->cmsg_level == SOL_SOCKET) && (pCmsg_X->cmsg_type == SCM_TIMESTAMPING) && (pCmsg_X->cmsg_len >= CMSG_LEN(sizeof(pTs_X))))
+    {
+      memcpy(pTs_X, CMSG_DATA(pCmsg_X), sizeof(pTs_X));
+      if ((pTs_X[0].tv_sec) || (pTs_X[0].tv_nsec))
+      {
+        _rTimeStamp_X.SoftwareInNs_U64 = Bof_SocketTimeStampToNs(pTs_X[0]);
+      }
+      _rTimeStamp_X.HardwareInNs_U64 = Bof_SocketTimeStampToNs(pTs_X[2]);
+    }
+  }
+  return (_rTimeStamp_X.SoftwareInNs_U64 != 0) || (_rTimeStamp_X.HardwareInNs_U64 != 0);
+}
+#endif
+
+/*!
+ * Description
+ * Asks the driver of an interface to time stamp every transmitted and/or received packet in hardware (SIOCSHWTSTAMP).
+ * The setting is global to the interface and needs CAP_NET_ADMIN.
+ *
+ * Parameters
+ * _rInterfaceName_S: Specifies the interface (eth0...)
+ * _Tx_B: Specifies if the transmitted packets must be time stamped
+ * _Rx_B: Specifies if the received packets must be time stamped
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, the errno value otherwise (EOPNOTSUPP for a nic
+ * without time stamping unit, EPERM without the capability)
+ */
+inline BOFERR Bof_SocketEnableHardwareTimeStamp(const std::string &_rInterfaceName_S, bool _Tx_B, bool _Rx_B)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+  struct hwtstamp_config Config_X;
+  struct ifreq Request_X;
+  int Fd_i;
+
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_rInterfaceName_S.size()) && (_rInterfaceName_S.size() < IFNAMSIZ))
+  {
+    Fd_i = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    Rts_E = static_cast<BOFERR>(errno);
+    if (Fd_i >= 0)
+    {
+      memset(&Config_X, 0, sizeof(Config_X));
+      Config_X.tx_type = _Tx_B ? HWTSTAMP_TX_ON : HWTSTAMP_TX_OFF;
+      Config_X.rx_filter = _Rx_B ? HWTSTAMP_FILTER_ALL : HWTSTAMP_FILTER_NONE;
+      memset(&Request_X, 0, sizeof(Request_X));
+      memcpy(Request_X.ifr_name, _rInterfaceName_S.c_str(), _rInterfaceName_S.size());
+      Request_X.ifr_data = reinterpret_cast<char *>(&Config_X);
+      Rts_E = (ioctl(Fd_i, SIOCSHWTSTAMP, &Request_X) == 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+      close(Fd_i);
+    }
+  }
+#endif
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Time stamped socket reader/writer
+ *
+ * Description
+ * Enables SO_TIMESTAMPING on a socket (udp or tcp) and reads/writes it with recvmsg/sendmsg:
+ * - Read gives the kernel reception time stamp of the data, taken when the packet entered the stack (software) or
+ *   the nic (hardware): the scheduling delay of the reading thread is not in it.
+ * - Write returns an id and the kernel queues one transmit time stamp per enabled point in the socket error queue
+ *   (SOF_TIMESTAMPING_OPT_ID, OPT_TSONLY: the payload is not looped back). ReadTxTimeStamp collects them.
+ * The socket is not owned. The error queue is shared with the MSG_ZEROCOPY completions: do not use BofSocketZeroCopy
+ * on the same socket. An object is not thread safe.
+ *
+ * See Also
+ * BofSocketDatagramBatch, Bof_SocketParseTimeStamp
+ */
+class BofSocketTimeStamp
+{
+private:
+  BOFSOCKET                      mSocket = BOFSOCKET_INVALID;
+  BOF_SOCKET_TIMESTAMP_PARAM     mTimeStampParam_X;
+  BOFERR                         mErrorCode_E = BOF_ERR_INIT;
+  bool                           mStream_B = false;
+  uint32_t                       mNextTxId_U32 = 0;      //Id the kernel gives to the next write (datagram count or byte offset)
+  BOF_SOCKET_TIMESTAMP_STATISTIC mTimeStampStatistic_X;
+
+public:
+  BofSocketTimeStamp(BOFSOCKET _Socket, const BOF_SOCKET_TIMESTAMP_PARAM &_rTimeStampParam_X)
+  {
+    Open(_Socket, _rTimeStampParam_X);
+  }
+  BofSocketTimeStamp(BofSocket &_rBofSocket, const BOF_SOCKET_TIMESTAMP_PARAM &_rTimeStampParam_X)
+  {
+    Open(_rBofSocket.GetSocketHandle(), _rTimeStampParam_X);
+  }
+  virtual ~BofSocketTimeStamp()
+  {
+  }
+  BofSocketTimeStamp &operator=(const BofSocketTimeStamp &) = delete; // Disallow copying
+  BofSocketTimeStamp(const BofSocketTimeStamp &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+
+  /*!
+   * Description
+   * Reads a datagram (or the available stream data) with its reception time stamp.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies how long to wait for data. 0 does not wait.
+   * _rNb_U32:         Specifies the capacity of _pBuffer_U8 and returns the number of byte read
+   * _pBuffer_U8:      Specifies the destination buffer
+   * _pPeerAddress_X:  nullptr or returns the source address
+   * _rTimeStamp_X:    Returns the reception time stamp (for a stream, the one of the first segment read)
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if data was read, BOF_ERR_ETIMEDOUT if nothing arrived in time, BOF_ERR_EOF on a closed stream
+   */
+  BOFERR Read(uint32_t _TimeoutInMs_U32, uint32_t &_rNb_U32, uint8_t *_pBuffer_U8, BOF_SOCKET_ADDRESS *_pPeerAddress_X, BOF_SOCKET_TIMESTAMP &_rTimeStamp_X)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+    uint8_t pControl_U8[BOF_SOCKET_TIMESTAMP_CONTROL_SIZE + 64];
+    struct sockaddr_storage Peer_X;
+    struct msghdr Msg_X;
+    struct iovec IoVec_X;
+    ssize_t Sts;
+
+    _rTimeStamp_X.Reset();
+    Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_pBuffer_U8) && (_rNb_U32))
+    {
+      Rts_E = S_WaitFor(mSocket, POLLIN, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        IoVec_X.iov_base = _pBuffer_U8;
+        IoVec_X.iov_len = _rNb_U32;
+        memset(&Msg_X, 0, sizeof(Msg_X));
+        Msg_X.msg_name = &Peer_X;
+        Msg_X.msg_namelen = sizeof(Peer_X);
+        Msg_X.msg_iov = &IoVec_X;
+        Msg_X.msg_iovlen = 1;
+        Msg_X.msg_control = pControl_U8;
+        Msg_X.msg_controllen = sizeof(pControl_U8);
+        Sts = recvmsg(mSocket, &Msg_X, MSG_DONTWAIT);
+        if (Sts > 0)
+        {
+          _rNb_U32 = static_cast<uint32_t>(Sts);
+          Bof_SocketParseTimeStamp(Msg_X, _rTimeStamp_X);
+          if (_pPeerAddress_X)
+          {
+            S_SockAddrToSocketAddress(Peer_X, Msg_X.msg_namelen, *_pPeerAddress_X);
+          }
+          mTimeStampStatistic_X.NbRead_U64++;
+          mTimeStampStatistic_X.NbRxSoftware_U64 += _rTimeStamp_X.SoftwareInNs_U64 ? 1 : 0;
+          mTimeStampStatistic_X.NbRxHardware_U64 += _rTimeStamp_X.HardwareInNs_U64 ? 1 : 0;
+        }
+        else if ((Sts == 0) && (mStream_B))
+        {
+          Rts_E = BOF_ERR_EOF;
+        }
+        else if (Sts < 0)
+        {
+          Rts_E = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? BOF_ERR_ETIMEDOUT : static_cast<BOFERR>(errno);
+        }
+      }
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        _rNb_U32 = 0;
+        if ((Rts_E != BOF_ERR_ETIMEDOUT) && (Rts_E != BOF_ERR_EOF))
+        {
+          mTimeStampStatistic_X.NbError_U64++;
+        }
+      }
+    }
+#else
+    _rNb_U32 = 0;
+#endif
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Writes a datagram (or stream data) in one sendmsg and returns the id of its transmit time stamps.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies how long to wait for socket buffer space. 0 does not wait.
+   * _rNb_U32:         Specifies the number of byte to write and returns the number written (a stream can write less)
+   * _pBuffer_U8:      Specifies the data
+   * _pPeerAddress_X:  nullptr for a connected socket or the destination address
+   * _rTxId_U32:       Returns the id given to the BOF_SOCKET_TX_TIMESTAMP entries of this write
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_ETIMEDOUT if the socket stayed full
+   */
+  BOFERR Write(uint32_t _TimeoutInMs_U32, uint32_t &_rNb_U32, const uint8_t *_pBuffer_U8, const BOF_SOCKET_ADDRESS *_pPeerAddress_X, uint32_t &_rTxId_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+    struct msghdr Msg_X;
+    struct iovec IoVec_X;
+    ssize_t Sts;
+
+    _rTxId_U32 = 0;
+    Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (_pBuffer_U8) && (_rNb_U32))
+    {
+      Rts_E = S_WaitFor(mSocket, POLLOUT, _TimeoutInMs_U32);
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        IoVec_X.iov_base = const_cast<uint8_t *>(_pBuffer_U8);
+        IoVec_X.iov_len = _rNb_U32;
+        memset(&Msg_X, 0, sizeof(Msg_X));
+        if (_pPeerAddress_X)
+        {
+          Msg_X.msg_name = _pPeerAddress_X->IpV6_B ? reinterpret_cast<void *>(const_cast<BOF_SOCKADDR_IN6 *>(&_pPeerAddress_X->IpV6Address_X))
+                                                   : reinterpret_cast<void *>(const_cast<BOF_SOCKADDR_IN *>(&_pPeerAddress_X->IpV4Address_X));
+          Msg_X.msg_namelen = _pPeerAddress_X->IpV6_B ? sizeof(_pPeerAddress_X->IpV6Address_X) : sizeof(_pPeerAddress_X->IpV4Address_X);
+        }
+        Msg_X.msg_iov = &IoVec_X;
+        Msg_X.msg_iovlen = 1;
+        Sts = sendmsg(mSocket, &Msg_X, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (Sts >= 0)
+        {
+          _rNb_U32 = static_cast<uint32_t>(Sts);
+          //Udp: one id per datagram. Tcp: the id is the offset of the last byte of the write
+          if (mStream_B)
+          {
+            mNextTxId_U32 += _rNb_U32;
+            _rTxId_U32 = mNextTxId_U32 - 1;
+          }
+          else
+          {
+            _rTxId_U32 = mNextTxId_U32++;
+          }
+          mTimeStampStatistic_X.NbWrite_U64++;
+        }
+        else
+        {
+          Rts_E = ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? BOF_ERR_ETIMEDOUT : static_cast<BOFERR>(errno);
+        }
+      }
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        _rNb_U32 = 0;
+        mTimeStampStatistic_X.NbError_U64++;
+      }
+    }
+#else
+    _rTxId_U32 = 0;
+#endif
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Collects the transmit time stamps queued by the kernel in the socket error queue.
+   *
+   * Parameters
+   * _TimeoutInMs_U32: Specifies how long to wait for the first one. 0 does not wait.
+   * _rTxTimeStampCollection: Returns the time stamps read (appended), in the order the kernel produced them
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if at least one time stamp was read, BOF_ERR_ETIMEDOUT otherwise
+   */
+  BOFERR ReadTxTimeStamp(uint32_t _TimeoutInMs_U32, std::vector<BOF_SOCKET_TX_TIMESTAMP> &_rTxTimeStampCollection)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+    uint8_t pControl_U8[BOF_SOCKET_TIMESTAMP_CONTROL_SIZE + CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+    BOF_SOCKET_TX_TIMESTAMP TxTimeStamp_X;
+    struct sock_extended_err *pErr_X;
+    struct cmsghdr *pCmsg_X;
+    struct msghdr Msg_X;
+    uint32_t Start_U32, Elapsed_U32, Nb_U32 = 0;
+    bool Again_B = true, Found_B;
+
+    Rts_E = mErrorCode_E;
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      Start_U32 = Bof_GetMsTickCount();
+      while (Again_B)
+      {
+        memset(&Msg_X, 0, sizeof(Msg_X));
+        Msg_X.msg_control = pControl_U8;
+        Msg_X.msg_controllen = sizeof(pControl_U8);
+        if (recvmsg(mSocket, &Msg_X, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0)
+        {
+          Found_B = false;
+          for (pCmsg_X = CMSG_FIRSTHDR(&Msg_X); pCmsg_X != nullptr; pCmsg_X = CMSG_NXTHDR(&Msg_X, pCmsg_X))
+          {
+            if (((pCmsg_X->cmsg_level == SOL_IP) && (pCmsg_X->cmsg_type == IP_RECVERR)) || ((pCmsg_X->cmsg_level == SOL_IPV6) && (pCmsg_X->cmsg_type == IPV6_RECVERR)))
+            {
+              pErr_X = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(pCmsg_X));
+              if ((pErr_X->ee_errno == ENOMSG) && (pErr_X->ee_origin == SO_EE_ORIGIN_TIMESTAMPING))
+              {
+                TxTimeStamp_X.Id_U32 = pErr_X->ee_data;
+                TxTimeStamp_X.Point_E = (pErr_X->ee_info == SCM_TSTAMP_SCHED) ? BOF_SOCKET_TX_TIMESTAMP_POINT::BOF_SOCKET_TX_TIMESTAMP_POINT_SCHED
+                                        : (pErr_X->ee_info == SCM_TSTAMP_ACK) ? BOF_SOCKET_TX_TIMESTAMP_POINT::BOF_SOCKET_TX_TIMESTAMP_POINT_ACK
+                                                                              : BOF_SOCKET_TX_TIMESTAMP_POINT::BOF_SOCKET_TX_TIMESTAMP_POINT_SEND;
+                Found_B = true;
+              }
+            }
+          }
+          //The SCM_TIMESTAMPING cmsg and the sock_extended_err one come in the same message, in any order
+          if ((Found_B) && (Bof_SocketParseTimeStamp(Msg_X, TxTimeStamp_X.TimeStamp_X)))
+          {
+            _rTxTimeStampCollection.push_back(TxTimeStamp_X);
+            Nb_U32++;
+          }
+        }
+        else if (Nb_U32)
+        {
+          Again_B = false;
+        }
+        else
+        {
+          //The error queue is signaled by POLLERR which poll always reports: no event to ask for
+          Elapsed_U32 = Bof_ElapsedMsTime(Start_U32);
+          Again_B = (Elapsed_U32 < _TimeoutInMs_U32) && (S_WaitFor(mSocket, 0, _TimeoutInMs_U32 - Elapsed_U32) == BOF_ERR_NO_ERROR);
+        }
+      }
+      Rts_E = Nb_U32 ? BOF_ERR_NO_ERROR : BOF_ERR_ETIMEDOUT;
+      mTimeStampStatistic_X.NbTxTimeStamp_U64 += Nb_U32;
+    }
+#endif
+    return Rts_E;
+  }
+
+  BOF_SOCKET_TIMESTAMP_STATISTIC TimeStampStatistic() const
+  {
+    return mTimeStampStatistic_X;
+  }
+  void ResetTimeStampStatistic()
+  {
+    mTimeStampStatistic_X.Reset();
+  }
+  std::string TimeStampDebugInfo() const
+  {
+    const BOF_SOCKET_TIMESTAMP_STATISTIC &rStat_X = mTimeStampStatistic_X;
+
+    return Bof_Sprintf("TimeStamp Rx sw %d hw %d Tx sw %d hw %d sched %d ack %d Rd %lld sw %lld hw %lld Wr %lld TxTs %lld Err %lld", mTimeStampParam_X.RxSoftware_B, mTimeStampParam_X.RxHardware_B,
+                       mTimeStampParam_X.TxSoftware_B, mTimeStampParam_X.TxHardware_B, mTimeStampParam_X.TxSched_B, mTimeStampParam_X.TxAck_B, rStat_X.NbRead_U64, rStat_X.NbRxSoftware_U64,
+                       rStat_X.NbRxHardware_U64, rStat_X.NbWrite_U64, rStat_X.NbTxTimeStamp_U64, rStat_X.NbError_U64);
+  }
+
+private:
+  void Open(BOFSOCKET _Socket, const BOF_SOCKET_TIMESTAMP_PARAM &_rTimeStampParam_X)
+  {
+    mSocket = _Socket;
+    mTimeStampParam_X = _rTimeStampParam_X;
+    mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+    uint32_t Flag_U32 = SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+    int Type_i;
+    socklen_t Len;
+
+    mErrorCode_E = BOF_ERR_EINVAL;
+    Len = sizeof(Type_i);
+    if ((mSocket != BOFSOCKET_INVALID) && (getsockopt(mSocket, SOL_SOCKET, SO_TYPE, &Type_i, &Len) == 0))
+    {
+      mStream_B = (Type_i == SOCK_STREAM);
+      //The generation flags say which time stamps the kernel takes, the reporting ones which it gives back
+      if (mTimeStampParam_X.RxSoftware_B)
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+      }
+      if (mTimeStampParam_X.RxHardware_B)
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+      }
+      if (mTimeStampParam_X.TxSoftware_B)
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE;
+      }
+      if (mTimeStampParam_X.TxHardware_B)
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE;
+      }
+      if (mTimeStampParam_X.TxSched_B)
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_TX_SCHED | SOF_TIMESTAMPING_SOFTWARE;
+      }
+      if ((mTimeStampParam_X.TxAck_B) && (mStream_B))
+      {
+        Flag_U32 |= SOF_TIMESTAMPING_TX_ACK | SOF_TIMESTAMPING_SOFTWARE;
+      }
+      mErrorCode_E = (setsockopt(mSocket, SOL_SOCKET, SO_TIMESTAMPING, &Flag_U32, sizeof(Flag_U32)) == 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+    }
+#endif
+  }
+
+#if BOF_SOCKET_TIMESTAMP_AVAILABLE
+  static BOFERR S_WaitFor(BOFSOCKET _Socket, short _Event_i, uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+    struct pollfd Fd_X;
+    int Sts_i;
+
+    if (_TimeoutInMs_U32)
+    {
+      Fd_X.fd = _Socket;
+      Fd_X.events = _Event_i;
+      Fd_X.revents = 0;
+      do
+      {
+        Sts_i = poll(&Fd_X, 1, static_cast<int>(_TimeoutInMs_U32));
+      } while ((Sts_i < 0) && (errno == EINTR));
+      if (Sts_i == 0)
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+      }
+      else if (Sts_i < 0)
+      {
+        Rts_E = static_cast<BOFERR>(errno);
+      }
+    }
+    return Rts_E;
+  }
+
+  static void S_SockAddrToSocketAddress(const struct sockaddr_storage &_rPeer_X, socklen_t _Len, BOF_SOCKET_ADDRESS &_rAddress_X)
+  {
+    _rAddress_X.Reset();
+    if ((_rPeer_X.ss_family == AF_INET6) && (_Len >= sizeof(_rAddress_X.IpV6Address_X)))
+    {
+      _rAddress_X.IpV6_B = true;
+      memcpy(&_rAddress_X.IpV6Address_X, &_rPeer_X, sizeof(_rAddress_X.IpV6Address_X));
+    }
+    else if ((_rPeer_X.ss_family == AF_INET) && (_Len >= sizeof(_rAddress_X.IpV4Address_X)))
+    {
+      memcpy(&_rAddress_X.IpV4Address_X, &_rPeer_X, sizeof(_rAddress_X.IpV4Address_X));
+    }
+  }
+#endif
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the kernel zero copy transmit paths: sendfile/splice
+ * for file to socket transfers and MSG_ZEROCOPY for large user buffers.
+ *
+ * Name:        bofsocketzerocopy.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Linux only: the other platforms return BOF_ERR_NOT_SUPPORTED.
+ *              MSG_ZEROCOPY needs a 4.14 kernel for tcp. When the socket
+ *              refuses SO_ZEROCOPY the writer falls back to a copying send.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsharedbuffer.h>
+#include <bofstd/bofsocketio.h>
+#include <bofstd/bofstringformatter.h>
+#include <bofstd/bofsystem.h>
+#include <deque>
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#if defined(__linux__)
+#define BOF_SOCKET_ZERO_COPY_AVAILABLE 1
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+#else
+#define BOF_SOCKET_ZERO_COPY_AVAILABLE 0
+#endif
+
+#define BOF_SOCKET_ZERO_COPY_SPLICE_CHUNK (1024 * 1024)   /*! Maximum number of byte moved by one splice call */
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_ZERO_COPY_PARAM
+{
+  uint32_t ZeroCopyThresholdInByte_U32;  /*! Smaller writes use a plain copying send: pinning the pages costs more than copying them */
+  uint32_t MaxInFlight_U32;              /*! Maximum number of zero copy send waiting for their kernel completion */
+
+  BOF_SOCKET_ZERO_COPY_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    ZeroCopyThresholdInByte_U32 = 16 * 1024;
+    MaxInFlight_U32 = 256;
+  }
+};
+
+struct BOF_SOCKET_ZERO_COPY_STATISTIC
+{
+  uint64_t NbZeroCopyWrite_U64;
+  uint64_t NbZeroCopyByte_U64;
+  uint64_t NbCopyWrite_U64;
+  uint64_t NbCopyByte_U64;
+  uint64_t NbCompletion_U64;        /*! Number of zero copy send released by the kernel */
+  uint64_t NbKernelCopied_U64;      /*! Completions reporting that the kernel had to copy anyway (loopback, no sg nic, ...) */
+  uint64_t NbOptMemFull_U64;        /*! ENOBUFS: the kernel ran out of optmem to pin more pages */
+  uint32_t NbMaxInFlight_U32;
+  uint64_t NbError_U64;
+
+  BOF_SOCKET_ZERO_COPY_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbZeroCopyWrite_U64 = 0;
+    NbZeroCopyByte_U64 = 0;
+    NbCopyWrite_U64 = 0;
+    NbCopyByte_U64 = 0;
+    NbCompletion_U64 = 0;
+    NbKernelCopied_U64 = 0;
+    NbOptMemFull_U64 = 0;
+    NbMaxInFlight_U32 = 0;
+    NbError_U64 = 0;
+  }
+};
+
+/*** Function ***************************************************************/
+
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+// Waits for _Event_i on _Fd_i. Returns BOF_ERR_ETIMEDOUT when nothing came in _TimeoutInMs_U32 (0 does not wait)
+inline BOFERR Bof_SocketZeroCopyWaitFor(int _Fd_i, short _Event_i, uint32_t _TimeoutInMs_U32)
+{
+  BOFERR Rts_E = BOF_ERR_ETIMEDOUT;
+  struct pollfd Fd_X;
+  int Sts_i;
+
+  Fd_X.fd = _Fd_i;
+  Fd_X.events = _Event_i;
+  Fd_X.revents = 0;
+  do
+  {
+    Sts_i = poll(&Fd_X, 1, static_cast<int>(_TimeoutInMs_U32));
+  } while ((Sts_i < 0) && (errno == EINTR));
+  if (Sts_i > 0)
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+  }
+  else if (Sts_i < 0)
+  {
+    Rts_E = static_cast<BOFERR>(errno);
+  }
+  return Rts_E;
+}
+
+inline uint32_t Bof_SocketZeroCopyRemainingTime(uint32_t _Start_U32, uint32_t _TimeoutInMs_U32)
+{
+  uint32_t Elapsed_U32 = Bof_ElapsedMsTime(_Start_U32);
+
+  return (Elapsed_U32 < _TimeoutInMs_U32) ? (_TimeoutInMs_U32 - Elapsed_U32) : 0;
+}
+#endif
+
+/*!
+ * Description
+ * Sends a file range on a socket with sendfile: the page cache pages go to the socket without being copied in
+ * user space.
+ *
+ * Parameters
+ * _Socket:  Specifies the (connected) socket
+ * _FileFd_i: Specifies the file descriptor to read from. It must support mmap (regular file or block device)
+ * _Offset_U64: Specifies the file offset of the first byte. The file position is not changed.
+ * _Size_U64: Specifies the number of byte to send
+ * _TimeoutInMs_U32: Specifies the global time allowed for the transfer
+ * _rNbSent_U64: Returns the number of byte sent
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the whole range was sent, BOF_ERR_EOF if the file is shorter, BOF_ERR_ETIMEDOUT on timeout
+ */
+inline BOFERR Bof_SocketSendFile(BOFSOCKET _Socket, int _FileFd_i, uint64_t _Offset_U64, uint64_t _Size_U64, uint32_t _TimeoutInMs_U32, uint64_t &_rNbSent_U64)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+  uint32_t Start_U32;
+  off_t Offset;
+  ssize_t Sts;
+  size_t Nb;
+
+  _rNbSent_U64 = 0;
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_Socket != BOFSOCKET_INVALID) && (_FileFd_i >= 0))
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+    Offset = static_cast<off_t>(_Offset_U64);
+    Start_U32 = Bof_GetMsTickCount();
+    while ((Rts_E == BOF_ERR_NO_ERROR) && (_rNbSent_U64 < _Size_U64))
+    {
+      Nb = static_cast<size_t>(((_Size_U64 - _rNbSent_U64) > 0x7FFFF000) ? 0x7FFFF000 : (_Size_U64 - _rNbSent_U64));
+      Sts = sendfile(_Socket, _FileFd_i, &Offset, Nb);
+      if (Sts > 0)
+      {
+        _rNbSent_U64 += static_cast<uint64_t>(Sts);
+      }
+      else if (Sts == 0)
+      {
+        Rts_E = BOF_ERR_EOF;
+      }
+      else if ((errno == EAGAIN) || (errno == EINTR))
+      {
+        Rts_E = Bof_SocketZeroCopyWaitFor(_Socket, POLLOUT, Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+      }
+      else
+      {
+        Rts_E = static_cast<BOFERR>(errno);
+      }
+    }
+  }
+#else
+  _rNbSent_U64 = 0;
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Sends a file range on a socket with sendfile. _Size_U64 equal to 0 sends up to the end of the file.
+ *
+ * Parameters
+ * _Socket:  Specifies the (connected) socket
+ * _rPath: Specifies the file to send
+ * _Offset_U64: Specifies the file offset of the first byte
+ * _Size_U64: Specifies the number of byte to send, 0 for the whole file from _Offset_U64
+ * _TimeoutInMs_U32: Specifies the global time allowed for the transfer
+ * _rNbSent_U64: Returns the number of byte sent
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+inline BOFERR Bof_SocketSendFile(BOFSOCKET _Socket, const BofPath &_rPath, uint64_t _Offset_U64, uint64_t _Size_U64, uint32_t _TimeoutInMs_U32, uint64_t &_rNbSent_U64)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+  struct stat Stat_X;
+  int Fd_i;
+
+  _rNbSent_U64 = 0;
+  Fd_i = open(_rPath.FullPathName(false).c_str(), O_RDONLY | O_CLOEXEC);
+  Rts_E = (Fd_i >= 0) ? BOF_ERR_NO_ERROR : static_cast<BOFERR>(errno);
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = BOF_ERR_SEEK;
+    if ((fstat(Fd_i, &Stat_X) == 0) && (_Offset_U64 <= static_cast<uint64_t>(Stat_X.st_size)))
+    {
+      if (_Size_U64 == 0)
+      {
+        _Size_U64 = static_cast<uint64_t>(Stat_X.st_size) - _Offset_U64;
+      }
+      Rts_E = Bof_SocketSendFile(_Socket, Fd_i, _Offset_U64, _Size_U64, _TimeoutInMs_U32, _rNbSent_U64);
+    }
+    close(Fd_i);
+  }
+#else
+  _rNbSent_U64 = 0;
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Sends a file range on the data channel of a BofSocketIo session (ftp data command for example) with sendfile
+ * instead of reading it in the session data buffer and pushing it through BofSocket::V_WriteData.
+ * The session last io time is refreshed so that its no io close timeout does not fire during a long transfer.
+ *
+ * Parameters
+ * _rBofSocketIo:  Specifies the connected data session
+ * _rPath: Specifies the file to send
+ * _Offset_U64: Specifies the file offset of the first byte (restart marker)
+ * _Size_U64: Specifies the number of byte to send, 0 for the whole file from _Offset_U64
+ * _TimeoutInMs_U32: Specifies the global time allowed for the transfer
+ * _rNbSent_U64: Returns the number of byte sent
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+inline BOFERR Bof_SocketIoSendFile(BofSocketIo &_rBofSocketIo, const BofPath &_rPath, uint64_t _Offset_U64, uint64_t _Size_U64, uint32_t _TimeoutInMs_U32, uint64_t &_rNbSent_U64)
+{
+  BOFERR Rts_E;
+
+  Rts_E = Bof_SocketSendFile(_rBofSocketIo.NativeSocketHandle(), _rPath, _Offset_U64, _Size_U64, _TimeoutInMs_U32, _rNbSent_U64);
+  if (_rNbSent_U64)
+  {
+    _rBofSocketIo.LastIoTimeInMs(Bof_GetMsTickCount());
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Moves data from any file descriptor (socket, pipe, character device, ...) to a socket through an internal pipe
+ * with splice, without copying it in user space. Use it where sendfile refuses the source (socket to socket relay).
+ *
+ * Parameters
+ * _InFd_i:  Specifies the source file descriptor
+ * _Socket:  Specifies the destination socket
+ * _Size_U64: Specifies the number of byte to move
+ * _TimeoutInMs_U32: Specifies the global time allowed for the transfer
+ * _rNbSent_U64: Returns the number of byte written to _Socket
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the whole size was moved, BOF_ERR_EOF if the source ended before
+ */
+inline BOFERR Bof_SocketSplice(int _InFd_i, BOFSOCKET _Socket, uint64_t _Size_U64, uint32_t _TimeoutInMs_U32, uint64_t &_rNbSent_U64)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+  int pPipe_i[2];
+  uint32_t Start_U32;
+  uint64_t NbInPipe_U64, NbRead_U64;
+  ssize_t Sts;
+  size_t Nb;
+
+  _rNbSent_U64 = 0;
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_InFd_i >= 0) && (_Socket != BOFSOCKET_INVALID))
+  {
+    Rts_E = BOF_ERR_CREATE;
+    if (pipe2(pPipe_i, O_CLOEXEC | O_NONBLOCK) == 0)
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      NbRead_U64 = 0;
+      NbInPipe_U64 = 0;
+      Start_U32 = Bof_GetMsTickCount();
+      while ((Rts_E == BOF_ERR_NO_ERROR) && (_rNbSent_U64 < _Size_U64))
+      {
+        if ((NbInPipe_U64 == 0) && (NbRead_U64 < _Size_U64))
+        {
+          Nb = static_cast<size_t>(((_Size_U64 - NbRead_U64) > BOF_SOCKET_ZERO_COPY_SPLICE_CHUNK) ? BOF_SOCKET_ZERO_COPY_SPLICE_CHUNK : (_Size_U64 - NbRead_U64));
+          Sts = splice(_InFd_i, nullptr, pPipe_i[1], nullptr, Nb, SPLICE_F_MOVE | SPLICE_F_MORE | SPLICE_F_NONBLOCK);
+          if (Sts > 0)
+          {
+            NbRead_U64 += static_cast<uint64_t>(Sts);
+            NbInPipe_U64 += static_cast<uint64_t>(Sts);
+          }
+          else if (Sts == 0)
+          {
+            Rts_E = BOF_ERR_EOF;
+          }
+          else if ((errno == EAGAIN) || (errno == EINTR))
+          {
+            Rts_E = Bof_SocketZeroCopyWaitFor(_InFd_i, POLLIN, Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+          }
+          else
+          {
+            Rts_E = static_cast<BOFERR>(errno);
+          }
+        }
+        else
+        {
+          Sts = splice(pPipe_i[0], nullptr, _Socket, nullptr, static_cast<size_t>(NbInPipe_U64), SPLICE_F_MOVE | SPLICE_F_MORE | SPLICE_F_NONBLOCK);
+          if (Sts > 0)
+          {
+            _rNbSent_U64 += static_cast<uint64_t>(Sts);
+            NbInPipe_U64 -= static_cast<uint64_t>(Sts);
+          }
+          else if ((Sts < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+          {
+            Rts_E = Bof_SocketZeroCopyWaitFor(_Socket, POLLOUT, Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+          }
+          else
+          {
+            Rts_E = (Sts < 0) ? static_cast<BOFERR>(errno) : BOF_ERR_WRITE;
+          }
+        }
+      }
+      close(pPipe_i[0]);
+      close(pPipe_i[1]);
+    }
+  }
+#else
+  _rNbSent_U64 = 0;
+#endif
+  return Rts_E;
+}
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * MSG_ZEROCOPY socket writer
+ *
+ * Description
+ * Sends BofSharedBuffer views with MSG_ZEROCOPY: the kernel transmits straight from the user pages, so the pages
+ * must not be modified or freed before the kernel reports that it is done with them on the socket error queue.
+ * The writer keeps a reference on each buffer sent (its own BofSharedBuffer copy, no data copy) and drops it when
+ * the matching completion is read, so the storage goes back to its allocator only after the transmission.
+ * Completions are reaped on each Write and by ProcessCompletion/Flush. Writes smaller than
+ * ZeroCopyThresholdInByte_U32 use a plain send as page pinning does not pay off for them.
+ * An object is not thread safe and must be the only writer of its socket.
+ *
+ * See Also
+ * BofSharedBuffer, Bof_SocketSendFile
+ */
+class BofSocketZeroCopyWriter
+{
+private:
+  struct ZERO_COPY_ENTRY
+  {
+    uint32_t        Id_U32;
+    bool            Done_B;
+    BofSharedBuffer Buffer;
+  };
+
+  BOFSOCKET                      mSocket;
+  BOF_SOCKET_ZERO_COPY_PARAM     mSocketZeroCopyParam_X;
+  BOFERR                         mErrorCode_E = BOF_ERR_INIT;
+  bool                           mZeroCopy_B = false;
+  uint32_t                       mNextId_U32 = 0;
+  std::deque<ZERO_COPY_ENTRY>    mInFlightCollection;
+  BOF_SOCKET_ZERO_COPY_STATISTIC mSocketZeroCopyStatistic_X;
+
+public:
+  BofSocketZeroCopyWriter(BOFSOCKET _Socket, const BOF_SOCKET_ZERO_COPY_PARAM &_rSocketZeroCopyParam_X)
+  {
+    Open(_Socket, _rSocketZeroCopyParam_X);
+  }
+  BofSocketZeroCopyWriter(BofSocket &_rBofSocket, const BOF_SOCKET_ZERO_COPY_PARAM &_rSocketZeroCopyParam_X)
+  {
+    Open(_rBofSocket.GetSocketHandle(), _rSocketZeroCopyParam_X);
+  }
+  virtual ~BofSocketZeroCopyWriter()
+  {
+    // The pages may still be referenced by the kernel: give it a chance to finish before releasing the buffers
+    Flush(1000);
+  }
+  BofSocketZeroCopyWriter &operator=(const BofSocketZeroCopyWriter &) = delete; // Disallow copying
+  BofSocketZeroCopyWriter(const BofSocketZeroCopyWriter &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+  bool IsZeroCopy() const
+  {
+    return mZeroCopy_B;
+  }
+  uint32_t NbInFlight() const
+  {
+    return static_cast<uint32_t>(mInFlightCollection.size());
+  }
+
+  /*!
+   * Description
+   * Sends the whole view. The buffer can be released by the caller as soon as the call returns: the writer keeps
+   * its own reference until the kernel completion.
+   *
+   * Parameters
+   * _TimeoutInMs_U32:  Specifies the time allowed to push the whole buffer in the socket
+   * _rBuffer: Specifies the data to send
+   * _rNbWritten_U64:  Returns the number of byte accepted by the kernel
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if the whole buffer was written, BOF_ERR_ETIMEDOUT if the socket stayed full.
+   */
+  BOFERR Write(uint32_t _TimeoutInMs_U32, const BofSharedBuffer &_rBuffer, uint64_t &_rNbWritten_U64)
+  {
+    BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+    ZERO_COPY_ENTRY Entry_X;
+    uint32_t Start_U32;
+    bool ZeroCopy_B;
+    ssize_t Sts;
+    int Flag_i;
+
+    _rNbWritten_U64 = 0;
+    Rts_E = (mErrorCode_E == BOF_ERR_NO_ERROR) ? BOF_ERR_EINVAL : mErrorCode_E;
+    if ((mErrorCode_E == BOF_ERR_NO_ERROR) && (!_rBuffer.IsNull()))
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      Start_U32 = Bof_GetMsTickCount();
+      ZeroCopy_B = (mZeroCopy_B) && (_rBuffer.Size() >= mSocketZeroCopyParam_X.ZeroCopyThresholdInByte_U32);
+      Flag_i = ZeroCopy_B ? (MSG_ZEROCOPY | MSG_DONTWAIT | MSG_NOSIGNAL) : (MSG_DONTWAIT | MSG_NOSIGNAL);
+      ReapCompletion();
+      while ((Rts_E == BOF_ERR_NO_ERROR) && (_rNbWritten_U64 < _rBuffer.Size()))
+      {
+        if ((ZeroCopy_B) && (mInFlightCollection.size() >= mSocketZeroCopyParam_X.MaxInFlight_U32))
+        {
+          Rts_E = WaitForCompletion(Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+        }
+        else
+        {
+          Sts = send(mSocket, _rBuffer.Data() + _rNbWritten_U64, static_cast<size_t>(_rBuffer.Size() - _rNbWritten_U64), Flag_i);
+          if (Sts > 0)
+          {
+            if (ZeroCopy_B)
+            {
+              // Each successful MSG_ZEROCOPY send, even partial, consumes one completion id
+              Entry_X.Id_U32 = mNextId_U32++;
+              Entry_X.Done_B = false;
+              Entry_X.Buffer = _rBuffer;
+              mInFlightCollection.push_back(std::move(Entry_X));
+              if (mInFlightCollection.size() > mSocketZeroCopyStatistic_X.NbMaxInFlight_U32)
+              {
+                mSocketZeroCopyStatistic_X.NbMaxInFlight_U32 = static_cast<uint32_t>(mInFlightCollection.size());
+              }
+              mSocketZeroCopyStatistic_X.NbZeroCopyWrite_U64++;
+              mSocketZeroCopyStatistic_X.NbZeroCopyByte_U64 += static_cast<uint64_t>(Sts);
+            }
+            else
+            {
+              mSocketZeroCopyStatistic_X.NbCopyWrite_U64++;
+              mSocketZeroCopyStatistic_X.NbCopyByte_U64 += static_cast<uint64_t>(Sts);
+            }
+            _rNbWritten_U64 += static_cast<uint64_t>(Sts);
+          }
+          else if ((Sts < 0) && (errno == ENOBUFS) && (ZeroCopy_B))
+          {
+            mSocketZeroCopyStatistic_X.NbOptMemFull_U64++;
+            Rts_E = WaitForCompletion(Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+          }
+          else if ((Sts < 0) && ((errno == EAGAIN) || (errno == EINTR)))
+          {
+            Rts_E = Bof_SocketZeroCopyWaitFor(mSocket, POLLOUT, Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+            ReapCompletion();
+          }
+          else
+          {
+            Rts_E = (Sts < 0) ? static_cast<BOFERR>(errno) : BOF_ERR_WRITE;
+          }
+        }
+      }
+      if (Rts_E != BOF_ERR_NO_ERROR)
+      {
+        mSocketZeroCopyStatistic_X.NbError_U64++;
+      }
+    }
+#else
+    _rNbWritten_U64 = 0;
+#endif
+    return Rts_E;
+  }
+
+  /*!
+   * Description
+   * Reads the pending completions without waiting and releases the buffers the kernel is done with.
+   *
+   * Parameters
+   * None
+   *
+   * Returns
+   * uint32_t: The number of zero copy send completed by this call
+   */
+  uint32_t ProcessCompletion()
+  {
+    return ReapCompletion();
+  }
+
+  /*!
+   * Description
+   * Waits until every zero copy send has been completed by the kernel.
+   *
+   * Parameters
+   * _TimeoutInMs_U32:  Specifies the maximum time to wait
+   *
+   * Returns
+   * BOFERR: BOF_ERR_NO_ERROR if nothing is in flight anymore, BOF_ERR_ETIMEDOUT otherwise
+   */
+  BOFERR Flush(uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+    uint32_t Start_U32;
+
+    Start_U32 = Bof_GetMsTickCount();
+    ReapCompletion();
+    while ((Rts_E == BOF_ERR_NO_ERROR) && (!mInFlightCollection.empty()))
+    {
+      Rts_E = WaitForCompletion(Bof_SocketZeroCopyRemainingTime(Start_U32, _TimeoutInMs_U32));
+    }
+#endif
+    return Rts_E;
+  }
+
+  BOF_SOCKET_ZERO_COPY_STATISTIC SocketZeroCopyStatistic() const
+  {
+    return mSocketZeroCopyStatistic_X;
+  }
+  void ResetSocketZeroCopyStatistic()
+  {
+    mSocketZeroCopyStatistic_X.Reset();
+  }
+  std::string SocketZeroCopyDebugInfo() const
+  {
+    const BOF_SOCKET_ZERO_COPY_STATISTIC &rStat_X = mSocketZeroCopyStatistic_X;
+
+    return Bof_Sprintf("Zc %d InFlight %d/%d max %d Zc %lld wr %lld B Copy %lld wr %lld B Cpl %lld kcopied %lld OptMem %lld Err %lld", mZeroCopy_B, static_cast<uint32_t>(mInFlightCollection.size()),
+                       mSocketZeroCopyParam_X.MaxInFlight_U32, rStat_X.NbMaxInFlight_U32, rStat_X.NbZeroCopyWrite_U64, rStat_X.NbZeroCopyByte_U64, rStat_X.NbCopyWrite_U64, rStat_X.NbCopyByte_U64,
+                       rStat_X.NbCompletion_U64, rStat_X.NbKernelCopied_U64, rStat_X.NbOptMemFull_U64, rStat_X.NbError_U64);
+  }
+
+private:
+  void Open(BOFSOCKET _Socket, const BOF_SOCKET_ZERO_COPY_PARAM &_rSocketZeroCopyParam_X)
+  {
+    mSocket = _Socket;
+    mSocketZeroCopyParam_X = _rSocketZeroCopyParam_X;
+    mErrorCode_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+    int Val_i;
+
+    mErrorCode_E = BOF_ERR_EINVAL;
+    if ((mSocket != BOFSOCKET_INVALID) && (mSocketZeroCopyParam_X.MaxInFlight_U32))
+    {
+      mErrorCode_E = BOF_ERR_NO_ERROR;
+      Val_i = 1;
+      mZeroCopy_B = (setsockopt(mSocket, SOL_SOCKET, SO_ZEROCOPY, &Val_i, sizeof(Val_i)) == 0);
+    }
+#endif
+  }
+
+#if BOF_SOCKET_ZERO_COPY_AVAILABLE
+  BOFERR WaitForCompletion(uint32_t _TimeoutInMs_U32)
+  {
+    BOFERR Rts_E;
+
+    // The error queue is signaled by POLLERR which poll always reports: no event to ask for
+    Rts_E = Bof_SocketZeroCopyWaitFor(mSocket, 0, _TimeoutInMs_U32);
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (ReapCompletion() == 0))
+    {
+      // POLLERR/POLLHUP without completion: a real socket error
+      Rts_E = BOF_ERR_WRITE;
+    }
+    return Rts_E;
+  }
+
+  uint32_t ReapCompletion()
+  {
+    uint32_t Rts_U32 = 0, First_U32, Last_U32;
+    uint8_t pControl_U8[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+    struct sock_extended_err *pErr_X;
+    struct cmsghdr *pCmsg_X;
+    struct msghdr Msg_X;
+    bool Again_B = true;
+
+    while ((Again_B) && (!mInFlightCollection.empty()))
+    {
+      memset(&Msg_X, 0, sizeof(Msg_X));
+      Msg_X.msg_control = pControl_U8;
+      Msg_X.msg_controllen = sizeof(pControl_U8);
+      Again_B = (recvmsg(mSocket, &Msg_X, MSG_ERRQUEUE | MSG_DONTWAIT) >= 0);
+      if (Again_B)
+      {
+        for (pCmsg_X = CMSG_FIRSTHDR(&Msg_X); pCmsg_X != nullptr; pCmsg_X = CMSG_NXTHDR(&Msg_X, pCmsg_X))
+        {
+          if (((pCmsg_X->cmsg_level == SOL_IP) && (pCmsg_X->cmsg_type == IP_RECVERR)) || ((pCmsg_X->cmsg_level == SOL_IPV6) && (pCmsg_X->cmsg_type == IPV6_RECVERR)))
+          {
+            pErr_X = reinterpret_cast<struct sock_extended_err *>(CMSG_DATA(pCmsg_X));
+            if ((pErr_X->ee_errno == 0) && (pErr_X->ee_origin == SO_EE_ORIGIN_ZEROCOPY))
+            {
+              // ee_info..ee_data is the inclusive range of completed ids
+              First_U32 = pErr_X->ee_info;
+              Last_U32 = pErr_X->ee_data;
+              Rts_U32 += Complete(First_U32, Last_U32);
+              if (pErr_X->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+              {
+                mSocketZeroCopyStatistic_X.NbKernelCopied_U64 += (Last_U32 - First_U32) + 1;
+              }
+            }
+          }
+        }
+      }
+    }
+    return Rts_U32;
+  }
+
+  uint32_t Complete(uint32_t _First_U32, uint32_t _Last_U32)
+  {
+    uint32_t Rts_U32 = 0;
+
+    for (ZERO_COPY_ENTRY &rEntry_X : mInFlightCollection)
+    {
+      // Unsigned differences keep the test right when the 32 bit id wraps
+      if ((!rEntry_X.Done_B) && ((rEntry_X.Id_U32 - _First_U32) <= (_Last_U32 - _First_U32)))
+      {
+        rEntry_X.Done_B = true;
+        rEntry_X.Buffer.Release();
+        Rts_U32++;
+      }
+    }
+    while ((!mInFlightCollection.empty()) && (mInFlightCollection.front().Done_B))
+    {
+      mInFlightCollection.pop_front();
+    }
+    mSocketZeroCopyStatistic_X.NbCompletion_U64 += Rts_U32;
+    return Rts_U32;
+  }
+#endif
+};
+
+END_BOF_NAMESPACE()
@@ -0,0 +1,768 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines a hierarchical timing wheel used to manage a large
+ * number of timeouts with O(1) schedule and cancel.
+ *
+ * Name:        boftimingwheel.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofstd.h>
+#include <bofstd/bofsystem.h>
+#include <bofstd/bofthread.h>
+#include <bofstd/bofstatistics.h>
+#include <bofstd/bofstringformatter.h>
+#include <functional>
+#include <vector>
+
+BEGIN_BOF_NAMESPACE()
+
+#define BOF_TIMING_WHEEL_LOCK(Sts)   {Sts=mTimingWheelParam_X.MultiThreadAware_B ? Bof_LockMutex(mTwMtx_X):BOF_ERR_NO_ERROR;}
+#define BOF_TIMING_WHEEL_UNLOCK()    {if (mTimingWheelParam_X.MultiThreadAware_B) Bof_UnlockMutex(mTwMtx_X);}
+
+/*** Define *****************************************************************/
+
+typedef uint64_t BOF_TIMER_HANDLE;                  /*! Generation (32 msb) | timer index (32 lsb). 0 is never a valid handle */
+constexpr BOF_TIMER_HANDLE BOF_TIMER_HANDLE_INVALID = 0;
+
+constexpr uint32_t BOF_TIMING_WHEEL_ROOT_BIT = 8;   /*! Level 0: 256 slots of 1 tick */
+constexpr uint32_t BOF_TIMING_WHEEL_LEVEL_BIT = 6;  /*! Level 1..3: 64 slots, each one covering the full range of the level below */
+constexpr uint32_t BOF_TIMING_WHEEL_NB_LEVEL = 4;
+constexpr uint32_t BOF_TIMING_WHEEL_ROOT_SIZE = (1 << BOF_TIMING_WHEEL_ROOT_BIT);
+constexpr uint32_t BOF_TIMING_WHEEL_LEVEL_SIZE = (1 << BOF_TIMING_WHEEL_LEVEL_BIT);
+constexpr uint32_t BOF_TIMING_WHEEL_NB_SLOT = BOF_TIMING_WHEEL_ROOT_SIZE + ((BOF_TIMING_WHEEL_NB_LEVEL - 1) * BOF_TIMING_WHEEL_LEVEL_SIZE);
+constexpr uint64_t BOF_TIMING_WHEEL_MAX_TICK = (1ULL << (BOF_TIMING_WHEEL_ROOT_BIT + ((BOF_TIMING_WHEEL_NB_LEVEL - 1) * BOF_TIMING_WHEEL_LEVEL_BIT))) - 1;
+
+/*** Structure **************************************************************/
+
+struct BOF_TIMING_WHEEL_EXPIRED
+{
+  BOF_TIMER_HANDLE TimerHandle;                     /*! Handle returned by Schedule. It is no more valid when the callback is called */
+  void             *pUserArg;                       /*! Value given to Schedule */
+  uint32_t         LateInMs_U32;                    /*! Delay between the programmed expiry time and the moment it has been detected */
+};
+
+//Called once per Advance call with all the timers expired during this call. It is called without any internal lock held so
+//Schedule/Cancel can be called from it.
+typedef std::function<void(const std::vector<BOF_TIMING_WHEEL_EXPIRED> &_rExpiredCollection)> BOF_TIMING_WHEEL_CALLBACK;
+
+//Called by Schedule/Reschedule, without any internal lock held, when the new timer expires before the deadline returned by
+//the last NextExpiryInMs call: the thread sleeping on this deadline must be woken up to recompute its wait.
+typedef std::function<void()> BOF_TIMING_WHEEL_WAKE_UP_CALLBACK;
+
+struct BOF_TIMING_WHEEL_PARAM
+{
+  bool                      MultiThreadAware_B;     /*! true if Schedule/Cancel can be called from another thread than the one calling Advance */
+  uint32_t                  TickInMs_U32;           /*! Timer resolution. A timer never expires before its delay but can expire up to one tick later */
+  uint32_t                  NbMaxTimer_U32;         /*! Number of timer which can be armed at the same time (preallocated) */
+  BOF_TIMING_WHEEL_CALLBACK OnExpired;              /*! Batched expiry callback */
+  BOF_TIMING_WHEEL_WAKE_UP_CALLBACK OnWakeUp;       /*! Optional: wakes up the thread waiting for NextExpiryInMs when an earlier timer is armed */
+
+  BOF_TIMING_WHEEL_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    MultiThreadAware_B = false;
+    TickInMs_U32       = 10;
+    NbMaxTimer_U32     = 0;
+    OnExpired          = nullptr;
+    OnWakeUp           = nullptr;
+  }
+};
+
+struct BOF_TIMING_WHEEL_STATISTIC
+{
+  uint32_t NbArmed_U32;                             /*! Current number of armed timer */
+  uint32_t NbMaxArmed_U32;                          /*! Maximum number of armed timer seen */
+  uint64_t NbSchedule_U64;
+  uint64_t NbCancel_U64;
+  uint64_t NbExpired_U64;
+  uint64_t NbCascade_U64;                           /*! Number of timer moved from an upper level to a lower one */
+  uint64_t NbScheduleError_U64;                     /*! Schedule failed because NbMaxTimer_U32 timers were already armed */
+  uint32_t MaxLateInMs_U32;
+
+  BOF_TIMING_WHEEL_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbArmed_U32         = 0;
+    NbMaxArmed_U32      = 0;
+    NbSchedule_U64      = 0;
+    NbCancel_U64        = 0;
+    NbExpired_U64       = 0;
+    NbCascade_U64       = 0;
+    NbScheduleError_U64 = 0;
+    MaxLateInMs_U32     = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+/*!
+ * Summary
+ * Hierarchical timing wheel
+ *
+ * Description
+ * Timers are linked in the slot corresponding to their expiry tick. Level 0 has one slot per tick,
+ * each upper level slot covers the whole range of the level below. When level 0 wraps, the next upper
+ * slot is cascaded down. Schedule, Cancel and Reschedule are O(1), expiry cost is proportional to the
+ * number of expired timer and all the timers expired during an Advance call are reported in one batch.
+ *
+ * Advance must be called periodically, either by a BofTimingWheelThread or by an existing loop (socket
+ * poller for example) which can use NextExpiryInMs to compute its wait timeout.
+ *
+ * See Also
+ * BofTimingWheelThread
+ */
+class BofTimingWheel
+{
+private:
+  static constexpr uint32_t NO_INDEX = 0xFFFFFFFF;
+
+  struct TIMER_NODE
+  {
+    uint32_t Prev_U32;
+    uint32_t Next_U32;
+    uint32_t Slot_U32;                              /*! Slot owning the node, NO_INDEX if free */
+    uint32_t Generation_U32;
+    uint64_t ExpireTick_U64;
+    void     *pUserArg;
+  };
+
+  BOF_TIMING_WHEEL_PARAM      mTimingWheelParam_X;
+  BOF_MUTEX                   mTwMtx_X;                       /*! Provide a serialized access to shared resources in a multi threaded environment*/
+  BOFERR                      mErrorCode_E;
+  std::vector<TIMER_NODE>     mTimerCollection;
+  uint32_t                    mFirstFree_U32;
+  uint32_t                    mpSlotHead_U32[BOF_TIMING_WHEEL_NB_SLOT];
+  uint64_t                    mpRootOccupancy_U64[BOF_TIMING_WHEEL_ROOT_SIZE / 64];  /*! One bit per non empty level 0 slot, used by NextExpiryInMs */
+  uint64_t                    mCrtTick_U64;                   /*! Next tick to process */
+  uint64_t                    mElapsedInMs_U64;              /*! Time elapsed since creation, rebuilt from the 32 bits ms tick count */
+  uint32_t                    mLastTimeInMs_U32;
+  uint64_t                    mWaitDeadlineInMs_U64;         /*! Elapsed time at which the waiter of the last NextExpiryInMs call wakes up */
+  BOF_TIMING_WHEEL_STATISTIC  mStatistic_X;
+  std::vector<BOF_TIMING_WHEEL_EXPIRED> mExpiredCollection;  /*! Kept between Advance calls to avoid reallocation */
+
+public:
+  BofTimingWheel(const BOF_TIMING_WHEEL_PARAM &_rTimingWheelParam_X);
+  virtual ~BofTimingWheel();
+
+  BofTimingWheel &operator=(const BofTimingWheel &) = delete; // Disallow copying
+  BofTimingWheel(const BofTimingWheel &) = delete;
+
+  BOFERR LastErrorCode() const;
+  BOFERR Schedule(uint32_t _DelayInMs_U32, void *_pUserArg, BOF_TIMER_HANDLE &_rTimerHandle);
+  BOFERR Reschedule(BOF_TIMER_HANDLE _TimerHandle, uint32_t _DelayInMs_U32);
+  BOFERR Cancel(BOF_TIMER_HANDLE _TimerHandle);
+  bool   IsArmed(BOF_TIMER_HANDLE _TimerHandle);
+  uint32_t Advance();
+  uint32_t Advance(uint32_t _NowInMs_U32);
+  uint32_t NextExpiryInMs(uint32_t _MaxWaitInMs_U32);
+  uint32_t TickInMs() const;
+  BOF_TIMING_WHEEL_STATISTIC Statistic();
+  void ResetStatistic();
+  std::string TimingWheelDebugInfo();
+
+private:
+  void UpdateElapsedTime(uint32_t _NowInMs_U32);
+  uint64_t DelayToTick(uint32_t _DelayInMs_U32) const;
+  uint32_t SlotOf(uint64_t _ExpireTick_U64) const;
+  void Link(uint32_t _Index_U32);
+  void Unlink(uint32_t _Index_U32);
+  void Cascade(uint32_t _Level_U32);
+  uint32_t IndexOf(BOF_TIMER_HANDLE _TimerHandle) const;
+  bool IsBeforeWaitDeadline(uint64_t _ExpireTick_U64);
+};
+
+inline BofTimingWheel::BofTimingWheel(const BOF_TIMING_WHEEL_PARAM &_rTimingWheelParam_X)
+{
+  uint32_t i_U32;
+
+  mTimingWheelParam_X = _rTimingWheelParam_X;
+  mFirstFree_U32      = NO_INDEX;
+  mCrtTick_U64        = 0;
+  mElapsedInMs_U64    = 0;
+  mLastTimeInMs_U32   = Bof_GetMsTickCount();
+  mWaitDeadlineInMs_U64 = 0xFFFFFFFFFFFFFFFFULL;
+  for (i_U32 = 0; i_U32 < BOF_TIMING_WHEEL_NB_SLOT; i_U32++)
+  {
+    mpSlotHead_U32[i_U32] = NO_INDEX;
+  }
+  memset(mpRootOccupancy_U64, 0, sizeof(mpRootOccupancy_U64));
+
+  mErrorCode_E = BOF_ERR_EINVAL;
+  if ((mTimingWheelParam_X.TickInMs_U32) && (mTimingWheelParam_X.NbMaxTimer_U32) && (mTimingWheelParam_X.NbMaxTimer_U32 < NO_INDEX) && (mTimingWheelParam_X.OnExpired))
+  {
+    mErrorCode_E = mTimingWheelParam_X.MultiThreadAware_B ? Bof_CreateMutex("BofTimingWheel", true, true, mTwMtx_X) : BOF_ERR_NO_ERROR;
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      mTimerCollection.resize(mTimingWheelParam_X.NbMaxTimer_U32);
+      for (i_U32 = 0; i_U32 < mTimingWheelParam_X.NbMaxTimer_U32; i_U32++)
+      {
+        mTimerCollection[i_U32].Prev_U32       = NO_INDEX;
+        mTimerCollection[i_U32].Next_U32       = (i_U32 + 1 < mTimingWheelParam_X.NbMaxTimer_U32) ? i_U32 + 1 : NO_INDEX;
+        mTimerCollection[i_U32].Slot_U32       = NO_INDEX;
+        mTimerCollection[i_U32].Generation_U32 = 1;
+        mTimerCollection[i_U32].ExpireTick_U64 = 0;
+        mTimerCollection[i_U32].pUserArg       = nullptr;
+      }
+      mFirstFree_U32 = 0;
+      mExpiredCollection.reserve(256);
+    }
+  }
+}
+
+inline BofTimingWheel::~BofTimingWheel()
+{
+  Bof_DestroyMutex(mTwMtx_X);
+}
+
+inline BOFERR BofTimingWheel::LastErrorCode() const
+{
+  return mErrorCode_E;
+}
+
+inline uint32_t BofTimingWheel::TickInMs() const
+{
+  return mTimingWheelParam_X.TickInMs_U32;
+}
+
+/*!
+ * Description
+ * Arm a one shot timer. To get a periodic timer, call Reschedule or Schedule from the expiry callback.
+ *
+ * Parameters
+ * _DelayInMs_U32:  Specifies the delay after which the timer expires (rounded up to the next tick).
+ * _pUserArg:       Specifies a value given back in BOF_TIMING_WHEEL_EXPIRED.
+ * _rTimerHandle:   Returns the timer handle.
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_FULL if NbMaxTimer_U32 timers are armed
+ */
+inline BOFERR BofTimingWheel::Schedule(uint32_t _DelayInMs_U32, void *_pUserArg, BOF_TIMER_HANDLE &_rTimerHandle)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+  bool     WakeUp_B = false;
+
+  _rTimerHandle = BOF_TIMER_HANDLE_INVALID;
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    BOF_TIMING_WHEEL_LOCK(Rts_E);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = mFirstFree_U32;
+      if (Index_U32 == NO_INDEX)
+      {
+        mStatistic_X.NbScheduleError_U64++;
+        Rts_E = BOF_ERR_FULL;
+      }
+      else
+      {
+        TIMER_NODE &rTimer_X = mTimerCollection[Index_U32];
+
+        mFirstFree_U32         = rTimer_X.Next_U32;
+        rTimer_X.ExpireTick_U64 = mCrtTick_U64 + DelayToTick(_DelayInMs_U32);
+        rTimer_X.pUserArg       = _pUserArg;
+        Link(Index_U32);
+        _rTimerHandle = (static_cast<uint64_t>(rTimer_X.Generation_U32) << 32) | Index_U32;
+        WakeUp_B      = IsBeforeWaitDeadline(rTimer_X.ExpireTick_U64);
+
+        mStatistic_X.NbSchedule_U64++;
+        mStatistic_X.NbArmed_U32++;
+        BOF_SET_NEW_STAT_MAX(mStatistic_X.NbArmed_U32, mStatistic_X.NbMaxArmed_U32);
+      }
+      BOF_TIMING_WHEEL_UNLOCK();
+      if (WakeUp_B)
+      {
+        mTimingWheelParam_X.OnWakeUp();
+      }
+    }
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Move an armed timer to a new expiry time, relative to now. This is cheaper than Cancel+Schedule and keeps the handle.
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_NOT_FOUND if the timer has already expired or been canceled
+ */
+inline BOFERR BofTimingWheel::Reschedule(BOF_TIMER_HANDLE _TimerHandle, uint32_t _DelayInMs_U32)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+  bool     WakeUp_B = false;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    BOF_TIMING_WHEEL_LOCK(Rts_E);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = IndexOf(_TimerHandle);
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        Unlink(Index_U32);
+        mTimerCollection[Index_U32].ExpireTick_U64 = mCrtTick_U64 + DelayToTick(_DelayInMs_U32);
+        Link(Index_U32);
+        WakeUp_B = IsBeforeWaitDeadline(mTimerCollection[Index_U32].ExpireTick_U64);
+      }
+      BOF_TIMING_WHEEL_UNLOCK();
+      if (WakeUp_B)
+      {
+        mTimingWheelParam_X.OnWakeUp();
+      }
+    }
+  }
+  return Rts_E;
+}
+
+inline BOFERR BofTimingWheel::Cancel(BOF_TIMER_HANDLE _TimerHandle)
+{
+  BOFERR   Rts_E = mErrorCode_E;
+  uint32_t Index_U32;
+
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    BOF_TIMING_WHEEL_LOCK(Rts_E);
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Index_U32 = IndexOf(_TimerHandle);
+      if (Index_U32 == NO_INDEX)
+      {
+        Rts_E = BOF_ERR_NOT_FOUND;
+      }
+      else
+      {
+        TIMER_NODE &rTimer_X = mTimerCollection[Index_U32];
+
+        Unlink(Index_U32);
+        rTimer_X.Generation_U32++;
+        if (rTimer_X.Generation_U32 == 0)
+        {
+          rTimer_X.Generation_U32 = 1;
+        }
+        rTimer_X.Next_U32 = mFirstFree_U32;
+        mFirstFree_U32    = Index_U32;
+        mStatistic_X.NbCancel_U64++;
+        mStatistic_X.NbArmed_U32--;
+      }
+      BOF_TIMING_WHEEL_UNLOCK();
+    }
+  }
+  return Rts_E;
+}
+
+inline bool BofTimingWheel::IsArmed(BOF_TIMER_HANDLE _TimerHandle)
+{
+  bool   Rts_B = false;
+  BOFERR Sts_E;
+
+  BOF_TIMING_WHEEL_LOCK(Sts_E);
+  if (Sts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_B = (IndexOf(_TimerHandle) != NO_INDEX);
+    BOF_TIMING_WHEEL_UNLOCK();
+  }
+  return Rts_B;
+}
+
+inline uint32_t BofTimingWheel::Advance()
+{
+  return Advance(Bof_GetMsTickCount());
+}
+
+/*!
+ * Description
+ * Process all the ticks elapsed up to _NowInMs_U32 and call OnExpired once with every timer expired.
+ *
+ * Parameters
+ * _NowInMs_U32:  Specifies the current time as returned by Bof_GetMsTickCount.
+ *
+ * Returns
+ * uint32_t: The number of expired timer
+ */
+inline uint32_t BofTimingWheel::Advance(uint32_t _NowInMs_U32)
+{
+  uint32_t Rts_U32 = 0, Slot_U32, Index_U32, Level_U32, LateInMs_U32;
+  uint64_t TargetTick_U64;
+  BOFERR   Sts_E;
+  BOF_TIMING_WHEEL_EXPIRED Expired_X;
+
+  if (mErrorCode_E == BOF_ERR_NO_ERROR)
+  {
+    BOF_TIMING_WHEEL_LOCK(Sts_E);
+    if (Sts_E == BOF_ERR_NO_ERROR)
+    {
+      mExpiredCollection.clear();
+      UpdateElapsedTime(_NowInMs_U32);
+      TargetTick_U64 = mElapsedInMs_U64 / mTimingWheelParam_X.TickInMs_U32;
+      while (mCrtTick_U64 <= TargetTick_U64)
+      {
+        Slot_U32 = static_cast<uint32_t>(mCrtTick_U64 & (BOF_TIMING_WHEEL_ROOT_SIZE - 1));
+        if (Slot_U32 == 0)
+        {
+          for (Level_U32 = 1; Level_U32 < BOF_TIMING_WHEEL_NB_LEVEL; Level_U32++)
+          {
+            Cascade(Level_U32);
+            if (((mCrtTick_U64 >> (BOF_TIMING_WHEEL_ROOT_BIT + ((Level_U32 - 1) * BOF_TIMING_WHEEL_LEVEL_BIT))) & (BOF_TIMING_WHEEL_LEVEL_SIZE - 1)) != 0)
+            {
+              break;
+            }
+          }
+        }
+        while (mpSlotHead_U32[Slot_U32] != NO_INDEX)
+        {
+          Index_U32 = mpSlotHead_U32[Slot_U32];
+          TIMER_NODE &rTimer_X = mTimerCollection[Index_U32];
+
+          Unlink(Index_U32);
+          LateInMs_U32 = static_cast<uint32_t>(mElapsedInMs_U64 - (rTimer_X.ExpireTick_U64 * mTimingWheelParam_X.TickInMs_U32));
+          Expired_X.TimerHandle  = (static_cast<uint64_t>(rTimer_X.Generation_U32) << 32) | Index_U32;
+          Expired_X.pUserArg     = rTimer_X.pUserArg;
+          Expired_X.LateInMs_U32 = LateInMs_U32;
+          mExpiredCollection.push_back(Expired_X);
+          BOF_SET_NEW_STAT_MAX(LateInMs_U32, mStatistic_X.MaxLateInMs_U32);
+
+          rTimer_X.Generation_U32++;
+          if (rTimer_X.Generation_U32 == 0)
+          {
+            rTimer_X.Generation_U32 = 1;
+          }
+          rTimer_X.Next_U32 = mFirstFree_U32;
+          mFirstFree_U32    = Index_U32;
+          mStatistic_X.NbArmed_U32--;
+        }
+        mCrtTick_U64++;
+      }
+      Rts_U32 = static_cast<uint32_t>(mExpiredCollection.size());
+      mStatistic_X.NbExpired_U64 += Rts_U32;
+      BOF_TIMING_WHEEL_UNLOCK();
+
+      //Outside of the lock: the callback is allowed to Schedule/Cancel. If MultiThreadAware_B is true, Advance must be called by one thread only.
+      if (Rts_U32)
+      {
+        mTimingWheelParam_X.OnExpired(mExpiredCollection);
+      }
+    }
+  }
+  return Rts_U32;
+}
+
+/*!
+ * Description
+ * Return the time until the next level 0 timer expiry. Timers still in upper levels are not looked at, the
+ * returned value is then capped to the next level 0 wrap. This is intended to compute a poll/wait timeout.
+ *
+ * Parameters
+ * _MaxWaitInMs_U32:  Specifies the value returned if no timer is pending in level 0.
+ *
+ * Returns
+ * uint32_t: Delay in ms (0 if a tick is already due)
+ */
+inline uint32_t BofTimingWheel::NextExpiryInMs(uint32_t _MaxWaitInMs_U32)
+{
+  uint32_t Rts_U32 = _MaxWaitInMs_U32, Slot_U32, Word_U32, Bit_U32, NbTick_U32;
+  uint64_t Word_U64, ElapsedInMs_U64;
+  BOFERR   Sts_E;
+
+  if (mErrorCode_E == BOF_ERR_NO_ERROR)
+  {
+    BOF_TIMING_WHEEL_LOCK(Sts_E);
+    if (Sts_E == BOF_ERR_NO_ERROR)
+    {
+      //Number of tick before level 0 wraps and an upper level must be cascaded
+      Slot_U32   = static_cast<uint32_t>(mCrtTick_U64 & (BOF_TIMING_WHEEL_ROOT_SIZE - 1));
+      NbTick_U32 = (Slot_U32 == 0) ? 0 : BOF_TIMING_WHEEL_ROOT_SIZE - Slot_U32;
+      for (Word_U32 = Slot_U32 / 64; Word_U32 < BOF_TIMING_WHEEL_ROOT_SIZE / 64; Word_U32++)
+      {
+        Word_U64 = mpRootOccupancy_U64[Word_U32];
+        if (Word_U32 == Slot_U32 / 64)
+        {
+          Word_U64 &= ~((1ULL << (Slot_U32 % 64)) - 1);
+        }
+        if (Word_U64)
+        {
+          Bit_U32    = static_cast<uint32_t>(__builtin_ctzll(Word_U64));
+          NbTick_U32 = (Word_U32 * 64) + Bit_U32 - Slot_U32;
+          break;
+        }
+      }
+      ElapsedInMs_U64 = mElapsedInMs_U64 + Bof_ElapsedMsTime(mLastTimeInMs_U32);
+      if (((mCrtTick_U64 + NbTick_U32) * mTimingWheelParam_X.TickInMs_U32) <= ElapsedInMs_U64)
+      {
+        Rts_U32 = 0;
+      }
+      else if (((mCrtTick_U64 + NbTick_U32) * mTimingWheelParam_X.TickInMs_U32) - ElapsedInMs_U64 < Rts_U32)
+      {
+        Rts_U32 = static_cast<uint32_t>(((mCrtTick_U64 + NbTick_U32) * mTimingWheelParam_X.TickInMs_U32) - ElapsedInMs_U64);
+      }
+      mWaitDeadlineInMs_U64 = ElapsedInMs_U64 + Rts_U32;
+      BOF_TIMING_WHEEL_UNLOCK();
+    }
+  }
+  return Rts_U32;
+}
+
+inline BOF_TIMING_WHEEL_STATISTIC BofTimingWheel::Statistic()
+{
+  BOF_TIMING_WHEEL_STATISTIC Rts_X;
+  BOFERR Sts_E;
+
+  BOF_TIMING_WHEEL_LOCK(Sts_E);
+  if (Sts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_X = mStatistic_X;
+    BOF_TIMING_WHEEL_UNLOCK();
+  }
+  return Rts_X;
+}
+
+inline void BofTimingWheel::ResetStatistic()
+{
+  BOFERR   Sts_E;
+  uint32_t NbArmed_U32;
+
+  BOF_TIMING_WHEEL_LOCK(Sts_E);
+  if (Sts_E == BOF_ERR_NO_ERROR)
+  {
+    NbArmed_U32 = mStatistic_X.NbArmed_U32;
+    mStatistic_X.Reset();
+    mStatistic_X.NbArmed_U32    = NbArmed_U32;
+    mStatistic_X.NbMaxArmed_U32 = NbArmed_U32;
+    BOF_TIMING_WHEEL_UNLOCK();
+  }
+}
+
+inline std::string BofTimingWheel::TimingWheelDebugInfo()
+{
+  BOF_TIMING_WHEEL_STATISTIC Statistic_X = Statistic();
+
+  return Bof_Sprintf("Tick %d ms Crt %lld Armed %d/%d Max %d Sched %lld Cancel %lld Exp %lld Cascade %lld SchedErr %lld MaxLate %d ms\n", mTimingWheelParam_X.TickInMs_U32, mCrtTick_U64,
+                     Statistic_X.NbArmed_U32, mTimingWheelParam_X.NbMaxTimer_U32, Statistic_X.NbMaxArmed_U32, Statistic_X.NbSchedule_U64, Statistic_X.NbCancel_U64, Statistic_X.NbExpired_U64,
+                     Statistic_X.NbCascade_U64, Statistic_X.NbScheduleError_U64, Statistic_X.MaxLateInMs_U32);
+}
+
+inline void BofTimingWheel::UpdateElapsedTime(uint32_t _NowInMs_U32)
+{
+  //Unsigned difference: handles the 32 bits ms tick count wrap around
+  mElapsedInMs_U64 += static_cast<uint32_t>(_NowInMs_U32 - mLastTimeInMs_U32);
+  mLastTimeInMs_U32 = _NowInMs_U32;
+}
+
+inline uint64_t BofTimingWheel::DelayToTick(uint32_t _DelayInMs_U32) const
+{
+  //Also take into account the time elapsed since the last Advance call as mCrtTick_U64 can lag behind
+  uint64_t Rts_U64 = (static_cast<uint64_t>(_DelayInMs_U32) + Bof_ElapsedMsTime(mLastTimeInMs_U32) + mTimingWheelParam_X.TickInMs_U32 - 1) / mTimingWheelParam_X.TickInMs_U32;
+
+  if (Rts_U64 > BOF_TIMING_WHEEL_MAX_TICK)
+  {
+    Rts_U64 = BOF_TIMING_WHEEL_MAX_TICK;
+  }
+  return Rts_U64;
+}
+
+inline uint32_t BofTimingWheel::SlotOf(uint64_t _ExpireTick_U64) const
+{
+  uint32_t Rts_U32, Level_U32, Shift_U32;
+  uint64_t Delta_U64;
+
+  if (_ExpireTick_U64 < mCrtTick_U64)
+  {
+    _ExpireTick_U64 = mCrtTick_U64;
+  }
+  Delta_U64 = _ExpireTick_U64 - mCrtTick_U64;
+  if (Delta_U64 < BOF_TIMING_WHEEL_ROOT_SIZE)
+  {
+    Rts_U32 = static_cast<uint32_t>(_ExpireTick_U64 & (BOF_TIMING_WHEEL_ROOT_SIZE - 1));
+  }
+  else
+  {
+    Rts_U32 = BOF_TIMING_WHEEL_ROOT_SIZE;
+    for (Level_U32 = 1; Level_U32 < BOF_TIMING_WHEEL_NB_LEVEL; Level_U32++)
+    {
+      Shift_U32 = BOF_TIMING_WHEEL_ROOT_BIT + (Level_U32 * BOF_TIMING_WHEEL_LEVEL_BIT);
+      if ((Delta_U64 < (1ULL << Shift_U32)) || (Level_U32 == BOF_TIMING_WHEEL_NB_LEVEL - 1))
+      {
+        Rts_U32 += static_cast<uint32_t>((_ExpireTick_U64 >> (Shift_U32 - BOF_TIMING_WHEEL_LEVEL_BIT)) & (BOF_TIMING_WHEEL_LEVEL_SIZE - 1));
+        break;
+      }
+      Rts_U32 += BOF_TIMING_WHEEL_LEVEL_SIZE;
+    }
+  }
+  return Rts_U32;
+}
+
+inline void BofTimingWheel::Link(uint32_t _Index_U32)
+{
+  TIMER_NODE &rTimer_X = mTimerCollection[_Index_U32];
+  uint32_t   Slot_U32  = SlotOf(rTimer_X.ExpireTick_U64);
+
+  rTimer_X.Slot_U32 = Slot_U32;
+  rTimer_X.Prev_U32 = NO_INDEX;
+  rTimer_X.Next_U32 = mpSlotHead_U32[Slot_U32];
+  if (rTimer_X.Next_U32 != NO_INDEX)
+  {
+    mTimerCollection[rTimer_X.Next_U32].Prev_U32 = _Index_U32;
+  }
+  mpSlotHead_U32[Slot_U32] = _Index_U32;
+  if (Slot_U32 < BOF_TIMING_WHEEL_ROOT_SIZE)
+  {
+    mpRootOccupancy_U64[Slot_U32 / 64] |= (1ULL << (Slot_U32 % 64));
+  }
+}
+
+inline void BofTimingWheel::Unlink(uint32_t _Index_U32)
+{
+  TIMER_NODE &rTimer_X = mTimerCollection[_Index_U32];
+
+  if (rTimer_X.Prev_U32 != NO_INDEX)
+  {
+    mTimerCollection[rTimer_X.Prev_U32].Next_U32 = rTimer_X.Next_U32;
+  }
+  else
+  {
+    mpSlotHead_U32[rTimer_X.Slot_U32] = rTimer_X.Next_U32;
+    if ((rTimer_X.Slot_U32 < BOF_TIMING_WHEEL_ROOT_SIZE) && (rTimer_X.Next_U32 == NO_INDEX))
+    {
+      mpRootOccupancy_U64[rTimer_X.Slot_U32 / 64] &= ~(1ULL << (rTimer_X.Slot_U32 % 64));
+    }
+  }
+  if (rTimer_X.Next_U32 != NO_INDEX)
+  {
+    mTimerCollection[rTimer_X.Next_U32].Prev_U32 = rTimer_X.Prev_U32;
+  }
+  rTimer_X.Slot_U32 = NO_INDEX;
+  rTimer_X.Prev_U32 = NO_INDEX;
+  rTimer_X.Next_U32 = NO_INDEX;
+}
+
+//Move all the timers of the current slot of _Level_U32 to the lower levels
+inline void BofTimingWheel::Cascade(uint32_t _Level_U32)
+{
+  uint32_t Slot_U32, Index_U32;
+
+  Slot_U32 = BOF_TIMING_WHEEL_ROOT_SIZE + ((_Level_U32 - 1) * BOF_TIMING_WHEEL_LEVEL_SIZE) +
+             static_cast<uint32_t>((mCrtTick_U64 >> (BOF_TIMING_WHEEL_ROOT_BIT + ((_Level_U32 - 1) * BOF_TIMING_WHEEL_LEVEL_BIT))) & (BOF_TIMING_WHEEL_LEVEL_SIZE - 1));
+  while (mpSlotHead_U32[Slot_U32] != NO_INDEX)
+  {
+    Index_U32 = mpSlotHead_U32[Slot_U32];
+    Unlink(Index_U32);
+    Link(Index_U32);
+    mStatistic_X.NbCascade_U64++;
+  }
+}
+
+//Called with the lock held. The deadline is moved to the new expiry so that a burst of earlier timers signals the waiter once.
+inline bool BofTimingWheel::IsBeforeWaitDeadline(uint64_t _ExpireTick_U64)
+{
+  bool Rts_B = false;
+
+  if ((mTimingWheelParam_X.OnWakeUp) && (_ExpireTick_U64 * mTimingWheelParam_X.TickInMs_U32 < mWaitDeadlineInMs_U64))
+  {
+    mWaitDeadlineInMs_U64 = _ExpireTick_U64 * mTimingWheelParam_X.TickInMs_U32;
+    Rts_B                 = true;
+  }
+  return Rts_B;
+}
+
+inline uint32_t BofTimingWheel::IndexOf(BOF_TIMER_HANDLE _TimerHandle) const
+{
+  uint32_t Rts_U32   = NO_INDEX;
+  uint32_t Index_U32 = static_cast<uint32_t>(_TimerHandle & 0xFFFFFFFF);
+
+  if ((Index_U32 < mTimerCollection.size()) && (mTimerCollection[Index_U32].Slot_U32 != NO_INDEX) && (mTimerCollection[Index_U32].Generation_U32 == static_cast<uint32_t>(_TimerHandle >> 32)))
+  {
+    Rts_U32 = Index_U32;
+  }
+  return Rts_U32;
+}
+
+/*!
+ * Summary
+ * Thread driving a BofTimingWheel
+ *
+ * Description
+ * The thread sleeps until the next level 0 expiry (or SignalThreadWakeUpEvent) and calls Advance.
+ * The timing wheel is created with MultiThreadAware_B forced to true and an OnWakeUp which signals the thread, so a
+ * timer armed from another thread for a time earlier than the current sleep deadline is not delayed.
+ */
+class BofTimingWheelThread : public BofThread
+{
+private:
+  std::unique_ptr<BofTimingWheel> mpuTimingWheel = nullptr;
+  BOFERR mErrorCode_E = BOF_ERR_INIT;
+
+public:
+  BofTimingWheelThread(const BOF_TIMING_WHEEL_PARAM &_rTimingWheelParam_X)
+  {
+    BOF_TIMING_WHEEL_PARAM TimingWheelParam_X = _rTimingWheelParam_X;
+
+    TimingWheelParam_X.MultiThreadAware_B = true;
+    TimingWheelParam_X.OnWakeUp           = [this]() { SignalThreadWakeUpEvent(); };
+    mpuTimingWheel.reset(new BofTimingWheel(TimingWheelParam_X));
+    mErrorCode_E = mpuTimingWheel->LastErrorCode();
+  }
+  virtual ~BofTimingWheelThread()
+  {
+    DestroyBofProcessingThread("~BofTimingWheelThread");
+  }
+  BofTimingWheelThread &operator=(const BofTimingWheelThread &) = delete; // Disallow copying
+  BofTimingWheelThread(const BofTimingWheelThread &) = delete;
+
+  BOFERR LastErrorCode() const { return mErrorCode_E; }
+  BofTimingWheel &TimingWheel() { return *mpuTimingWheel; }
+
+  BOFERR Start(const std::string &_rName_S, BOF_THREAD_SCHEDULER_POLICY _ThreadSchedulerPolicy_E, BOF_THREAD_PRIORITY _ThreadPriority_E, uint64_t _ThreadCpuCoreAffinityMask_U64)
+  {
+    BOFERR Rts_E = mErrorCode_E;
+
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = LaunchBofProcessingThread(_rName_S, false, 0, _ThreadSchedulerPolicy_E, _ThreadPriority_E, _ThreadCpuCoreAffinityMask_U64, 2000, 0);
+    }
+    return Rts_E;
+  }
+
+private:
+  BOFERR V_OnProcessing() override
+  {
+    //Wake up at least once per level 0 revolution to cascade the upper levels
+    WaitForThreadWakeUpEvent(mpuTimingWheel->NextExpiryInMs(mpuTimingWheel->TickInMs() * BOF_TIMING_WHEEL_ROOT_SIZE));
+    if (!IsThreadLoopMustExit())
+    {
+      mpuTimingWheel->Advance();
+    }
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+END_BOF_NAMESPACE()
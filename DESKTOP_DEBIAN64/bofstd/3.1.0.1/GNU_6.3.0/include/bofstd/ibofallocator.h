@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module defines the IBofAllocator interface and the helpers which
+ * bind an allocator to a BOF_BUFFER
+ *
+ * Name:        ibofallocator.h
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         Nothing
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+#pragma once
+
+/*** Include ****************************************************************/
+#include <bofstd/bofsystem.h>
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Define *****************************************************************/
+
+#define BOF_ALLOCATOR_MAGIC_NUMBER       0x41A110C8
+#define BOF_ALLOCATOR_BUFFER_TAG_BIT     0x01    //Set in BOF_BUFFER::pUser by Bof_AllocatorBufferAlloc
+
+/*** Structure **************************************************************/
+
+struct BOF_ALLOCATOR_STATISTIC
+{
+  uint64_t NbAlloc_U64;
+  uint64_t NbFree_U64;
+  uint64_t NbAllocFail_U64;           /*! Allocation refused (memory limit reached or system allocation failure) */
+  uint64_t NbCacheHit_U64;            /*! Allocation served by the calling thread cache without any lock */
+  uint64_t NbFallback_U64;            /*! Allocation too large for the allocator, served by the system heap */
+  uint64_t CurrentAllocInByte_U64;    /*! Bytes handed out and not yet freed (block size granularity) */
+  uint64_t MaxAllocInByte_U64;        /*! High water mark of CurrentAllocInByte_U64 (approximate for multi threaded allocators) */
+  uint64_t ReservedInByte_U64;        /*! Memory taken from the system by the allocator */
+
+  BOF_ALLOCATOR_STATISTIC()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbAlloc_U64            = 0;
+    NbFree_U64             = 0;
+    NbAllocFail_U64        = 0;
+    NbCacheHit_U64         = 0;
+    NbFallback_U64         = 0;
+    CurrentAllocInByte_U64 = 0;
+    MaxAllocInByte_U64     = 0;
+    ReservedInByte_U64     = 0;
+  }
+};
+
+/*** Class **************************************************************/
+
+class IBofAllocator
+{
+private:
+  uint32_t mMagicNumber_U32;
+
+public:
+  IBofAllocator() : mMagicNumber_U32(BOF_ALLOCATOR_MAGIC_NUMBER) {}
+  virtual ~IBofAllocator() { mMagicNumber_U32 = 0; }
+  bool IsAllocatorValid() const { return (mMagicNumber_U32 == BOF_ALLOCATOR_MAGIC_NUMBER); }
+  //_SizeInByte_U64 must be given back to V_Free: size class allocators do not store it in the block
+  virtual void *V_Allocate(uint64_t _SizeInByte_U64) = 0;
+  virtual void V_Free(void *_pData, uint64_t _SizeInByte_U64) = 0;
+  virtual BOFERR V_Statistic(BOF_ALLOCATOR_STATISTIC &_rStatistic_X) = 0;
+  virtual const char *V_Name() const { return ""; }
+};
+
+/*** Function **************************************************************/
+
+/*!
+ * Description
+ * Returns the allocator which owns the storage of a BOF_BUFFER built by Bof_AllocatorBufferAlloc. pUser is shared
+ * with other producers (Bof_AlignedMemAlloc keeps its BOF_BUFFER_ALLOCATE_HEADER there), so the allocator pointer is
+ * stored with BOF_ALLOCATOR_BUFFER_TAG_BIT set: heap and object pointers never have this bit, hence they are rejected
+ * without being dereferenced. The magic number of the allocator is then checked as a second guard.
+ *
+ * Parameters
+ * _rBuffer_X: Specifies the buffer
+ *
+ * Returns
+ * IBofAllocator *: The owning allocator or nullptr if the buffer does not come from Bof_AllocatorBufferAlloc
+ */
+inline IBofAllocator *Bof_AllocatorOfBuffer(const BOF_BUFFER &_rBuffer_X)
+{
+  IBofAllocator *pRts    = nullptr;
+  uintptr_t     User_U64 = reinterpret_cast<uintptr_t>(_rBuffer_X.pUser);
+
+  if ((!_rBuffer_X.MustBeDeleted_B) && (_rBuffer_X.pData_U8) && (User_U64 & BOF_ALLOCATOR_BUFFER_TAG_BIT))
+  {
+    pRts = reinterpret_cast<IBofAllocator *>(User_U64 & ~static_cast<uintptr_t>(BOF_ALLOCATOR_BUFFER_TAG_BIT));
+    if (!pRts->IsAllocatorValid())
+    {
+      pRts = nullptr;
+    }
+  }
+  return pRts;
+}
+
+/*!
+ * Description
+ * Allocates the storage of a BOF_BUFFER from an allocator. The allocator is kept, tagged, in BOF_BUFFER::pUser (see
+ * Bof_AllocatorOfBuffer) and MustBeDeleted_B stays false so that BOF_BUFFER::ReleaseStorage never calls delete[] on
+ * it: such a buffer must be released with Bof_AllocatorBufferFree.
+ *
+ * Parameters
+ * _pAllocator: Specifies the allocator to use
+ * _Capacity_U64: Specifies the buffer capacity
+ * _rBuffer_X: Returns the buffer (Size_U64 is 0)
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful
+ */
+inline BOFERR Bof_AllocatorBufferAlloc(IBofAllocator *_pAllocator, uint64_t _Capacity_U64, BOF_BUFFER &_rBuffer_X)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+
+  _rBuffer_X.Reset();
+  if ((_pAllocator) && (_Capacity_U64))
+  {
+    Rts_E              = BOF_ERR_ENOMEM;
+    _rBuffer_X.pData_U8 = static_cast<uint8_t *>(_pAllocator->V_Allocate(_Capacity_U64));
+    if (_rBuffer_X.pData_U8)
+    {
+      Rts_E                   = BOF_ERR_NO_ERROR;
+      _rBuffer_X.Capacity_U64 = _Capacity_U64;
+      _rBuffer_X.pUser        = reinterpret_cast<void *>(reinterpret_cast<uintptr_t>(_pAllocator) | BOF_ALLOCATOR_BUFFER_TAG_BIT);
+    }
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Gives the storage of a buffer built by Bof_AllocatorBufferAlloc back to its allocator and resets the buffer.
+ * Any other buffer (owned by delete[], by Bof_AlignedMemAlloc, ...) is left untouched.
+ *
+ * Parameters
+ * _rBuffer_X: Specifies the buffer to release
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation is successful, BOF_ERR_EINVAL if the buffer is not allocator owned
+ */
+inline BOFERR Bof_AllocatorBufferFree(BOF_BUFFER &_rBuffer_X)
+{
+  BOFERR        Rts_E = BOF_ERR_EINVAL;
+  IBofAllocator *pAllocator = Bof_AllocatorOfBuffer(_rBuffer_X);
+
+  if (pAllocator)
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+    pAllocator->V_Free(_rBuffer_X.pData_U8, _rBuffer_X.Capacity_U64);
+    _rBuffer_X.Reset();
+  }
+  return Rts_E;
+}
+
+END_BOF_NAMESPACE()
@@ -56,7 +56,7 @@ add_library(bofstd STATIC IMPORTED)
 set_target_properties(bofstd PROPERTIES
   INTERFACE_COMPILE_DEFINITIONS "SPDLOG_ENABLE_MESSAGE_COUNTER"
   INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include;${_IMPORT_PREFIX}/include/fmt;${_IMPORT_PREFIX}/include/spdlog;${_IMPORT_PREFIX}/include/jsoncpp;${_IMPORT_PREFIX}/include/async;${_IMPORT_PREFIX}/include/libyuv"
-  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:rt>;\$<LINK_ONLY:dl>;\$<LINK_ONLY:pthread>"
+  INTERFACE_LINK_LIBRARIES "\$<LINK_ONLY:rt>;\$<LINK_ONLY:dl>;\$<LINK_ONLY:pthread>;\$<LINK_ONLY:resolv>"
 )
 
 if(CMAKE_VERSION VERSION_LESS 2.8.12)
@@ -0,0 +1,1927 @@
+/*
+ * Copyright (c) 2015-2025, Onbings. All rights reserved.
+ *
+ * THIS CODE AND INFORMATION IS PROVIDED "AS IS" WITHOUT WARRANTY OF ANY
+ * KIND, EITHER EXPRESSED OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND/OR FITNESS FOR A PARTICULAR
+ * PURPOSE.
+ *
+ * This module implements the loopback socket benchmark program: the socket
+ * micro benchmarks used to compare the cpu cost of the different socket io
+ * paths, and the benchmark suite (latency, throughput, accept rate, session
+ * scale, file transfer, pipe, library classes) which prints json lines per
+ * poller engine. It is not part of the library, build it with
+ *   g++ -std=c++14 -O2 bofsocketbenchmark.cpp $(pkg-config --cflags --libs bofstd) -pthread
+ *
+ * Name:        bofsocketbenchmark.cpp
+ * Author:      Bernard HARMEL: onbings@dscloud.me
+ * Web:			    onbings.dscloud.me
+ * Revision:    1.0
+ *
+ * Rem:         The cpu time is the thread cpu time (user + system) of the
+ *              sending and of the receiving thread, so the figures do not
+ *              depend on the load of the other cores.
+ *              Linux only: elsewhere the benchmarks return BOF_ERR_NOT_SUPPORTED.
+ *
+ * History:
+ *
+ * V 1.00  Oct 19 2026  BHA : Initial release
+ */
+
+/*** Include ****************************************************************/
+#include <bofstd/bofpipe.h>
+#include <bofstd/bofshmpipe.h>
+#include <bofstd/bofsocketbatch.h>
+#include <bofstd/bofsocketio.h>
+#include <bofstd/bofsocketpoller.h>
+#include <bofstd/bofsocketserver.h>
+#include <bofstd/bofsocketzerocopy.h>
+#include <bofstd/bofstring.h>
+#include <bofstd/ibofsocketsessionfactory.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+BEGIN_BOF_NAMESPACE()
+
+/*** Enum *****************************************************************/
+
+enum class BOF_SOCKET_UDP_BENCHMARK_MODE : uint32_t
+{
+  BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM = 0,  //One send/recvfrom per datagram (BofSocket::V_WriteData/V_ReadData path)
+  BOF_SOCKET_UDP_BENCHMARK_MODE_BATCH,             //sendmmsg/recvmmsg by Batch_U32
+  BOF_SOCKET_UDP_BENCHMARK_MODE_GSO_GRO,           //sendmmsg of gso super datagrams received with gro
+  BOF_SOCKET_UDP_BENCHMARK_MODE_MAX
+};
+
+enum class BOF_SOCKET_LIBRARY_BENCHMARK : uint32_t
+{
+  BOF_SOCKET_LIBRARY_BENCHMARK_BOFSOCKET = 0,      //BofSocket::V_Connect/V_Listen, echo with V_ReadData/V_WriteData on both ends
+  BOF_SOCKET_LIBRARY_BENCHMARK_BOFSOCKETSERVER,    //BofSocket client, BofSocketServer session thread echoing from BofSocketIo::V_SignalDataRead
+  BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_NATIVE,     //Two BofPipe BOF_PIPE_NATIVE, one per direction
+  BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_UDP,        //Two BofPipe BOF_PIPE_OVER_LOCAL_UDP, one per direction
+  BOF_SOCKET_LIBRARY_BENCHMARK_MAX
+};
+
+enum class BOF_SOCKET_BENCHMARK : uint32_t
+{
+  BOF_SOCKET_BENCHMARK_TCP_LATENCY = 0,  //Request/response round trip percentiles on one connection
+  BOF_SOCKET_BENCHMARK_TCP_STREAM,       //One way streaming throughput
+  BOF_SOCKET_BENCHMARK_UDP_PPS,          //Datagram rate of each BOF_SOCKET_UDP_BENCHMARK_MODE (no poller engine involved)
+  BOF_SOCKET_BENCHMARK_ACCEPT_RATE,      //Connect/accept/close cycles per second
+  BOF_SOCKET_BENCHMARK_IDLE_SESSION,     //Request/response round trip with NbIdleSession_U32 idle sessions registered in the engine
+  BOF_SOCKET_BENCHMARK_FILE_TRANSFER,    //Ftp like: command on a control connection, file sent with sendfile on a data connection
+  BOF_SOCKET_BENCHMARK_PIPE_ROUND_TRIP,  //Ping pong over the pipe transports: native pipe, local udp and shared memory rings
+  BOF_SOCKET_BENCHMARK_LIBRARY_ROUND_TRIP,  //Ping pong through the library classes: BofSocket, BofSocketServer/BofSocketIo and BofPipe
+  BOF_SOCKET_BENCHMARK_MAX
+};
+
+/*** Structure **************************************************************/
+
+struct BOF_SOCKET_UDP_BENCHMARK_PARAM
+{
+  BOF_SOCKET_UDP_BENCHMARK_MODE Mode_E;
+  uint32_t                      NbDatagram_U32;
+  uint32_t                      DatagramSize_U32;
+  uint32_t                      Batch_U32;                  /*! Number of datagram (or gso super datagram) per syscall */
+  uint32_t                      NbSegmentPerGso_U32;        /*! Number of DatagramSize_U32 segments in a gso super datagram */
+  uint32_t                      SocketBufferSizeInByte_U32; /*! SO_RCVBUF/SO_SNDBUF, capped by the kernel net.core limits */
+  uint32_t                      IdleTimeoutInMs_U32;        /*! The receiver stops when nothing came in for this time (lost datagrams) */
+
+  BOF_SOCKET_UDP_BENCHMARK_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Mode_E = BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM;
+    NbDatagram_U32 = 200000;
+    DatagramSize_U32 = 1316;
+    Batch_U32 = 64;
+    NbSegmentPerGso_U32 = 32;
+    SocketBufferSizeInByte_U32 = 8 * 1024 * 1024;
+    IdleTimeoutInMs_U32 = 200;
+  }
+};
+
+struct BOF_SOCKET_UDP_BENCHMARK_RESULT
+{
+  BOF_SOCKET_UDP_BENCHMARK_MODE Mode_E;
+  uint64_t                      NbDatagramSent_U64;
+  uint64_t                      NbDatagramReceived_U64;
+  uint64_t                      NbWriteCall_U64;
+  uint64_t                      NbReadCall_U64;
+  uint64_t                      TxCpuInNs_U64;
+  uint64_t                      RxCpuInNs_U64;
+  uint64_t                      WallInNs_U64;
+
+  BOF_SOCKET_UDP_BENCHMARK_RESULT()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Mode_E = BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM;
+    NbDatagramSent_U64 = 0;
+    NbDatagramReceived_U64 = 0;
+    NbWriteCall_U64 = 0;
+    NbReadCall_U64 = 0;
+    TxCpuInNs_U64 = 0;
+    RxCpuInNs_U64 = 0;
+    WallInNs_U64 = 0;
+  }
+
+  double TxCpuNsPerDatagram() const
+  {
+    return NbDatagramSent_U64 ? static_cast<double>(TxCpuInNs_U64) / static_cast<double>(NbDatagramSent_U64) : 0.0;
+  }
+  double RxCpuNsPerDatagram() const
+  {
+    return NbDatagramReceived_U64 ? static_cast<double>(RxCpuInNs_U64) / static_cast<double>(NbDatagramReceived_U64) : 0.0;
+  }
+};
+
+struct BOF_SOCKET_BENCHMARK_PARAM
+{
+  uint32_t                              BenchmarkMask_U32;     /*! Bit (1 << BOF_SOCKET_BENCHMARK_xxx) set for each benchmark to run */
+  std::vector<BOF_SOCKET_POLLER_ENGINE> EngineCollection;      /*! Engines driving the server side of the tcp benchmarks, each one gives a result */
+  uint32_t                              NbRequest_U32;         /*! Round trips measured by the latency benchmarks */
+  uint32_t                              RequestSizeInByte_U32;
+  uint32_t                              ResponseSizeInByte_U32;
+  uint64_t                              StreamSizeInByte_U64;
+  uint32_t                              ChunkSizeInByte_U32;   /*! Size of each write of the stream benchmark */
+  uint32_t                              NbConnection_U32;      /*! Accept rate benchmark */
+  uint32_t                              NbIdleSession_U32;     /*! Idle session benchmark: each one uses two descriptors */
+  uint64_t                              FileSizeInByte_U64;    /*! File transfer benchmark, the file is created in the temporary directory */
+  uint32_t                              TimeoutInMs_U32;       /*! Maximum duration of each benchmark */
+  BOF_SOCKET_UDP_BENCHMARK_PARAM        UdpParam_X;            /*! Udp benchmark: Mode_E is ignored, every mode runs */
+
+  BOF_SOCKET_BENCHMARK_PARAM()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    BenchmarkMask_U32 = (1 << static_cast<uint32_t>(BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_MAX)) - 1;
+    EngineCollection = { BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_POLL, BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_EPOLL,
+                         BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_IO_URING };
+    NbRequest_U32 = 20000;
+    RequestSizeInByte_U32 = 64;
+    ResponseSizeInByte_U32 = 64;
+    StreamSizeInByte_U64 = 256 * 1024 * 1024;
+    ChunkSizeInByte_U32 = 64 * 1024;
+    NbConnection_U32 = 2000;
+    NbIdleSession_U32 = 1000;
+    FileSizeInByte_U64 = 64 * 1024 * 1024;
+    TimeoutInMs_U32 = 30000;
+    UdpParam_X.Reset();
+  }
+};
+
+struct BOF_SOCKET_BENCHMARK_RESULT
+{
+  BOF_SOCKET_BENCHMARK Benchmark_E;
+  std::string          Variant_S;             /*! Poller engine really used, udp mode or pipe transport */
+  BOFERR               Sts_E;
+  uint32_t             NbSession_U32;
+  uint64_t             NbOperation_U64;       /*! Round trips, datagrams, accepted connections or transfers */
+  uint64_t             NbByte_U64;
+  uint64_t             WallInNs_U64;
+  uint64_t             LatencyMinInNs_U64;    /*! Latency benchmarks: round trip time distribution */
+  uint64_t             LatencyP50InNs_U64;
+  uint64_t             LatencyP90InNs_U64;
+  uint64_t             LatencyP99InNs_U64;
+  uint64_t             LatencyP999InNs_U64;
+  uint64_t             LatencyMaxInNs_U64;
+
+  BOF_SOCKET_BENCHMARK_RESULT()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    Benchmark_E = BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_TCP_LATENCY;
+    Variant_S = "";
+    Sts_E = BOF_ERR_NO_ERROR;
+    NbSession_U32 = 0;
+    NbOperation_U64 = 0;
+    NbByte_U64 = 0;
+    WallInNs_U64 = 0;
+    LatencyMinInNs_U64 = 0;
+    LatencyP50InNs_U64 = 0;
+    LatencyP90InNs_U64 = 0;
+    LatencyP99InNs_U64 = 0;
+    LatencyP999InNs_U64 = 0;
+    LatencyMaxInNs_U64 = 0;
+  }
+
+  double OperationPerS() const
+  {
+    return WallInNs_U64 ? (static_cast<double>(NbOperation_U64) * 1e9) / static_cast<double>(WallInNs_U64) : 0.0;
+  }
+  double MegaBytePerS() const
+  {
+    return WallInNs_U64 ? (static_cast<double>(NbByte_U64) * 1e3) / static_cast<double>(WallInNs_U64) : 0.0;
+  }
+};
+
+/*** Function ***************************************************************/
+
+const char *Bof_SocketUdpBenchmarkModeName(BOF_SOCKET_UDP_BENCHMARK_MODE _Mode_E)
+{
+  const char *pRts_c = "?";
+
+  switch (_Mode_E)
+  {
+    case BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM:
+      pRts_c = "per_datagram";
+      break;
+    case BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_BATCH:
+      pRts_c = "batch";
+      break;
+    case BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_GSO_GRO:
+      pRts_c = "gso_gro";
+      break;
+    default:
+      break;
+  }
+  return pRts_c;
+}
+
+std::string Bof_SocketUdpBenchmarkResultToString(const BOF_SOCKET_UDP_BENCHMARK_RESULT &_rResult_X)
+{
+  return Bof_Sprintf("%-12s Tx %lld dg %lld call %.1f ns/dg Rx %lld dg %lld call %.1f ns/dg Lost %lld Wall %.3f ms", Bof_SocketUdpBenchmarkModeName(_rResult_X.Mode_E), _rResult_X.NbDatagramSent_U64, _rResult_X.NbWriteCall_U64,
+                     _rResult_X.TxCpuNsPerDatagram(), _rResult_X.NbDatagramReceived_U64, _rResult_X.NbReadCall_U64, _rResult_X.RxCpuNsPerDatagram(),
+                     (_rResult_X.NbDatagramSent_U64 > _rResult_X.NbDatagramReceived_U64) ? _rResult_X.NbDatagramSent_U64 - _rResult_X.NbDatagramReceived_U64 : 0, static_cast<double>(_rResult_X.WallInNs_U64) / 1000000.0);
+}
+
+#if BOF_SOCKET_BATCH_AVAILABLE
+uint64_t Bof_SocketBenchmarkClockInNs(clockid_t _ClockId)
+{
+  struct timespec Ts_X;
+
+  clock_gettime(_ClockId, &Ts_X);
+  return (static_cast<uint64_t>(Ts_X.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(Ts_X.tv_nsec);
+}
+
+BOFSOCKET Bof_SocketBenchmarkOpenUdp(uint32_t _BufferSizeInByte_U32)
+{
+  BOFSOCKET Rts;
+  int Val_i;
+
+  Rts = socket(AF_INET, SOCK_DGRAM, 0);
+  if (Rts != BOFSOCKET_INVALID)
+  {
+    Val_i = static_cast<int>(_BufferSizeInByte_U32);
+    setsockopt(Rts, SOL_SOCKET, SO_RCVBUF, &Val_i, sizeof(Val_i));
+    setsockopt(Rts, SOL_SOCKET, SO_SNDBUF, &Val_i, sizeof(Val_i));
+  }
+  return Rts;
+}
+
+void Bof_SocketBenchmarkUdpSender(BOFSOCKET _Socket, const BOF_SOCKET_UDP_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_UDP_BENCHMARK_RESULT &_rResult_X)
+{
+  BOF_SOCKET_DATAGRAM_BATCH_PARAM BatchParam_X;
+  std::vector<BOF_SOCKET_DATAGRAM> DatagramCollection;
+  std::vector<uint8_t> Payload;
+  uint32_t i_U32, NbSegment_U32, NbEntry_U32, NbWritten_U32, NbToSend_U32;
+  uint64_t Start_U64;
+  ssize_t Sts;
+
+  NbSegment_U32 = (_rParam_X.Mode_E == BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_GSO_GRO) ? _rParam_X.NbSegmentPerGso_U32 : 1;
+  Payload.resize(static_cast<size_t>(_rParam_X.DatagramSize_U32) * NbSegment_U32, 0x5A);
+  BatchParam_X.MaxBatch_U32 = _rParam_X.Batch_U32;
+  BatchParam_X.KernelTimeStamp_B = false;
+  BofSocketDatagramBatch DatagramBatch(_Socket, BatchParam_X);
+
+  DatagramCollection.resize(_rParam_X.Batch_U32);
+  for (i_U32 = 0; i_U32 < _rParam_X.Batch_U32; i_U32++)
+  {
+    DatagramCollection[i_U32].pBuffer_U8 = Payload.data();
+    DatagramCollection[i_U32].Nb_U32 = static_cast<uint32_t>(Payload.size());
+    DatagramCollection[i_U32].SegmentSize_U16 = (NbSegment_U32 > 1) ? static_cast<uint16_t>(_rParam_X.DatagramSize_U32) : 0;
+  }
+  Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_THREAD_CPUTIME_ID);
+  if (_rParam_X.Mode_E == BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM)
+  {
+    for (i_U32 = 0; i_U32 < _rParam_X.NbDatagram_U32; i_U32++)
+    {
+      _rResult_X.NbWriteCall_U64++;
+      Sts = send(_Socket, Payload.data(), Payload.size(), 0);
+      if (Sts > 0)
+      {
+        _rResult_X.NbDatagramSent_U64++;
+      }
+    }
+  }
+  else
+  {
+    NbToSend_U32 = (_rParam_X.NbDatagram_U32 + NbSegment_U32 - 1) / NbSegment_U32;
+    while (NbToSend_U32)
+    {
+      NbEntry_U32 = (NbToSend_U32 > _rParam_X.Batch_U32) ? _rParam_X.Batch_U32 : NbToSend_U32;
+      if (DatagramBatch.WriteDatagram(1000, NbEntry_U32, DatagramCollection.data(), NbWritten_U32) != BOF_ERR_NO_ERROR)
+      {
+        NbToSend_U32 = 0;
+      }
+      else
+      {
+        NbToSend_U32 -= NbWritten_U32;
+      }
+      _rResult_X.NbDatagramSent_U64 += static_cast<uint64_t>(NbWritten_U32) * NbSegment_U32;
+    }
+    _rResult_X.NbWriteCall_U64 = DatagramBatch.DatagramBatchStatistic().NbWriteCall_U64;
+  }
+  _rResult_X.TxCpuInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_THREAD_CPUTIME_ID) - Start_U64;
+}
+
+void Bof_SocketBenchmarkUdpReceiver(BOFSOCKET _Socket, const BOF_SOCKET_UDP_BENCHMARK_PARAM &_rParam_X, const std::atomic<bool> &_rSenderDone_B, BOF_SOCKET_UDP_BENCHMARK_RESULT &_rResult_X)
+{
+  BOF_SOCKET_DATAGRAM_BATCH_PARAM BatchParam_X;
+  std::vector<BOF_SOCKET_DATAGRAM> DatagramCollection;
+  std::vector<uint8_t> Buffer;
+  uint32_t i_U32, BufferSize_U32, NbRead_U32, LastRx_U32;
+  uint64_t Start_U64;
+  bool Gro_B;
+  ssize_t Sts;
+
+  Gro_B = (_rParam_X.Mode_E == BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_GSO_GRO);
+  BufferSize_U32 = Gro_B ? 0x10000 : _rParam_X.DatagramSize_U32;
+  Buffer.resize(static_cast<size_t>(BufferSize_U32) * _rParam_X.Batch_U32);
+  BatchParam_X.MaxBatch_U32 = _rParam_X.Batch_U32;
+  BatchParam_X.KernelTimeStamp_B = false;
+  BatchParam_X.Gro_B = Gro_B;
+  BofSocketDatagramBatch DatagramBatch(_Socket, BatchParam_X);
+
+  DatagramCollection.resize(_rParam_X.Batch_U32);
+  for (i_U32 = 0; i_U32 < _rParam_X.Batch_U32; i_U32++)
+  {
+    DatagramCollection[i_U32].pBuffer_U8 = &Buffer[static_cast<size_t>(i_U32) * BufferSize_U32];
+    DatagramCollection[i_U32].BufferSizeInByte_U32 = BufferSize_U32;
+  }
+  LastRx_U32 = Bof_GetMsTickCount();
+  Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_THREAD_CPUTIME_ID);
+  while ((_rResult_X.NbDatagramReceived_U64 < _rParam_X.NbDatagram_U32) && ((!_rSenderDone_B.load()) || (Bof_ElapsedMsTime(LastRx_U32) < _rParam_X.IdleTimeoutInMs_U32)))
+  {
+    if (_rParam_X.Mode_E == BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM)
+    {
+      _rResult_X.NbReadCall_U64++;
+      Sts = recv(_Socket, Buffer.data(), BufferSize_U32, MSG_DONTWAIT);
+      if (Sts > 0)
+      {
+        _rResult_X.NbDatagramReceived_U64++;
+        LastRx_U32 = Bof_GetMsTickCount();
+      }
+    }
+    else if (DatagramBatch.ReadDatagram(0, _rParam_X.Batch_U32, DatagramCollection.data(), NbRead_U32) == BOF_ERR_NO_ERROR)
+    {
+      for (i_U32 = 0; i_U32 < NbRead_U32; i_U32++)
+      {
+        _rResult_X.NbDatagramReceived_U64 += DatagramCollection[i_U32].SegmentSize_U16 ? (DatagramCollection[i_U32].Nb_U32 + DatagramCollection[i_U32].SegmentSize_U16 - 1) / DatagramCollection[i_U32].SegmentSize_U16 : 1;
+      }
+      LastRx_U32 = Bof_GetMsTickCount();
+    }
+  }
+  if (_rParam_X.Mode_E != BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_PER_DATAGRAM)
+  {
+    _rResult_X.NbReadCall_U64 = DatagramBatch.DatagramBatchStatistic().NbReadCall_U64;
+  }
+  _rResult_X.RxCpuInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_THREAD_CPUTIME_ID) - Start_U64;
+}
+#endif
+
+/*!
+ * Description
+ * Sends NbDatagram_U32 udp datagrams of DatagramSize_U32 bytes on the loopback interface from a second thread and
+ * receives them in the calling thread with the io path given by Mode_E. The receiver polls the socket without
+ * sleeping, so its cpu time includes the empty reads and is an upper bound of the cost per datagram.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _rResult_X: Returns the measured counters and cpu times
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful, BOF_ERR_NOT_SUPPORTED if the mode cannot run here.
+ */
+BOFERR Bof_SocketUdpLoopbackBenchmark(const BOF_SOCKET_UDP_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_UDP_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_BATCH_AVAILABLE
+  BOFSOCKET RxSocket, TxSocket;
+  struct sockaddr_in Address_X;
+  socklen_t Len;
+  std::atomic<bool> SenderDone_B;
+  uint64_t Start_U64;
+
+  _rResult_X.Reset();
+  _rResult_X.Mode_E = _rParam_X.Mode_E;
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_rParam_X.Mode_E < BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_MAX) && (_rParam_X.NbDatagram_U32) && (_rParam_X.DatagramSize_U32) && (_rParam_X.Batch_U32) && (_rParam_X.NbSegmentPerGso_U32) &&
+      (_rParam_X.DatagramSize_U32 <= 0xFFFF) && (static_cast<uint64_t>(_rParam_X.DatagramSize_U32) * _rParam_X.NbSegmentPerGso_U32 <= BOF_SOCKET_BATCH_MAX_GSO_SIZE))
+  {
+    Rts_E = BOF_ERR_CREATE;
+    RxSocket = Bof_SocketBenchmarkOpenUdp(_rParam_X.SocketBufferSizeInByte_U32);
+    TxSocket = Bof_SocketBenchmarkOpenUdp(_rParam_X.SocketBufferSizeInByte_U32);
+    if ((RxSocket != BOFSOCKET_INVALID) && (TxSocket != BOFSOCKET_INVALID))
+    {
+      memset(&Address_X, 0, sizeof(Address_X));
+      Address_X.sin_family = AF_INET;
+      Address_X.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+      Len = sizeof(Address_X);
+      if ((bind(RxSocket, reinterpret_cast<struct sockaddr *>(&Address_X), sizeof(Address_X)) == 0) && (getsockname(RxSocket, reinterpret_cast<struct sockaddr *>(&Address_X), &Len) == 0) &&
+          (connect(TxSocket, reinterpret_cast<struct sockaddr *>(&Address_X), sizeof(Address_X)) == 0))
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        if (_rParam_X.Mode_E == BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_GSO_GRO)
+        {
+          BOF_SOCKET_DATAGRAM_BATCH_PARAM BatchParam_X;
+          BatchParam_X.Gro_B = true;
+          BofSocketDatagramBatch RxProbe(RxSocket, BatchParam_X), TxProbe(TxSocket, BatchParam_X);
+
+          if ((!RxProbe.IsGroEnabled()) || (!TxProbe.IsGsoSupported()))
+          {
+            Rts_E = BOF_ERR_NOT_SUPPORTED;
+          }
+        }
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          SenderDone_B.store(false);
+          Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+          std::thread Sender([&]() {
+            Bof_SocketBenchmarkUdpSender(TxSocket, _rParam_X, _rResult_X);
+            SenderDone_B.store(true);
+          });
+          Bof_SocketBenchmarkUdpReceiver(RxSocket, _rParam_X, SenderDone_B, _rResult_X);
+          Sender.join();
+          _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+        }
+      }
+    }
+    if (RxSocket != BOFSOCKET_INVALID)
+    {
+      close(RxSocket);
+    }
+    if (TxSocket != BOFSOCKET_INVALID)
+    {
+      close(TxSocket);
+    }
+  }
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Runs Bof_SocketUdpLoopbackBenchmark for every mode with the same parameters. A mode which is not supported
+ * by the running kernel is skipped.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters (Mode_E is ignored)
+ * _rResultCollection: Returns one result per mode which could run
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+BOFERR Bof_SocketUdpLoopbackBenchmarkAllMode(const BOF_SOCKET_UDP_BENCHMARK_PARAM &_rParam_X, std::vector<BOF_SOCKET_UDP_BENCHMARK_RESULT> &_rResultCollection)
+{
+  BOFERR Rts_E = BOF_ERR_NO_ERROR, Sts_E;
+  BOF_SOCKET_UDP_BENCHMARK_PARAM Param_X;
+  BOF_SOCKET_UDP_BENCHMARK_RESULT Result_X;
+  uint32_t Mode_U32;
+
+  _rResultCollection.clear();
+  Param_X = _rParam_X;
+  for (Mode_U32 = 0; (Mode_U32 < static_cast<uint32_t>(BOF_SOCKET_UDP_BENCHMARK_MODE::BOF_SOCKET_UDP_BENCHMARK_MODE_MAX)) && (Rts_E == BOF_ERR_NO_ERROR); Mode_U32++)
+  {
+    Param_X.Mode_E = static_cast<BOF_SOCKET_UDP_BENCHMARK_MODE>(Mode_U32);
+    Sts_E = Bof_SocketUdpLoopbackBenchmark(Param_X, Result_X);
+    if (Sts_E == BOF_ERR_NO_ERROR)
+    {
+      _rResultCollection.push_back(Result_X);
+    }
+    else if (Sts_E != BOF_ERR_NOT_SUPPORTED)
+    {
+      Rts_E = Sts_E;
+    }
+  }
+  return Rts_E;
+}
+
+const char *Bof_SocketBenchmarkName(BOF_SOCKET_BENCHMARK _Benchmark_E)
+{
+  const char *pRts_c = "?";
+
+  switch (_Benchmark_E)
+  {
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_TCP_LATENCY:
+      pRts_c = "tcp_latency";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_TCP_STREAM:
+      pRts_c = "tcp_stream";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_UDP_PPS:
+      pRts_c = "udp_pps";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_ACCEPT_RATE:
+      pRts_c = "accept_rate";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_IDLE_SESSION:
+      pRts_c = "idle_session";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_FILE_TRANSFER:
+      pRts_c = "file_transfer";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_PIPE_ROUND_TRIP:
+      pRts_c = "pipe_round_trip";
+      break;
+    case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_LIBRARY_ROUND_TRIP:
+      pRts_c = "library_round_trip";
+      break;
+    default:
+      break;
+  }
+  return pRts_c;
+}
+
+//One json object per line (json lines): easy to append to a file and to compare between runs
+std::string Bof_SocketBenchmarkResultToJson(const BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  return Bof_Sprintf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"status\":%d,\"sessions\":%u,\"ops\":%lld,\"bytes\":%lld,\"wall_ns\":%lld,\"ops_per_s\":%.1f,\"mb_per_s\":%.3f,"
+                     "\"lat_min_ns\":%lld,\"lat_p50_ns\":%lld,\"lat_p90_ns\":%lld,\"lat_p99_ns\":%lld,\"lat_p999_ns\":%lld,\"lat_max_ns\":%lld}",
+                     Bof_SocketBenchmarkName(_rResult_X.Benchmark_E), _rResult_X.Variant_S.c_str(), static_cast<int>(_rResult_X.Sts_E), _rResult_X.NbSession_U32, _rResult_X.NbOperation_U64,
+                     _rResult_X.NbByte_U64, _rResult_X.WallInNs_U64, _rResult_X.OperationPerS(), _rResult_X.MegaBytePerS(), _rResult_X.LatencyMinInNs_U64, _rResult_X.LatencyP50InNs_U64,
+                     _rResult_X.LatencyP90InNs_U64, _rResult_X.LatencyP99InNs_U64, _rResult_X.LatencyP999InNs_U64, _rResult_X.LatencyMaxInNs_U64);
+}
+
+#if BOF_SOCKET_BATCH_AVAILABLE
+//Sorts _rSampleCollection (round trip times in ns) and fills the latency fields of _rResult_X
+void Bof_SocketBenchmarkLatency(std::vector<uint64_t> &_rSampleCollection, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  size_t Nb;
+
+  Nb = _rSampleCollection.size();
+  if (Nb)
+  {
+    std::sort(_rSampleCollection.begin(), _rSampleCollection.end());
+    _rResult_X.LatencyMinInNs_U64 = _rSampleCollection[0];
+    _rResult_X.LatencyP50InNs_U64 = _rSampleCollection[(Nb * 50) / 100];
+    _rResult_X.LatencyP90InNs_U64 = _rSampleCollection[(Nb * 90) / 100];
+    _rResult_X.LatencyP99InNs_U64 = _rSampleCollection[(Nb * 99) / 100];
+    _rResult_X.LatencyP999InNs_U64 = _rSampleCollection[(Nb * 999) / 1000];
+    _rResult_X.LatencyMaxInNs_U64 = _rSampleCollection[Nb - 1];
+  }
+}
+
+//Blocking loop on a blocking descriptor: returns false on error or end of stream
+bool Bof_SocketBenchmarkWriteAll(int _Fd_i, const uint8_t *_pBuffer_U8, size_t _Nb)
+{
+  bool Rts_B = true;
+  ssize_t Sts;
+
+  while ((Rts_B) && (_Nb))
+  {
+    Sts = write(_Fd_i, _pBuffer_U8, _Nb);
+    if (Sts > 0)
+    {
+      _pBuffer_U8 += Sts;
+      _Nb -= static_cast<size_t>(Sts);
+    }
+    else if ((Sts < 0) && (errno == EINTR))
+    {
+    }
+    else
+    {
+      Rts_B = false;
+    }
+  }
+  return Rts_B;
+}
+
+bool Bof_SocketBenchmarkReadAll(int _Fd_i, uint8_t *_pBuffer_U8, size_t _Nb)
+{
+  bool Rts_B = true;
+  ssize_t Sts;
+
+  while ((Rts_B) && (_Nb))
+  {
+    Sts = read(_Fd_i, _pBuffer_U8, _Nb);
+    if (Sts > 0)
+    {
+      _pBuffer_U8 += Sts;
+      _Nb -= static_cast<size_t>(Sts);
+    }
+    else if ((Sts < 0) && (errno == EINTR))
+    {
+    }
+    else
+    {
+      Rts_B = false;
+    }
+  }
+  return Rts_B;
+}
+
+//Blocking loopback tcp listener on an ephemeral port, _rPort_U16 returns the port in host byte order
+BOFSOCKET Bof_SocketBenchmarkTcpListen(uint16_t &_rPort_U16)
+{
+  BOFSOCKET Rts;
+  struct sockaddr_in Address_X;
+  socklen_t Len;
+  int Val_i = 1;
+
+  Rts = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (Rts != BOFSOCKET_INVALID)
+  {
+    setsockopt(Rts, SOL_SOCKET, SO_REUSEADDR, &Val_i, sizeof(Val_i));
+    memset(&Address_X, 0, sizeof(Address_X));
+    Address_X.sin_family = AF_INET;
+    Address_X.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Len = sizeof(Address_X);
+    if ((bind(Rts, reinterpret_cast<struct sockaddr *>(&Address_X), sizeof(Address_X)) == 0) && (listen(Rts, SOMAXCONN) == 0) &&
+        (getsockname(Rts, reinterpret_cast<struct sockaddr *>(&Address_X), &Len) == 0))
+    {
+      _rPort_U16 = ntohs(Address_X.sin_port);
+    }
+    else
+    {
+      close(Rts);
+      Rts = BOFSOCKET_INVALID;
+    }
+  }
+  return Rts;
+}
+
+//Blocking loopback tcp connection with TCP_NODELAY
+BOFSOCKET Bof_SocketBenchmarkTcpConnect(uint16_t _Port_U16)
+{
+  BOFSOCKET Rts;
+  struct sockaddr_in Address_X;
+  int Val_i = 1;
+
+  Rts = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (Rts != BOFSOCKET_INVALID)
+  {
+    setsockopt(Rts, IPPROTO_TCP, TCP_NODELAY, &Val_i, sizeof(Val_i));
+    memset(&Address_X, 0, sizeof(Address_X));
+    Address_X.sin_family = AF_INET;
+    Address_X.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    Address_X.sin_port = htons(_Port_U16);
+    if (connect(Rts, reinterpret_cast<struct sockaddr *>(&Address_X), sizeof(Address_X)) != 0)
+    {
+      close(Rts);
+      Rts = BOFSOCKET_INVALID;
+    }
+  }
+  return Rts;
+}
+
+struct BOF_SOCKET_BENCHMARK_SERVER_COUNTER
+{
+  std::atomic<uint64_t> NbAccept_U64;
+  std::atomic<uint64_t> NbByteReceived_U64;
+
+  BOF_SOCKET_BENCHMARK_SERVER_COUNTER()
+  {
+    Reset();
+  }
+
+  void Reset()
+  {
+    NbAccept_U64.store(0);
+    NbByteReceived_U64.store(0);
+  }
+};
+
+/*!
+ * Summary
+ * Session of the tcp benchmark server
+ *
+ * Description
+ * BofSocketIo dispatched by the BofSocketPollServer (BOF_SOCKET_POLLER_DISPATCH_DATA_READ): V_SignalDataRead counts
+ * the received bytes and, when RequestSize is not 0, writes a response of ResponseSize bytes for each complete request.
+ * With a RequestSize of 0 the data is only sunk.
+ *
+ * See Also
+ * BofSocketBenchmarkServer
+ */
+class BofSocketBenchmarkSession : public BofSocketIo
+{
+private:
+  BOF_SOCKET_BENCHMARK_SERVER_COUNTER &mrCounter_X;
+  const std::vector<uint8_t>          &mrResponse;
+  uint32_t                            mRequestSize_U32;
+  uint32_t                            mTimeoutInMs_U32;
+  uint32_t                            mPending_U32 = 0;     //Request bytes received and not answered yet
+
+public:
+  BofSocketBenchmarkSession(std::unique_ptr<BofSocket> _puSocket, const BOF_SOCKET_IO_PARAM &_rBofSocketIoParam_X, BOF_SOCKET_BENCHMARK_SERVER_COUNTER &_rCounter_X,
+                            uint32_t _RequestSize_U32, const std::vector<uint8_t> &_rResponse, uint32_t _TimeoutInMs_U32)
+    : BofSocketIo(nullptr, std::move(_puSocket), _rBofSocketIoParam_X), mrCounter_X(_rCounter_X), mrResponse(_rResponse), mRequestSize_U32(_RequestSize_U32), mTimeoutInMs_U32(_TimeoutInMs_U32)
+  {
+  }
+  virtual ~BofSocketBenchmarkSession()
+  {
+  }
+  BofSocketBenchmarkSession &operator=(const BofSocketBenchmarkSession &) = delete; // Disallow copying
+  BofSocketBenchmarkSession(const BofSocketBenchmarkSession &) = delete;
+
+  BOFERR V_SignalDataRead(uint32_t _Nb_U32, const uint8_t * /*_pBuffer_U8*/) override
+  {
+    BOFERR Rts_E = BOF_ERR_NO_ERROR;
+    uint32_t Nb_U32;
+
+    mrCounter_X.NbByteReceived_U64.fetch_add(_Nb_U32);
+    if (mRequestSize_U32)
+    {
+      mPending_U32 += _Nb_U32;
+      while ((Rts_E == BOF_ERR_NO_ERROR) && (mPending_U32 >= mRequestSize_U32))
+      {
+        mPending_U32 -= mRequestSize_U32;
+        //A response smaller than the socket buffer never blocks: the client waits for it before its next request
+        if (mrResponse.size())
+        {
+          Nb_U32 = static_cast<uint32_t>(mrResponse.size());
+          Rts_E = Write(mTimeoutInMs_U32, false, Nb_U32, mrResponse.data(), nullptr);
+        }
+      }
+    }
+    return Rts_E;
+  }
+};
+
+/*!
+ * Summary
+ * Loopback tcp server of the tcp benchmarks
+ *
+ * Description
+ * A BofSocketPollServer driven by the poller engine under test accepts the connections of its listener and gives
+ * each of them to a BofSocketBenchmarkSession, so the figures include the library dispatch path (session table,
+ * ParseAndDispatchIncomingData, BofSocketIo::Write) and not only the kernel. The counters can be read from any thread.
+ *
+ * See Also
+ * Bof_SocketBenchmarkSuite
+ */
+class BofSocketBenchmarkServer : public IBofSocketSessionFactory
+{
+private:
+  BOFERR                               mErrorCode_E = BOF_ERR_INIT;
+  uint16_t                             mPort_U16 = 0;
+  uint32_t                             mRequestSize_U32 = 0;
+  uint32_t                             mTimeoutInMs_U32 = 0;
+  std::vector<uint8_t>                 mResponse;
+  BOF_SOCKET_BENCHMARK_SERVER_COUNTER  mCounter_X;
+  std::unique_ptr<BofSocketPollServer> mpuPollServer = nullptr;   //Destroyed first: its sessions use the members above
+
+public:
+  BofSocketBenchmarkServer(BOF_SOCKET_POLLER_ENGINE _Engine_E, uint32_t _RequestSize_U32, uint32_t _ResponseSize_U32, uint32_t _TimeoutInMs_U32)
+    : mRequestSize_U32(_RequestSize_U32), mTimeoutInMs_U32(_TimeoutInMs_U32), mResponse(_ResponseSize_U32, 0xA5)
+  {
+    BOF_SOCKET_POLL_SERVER_PARAM PollServerParam_X;
+    BOF_SOCKET_PARAM ListenerParam_X;
+    std::unique_ptr<BofSocket> puListener;
+    BOFSOCKET Listener;
+
+    PollServerParam_X.SocketServerParam_X.Name_S = "bofbench_server";
+    PollServerParam_X.SocketServerParam_X.NbMaxSession_U32 = 0x10000;
+    PollServerParam_X.Engine_E = _Engine_E;
+    PollServerParam_X.PollTimeoutInMs_U32 = 100;
+    mpuPollServer.reset(new BofSocketPollServer(this, PollServerParam_X));
+    mErrorCode_E = mpuPollServer->LastErrorCode();
+    if (mErrorCode_E == BOF_ERR_NO_ERROR)
+    {
+      mErrorCode_E = BOF_ERR_CREATE;
+      Listener = Bof_SocketBenchmarkTcpListen(mPort_U16);
+      if (Listener != BOFSOCKET_INVALID)
+      {
+        ListenerParam_X.BaseChannelParam_X.ChannelName_S = "bofbench_listener";
+        ListenerParam_X.BaseChannelParam_X.Blocking_B = true;
+        ListenerParam_X.BaseChannelParam_X.ListenBackLog_U32 = SOMAXCONN;
+        ListenerParam_X.BindIpAddress_S = Bof_Sprintf("tcp://127.0.0.1:%d", mPort_U16);
+        ListenerParam_X.NoDelay_B = true;
+        puListener.reset(new BofSocket(Listener, ListenerParam_X));
+        mErrorCode_E = puListener->LastErrorCode();
+        if (mErrorCode_E == BOF_ERR_NO_ERROR)
+        {
+          mErrorCode_E = mpuPollServer->AddListener(std::move(puListener), BOF_SOCKET_POLLER_DISPATCH::BOF_SOCKET_POLLER_DISPATCH_DATA_READ,
+                                                    BOF_SOCKET_POLLER_TRIGGER::BOF_SOCKET_POLLER_TRIGGER_LEVEL);
+        }
+        if (mErrorCode_E == BOF_ERR_NO_ERROR)
+        {
+          mErrorCode_E = mpuPollServer->Start();
+        }
+      }
+    }
+  }
+  virtual ~BofSocketBenchmarkServer()
+  {
+    mpuPollServer.reset(nullptr);
+  }
+  BofSocketBenchmarkServer &operator=(const BofSocketBenchmarkServer &) = delete; // Disallow copying
+  BofSocketBenchmarkServer(const BofSocketBenchmarkServer &) = delete;
+
+  BOFERR LastErrorCode() const
+  {
+    return mErrorCode_E;
+  }
+  const char *EngineName() const
+  {
+    return mpuPollServer->EngineName();
+  }
+  uint16_t Port() const
+  {
+    return mPort_U16;
+  }
+  uint64_t NbAccept() const
+  {
+    return mCounter_X.NbAccept_U64.load();
+  }
+  uint64_t NbSession() const
+  {
+    return mpuPollServer->NbSession();
+  }
+  uint64_t NbByteReceived() const
+  {
+    return mCounter_X.NbByteReceived_U64.load();
+  }
+
+  //Polls _rCounter until it reaches _Target_U64 or the timeout expires
+  static bool S_WaitCounter(const std::atomic<uint64_t> &_rCounter, uint64_t _Target_U64, uint32_t _TimeoutInMs_U32)
+  {
+    uint32_t Start_U32 = Bof_GetMsTickCount();
+
+    while ((_rCounter.load() < _Target_U64) && (Bof_ElapsedMsTime(Start_U32) < _TimeoutInMs_U32))
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return _rCounter.load() >= _Target_U64;
+  }
+  bool WaitNbAccept(uint64_t _Nb_U64, uint32_t _TimeoutInMs_U32) const
+  {
+    return S_WaitCounter(mCounter_X.NbAccept_U64, _Nb_U64, _TimeoutInMs_U32);
+  }
+  bool WaitNbByteReceived(uint64_t _Nb_U64, uint32_t _TimeoutInMs_U32) const
+  {
+    return S_WaitCounter(mCounter_X.NbByteReceived_U64, _Nb_U64, _TimeoutInMs_U32);
+  }
+
+  //Called by the poll thread for each accepted connection
+  std::shared_ptr<BofSocketIo> V_OpenSession(BOF_SOCKET_SESSION_TYPE /*_SessionType_E*/, uint32_t _SessionIndex_U32, std::unique_ptr<BofSocket> _puSocket) override
+  {
+    BOF_SOCKET_IO_PARAM SocketIoParam_X;
+
+    mCounter_X.NbAccept_U64.fetch_add(1);
+    SocketIoParam_X.Name_S = Bof_Sprintf("bofbench_session_%u", _SessionIndex_U32);
+    SocketIoParam_X.NotifyRcvBufferSize_U32 = 0x10000;
+    SocketIoParam_X.NotifyType_E = BOF_SOCKET_IO_NOTIFY_TYPE::ASAP;
+    return std::make_shared<BofSocketBenchmarkSession>(std::move(_puSocket), SocketIoParam_X, mCounter_X, mRequestSize_U32, mResponse, mTimeoutInMs_U32);
+  }
+  //Called by the poll thread once a session closed by its peer has been removed: dropping the reference closes it
+  BOFERR V_CloseSession(std::shared_ptr<BofSocketIo> /*_psSocketSession*/) override
+  {
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+//Request/response round trips on one connection, after _NbIdle_U32 idle connections have been accepted by the same server
+BOFERR Bof_SocketBenchmarkTcpLatency(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_POLLER_ENGINE _Engine_E, uint32_t _NbIdle_U32, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E;
+  BofSocketBenchmarkServer Server(_Engine_E, _rParam_X.RequestSizeInByte_U32, _rParam_X.ResponseSizeInByte_U32, _rParam_X.TimeoutInMs_U32);
+  std::vector<BOFSOCKET> IdleCollection;
+  std::vector<uint64_t> SampleCollection;
+  std::vector<uint8_t> Request(_rParam_X.RequestSizeInByte_U32, 0x5A), Response(_rParam_X.ResponseSizeInByte_U32);
+  BOFSOCKET Client;
+  uint32_t i_U32;
+  uint64_t Start_U64, Now_U64;
+  bool Ok_B;
+
+  _rResult_X.Variant_S = Server.EngineName();
+  Rts_E = Server.LastErrorCode();
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = BOF_ERR_CREATE;
+    Ok_B = true;
+    for (i_U32 = 0; (i_U32 < _NbIdle_U32) && (Ok_B); i_U32++)
+    {
+      IdleCollection.push_back(Bof_SocketBenchmarkTcpConnect(Server.Port()));
+      Ok_B = (IdleCollection.back() != BOFSOCKET_INVALID);
+    }
+    Client = Ok_B ? Bof_SocketBenchmarkTcpConnect(Server.Port()) : BOFSOCKET_INVALID;
+    if (Client != BOFSOCKET_INVALID)
+    {
+      Rts_E = BOF_ERR_ETIMEDOUT;
+      if (Server.WaitNbAccept(_NbIdle_U32 + 1, _rParam_X.TimeoutInMs_U32))
+      {
+        Rts_E = BOF_ERR_NO_ERROR;
+        _rResult_X.NbSession_U32 = static_cast<uint32_t>(Server.NbSession());
+        SampleCollection.reserve(_rParam_X.NbRequest_U32);
+        Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+        for (i_U32 = 0; (i_U32 < _rParam_X.NbRequest_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+        {
+          Now_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+          if ((Bof_SocketBenchmarkWriteAll(Client, Request.data(), Request.size())) && (Bof_SocketBenchmarkReadAll(Client, Response.data(), Response.size())))
+          {
+            SampleCollection.push_back(Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Now_U64);
+          }
+          else
+          {
+            Rts_E = BOF_ERR_READ;
+          }
+        }
+        _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+        _rResult_X.NbOperation_U64 = SampleCollection.size();
+        _rResult_X.NbByte_U64 = SampleCollection.size() * (Request.size() + Response.size());
+        Bof_SocketBenchmarkLatency(SampleCollection, _rResult_X);
+      }
+      close(Client);
+    }
+    for (i_U32 = 0; i_U32 < IdleCollection.size(); i_U32++)
+    {
+      if (IdleCollection[i_U32] != BOFSOCKET_INVALID)
+      {
+        close(IdleCollection[i_U32]);
+      }
+    }
+  }
+  return Rts_E;
+}
+
+//One way stream of StreamSizeInByte_U64 bytes written by ChunkSizeInByte_U32: ends when the server has read everything
+BOFERR Bof_SocketBenchmarkTcpStream(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_POLLER_ENGINE _Engine_E, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E;
+  BofSocketBenchmarkServer Server(_Engine_E, 0, 0, _rParam_X.TimeoutInMs_U32);
+  std::vector<uint8_t> Chunk(_rParam_X.ChunkSizeInByte_U32, 0x5A);
+  BOFSOCKET Client;
+  uint64_t Start_U64, Remain_U64;
+  size_t Nb;
+
+  _rResult_X.Variant_S = Server.EngineName();
+  Rts_E = Server.LastErrorCode();
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = BOF_ERR_CREATE;
+    Client = Bof_SocketBenchmarkTcpConnect(Server.Port());
+    if (Client != BOFSOCKET_INVALID)
+    {
+      Rts_E = BOF_ERR_NO_ERROR;
+      _rResult_X.NbSession_U32 = 1;
+      Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+      Remain_U64 = _rParam_X.StreamSizeInByte_U64;
+      while ((Remain_U64) && (Rts_E == BOF_ERR_NO_ERROR))
+      {
+        Nb = (Remain_U64 > Chunk.size()) ? Chunk.size() : static_cast<size_t>(Remain_U64);
+        if (Bof_SocketBenchmarkWriteAll(Client, Chunk.data(), Nb))
+        {
+          Remain_U64 -= Nb;
+          _rResult_X.NbOperation_U64++;
+        }
+        else
+        {
+          Rts_E = BOF_ERR_WRITE;
+        }
+      }
+      if ((Rts_E == BOF_ERR_NO_ERROR) && (!Server.WaitNbByteReceived(_rParam_X.StreamSizeInByte_U64, _rParam_X.TimeoutInMs_U32)))
+      {
+        Rts_E = BOF_ERR_ETIMEDOUT;
+      }
+      _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+      _rResult_X.NbByte_U64 = Server.NbByteReceived();
+      close(Client);
+    }
+  }
+  return Rts_E;
+}
+
+//NbConnection_U32 sequential connect/close: ends when the server has accepted all of them
+BOFERR Bof_SocketBenchmarkAcceptRate(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_POLLER_ENGINE _Engine_E, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E;
+  BofSocketBenchmarkServer Server(_Engine_E, 0, 0, _rParam_X.TimeoutInMs_U32);
+  std::vector<uint64_t> SampleCollection;
+  BOFSOCKET Client;
+  uint32_t i_U32;
+  uint64_t Start_U64, Now_U64;
+
+  _rResult_X.Variant_S = Server.EngineName();
+  Rts_E = Server.LastErrorCode();
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    SampleCollection.reserve(_rParam_X.NbConnection_U32);
+    Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+    for (i_U32 = 0; (i_U32 < _rParam_X.NbConnection_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+    {
+      Now_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+      Client = Bof_SocketBenchmarkTcpConnect(Server.Port());
+      if (Client != BOFSOCKET_INVALID)
+      {
+        SampleCollection.push_back(Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Now_U64);
+        close(Client);
+      }
+      else
+      {
+        Rts_E = static_cast<BOFERR>(errno);
+      }
+    }
+    if ((Rts_E == BOF_ERR_NO_ERROR) && (!Server.WaitNbAccept(_rParam_X.NbConnection_U32, _rParam_X.TimeoutInMs_U32)))
+    {
+      Rts_E = BOF_ERR_ETIMEDOUT;
+    }
+    _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+    _rResult_X.NbOperation_U64 = Server.NbAccept();
+    Bof_SocketBenchmarkLatency(SampleCollection, _rResult_X);
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Ftp like transfer: the client sends a RETR command on a control connection and opens a data connection, the
+ * server sends FileSizeInByte_U64 bytes of a temporary file with Bof_SocketSendFile, closes the data connection and
+ * answers 226 on the control one. The wall time goes from the command to the 226 answer.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _rResult_X: Returns the measured values
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+BOFERR Bof_SocketBenchmarkFileTransfer(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E = BOF_ERR_CREATE;
+  char pFileName_c[] = "/tmp/bofbenchXXXXXX";
+  std::vector<uint8_t> Buffer(0x10000, 0x5A);
+  std::atomic<BOFERR> ServerSts_E(BOF_ERR_NO_ERROR);
+  BOFSOCKET ControlListener, DataListener, Control, Data;
+  uint16_t ControlPort_U16 = 0, DataPort_U16 = 0;
+  uint64_t Remain_U64, Start_U64;
+  uint8_t pCommand_U8[6];
+  int FileFd_i;
+  size_t Nb;
+  ssize_t Sts;
+
+  _rResult_X.Variant_S = "sendfile";
+  _rResult_X.NbSession_U32 = 2;
+  FileFd_i = mkstemp(pFileName_c);
+  if (FileFd_i >= 0)
+  {
+    unlink(pFileName_c);
+    Rts_E = BOF_ERR_NO_ERROR;
+    for (Remain_U64 = _rParam_X.FileSizeInByte_U64; (Remain_U64) && (Rts_E == BOF_ERR_NO_ERROR); Remain_U64 -= Nb)
+    {
+      Nb = (Remain_U64 > Buffer.size()) ? Buffer.size() : static_cast<size_t>(Remain_U64);
+      Rts_E = Bof_SocketBenchmarkWriteAll(FileFd_i, Buffer.data(), Nb) ? BOF_ERR_NO_ERROR : BOF_ERR_WRITE;
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = BOF_ERR_CREATE;
+      ControlListener = Bof_SocketBenchmarkTcpListen(ControlPort_U16);
+      DataListener = Bof_SocketBenchmarkTcpListen(DataPort_U16);
+      if ((ControlListener != BOFSOCKET_INVALID) && (DataListener != BOFSOCKET_INVALID))
+      {
+        std::thread Server([&]() {
+          BOFSOCKET ServerControl, ServerData;
+          uint64_t NbSent_U64 = 0;
+          uint8_t pRequest_U8[6];
+
+          ServerControl = accept4(ControlListener, nullptr, nullptr, SOCK_CLOEXEC);
+          if (ServerControl != BOFSOCKET_INVALID)
+          {
+            if (Bof_SocketBenchmarkReadAll(ServerControl, pRequest_U8, sizeof(pRequest_U8)))
+            {
+              ServerData = accept4(DataListener, nullptr, nullptr, SOCK_CLOEXEC);
+              if (ServerData != BOFSOCKET_INVALID)
+              {
+                ServerSts_E.store(Bof_SocketSendFile(ServerData, FileFd_i, 0, _rParam_X.FileSizeInByte_U64, _rParam_X.TimeoutInMs_U32, NbSent_U64));
+                close(ServerData);
+                Bof_SocketBenchmarkWriteAll(ServerControl, reinterpret_cast<const uint8_t *>("226\r\n"), 5);
+              }
+            }
+            close(ServerControl);
+          }
+        });
+        Control = Bof_SocketBenchmarkTcpConnect(ControlPort_U16);
+        if (Control != BOFSOCKET_INVALID)
+        {
+          Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+          memcpy(pCommand_U8, "RETR\r\n", sizeof(pCommand_U8));
+          if (Bof_SocketBenchmarkWriteAll(Control, pCommand_U8, sizeof(pCommand_U8)))
+          {
+            Data = Bof_SocketBenchmarkTcpConnect(DataPort_U16);
+            if (Data != BOFSOCKET_INVALID)
+            {
+              Rts_E = BOF_ERR_NO_ERROR;
+              do
+              {
+                Sts = read(Data, Buffer.data(), Buffer.size());
+                if (Sts > 0)
+                {
+                  _rResult_X.NbByte_U64 += static_cast<uint64_t>(Sts);
+                }
+              } while ((Sts > 0) || ((Sts < 0) && (errno == EINTR)));
+              close(Data);
+              if (!Bof_SocketBenchmarkReadAll(Control, pCommand_U8, 5))
+              {
+                Rts_E = BOF_ERR_READ;
+              }
+              _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+            }
+          }
+          close(Control);
+        }
+        //Unblocks the server thread if the client side failed before connecting
+        shutdown(ControlListener, SHUT_RDWR);
+        shutdown(DataListener, SHUT_RDWR);
+        Server.join();
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = ServerSts_E.load();
+        }
+        if ((Rts_E == BOF_ERR_NO_ERROR) && (_rResult_X.NbByte_U64 != _rParam_X.FileSizeInByte_U64))
+        {
+          Rts_E = BOF_ERR_READ;
+        }
+        _rResult_X.NbOperation_U64 = (Rts_E == BOF_ERR_NO_ERROR) ? 1 : 0;
+      }
+      if (ControlListener != BOFSOCKET_INVALID)
+      {
+        close(ControlListener);
+      }
+      if (DataListener != BOFSOCKET_INVALID)
+      {
+        close(DataListener);
+      }
+    }
+    close(FileFd_i);
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Ping pong of RequestSizeInByte_U32 bytes between the calling thread and an echo thread over the two kernel
+ * transports used by BofPipe: a pair of native pipes, or a pair of connected loopback udp sockets.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _Udp_B:     true for the local udp transport, false for the native pipes
+ * _rResult_X: Returns the measured values
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+BOFERR Bof_SocketBenchmarkPipeRoundTrip(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, bool _Udp_B, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E = BOF_ERR_CREATE;
+  std::vector<uint64_t> SampleCollection;
+  std::vector<uint8_t> Request(_rParam_X.RequestSizeInByte_U32, 0x5A), Response(_rParam_X.RequestSizeInByte_U32);
+  int pToEcho_i[2] = { -1, -1 }, pFromEcho_i[2] = { -1, -1 };
+  struct sockaddr_in pAddress_X[2];
+  socklen_t Len;
+  uint32_t i_U32;
+  uint64_t Start_U64, Now_U64;
+  bool Ok_B = false;
+
+  _rResult_X.Variant_S = _Udp_B ? "local_udp" : "native";
+  _rResult_X.NbSession_U32 = 1;
+  if (_Udp_B)
+  {
+    //pToEcho_i[0] is the client end, pToEcho_i[1] the echo end: both directions use the same socket pair
+    pToEcho_i[0] = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    pToEcho_i[1] = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if ((pToEcho_i[0] >= 0) && (pToEcho_i[1] >= 0))
+    {
+      for (i_U32 = 0; i_U32 < 2; i_U32++)
+      {
+        memset(&pAddress_X[i_U32], 0, sizeof(pAddress_X[i_U32]));
+        pAddress_X[i_U32].sin_family = AF_INET;
+        pAddress_X[i_U32].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        Len = sizeof(pAddress_X[i_U32]);
+        if ((bind(pToEcho_i[i_U32], reinterpret_cast<struct sockaddr *>(&pAddress_X[i_U32]), sizeof(pAddress_X[i_U32])) == 0) &&
+            (getsockname(pToEcho_i[i_U32], reinterpret_cast<struct sockaddr *>(&pAddress_X[i_U32]), &Len) == 0))
+        {
+        }
+        else
+        {
+          pAddress_X[i_U32].sin_port = 0;
+        }
+      }
+      Ok_B = (pAddress_X[0].sin_port) && (pAddress_X[1].sin_port) && (connect(pToEcho_i[0], reinterpret_cast<struct sockaddr *>(&pAddress_X[1]), sizeof(pAddress_X[1])) == 0) &&
+             (connect(pToEcho_i[1], reinterpret_cast<struct sockaddr *>(&pAddress_X[0]), sizeof(pAddress_X[0])) == 0);
+      pFromEcho_i[0] = pToEcho_i[0];
+      pFromEcho_i[1] = pToEcho_i[1];
+    }
+  }
+  else
+  {
+    Ok_B = (pipe2(pToEcho_i, O_CLOEXEC) == 0) && (pipe2(pFromEcho_i, O_CLOEXEC) == 0);
+  }
+  if (Ok_B)
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+    //Native pipe: client writes pToEcho_i[1], echo reads pToEcho_i[0] and writes pFromEcho_i[1], client reads pFromEcho_i[0]
+    int ClientTx_i = _Udp_B ? pToEcho_i[0] : pToEcho_i[1], ClientRx_i = _Udp_B ? pToEcho_i[0] : pFromEcho_i[0];
+    int EchoRx_i = _Udp_B ? pToEcho_i[1] : pToEcho_i[0], EchoTx_i = _Udp_B ? pToEcho_i[1] : pFromEcho_i[1];
+    std::thread Echo([&]() {
+      std::vector<uint8_t> Buffer(Request.size());
+      uint32_t j_U32;
+
+      for (j_U32 = 0; j_U32 < _rParam_X.NbRequest_U32; j_U32++)
+      {
+        //A datagram is read and written in one call, a pipe transfer below PIPE_BUF is atomic
+        if ((Bof_SocketBenchmarkReadAll(EchoRx_i, Buffer.data(), Buffer.size())) && (Bof_SocketBenchmarkWriteAll(EchoTx_i, Buffer.data(), Buffer.size())))
+        {
+        }
+        else
+        {
+          j_U32 = _rParam_X.NbRequest_U32;
+        }
+      }
+    });
+    SampleCollection.reserve(_rParam_X.NbRequest_U32);
+    Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+    for (i_U32 = 0; (i_U32 < _rParam_X.NbRequest_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+    {
+      Now_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+      if ((Bof_SocketBenchmarkWriteAll(ClientTx_i, Request.data(), Request.size())) && (Bof_SocketBenchmarkReadAll(ClientRx_i, Response.data(), Response.size())))
+      {
+        SampleCollection.push_back(Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Now_U64);
+      }
+      else
+      {
+        Rts_E = BOF_ERR_READ;
+      }
+    }
+    _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+    //On error the echo thread is released by the end of stream (pipe) or the shutdown (udp)
+    if (Rts_E != BOF_ERR_NO_ERROR)
+    {
+      shutdown(EchoRx_i, SHUT_RDWR);
+      close(ClientTx_i);
+      ClientTx_i = -1;
+      pToEcho_i[_Udp_B ? 0 : 1] = -1;
+    }
+    Echo.join();
+    _rResult_X.NbOperation_U64 = SampleCollection.size();
+    _rResult_X.NbByte_U64 = SampleCollection.size() * Request.size() * 2;
+    Bof_SocketBenchmarkLatency(SampleCollection, _rResult_X);
+  }
+  for (i_U32 = 0; i_U32 < 2; i_U32++)
+  {
+    if (pToEcho_i[i_U32] >= 0)
+    {
+      close(pToEcho_i[i_U32]);
+    }
+    if ((!_Udp_B) && (pFromEcho_i[i_U32] >= 0))
+    {
+      close(pFromEcho_i[i_U32]);
+    }
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Ping pong of RequestSizeInByte_U32 bytes between the calling thread and an echo thread over a BofShmPipe, the
+ * shared memory transport of BOF_PIPE_OVER_SHM.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _rResult_X: Returns the measured values
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+BOFERR Bof_SocketBenchmarkShmPipeRoundTrip(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E;
+  std::vector<uint64_t> SampleCollection;
+  std::vector<uint8_t> Request(_rParam_X.RequestSizeInByte_U32, 0x5A), Response(_rParam_X.RequestSizeInByte_U32);
+  BOF_SHM_PIPE_PARAM ShmPipeParam_X;
+  uint32_t i_U32, Nb_U32;
+  uint64_t Start_U64, Now_U64;
+
+  _rResult_X.Variant_S = "shm_ring";
+  _rResult_X.NbSession_U32 = 1;
+  ShmPipeParam_X.BaseChannelParam_X.ChannelName_S = Bof_Sprintf("bofbench_shm_%d", getpid());
+  ShmPipeParam_X.RingSizeInByte_U32 = (_rParam_X.RequestSizeInByte_U32 + BOF_SHM_RING_RECORD_HEADER_SIZE) * 4;
+  if (ShmPipeParam_X.RingSizeInByte_U32 < BOF_SHM_PIPE_DEFAULT_RING_SIZE)
+  {
+    ShmPipeParam_X.RingSizeInByte_U32 = BOF_SHM_PIPE_DEFAULT_RING_SIZE;
+  }
+  BofShmPipe::S_Destroy(ShmPipeParam_X.BaseChannelParam_X.ChannelName_S);
+  {
+    BofShmPipe Client(ShmPipeParam_X);
+    ShmPipeParam_X.BaseChannelParam_X.ListenBackLog_U32 = 1;
+    BofShmPipe Echo(ShmPipeParam_X);
+
+    Rts_E = Client.LastErrorCode();
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      Rts_E = Echo.LastErrorCode();
+    }
+    if (Rts_E == BOF_ERR_NO_ERROR)
+    {
+      std::thread EchoThread([&]() {
+        std::vector<uint8_t> Buffer(Request.size());
+        uint32_t j_U32, EchoNb_U32;
+        BOFERR Sts_E = BOF_ERR_NO_ERROR;
+
+        for (j_U32 = 0; (j_U32 < _rParam_X.NbRequest_U32) && (Sts_E == BOF_ERR_NO_ERROR); j_U32++)
+        {
+          //The request is below MaxRecordSize: it is read and written as a single record
+          EchoNb_U32 = static_cast<uint32_t>(Buffer.size());
+          Sts_E = Echo.V_ReadData(_rParam_X.TimeoutInMs_U32, EchoNb_U32, Buffer.data());
+          if (Sts_E == BOF_ERR_NO_ERROR)
+          {
+            Sts_E = Echo.V_WriteData(_rParam_X.TimeoutInMs_U32, EchoNb_U32, Buffer.data());
+          }
+        }
+      });
+      SampleCollection.reserve(_rParam_X.NbRequest_U32);
+      Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+      for (i_U32 = 0; (i_U32 < _rParam_X.NbRequest_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+      {
+        Now_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+        Nb_U32 = static_cast<uint32_t>(Request.size());
+        Rts_E = Client.V_WriteData(_rParam_X.TimeoutInMs_U32, Nb_U32, Request.data());
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Nb_U32 = static_cast<uint32_t>(Response.size());
+          Rts_E = Client.V_ReadData(_rParam_X.TimeoutInMs_U32, Nb_U32, Response.data());
+          if ((Rts_E == BOF_ERR_NO_ERROR) && (Nb_U32 == Response.size()))
+          {
+            SampleCollection.push_back(Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Now_U64);
+          }
+          else if (Rts_E == BOF_ERR_NO_ERROR)
+          {
+            Rts_E = BOF_ERR_READ;
+          }
+        }
+      }
+      _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+      //On error the echo thread gives up after TimeoutInMs_U32
+      EchoThread.join();
+      _rResult_X.NbOperation_U64 = SampleCollection.size();
+      _rResult_X.NbByte_U64 = SampleCollection.size() * Request.size() * 2;
+      Bof_SocketBenchmarkLatency(SampleCollection, _rResult_X);
+    }
+  }
+  BofShmPipe::S_Destroy(ShmPipeParam_X.BaseChannelParam_X.ChannelName_S);
+  return Rts_E;
+}
+
+//V_WriteData until _Nb_U32 bytes are written: returns false on error or timeout
+bool Bof_SocketBenchmarkChannelWriteAll(BofComChannel &_rChannel, uint32_t _TimeoutInMs_U32, const uint8_t *_pBuffer_U8, uint32_t _Nb_U32)
+{
+  bool Rts_B = true;
+  uint32_t Nb_U32;
+
+  while ((Rts_B) && (_Nb_U32))
+  {
+    Nb_U32 = _Nb_U32;
+    Rts_B = (_rChannel.V_WriteData(_TimeoutInMs_U32, Nb_U32, _pBuffer_U8) == BOF_ERR_NO_ERROR) && (Nb_U32) && (Nb_U32 <= _Nb_U32);
+    if (Rts_B)
+    {
+      _pBuffer_U8 += Nb_U32;
+      _Nb_U32 -= Nb_U32;
+    }
+  }
+  return Rts_B;
+}
+
+//V_ReadData until _Nb_U32 bytes are read: returns false on error or timeout
+bool Bof_SocketBenchmarkChannelReadAll(BofComChannel &_rChannel, uint32_t _TimeoutInMs_U32, uint8_t *_pBuffer_U8, uint32_t _Nb_U32)
+{
+  bool Rts_B = true;
+  uint32_t Nb_U32;
+
+  while ((Rts_B) && (_Nb_U32))
+  {
+    Nb_U32 = _Nb_U32;
+    Rts_B = (_rChannel.V_ReadData(_TimeoutInMs_U32, Nb_U32, _pBuffer_U8) == BOF_ERR_NO_ERROR) && (Nb_U32) && (Nb_U32 <= _Nb_U32);
+    if (Rts_B)
+    {
+      _pBuffer_U8 += Nb_U32;
+      _Nb_U32 -= Nb_U32;
+    }
+  }
+  return Rts_B;
+}
+
+//Echoes _NbRequest_U32 requests of _Nb_U32 bytes from _rRx to _rTx, stops on the first error (the client timed out or closed)
+void Bof_SocketBenchmarkChannelEcho(BofComChannel &_rRx, BofComChannel &_rTx, uint32_t _TimeoutInMs_U32, uint32_t _NbRequest_U32, uint32_t _Nb_U32)
+{
+  std::vector<uint8_t> Buffer(_Nb_U32);
+  uint32_t i_U32;
+
+  for (i_U32 = 0; i_U32 < _NbRequest_U32; i_U32++)
+  {
+    if ((!Bof_SocketBenchmarkChannelReadAll(_rRx, _TimeoutInMs_U32, Buffer.data(), _Nb_U32)) || (!Bof_SocketBenchmarkChannelWriteAll(_rTx, _TimeoutInMs_U32, Buffer.data(), _Nb_U32)))
+    {
+      i_U32 = _NbRequest_U32;
+    }
+  }
+}
+
+//Client side of the library benchmarks: NbRequest_U32 round trips of RequestSizeInByte_U32 bytes, written on _rTx and echoed back on _rRx
+BOFERR Bof_SocketBenchmarkChannelRoundTrip(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BofComChannel &_rTx, BofComChannel &_rRx, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E = BOF_ERR_NO_ERROR;
+  std::vector<uint64_t> SampleCollection;
+  std::vector<uint8_t> Request(_rParam_X.RequestSizeInByte_U32, 0x5A), Response(_rParam_X.RequestSizeInByte_U32);
+  uint32_t i_U32;
+  uint64_t Start_U64, Now_U64;
+
+  SampleCollection.reserve(_rParam_X.NbRequest_U32);
+  Start_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+  for (i_U32 = 0; (i_U32 < _rParam_X.NbRequest_U32) && (Rts_E == BOF_ERR_NO_ERROR); i_U32++)
+  {
+    Now_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC);
+    if ((Bof_SocketBenchmarkChannelWriteAll(_rTx, _rParam_X.TimeoutInMs_U32, Request.data(), _rParam_X.RequestSizeInByte_U32)) &&
+        (Bof_SocketBenchmarkChannelReadAll(_rRx, _rParam_X.TimeoutInMs_U32, Response.data(), _rParam_X.RequestSizeInByte_U32)))
+    {
+      SampleCollection.push_back(Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Now_U64);
+    }
+    else
+    {
+      Rts_E = BOF_ERR_READ;
+    }
+  }
+  _rResult_X.WallInNs_U64 = Bof_SocketBenchmarkClockInNs(CLOCK_MONOTONIC) - Start_U64;
+  _rResult_X.NbOperation_U64 = SampleCollection.size();
+  _rResult_X.NbByte_U64 = SampleCollection.size() * Request.size() * 2;
+  Bof_SocketBenchmarkLatency(SampleCollection, _rResult_X);
+  return Rts_E;
+}
+
+/*!
+ * Summary
+ * Echo session of the BofSocketServer benchmark
+ *
+ * Description
+ * BofSocketIo whose V_SignalDataRead, called from the session manager thread of the BofSocketServer, writes the
+ * received bytes back synchronously: the round trip measures the whole BofSocketServer/BofSocketIo dispatch path.
+ *
+ * See Also
+ * Bof_SocketBenchmarkLibraryRoundTrip
+ */
+class BofSocketBenchmarkEchoSession : public BofSocketIo
+{
+private:
+  uint32_t mTimeoutInMs_U32;
+
+public:
+  BofSocketBenchmarkEchoSession(BofSocketServer *_pBofSocketServer, std::unique_ptr<BofSocket> _puSocket, const BOF_SOCKET_IO_PARAM &_rBofSocketIoParam_X, uint32_t _TimeoutInMs_U32)
+    : BofSocketIo(_pBofSocketServer, std::move(_puSocket), _rBofSocketIoParam_X), mTimeoutInMs_U32(_TimeoutInMs_U32)
+  {
+  }
+  virtual ~BofSocketBenchmarkEchoSession()
+  {
+  }
+  BofSocketBenchmarkEchoSession &operator=(const BofSocketBenchmarkEchoSession &) = delete; // Disallow copying
+  BofSocketBenchmarkEchoSession(const BofSocketBenchmarkEchoSession &) = delete;
+
+  BOFERR V_SignalDataRead(uint32_t _Nb_U32, const uint8_t *_pBuffer_U8) override
+  {
+    uint32_t Nb_U32 = _Nb_U32;
+
+    return Write(mTimeoutInMs_U32, false, Nb_U32, _pBuffer_U8, nullptr);
+  }
+};
+
+//Creates the BofSocketBenchmarkEchoSession of the connections accepted by the BofSocketServer given to Server()
+class BofSocketBenchmarkEchoSessionFactory : public IBofSocketSessionFactory
+{
+private:
+  BofSocketServer *mpBofSocketServer = nullptr;
+  uint32_t        mTimeoutInMs_U32;
+
+public:
+  BofSocketBenchmarkEchoSessionFactory(uint32_t _TimeoutInMs_U32) : mTimeoutInMs_U32(_TimeoutInMs_U32)
+  {
+  }
+  virtual ~BofSocketBenchmarkEchoSessionFactory()
+  {
+  }
+  //The server is built with the factory: it is given once constructed, before any connection
+  void Server(BofSocketServer *_pBofSocketServer)
+  {
+    mpBofSocketServer = _pBofSocketServer;
+  }
+  std::shared_ptr<BofSocketIo> V_OpenSession(BOF_SOCKET_SESSION_TYPE /*_SessionType_E*/, uint32_t _SessionIndex_U32, std::unique_ptr<BofSocket> _puSocket) override
+  {
+    BOF_SOCKET_IO_PARAM SocketIoParam_X;
+
+    SocketIoParam_X.Name_S = Bof_Sprintf("bofbench_echo_%u", _SessionIndex_U32);
+    SocketIoParam_X.NotifyRcvBufferSize_U32 = 0x10000;
+    SocketIoParam_X.NotifyType_E = BOF_SOCKET_IO_NOTIFY_TYPE::ASAP;
+    return std::make_shared<BofSocketBenchmarkEchoSession>(mpBofSocketServer, std::move(_puSocket), SocketIoParam_X, mTimeoutInMs_U32);
+  }
+  BOFERR V_CloseSession(std::shared_ptr<BofSocketIo> /*_psSocketSession*/) override
+  {
+    return BOF_ERR_NO_ERROR;
+  }
+};
+
+//Blocking BofSocket connected to the loopback tcp port _Port_U16 with BofSocket::V_Connect
+BOFERR Bof_SocketBenchmarkBofSocketConnect(uint32_t _TimeoutInMs_U32, uint16_t _Port_U16, std::unique_ptr<BofSocket> &_rpuSocket)
+{
+  BOFERR Rts_E;
+  BOF_SOCKET_PARAM SocketParam_X;
+
+  SocketParam_X.BaseChannelParam_X.ChannelName_S = "bofbench_client";
+  SocketParam_X.BaseChannelParam_X.Blocking_B = true;
+  SocketParam_X.BindIpAddress_S = "tcp://0.0.0.0:0";
+  SocketParam_X.NoDelay_B = true;
+  _rpuSocket.reset(new BofSocket(SocketParam_X));
+  Rts_E = _rpuSocket->LastErrorCode();
+  if (Rts_E == BOF_ERR_NO_ERROR)
+  {
+    Rts_E = _rpuSocket->V_Connect(_TimeoutInMs_U32, Bof_Sprintf("tcp://127.0.0.1:%d", _Port_U16), "");
+  }
+  if (Rts_E != BOF_ERR_NO_ERROR)
+  {
+    _rpuSocket.reset(nullptr);
+  }
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Ping pong of RequestSizeInByte_U32 bytes between the calling thread and an echo through the library classes, so
+ * that their own cost (locks, buffering, session dispatch) is measured on top of the kernel transport measured by
+ * Bof_SocketBenchmarkTcpLatency and Bof_SocketBenchmarkPipeRoundTrip. The response has the size of the request.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _Library_E: Specifies the classes to drive
+ * _rResult_X: Returns the measured values
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if the operation was successful
+ */
+BOFERR Bof_SocketBenchmarkLibraryRoundTrip(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, BOF_SOCKET_LIBRARY_BENCHMARK _Library_E, BOF_SOCKET_BENCHMARK_RESULT &_rResult_X)
+{
+  BOFERR Rts_E = BOF_ERR_EINVAL;
+  BOF_SOCKET_PARAM ListenerParam_X;
+  BOF_SOCKET_SERVER_PARAM SocketServerParam_X;
+  BOF_PIPE_PARAM PipeParam_X;
+  std::unique_ptr<BofSocket> puListener, puClient;
+  std::unique_ptr<BofComChannel> puEcho;
+  std::unique_ptr<BofPipe> puToEcho, puFromEcho;
+  BOFSOCKET Listener;
+  uint16_t Port_U16 = 0;
+
+  _rResult_X.NbSession_U32 = 1;
+  switch (_Library_E)
+  {
+    case BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFSOCKET:
+      _rResult_X.Variant_S = "bofsocket";
+      Rts_E = BOF_ERR_CREATE;
+      Listener = Bof_SocketBenchmarkTcpListen(Port_U16);
+      if (Listener != BOFSOCKET_INVALID)
+      {
+        ListenerParam_X.BaseChannelParam_X.ChannelName_S = "bofbench_listener";
+        ListenerParam_X.BaseChannelParam_X.Blocking_B = true;
+        ListenerParam_X.BaseChannelParam_X.ListenBackLog_U32 = SOMAXCONN;
+        ListenerParam_X.BindIpAddress_S = Bof_Sprintf("tcp://127.0.0.1:%d", Port_U16);
+        ListenerParam_X.NoDelay_B = true;
+        puListener.reset(new BofSocket(Listener, ListenerParam_X));
+        Rts_E = puListener->LastErrorCode();
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = Bof_SocketBenchmarkBofSocketConnect(_rParam_X.TimeoutInMs_U32, Port_U16, puClient);
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        puEcho.reset(puListener->V_Listen(_rParam_X.TimeoutInMs_U32, ""));
+        Rts_E = puEcho ? BOF_ERR_NO_ERROR : BOF_ERR_ENOTCONN;
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        std::thread Echo([&]() { Bof_SocketBenchmarkChannelEcho(*puEcho, *puEcho, _rParam_X.TimeoutInMs_U32, _rParam_X.NbRequest_U32, _rParam_X.RequestSizeInByte_U32); });
+        Rts_E = Bof_SocketBenchmarkChannelRoundTrip(_rParam_X, *puClient, *puClient, _rResult_X);
+        //On error the echo thread is released by the end of stream
+        puClient.reset(nullptr);
+        Echo.join();
+      }
+      break;
+
+    case BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFSOCKETSERVER:
+      _rResult_X.Variant_S = "bofsocketserver";
+      Rts_E = BOF_ERR_CREATE;
+      //Reserve an ephemeral port for the listener of the server
+      Listener = Bof_SocketBenchmarkTcpListen(Port_U16);
+      if (Listener != BOFSOCKET_INVALID)
+      {
+        close(Listener);
+        BofSocketBenchmarkEchoSessionFactory EchoSessionFactory(_rParam_X.TimeoutInMs_U32);
+        SocketServerParam_X.ServerMode_E = BOF_SOCKET_SERVER_MODE::BOF_SOCKET_SERVER_SESSION;
+        SocketServerParam_X.Name_S = "bofbench_server";
+        SocketServerParam_X.Address_S = Bof_Sprintf("tcp://127.0.0.1:%d", Port_U16);
+        SocketServerParam_X.NbMaxSession_U32 = 1;
+        BofSocketServer SocketServer(&EchoSessionFactory, SocketServerParam_X);
+        EchoSessionFactory.Server(&SocketServer);
+        Rts_E = SocketServer.LastErrorCode();
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = Bof_SocketBenchmarkBofSocketConnect(_rParam_X.TimeoutInMs_U32, Port_U16, puClient);
+        }
+        if (Rts_E == BOF_ERR_NO_ERROR)
+        {
+          Rts_E = Bof_SocketBenchmarkChannelRoundTrip(_rParam_X, *puClient, *puClient, _rResult_X);
+          puClient.reset(nullptr);
+        }
+      }
+      break;
+
+    case BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_NATIVE:
+    case BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_UDP:
+      _rResult_X.Variant_S = (_Library_E == BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_NATIVE) ? "bofpipe_native" : "bofpipe_udp";
+      PipeParam_X.PipeType_E = (_Library_E == BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_BOFPIPE_NATIVE) ? BOF_PIPE_TYPE::BOF_PIPE_NATIVE : BOF_PIPE_TYPE::BOF_PIPE_OVER_LOCAL_UDP;
+      PipeParam_X.BaseChannelParam_X.ChannelName_S = "bofbench_to_echo";
+      PipeParam_X.BaseChannelParam_X.Blocking_B = true;
+      puToEcho.reset(new BofPipe(PipeParam_X));
+      PipeParam_X.BaseChannelParam_X.ChannelName_S = "bofbench_from_echo";
+      puFromEcho.reset(new BofPipe(PipeParam_X));
+      Rts_E = puToEcho->LastErrorCode();
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        Rts_E = puFromEcho->LastErrorCode();
+      }
+      if (Rts_E == BOF_ERR_NO_ERROR)
+      {
+        //On error the echo thread gives up after TimeoutInMs_U32
+        std::thread Echo([&]() { Bof_SocketBenchmarkChannelEcho(*puToEcho, *puFromEcho, _rParam_X.TimeoutInMs_U32, _rParam_X.NbRequest_U32, _rParam_X.RequestSizeInByte_U32); });
+        Rts_E = Bof_SocketBenchmarkChannelRoundTrip(_rParam_X, *puToEcho, *puFromEcho, _rResult_X);
+        Echo.join();
+      }
+      break;
+
+    default:
+      break;
+  }
+  return Rts_E;
+}
+#endif
+
+/*!
+ * Description
+ * Runs the loopback benchmarks selected by BenchmarkMask_U32. The tcp benchmarks (latency, stream, accept rate, idle
+ * session) run once per engine of EngineCollection, the other ones once per variant. Each result is printed as a json
+ * line on _pJsonOut as soon as it is available, so a long run can be followed and its output appended to a file.
+ * A benchmark which fails gives a result with its Sts_E and the suite goes on with the next one.
+ *
+ * Parameters
+ * _rParam_X:  Specifies the benchmark parameters
+ * _rResultCollection: Returns one result per benchmark and variant
+ * _pJsonOut:  nullptr or the stream receiving the json lines (stdout for example)
+ *
+ * Returns
+ * BOFERR: BOF_ERR_NO_ERROR if every benchmark was successful, otherwise the first error met
+ */
+BOFERR Bof_SocketBenchmarkSuite(const BOF_SOCKET_BENCHMARK_PARAM &_rParam_X, std::vector<BOF_SOCKET_BENCHMARK_RESULT> &_rResultCollection, FILE *_pJsonOut)
+{
+  BOFERR Rts_E = BOF_ERR_NOT_SUPPORTED;
+#if BOF_SOCKET_BATCH_AVAILABLE
+  BOF_SOCKET_BENCHMARK_RESULT Result_X;
+  BOF_SOCKET_BENCHMARK Benchmark_E;
+  std::vector<BOF_SOCKET_UDP_BENCHMARK_RESULT> UdpResultCollection;
+  uint32_t Benchmark_U32, i_U32, NbVariant_U32;
+  BOFERR Sts_E = BOF_ERR_NO_ERROR;
+
+  _rResultCollection.clear();
+  Rts_E = BOF_ERR_EINVAL;
+  if ((_rParam_X.NbRequest_U32) && (_rParam_X.RequestSizeInByte_U32) && (_rParam_X.RequestSizeInByte_U32 <= 0x10000) && (_rParam_X.ResponseSizeInByte_U32 <= 0x10000) &&
+      (_rParam_X.ChunkSizeInByte_U32))
+  {
+    Rts_E = BOF_ERR_NO_ERROR;
+    for (Benchmark_U32 = 0; Benchmark_U32 < static_cast<uint32_t>(BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_MAX); Benchmark_U32++)
+    {
+      if (_rParam_X.BenchmarkMask_U32 & (1 << Benchmark_U32))
+      {
+        Benchmark_E = static_cast<BOF_SOCKET_BENCHMARK>(Benchmark_U32);
+        UdpResultCollection.clear();
+        switch (Benchmark_E)
+        {
+          case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_UDP_PPS:
+            Sts_E = Bof_SocketUdpLoopbackBenchmarkAllMode(_rParam_X.UdpParam_X, UdpResultCollection);
+            NbVariant_U32 = static_cast<uint32_t>(UdpResultCollection.size());
+            break;
+          case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_FILE_TRANSFER:
+            NbVariant_U32 = 1;
+            break;
+          case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_PIPE_ROUND_TRIP:
+            NbVariant_U32 = 3;
+            break;
+          case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_LIBRARY_ROUND_TRIP:
+            NbVariant_U32 = static_cast<uint32_t>(BOF_SOCKET_LIBRARY_BENCHMARK::BOF_SOCKET_LIBRARY_BENCHMARK_MAX);
+            break;
+          default:
+            NbVariant_U32 = static_cast<uint32_t>(_rParam_X.EngineCollection.size());
+            break;
+        }
+        for (i_U32 = 0; i_U32 < NbVariant_U32; i_U32++)
+        {
+          Result_X.Reset();
+          Result_X.Benchmark_E = Benchmark_E;
+          switch (Benchmark_E)
+          {
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_TCP_LATENCY:
+              Sts_E = Bof_SocketBenchmarkTcpLatency(_rParam_X, _rParam_X.EngineCollection[i_U32], 0, Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_TCP_STREAM:
+              Sts_E = Bof_SocketBenchmarkTcpStream(_rParam_X, _rParam_X.EngineCollection[i_U32], Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_UDP_PPS:
+              Result_X.Variant_S = Bof_SocketUdpBenchmarkModeName(UdpResultCollection[i_U32].Mode_E);
+              Result_X.NbSession_U32 = 1;
+              Result_X.NbOperation_U64 = UdpResultCollection[i_U32].NbDatagramReceived_U64;
+              Result_X.NbByte_U64 = UdpResultCollection[i_U32].NbDatagramReceived_U64 * _rParam_X.UdpParam_X.DatagramSize_U32;
+              Result_X.WallInNs_U64 = UdpResultCollection[i_U32].WallInNs_U64;
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_ACCEPT_RATE:
+              Sts_E = Bof_SocketBenchmarkAcceptRate(_rParam_X, _rParam_X.EngineCollection[i_U32], Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_IDLE_SESSION:
+              Sts_E = Bof_SocketBenchmarkTcpLatency(_rParam_X, _rParam_X.EngineCollection[i_U32], _rParam_X.NbIdleSession_U32, Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_FILE_TRANSFER:
+              Sts_E = Bof_SocketBenchmarkFileTransfer(_rParam_X, Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_PIPE_ROUND_TRIP:
+              Sts_E = (i_U32 == 2) ? Bof_SocketBenchmarkShmPipeRoundTrip(_rParam_X, Result_X) : Bof_SocketBenchmarkPipeRoundTrip(_rParam_X, (i_U32 == 1), Result_X);
+              break;
+            case BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_LIBRARY_ROUND_TRIP:
+              Sts_E = Bof_SocketBenchmarkLibraryRoundTrip(_rParam_X, static_cast<BOF_SOCKET_LIBRARY_BENCHMARK>(i_U32), Result_X);
+              break;
+            default:
+              Sts_E = BOF_ERR_NOT_SUPPORTED;
+              break;
+          }
+          Result_X.Sts_E = Sts_E;
+          if ((Rts_E == BOF_ERR_NO_ERROR) && (Sts_E != BOF_ERR_NO_ERROR))
+          {
+            Rts_E = Sts_E;
+          }
+          _rResultCollection.push_back(Result_X);
+          if (_pJsonOut)
+          {
+            fprintf(_pJsonOut, "%s\n", Bof_SocketBenchmarkResultToJson(Result_X).c_str());
+            fflush(_pJsonOut);
+          }
+        }
+        if ((NbVariant_U32 == 0) && (Rts_E == BOF_ERR_NO_ERROR))
+        {
+          Rts_E = Sts_E;
+        }
+      }
+    }
+  }
+#endif
+  return Rts_E;
+}
+
+/*!
+ * Description
+ * Command line entry point of the benchmark suite: runs Bof_SocketBenchmarkSuite with the default parameters changed
+ * by the options below and prints the json lines on stdout.
+ *  -b name[,name...]   Benchmarks to run (Bof_SocketBenchmarkName: tcp_latency, library_round_trip...), all by default
+ *  -e engine[,engine]  Poller engines of the tcp benchmarks: poll, epoll, io_uring
+ *  -n count            Round trips of the latency benchmarks (NbRequest_U32)
+ *  -s size             Request size in byte
+ *  -t ms               Maximum duration of each benchmark
+ *  -q                  Quick run: small counts and sizes, for a smoke test
+ *
+ * Parameters
+ * _Argc_i:   Specifies the number of arguments
+ * _pArgv_c:  Specifies the arguments
+ *
+ * Returns
+ * int: 0 if every benchmark was successful, 1 if one failed, 2 on a bad option
+ */
+int Bof_SocketBenchmarkMain(int _Argc_i, char *_pArgv_c[])
+{
+  int Rts_i = 0;
+  BOF_SOCKET_BENCHMARK_PARAM Param_X;
+  std::vector<BOF_SOCKET_BENCHMARK_RESULT> ResultCollection;
+  std::vector<std::string> NameCollection;
+  uint32_t Benchmark_U32, Mask_U32;
+  int i_i;
+  char Option_c;
+  const char *pValue_c;
+
+  for (i_i = 1; (i_i < _Argc_i) && (Rts_i == 0); i_i++)
+  {
+    Option_c = ((_pArgv_c[i_i][0] == '-') && (_pArgv_c[i_i][1]) && (_pArgv_c[i_i][2] == 0)) ? _pArgv_c[i_i][1] : 0;
+    pValue_c = ((Option_c != 'q') && ((i_i + 1) < _Argc_i)) ? _pArgv_c[i_i + 1] : nullptr;
+    if (Option_c == 'q')
+    {
+      Param_X.NbRequest_U32 = 1000;
+      Param_X.StreamSizeInByte_U64 = 16 * 1024 * 1024;
+      Param_X.NbConnection_U32 = 200;
+      Param_X.NbIdleSession_U32 = 100;
+      Param_X.FileSizeInByte_U64 = 4 * 1024 * 1024;
+      Param_X.UdpParam_X.NbDatagram_U32 = 20000;
+    }
+    else if (pValue_c == nullptr)
+    {
+      Rts_i = 2;
+    }
+    else
+    {
+      i_i++;
+      switch (Option_c)
+      {
+        case 'b':
+          Param_X.BenchmarkMask_U32 = 0;
+          NameCollection = Bof_StringSplit(pValue_c, ",");
+          for (const std::string &rName_S : NameCollection)
+          {
+            Mask_U32 = 0;
+            for (Benchmark_U32 = 0; Benchmark_U32 < static_cast<uint32_t>(BOF_SOCKET_BENCHMARK::BOF_SOCKET_BENCHMARK_MAX); Benchmark_U32++)
+            {
+              if (rName_S == Bof_SocketBenchmarkName(static_cast<BOF_SOCKET_BENCHMARK>(Benchmark_U32)))
+              {
+                Mask_U32 = (1 << Benchmark_U32);
+              }
+            }
+            if (Mask_U32 == 0)
+            {
+              Rts_i = 2;
+            }
+            Param_X.BenchmarkMask_U32 |= Mask_U32;
+          }
+          break;
+        case 'e':
+          Param_X.EngineCollection.clear();
+          NameCollection = Bof_StringSplit(pValue_c, ",");
+          for (const std::string &rName_S : NameCollection)
+          {
+            if (rName_S == "poll")
+            {
+              Param_X.EngineCollection.push_back(BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_POLL);
+            }
+            else if (rName_S == "epoll")
+            {
+              Param_X.EngineCollection.push_back(BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_EPOLL);
+            }
+            else if (rName_S == "io_uring")
+            {
+              Param_X.EngineCollection.push_back(BOF_SOCKET_POLLER_ENGINE::BOF_SOCKET_POLLER_ENGINE_IO_URING);
+            }
+            else
+            {
+              Rts_i = 2;
+            }
+          }
+          break;
+        case 'n':
+          Param_X.NbRequest_U32 = static_cast<uint32_t>(strtoul(pValue_c, nullptr, 0));
+          break;
+        case 's':
+          Param_X.RequestSizeInByte_U32 = static_cast<uint32_t>(strtoul(pValue_c, nullptr, 0));
+          Param_X.ResponseSizeInByte_U32 = Param_X.RequestSizeInByte_U32;
+          break;
+        case 't':
+          Param_X.TimeoutInMs_U32 = static_cast<uint32_t>(strtoul(pValue_c, nullptr, 0));
+          break;
+        default:
+          Rts_i = 2;
+          break;
+      }
+    }
+  }
+  if (Rts_i)
+  {
+    fprintf(stderr, "Usage: %s [-b benchmark[,benchmark...]] [-e poll|epoll|io_uring[,...]] [-n count] [-s size] [-t ms] [-q]\n", _pArgv_c[0]);
+  }
+  else
+  {
+    Rts_i = (Bof_SocketBenchmarkSuite(Param_X, ResultCollection, stdout) == BOF_ERR_NO_ERROR) ? 0 : 1;
+  }
+  return Rts_i;
+}
+
+END_BOF_NAMESPACE()
+
+int main(int _Argc_i, char *_pArgv_c[])
+{
+  return BOF_NAMESPACE::Bof_SocketBenchmarkMain(_Argc_i, _pArgv_c);
+}